@@ -0,0 +1,595 @@
+// Headless benchmark for the metering core (analog_vu_dsp).
+//
+// Feeds synthetic sine, pink noise and impulse buffers through
+// processInterleavedFloatAudioToVuDb at several frame sizes, channel counts
+// and sample rates, then times the broadcast detectors (VuDetectors.h),
+// VUBallisticsBank, the scale lookups, the fast-math approximations
+// (VuFastMath.h), the spectrum FFT (VuFft.h), the level history
+// (VuLevelHistory.h) and the level export encoding (VuLevelExporter.h) on
+// their own. The pipeline runs in both math modes (dsp/<mode>-fast/...).
+// Reports ns/frame, throughput and heap allocations per call so regressions
+// show up before a build is rolled out.
+//
+// Usage: analog_vu_bench [--time-ms <n>] [--filter <substring>] [--isa <scalar|sse2|avx2|neon>] [--csv]
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "VUBallistics.h"
+#include "VUMeterScale.h"
+#include "VuAudioDsp.h"
+#include "VuDetectors.h"
+#include "VuDspKernels.h"
+#include "VuFastMath.h"
+#include "VuFft.h"
+#include "VuLevelExporter.h"
+#include "VuLevelHistory.h"
+
+// --- Allocation counting ---
+// Global operator new is replaced so every heap allocation made inside a timed
+// loop is counted, including ones hidden in Qt containers.
+
+namespace {
+std::atomic<std::uint64_t> gAllocations{0};
+} // namespace
+
+void* operator new(std::size_t size) {
+    gAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) { return operator new(size); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr double kPi = 3.14159265358979323846;
+
+struct Options {
+    double timeMs = 50.0;
+    std::string filter;
+    bool csv = false;
+};
+
+// --- Signals ---
+
+enum class Signal { Sine, PinkNoise, Impulse };
+
+const char* signalName(Signal s) {
+    switch (s) {
+    case Signal::Sine:
+        return "sine";
+    case Signal::PinkNoise:
+        return "pink";
+    case Signal::Impulse:
+        return "impulse";
+    }
+    return "?";
+}
+
+// One second of interleaved audio, so every buffer position sees realistic data
+std::vector<float> makeSignal(Signal signal, unsigned int channels, float sampleRate) {
+    const std::size_t frames = static_cast<std::size_t>(sampleRate);
+    std::vector<float> out(frames * channels);
+
+    switch (signal) {
+    case Signal::Sine:
+        // 1 kHz at -12 dBFS, small per-channel phase offset
+        for (std::size_t i = 0; i < frames; ++i) {
+            for (unsigned int c = 0; c < channels; ++c) {
+                const double phase = 2.0 * kPi * 1000.0 * static_cast<double>(i) / sampleRate + 0.1 * c;
+                out[i * channels + c] = static_cast<float>(0.25 * std::sin(phase));
+            }
+        }
+        break;
+
+    case Signal::PinkNoise: {
+        // Paul Kellet's economy pink filter over white noise, per channel
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> white(-1.0f, 1.0f);
+        std::vector<float> b0(channels), b1(channels), b2(channels);
+        for (std::size_t i = 0; i < frames; ++i) {
+            for (unsigned int c = 0; c < channels; ++c) {
+                const float w = white(rng);
+                b0[c] = 0.99765f * b0[c] + w * 0.0990460f;
+                b1[c] = 0.96300f * b1[c] + w * 0.2965164f;
+                b2[c] = 0.57000f * b2[c] + w * 1.0526913f;
+                out[i * channels + c] = 0.05f * (b0[c] + b1[c] + b2[c] + w * 0.1848f);
+            }
+        }
+        break;
+    }
+
+    case Signal::Impulse:
+        // Full-scale click every 100 ms on all channels
+        for (std::size_t i = 0; i < frames; i += static_cast<std::size_t>(sampleRate / 10.0f)) {
+            for (unsigned int c = 0; c < channels; ++c) {
+                out[i * channels + c] = 1.0f;
+            }
+        }
+        break;
+    }
+
+    return out;
+}
+
+// --- Reporting ---
+
+struct Result {
+    std::string name;
+    double nsPerCall = 0.0;
+    double nsPerFrame = 0.0;
+    double framesPerSec = 0.0;
+    double allocsPerCall = 0.0;
+};
+
+void printHeader(const Options& opt) {
+    if (opt.csv) {
+        std::printf("case,ns_per_call,ns_per_frame,mframes_per_s,allocs_per_call\n");
+    } else {
+        std::printf("%-44s %12s %12s %12s %10s\n", "case", "ns/call", "ns/frame", "Mframes/s", "allocs");
+    }
+}
+
+void printResult(const Options& opt, const Result& r) {
+    if (opt.csv) {
+        std::printf("%s,%.1f,%.3f,%.2f,%.3f\n",
+                    r.name.c_str(),
+                    r.nsPerCall,
+                    r.nsPerFrame,
+                    r.framesPerSec / 1e6,
+                    r.allocsPerCall);
+    } else {
+        std::printf("%-44s %12.1f %12.3f %12.2f %10.3f\n",
+                    r.name.c_str(),
+                    r.nsPerCall,
+                    r.nsPerFrame,
+                    r.framesPerSec / 1e6,
+                    r.allocsPerCall);
+    }
+    std::fflush(stdout);
+}
+
+// Runs fn repeatedly for about opt.timeMs after a short warm-up. fn processes
+// framesPerCall frames per call (0 for per-call only benchmarks).
+template <typename Fn>
+Result runTimed(const Options& opt, std::string name, unsigned int framesPerCall, Fn&& fn) {
+    for (int i = 0; i < 64; ++i) {
+        fn();
+    }
+
+    const auto budget = std::chrono::duration<double, std::milli>(opt.timeMs);
+    std::uint64_t calls = 0;
+    const std::uint64_t allocsBefore = gAllocations.load(std::memory_order_relaxed);
+    const auto start = Clock::now();
+    auto now = start;
+
+    // Check the clock every 16 calls to keep its cost out of small cases
+    while (now - start < budget) {
+        for (int i = 0; i < 16; ++i) {
+            fn();
+        }
+        calls += 16;
+        now = Clock::now();
+    }
+
+    const double ns = std::chrono::duration<double, std::nano>(now - start).count();
+    const std::uint64_t allocs = gAllocations.load(std::memory_order_relaxed) - allocsBefore;
+
+    Result r;
+    r.name = std::move(name);
+    r.nsPerCall = ns / static_cast<double>(calls);
+    if (framesPerCall > 0) {
+        r.nsPerFrame = r.nsPerCall / framesPerCall;
+        r.framesPerSec = 1e9 / r.nsPerFrame;
+    }
+    r.allocsPerCall = static_cast<double>(allocs) / static_cast<double>(calls);
+    return r;
+}
+
+bool matches(const Options& opt, const std::string& name) {
+    return opt.filter.empty() || name.find(opt.filter) != std::string::npos;
+}
+
+// --- Cases ---
+
+void benchPipeline(const Options& opt) {
+    const Signal signals[] = {Signal::Sine, Signal::PinkNoise, Signal::Impulse};
+    const float sampleRates[] = {44100.0f, 48000.0f, 96000.0f};
+    const unsigned int channelCounts[] = {1, 2, 8, 32};
+    const unsigned int frameSizes[] = {64, 256, 512, 2048};
+    struct Mode {
+        const char* name;
+        VuIntegrationMode integration;
+        VuMathMode math;
+    };
+    const Mode modes[] = {{"callback", VuIntegrationMode::PerCallback, VuMathMode::Exact},
+                          {"block", VuIntegrationMode::BlockAccurate, VuMathMode::Exact},
+                          {"callback-fast", VuIntegrationMode::PerCallback, VuMathMode::Fast},
+                          {"block-fast", VuIntegrationMode::BlockAccurate, VuMathMode::Fast}};
+
+    std::vector<float> out(kVuMaxChannels);
+
+    for (const Mode& mode : modes) {
+        for (const Signal signal : signals) {
+            for (const float sampleRate : sampleRates) {
+                for (const unsigned int channels : channelCounts) {
+                    const std::vector<float> audio = makeSignal(signal, channels, sampleRate);
+                    const std::size_t totalFrames = audio.size() / channels;
+
+                    for (const unsigned int frames : frameSizes) {
+                        char buf[128];
+                        std::snprintf(buf,
+                                      sizeof(buf),
+                                      "dsp/%s/%s/%gk/%uch/%u",
+                                      mode.name,
+                                      signalName(signal),
+                                      sampleRate / 1000.0f,
+                                      channels,
+                                      frames);
+                        if (!matches(opt, buf)) {
+                            continue;
+                        }
+
+                        const VuCalibration calibration = vuCalibration(VuReferenceOptions());
+                        VUBallisticsBank ballistics(-20.0f);
+                        ballistics.setFastMath(mode.math == VuMathMode::Fast);
+                        VuAudioDspState state;
+                        state.integrationMode = mode.integration;
+                        state.mathMode = mode.math;
+                        std::size_t pos = 0;
+
+                        const Result r = runTimed(opt, buf, frames, [&]() {
+                            if (pos + frames > totalFrames) {
+                                pos = 0;
+                            }
+                            processInterleavedFloatAudioToVuDb(audio.data() + pos * channels,
+                                                               frames,
+                                                               channels,
+                                                               sampleRate,
+                                                               calibration,
+                                                               ballistics,
+                                                               state,
+                                                               -20.0f,
+                                                               3.0f,
+                                                               out.data());
+                            pos += frames;
+                        });
+                        printResult(opt, r);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void benchDetectors(const Options& opt) {
+    const unsigned int channelCounts[] = {2, 8};
+    const unsigned int frames = 512;
+    const float sampleRate = 48000.0f;
+
+    struct DetectorCase {
+        const char* name;
+        VuDetectorOptions options;
+    };
+    DetectorCase cases[4] = {{"true-peak", {}}, {"ppm", {}}, {"loudness", {}}, {"all", {}}};
+    cases[0].options.truePeak = true;
+    cases[1].options.ppm = true;
+    cases[2].options.loudness = true;
+    cases[3].options.truePeak = cases[3].options.ppm = cases[3].options.loudness = true;
+
+    for (const unsigned int channels : channelCounts) {
+        const std::vector<float> audio = makeSignal(Signal::PinkNoise, channels, sampleRate);
+        const std::size_t totalFrames = audio.size() / channels;
+
+        for (const DetectorCase& c : cases) {
+            char buf[128];
+            std::snprintf(buf, sizeof(buf), "detectors/%s/%uch/%u", c.name, channels, frames);
+            if (!matches(opt, buf)) {
+                continue;
+            }
+
+            // About 20 KB of state; keep it off the stack like the capture path does
+            const std::unique_ptr<VuDetectorState> state = std::make_unique<VuDetectorState>();
+            std::size_t pos = 0;
+            printResult(opt, runTimed(opt, buf, frames, [&]() {
+                if (pos + frames > totalFrames) {
+                    pos = 0;
+                }
+                processInterleavedFloatAudioDetectors(
+                    audio.data() + pos * channels, frames, channels, sampleRate, c.options, *state);
+                pos += frames;
+            }));
+        }
+    }
+}
+
+void benchExport(const Options& opt) {
+    const unsigned int channelCounts[] = {2, 8};
+    const unsigned int batches[] = {1, 8};
+    const std::pair<const char*, VuLevelExporter::Format> formats[] = {{"binary", VuLevelExporter::Format::Binary},
+                                                                       {"osc", VuLevelExporter::Format::Osc}};
+
+    VuLevelFrame frame;
+    for (unsigned int c = 0; c < kVuMaxChannels; ++c) {
+        frame.vuDb[c] = -6.0f - static_cast<float>(c);
+        frame.peakHoldDb[c] = -3.0f - static_cast<float>(c);
+    }
+
+    for (const auto& [formatName, format] : formats) {
+        for (const unsigned int channels : channelCounts) {
+            for (const unsigned int batch : batches) {
+                char buf[128];
+                std::snprintf(buf, sizeof(buf), "export/%s/%uch/batch%u", formatName, channels, batch);
+                if (!matches(opt, buf)) {
+                    continue;
+                }
+
+                // One packet of the batch, as the exporter thread builds it
+                frame.channels = channels;
+                std::array<std::uint8_t, VuLevelExporter::kMaxPacketBytes> packet{};
+                printResult(opt, runTimed(opt, buf, 0, [&]() {
+                    std::size_t used = VuLevelExporter::beginPacket(format, batch, packet.data());
+                    for (unsigned int i = 0; i < batch; ++i) {
+                        ++frame.sequence;
+                        used += VuLevelExporter::appendFrame(
+                            format, batch, frame, 0, packet.data(), used, packet.size());
+                    }
+                    VuLevelExporter::finishPacket(format, packet.data(), batch);
+                }));
+            }
+        }
+    }
+}
+
+void benchBallistics(const Options& opt) {
+    const unsigned int channelCounts[] = {1, 2, 8, 32};
+
+    std::vector<float> target(kVuMaxChannels);
+    std::vector<float> out(kVuMaxChannels);
+    for (unsigned int c = 0; c < kVuMaxChannels; ++c) {
+        target[c] = -10.0f + 0.5f * static_cast<float>(c);
+    }
+
+    for (const unsigned int channels : channelCounts) {
+        const std::string processName = "ballistics/process/" + std::to_string(channels) + "ch";
+        if (matches(opt, processName)) {
+            VUBallisticsBank bank(-20.0f);
+            float flip = 1.0f;
+            printResult(opt, runTimed(opt, processName, 0, [&]() {
+                target[0] = flip * 3.0f;
+                flip = -flip;
+                bank.process(target.data(), out.data(), channels, 0.010f);
+            }));
+        }
+
+        const std::string stepName = "ballistics/step/" + std::to_string(channels) + "ch";
+        if (matches(opt, stepName)) {
+            VUBallisticsBank bank(-20.0f);
+            bank.setControlStep(0.001f);
+            float flip = 1.0f;
+            printResult(opt, runTimed(opt, stepName, 0, [&]() {
+                target[0] = flip * 3.0f;
+                flip = -flip;
+                bank.step(target.data(), out.data(), channels);
+            }));
+        }
+    }
+}
+
+void benchScale(const Options& opt) {
+    // Sweep the whole table range, including clamped values at both ends
+    std::vector<float> inputs(1024);
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        inputs[i] = -24.0f + 30.0f * static_cast<float>(i) / static_cast<float>(inputs.size());
+    }
+
+    // Default calibration, and a dense 128-point skin-style table
+    VUMeterScaleTable dense;
+    for (int i = 0; i < 128; ++i) {
+        const float vu = -20.0f + 23.0f * static_cast<float>(i) / 127.0f;
+        dense.append({vu, -47.0f + 94.0f * static_cast<float>(i) / 127.0f});
+    }
+
+    const struct {
+        const char* name;
+        VUMeterScaleTable table;
+    } tables[] = {{"default", builtInDefaultScaleTable()}, {"dense128", dense}};
+
+    for (const auto& t : tables) {
+        const std::string referenceName = std::string("scale/vuToAngleDeg/") + t.name;
+        if (matches(opt, referenceName)) {
+            std::size_t i = 0;
+            volatile float sink = 0.0f;
+            printResult(opt, runTimed(opt, referenceName, 0, [&]() {
+                sink = vuToAngleDeg(inputs[i], t.table);
+                i = (i + 1) & (inputs.size() - 1);
+            }));
+        }
+
+        const std::string compiledName = std::string("scale/compiled/") + t.name;
+        if (matches(opt, compiledName)) {
+            const VUMeterCompiledScale scale(t.table);
+            std::size_t i = 0;
+            volatile float sink = 0.0f;
+            printResult(opt, runTimed(opt, compiledName, 0, [&]() {
+                sink = scale.angleDeg(inputs[i]);
+                i = (i + 1) & (inputs.size() - 1);
+            }));
+        }
+    }
+}
+
+void benchMath(const Options& opt) {
+    // Mean squares across the meter's range, -120..+6 dBFS
+    std::vector<float> power(1024);
+    for (std::size_t i = 0; i < power.size(); ++i) {
+        const float dbfs = -120.0f + 126.0f * static_cast<float>(i) / static_cast<float>(power.size());
+        power[i] = std::pow(10.0f, dbfs / 10.0f);
+    }
+    std::vector<float> db(power.size());
+    const unsigned int n = static_cast<unsigned int>(power.size());
+
+    if (matches(opt, "math/powerDb/exact")) {
+        printResult(opt, runTimed(opt, "math/powerDb/exact", n, [&]() {
+            for (unsigned int i = 0; i < n; ++i) {
+                db[i] = 20.0f * std::log10(std::sqrt(power[i]));
+            }
+        }));
+    }
+    if (matches(opt, "math/powerDb/fast")) {
+        printResult(opt, runTimed(opt, "math/powerDb/fast", n, [&]() {
+            for (unsigned int i = 0; i < n; ++i) {
+                db[i] = vuFastPowerDb(power[i]);
+            }
+        }));
+    }
+    if (matches(opt, "math/exp/exact")) {
+        printResult(opt, runTimed(opt, "math/exp/exact", n, [&]() {
+            for (unsigned int i = 0; i < n; ++i) {
+                db[i] = std::exp(-power[i]);
+            }
+        }));
+    }
+    if (matches(opt, "math/exp/fast")) {
+        printResult(opt, runTimed(opt, "math/exp/fast", n, [&]() {
+            for (unsigned int i = 0; i < n; ++i) {
+                db[i] = vuFastExp(-power[i]);
+            }
+        }));
+    }
+}
+
+void benchOverlay(const Options& opt) {
+    const unsigned int fftSizes[] = {1024, 4096};
+    for (const unsigned int size : fftSizes) {
+        const std::string name = "fft/real/" + std::to_string(size);
+        if (!matches(opt, name)) {
+            continue;
+        }
+        VuRealFft fft(size);
+        const std::vector<float> audio = makeSignal(Signal::PinkNoise, 1, 48000.0f);
+        std::vector<float> re(fft.bins());
+        std::vector<float> im(fft.bins());
+        printResult(opt, runTimed(opt, name, size, [&]() { fft.transform(audio.data(), re.data(), im.data()); }));
+    }
+
+    // One history push per 256-frame stereo block, as the DSP worker does
+    if (matches(opt, "history/push")) {
+        VuLevelHistory history(-96.0f);
+        VuLevelFrame frame;
+        frame.channels = 2;
+        constexpr unsigned int kFrames = 256;
+        std::uint64_t counter = 0;
+        float level = -20.0f;
+        printResult(opt, runTimed(opt, "history/push", kFrames, [&]() {
+            level = level > 3.0f ? -20.0f : level + 0.1f;
+            frame.vuDb[0] = frame.vuDb[1] = level;
+            frame.peakHoldDb[0] = frame.peakHoldDb[1] = level;
+            counter += kFrames;
+            frame.frameCounter = counter;
+            history.push(frame, kFrames, 48000.0f);
+        }));
+    }
+
+    // A strip render's worth of reads: the 60 s span on both channels
+    if (matches(opt, "history/read")) {
+        VuLevelHistory history(-96.0f);
+        VuLevelFrame frame;
+        frame.channels = 2;
+        for (std::uint64_t i = 1; i <= 12000; ++i) { // 64 s of 256-frame blocks
+            frame.frameCounter = i * 256;
+            history.push(frame, 256, 48000.0f);
+        }
+        const unsigned int level = VuLevelHistory::levelFor(60.0, 800);
+        std::vector<VuLevelHistory::Bucket> buckets(VuLevelHistory::kCapacity);
+        printResult(opt, runTimed(opt, "history/read", 0, [&]() {
+            for (unsigned int c = 0; c < 2; ++c) {
+                history.read(level, c, buckets.data(), VuLevelHistory::kCapacity);
+            }
+        }));
+    }
+}
+
+bool parseIsa(const char* s, VuDspIsa& isa) {
+    const VuDspIsa all[] = {VuDspIsa::Scalar, VuDspIsa::Sse2, VuDspIsa::Avx2, VuDspIsa::Neon};
+    for (const VuDspIsa candidate : all) {
+        std::string name = vuDspIsaName(candidate);
+        std::transform(name.begin(), name.end(), name.begin(), [](unsigned char ch) { return std::tolower(ch); });
+        if (name == s) {
+            isa = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+void usage() {
+    std::fprintf(stderr,
+                 "Usage: analog_vu_bench [--time-ms <n>] [--filter <substring>] "
+                 "[--isa <scalar|sse2|avx2|neon>] [--csv]\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--time-ms") == 0 && i + 1 < argc) {
+            opt.timeMs = std::max(1.0, std::atof(argv[++i]));
+        } else if (std::strcmp(arg, "--filter") == 0 && i + 1 < argc) {
+            opt.filter = argv[++i];
+        } else if (std::strcmp(arg, "--isa") == 0 && i + 1 < argc) {
+            VuDspIsa isa = VuDspIsa::Scalar;
+            if (!parseIsa(argv[++i], isa)) {
+                usage();
+                return 2;
+            }
+            setVuActiveDspIsa(isa);
+        } else if (std::strcmp(arg, "--csv") == 0) {
+            opt.csv = true;
+        } else {
+            usage();
+            return 2;
+        }
+    }
+
+    if (!opt.csv) {
+        std::printf("analog_vu_bench: kernel %s, %.0f ms per case\n\n", vuDspIsaName(vuActiveDspIsa()), opt.timeMs);
+    }
+
+    printHeader(opt);
+    benchPipeline(opt);
+    benchDetectors(opt);
+    benchBallistics(opt);
+    benchScale(opt);
+    benchMath(opt);
+    benchOverlay(opt);
+    benchExport(opt);
+    return 0;
+}
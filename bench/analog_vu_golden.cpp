@@ -0,0 +1,706 @@
+// Golden-output regression check for the metering core and the meter renderer.
+//
+// Runs canned, deterministic audio through processInterleavedFloatAudioToVuDb
+// and VUBallisticsBank and compares the VU traces with the files under
+// bench/golden/dsp, for every built-in kernel (VuDspKernels.h) and both math
+// modes against the same reference trace. The vector kernels are also checked
+// against the scalar one directly, for 1..kVuMaxChannels channels and buffer
+// lengths that are not a multiple of the lane period. GUI builds also render
+// StereoVUMeterWidget offscreen for each VUMeterStyle, the Skin style being
+// the bundled model_702w skin, at fixed levels and compare the images with
+// bench/golden/render within a per-pixel tolerance.
+//
+// Every case is timed as well (per callback or per frame) and the p50/p95/p99
+// are printed; --history appends them to a CSV and reports the change since
+// the previous run, so an optimization can be accepted on both counts.
+//
+// Usage: analog_vu_golden [--record] [--golden-dir <dir>] [--out <dir>] [--filter <substring>]
+//                         [--tolerance-db <dB>] [--pixel-tolerance <0..255>]
+//                         [--history <csv>] [--max-regression <percent>]
+//
+// Exit status: 0 when every case matches, 1 on a mismatch, a missing golden
+// file or a timing regression beyond --max-regression, 2 on bad arguments.
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "VUBallistics.h"
+#include "VuAudioDsp.h"
+#include "VuDspKernels.h"
+
+#if defined(ANALOGVU_GOLDEN_RENDER) && (ANALOGVU_GOLDEN_RENDER == 1)
+#include <QApplication>
+#include <QFont>
+#include <QImage>
+
+#include "StereoVUMeterWidget.h"
+#endif
+
+#ifndef ANALOGVU_GOLDEN_DIR
+#define ANALOGVU_GOLDEN_DIR "bench/golden"
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr double kPi = 3.14159265358979323846;
+
+constexpr float kSampleRate = 48000.0f;
+constexpr unsigned int kChannels = 2;
+constexpr unsigned int kCallbackFrames = 480; // one trace row per 10 ms
+constexpr float kMinVu = -20.0f;
+constexpr float kMaxVu = 3.0f;
+
+struct Options {
+    bool record = false;
+    std::string goldenDir = ANALOGVU_GOLDEN_DIR;
+    std::string outDir = ".";
+    std::string filter;
+    double toleranceDb = 0.01;
+    int pixelTolerance = 8;
+    std::string historyPath;
+    double maxRegressionPercent = -1.0; // < 0: report only
+};
+
+struct Timing {
+    std::string name;
+    double p50Us = 0.0;
+    double p95Us = 0.0;
+    double p99Us = 0.0;
+};
+
+struct Report {
+    int passed = 0;
+    int failed = 0;
+    std::vector<Timing> timings;
+};
+
+bool matches(const Options& opt, const std::string& name) {
+    return opt.filter.empty() || name.find(opt.filter) != std::string::npos;
+}
+
+Timing percentiles(std::string name, std::vector<double> ns) {
+    Timing t;
+    t.name = std::move(name);
+    if (ns.empty()) {
+        return t;
+    }
+    std::sort(ns.begin(), ns.end());
+    auto at = [&](double q) { return ns[static_cast<std::size_t>(q * (ns.size() - 1))] / 1000.0; };
+    t.p50Us = at(0.50);
+    t.p95Us = at(0.95);
+    t.p99Us = at(0.99);
+    return t;
+}
+
+// -------- Canned audio --------
+
+// 32-bit LCG: the same noise on every platform and standard library
+class NoiseSource final {
+  public:
+    float next() {
+        state_ = state_ * 1664525u + 1013904223u;
+        return static_cast<float>(state_ >> 8) * (2.0f / 16777216.0f) - 1.0f;
+    }
+
+  private:
+    std::uint32_t state_ = 0x2545f491u;
+};
+
+enum class Signal { Tone, Pink, Impulse };
+
+const char* signalName(Signal s) {
+    switch (s) {
+    case Signal::Tone:
+        return "tone";
+    case Signal::Pink:
+        return "pink";
+    case Signal::Impulse:
+        return "impulse";
+    }
+    return "?";
+}
+
+// Three seconds of interleaved stereo; the right channel is 6 dB lower
+std::vector<float> makeSignal(Signal signal) {
+    const std::size_t frames = static_cast<std::size_t>(3.0f * kSampleRate);
+    std::vector<float> out(frames * kChannels, 0.0f);
+    const float gains[kChannels] = {1.0f, 0.5f};
+
+    switch (signal) {
+    case Signal::Tone:
+        // Silence, 1 kHz at 0 VU on system output (-14 dBFS RMS), +10 dB
+        // above that, then silence: attack, overshoot, pinning and release
+        for (std::size_t i = 0; i < frames; ++i) {
+            const double t = static_cast<double>(i) / kSampleRate;
+            double amplitude = 0.0;
+            if (t >= 0.5 && t < 1.5) {
+                amplitude = std::sqrt(2.0) * std::pow(10.0, -14.0 / 20.0);
+            } else if (t >= 1.5 && t < 2.0) {
+                amplitude = std::sqrt(2.0) * std::pow(10.0, -4.0 / 20.0);
+            }
+            const float s = static_cast<float>(amplitude * std::sin(2.0 * kPi * 1000.0 * t));
+            for (unsigned int c = 0; c < kChannels; ++c) {
+                out[i * kChannels + c] = s * gains[c];
+            }
+        }
+        break;
+
+    case Signal::Pink: {
+        // Paul Kellet's economy pink filter, as in analog_vu_bench
+        NoiseSource noise;
+        float b0 = 0.0f, b1 = 0.0f, b2 = 0.0f;
+        for (std::size_t i = 0; i < frames; ++i) {
+            const float w = noise.next();
+            b0 = 0.99765f * b0 + w * 0.0990460f;
+            b1 = 0.96300f * b1 + w * 0.2965164f;
+            b2 = 0.57000f * b2 + w * 1.0526913f;
+            const float s = 0.1f * (b0 + b1 + b2 + w * 0.1848f);
+            for (unsigned int c = 0; c < kChannels; ++c) {
+                out[i * kChannels + c] = s * gains[c];
+            }
+        }
+        break;
+    }
+
+    case Signal::Impulse:
+        // Full-scale click every 250 ms
+        for (std::size_t i = 0; i < frames; i += static_cast<std::size_t>(kSampleRate / 4.0f)) {
+            for (unsigned int c = 0; c < kChannels; ++c) {
+                out[i * kChannels + c] = gains[c];
+            }
+        }
+        break;
+    }
+    return out;
+}
+
+// -------- DSP traces --------
+
+struct TraceRow {
+    double timeS = 0.0;
+    std::array<float, kChannels> vu{};
+};
+
+struct Trace {
+    std::vector<TraceRow> rows;
+    std::vector<double> callNs;
+};
+
+Trace runTrace(const std::vector<float>& audio, VuIntegrationMode integration, VuMathMode math) {
+    const VuCalibration calibration = vuCalibration(VuReferenceOptions());
+    VUBallisticsBank ballistics(kMinVu);
+    ballistics.setFastMath(math == VuMathMode::Fast);
+    VuAudioDspState state;
+    state.integrationMode = integration;
+    state.mathMode = math;
+
+    Trace trace;
+    const std::size_t frames = audio.size() / kChannels;
+    trace.rows.reserve(frames / kCallbackFrames);
+    trace.callNs.reserve(frames / kCallbackFrames);
+
+    std::array<float, kVuMaxChannels> out{};
+    for (std::size_t pos = 0; pos + kCallbackFrames <= frames; pos += kCallbackFrames) {
+        const auto start = Clock::now();
+        processInterleavedFloatAudioToVuDb(audio.data() + pos * kChannels,
+                                           kCallbackFrames,
+                                           kChannels,
+                                           kSampleRate,
+                                           calibration,
+                                           ballistics,
+                                           state,
+                                           kMinVu,
+                                           kMaxVu,
+                                           out.data());
+        trace.callNs.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+
+        TraceRow row;
+        row.timeS = static_cast<double>(pos + kCallbackFrames) / kSampleRate;
+        std::copy_n(out.begin(), kChannels, row.vu.begin());
+        trace.rows.push_back(row);
+    }
+    return trace;
+}
+
+bool writeTrace(const fs::path& path, const std::string& name, const Trace& trace) {
+    fs::create_directories(path.parent_path());
+    std::ofstream f(path);
+    if (!f) {
+        return false;
+    }
+    f << "# analog_vu_golden " << name << "\n# time_s left_vu right_vu\n";
+    char line[96];
+    for (const TraceRow& row : trace.rows) {
+        std::snprintf(line, sizeof(line), "%.3f %.4f %.4f\n", row.timeS, row.vu[0], row.vu[1]);
+        f << line;
+    }
+    return static_cast<bool>(f);
+}
+
+bool readTrace(const fs::path& path, std::vector<TraceRow>& rows) {
+    std::ifstream f(path);
+    if (!f) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(f, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream in(line);
+        TraceRow row;
+        if (!(in >> row.timeS >> row.vu[0] >> row.vu[1])) {
+            return false;
+        }
+        rows.push_back(row);
+    }
+    return true;
+}
+
+// Empty when the traces agree, else what differs first
+std::string compareTrace(const std::vector<TraceRow>& golden, const Trace& actual, double toleranceDb) {
+    if (golden.size() != actual.rows.size()) {
+        return "row count " + std::to_string(actual.rows.size()) + ", golden " + std::to_string(golden.size());
+    }
+    for (std::size_t i = 0; i < golden.size(); ++i) {
+        for (unsigned int c = 0; c < kChannels; ++c) {
+            const double diff = std::abs(static_cast<double>(actual.rows[i].vu[c]) - golden[i].vu[c]);
+            if (diff > toleranceDb) {
+                char msg[128];
+                std::snprintf(msg,
+                              sizeof(msg),
+                              "t=%.3f s ch%u: %.4f VU, golden %.4f",
+                              golden[i].timeS,
+                              c,
+                              actual.rows[i].vu[c],
+                              golden[i].vu[c]);
+                return msg;
+            }
+        }
+    }
+    return std::string();
+}
+
+void reportCase(Report& report, const std::string& name, const std::string& error) {
+    if (error.empty()) {
+        ++report.passed;
+        std::printf("ok    %s\n", name.c_str());
+    } else {
+        ++report.failed;
+        std::printf("FAIL  %s: %s\n", name.c_str(), error.c_str());
+    }
+    std::fflush(stdout);
+}
+
+void checkDsp(const Options& opt, Report& report) {
+    struct Mode {
+        const char* name;
+        VuIntegrationMode integration;
+    };
+    const Mode modes[] = {{"callback", VuIntegrationMode::PerCallback}, {"block", VuIntegrationMode::BlockAccurate}};
+    const Signal signals[] = {Signal::Tone, Signal::Pink, Signal::Impulse};
+    const VuDspIsa isas[] = {VuDspIsa::Scalar, VuDspIsa::Sse2, VuDspIsa::Avx2, VuDspIsa::Neon};
+    const VuDspIsa defaultIsa = vuActiveDspIsa();
+
+    for (const Mode& mode : modes) {
+        for (const Signal signal : signals) {
+            const std::string base = std::string("dsp/") + mode.name + "/" + signalName(signal);
+            const fs::path path =
+                fs::path(opt.goldenDir) / "dsp" / (std::string(mode.name) + "-" + signalName(signal) + ".txt");
+            const std::vector<float> audio = makeSignal(signal);
+
+            // The reference: scalar kernel, exact math
+            if (opt.record) {
+                if (!matches(opt, base)) {
+                    continue;
+                }
+                setVuActiveDspIsa(VuDspIsa::Scalar);
+                const Trace trace = runTrace(audio, mode.integration, VuMathMode::Exact);
+                reportCase(report, base, writeTrace(path, base, trace) ? "" : "cannot write " + path.string());
+                continue;
+            }
+
+            std::vector<TraceRow> golden;
+            const bool haveGolden = readTrace(path, golden);
+
+            for (const VuDspIsa isa : isas) {
+                if (!vuEmphasisSumKernel(isa)) {
+                    continue;
+                }
+                for (const VuMathMode math : {VuMathMode::Exact, VuMathMode::Fast}) {
+                    std::string name = base + "/" + vuDspIsaName(isa);
+                    if (math == VuMathMode::Fast) {
+                        name += "-fast";
+                    }
+                    std::transform(name.begin(), name.end(), name.begin(), [](unsigned char ch) {
+                        return static_cast<char>(std::tolower(ch));
+                    });
+                    if (!matches(opt, name)) {
+                        continue;
+                    }
+
+                    setVuActiveDspIsa(isa);
+                    const Trace trace = runTrace(audio, mode.integration, math);
+                    report.timings.push_back(percentiles(name, trace.callNs));
+                    reportCase(report,
+                               name,
+                               haveGolden ? compareTrace(golden, trace, opt.toleranceDb)
+                                          : "no golden " + path.string() + " (run with --record)");
+                }
+            }
+        }
+    }
+    setVuActiveDspIsa(defaultIsa);
+}
+
+// -------- Kernel agreement --------
+
+// Every vector kernel against the scalar reference on the same buffers: all
+// channel counts (so every lane period lcm(channels, lanes) and its
+// per-position accumulators), frame counts around and between whole periods,
+// consecutive calls handing prev[] over, and a stride wider than the metered
+// channels. prev[] must come back bit-identical. The sums differ only in the
+// order of the double additions, so each has to agree within twice the
+// recursive-summation bound, frames * 2^-52 relative; NEON allows 2^-21, one
+// float ulp in the squared emphasis, for a scalar path contracted to FMA.
+std::string compareKernel(VuEmphasisSumKernel kernel, VuDspIsa isa, unsigned int channels) {
+    const unsigned int frameCounts[] = {1, 2, 3, 5, 8, 17, 63, 64, 65, 255, 257, 479, 1021};
+    const double ulpTolerance = isa == VuDspIsa::Neon ? std::ldexp(1.0, -21) : 0.0;
+    const VuEmphasisSumKernel scalar = vuEmphasisSumKernel(VuDspIsa::Scalar);
+
+    NoiseSource noise;
+    for (const unsigned int stride : {channels, channels + 1}) {
+        std::array<float, kVuMaxChannels> prevRef{};
+        std::array<double, kVuMaxChannels> sumsRef{};
+        for (unsigned int c = 0; c < channels; ++c) {
+            prevRef[c] = noise.next();
+        }
+        std::array<float, kVuMaxChannels> prev = prevRef;
+        std::array<double, kVuMaxChannels> sums = sumsRef;
+
+        unsigned long long totalFrames = 0;
+        for (const unsigned int frames : frameCounts) {
+            std::vector<float> data(static_cast<std::size_t>(frames) * stride);
+            for (float& x : data) {
+                x = noise.next();
+            }
+            scalar(data.data(), frames, stride, channels, prevRef.data(), sumsRef.data());
+            kernel(data.data(), frames, stride, channels, prev.data(), sums.data());
+            totalFrames += frames;
+
+            const double tolerance = std::max(static_cast<double>(totalFrames) * std::ldexp(1.0, -52), ulpTolerance);
+            for (unsigned int c = 0; c < channels; ++c) {
+                char msg[160];
+                if (prev[c] != prevRef[c]) {
+                    std::snprintf(msg,
+                                  sizeof(msg),
+                                  "stride %u, %u frames, ch%u: prev %.9g, scalar %.9g",
+                                  stride,
+                                  frames,
+                                  c,
+                                  prev[c],
+                                  prevRef[c]);
+                    return msg;
+                }
+                const double error = std::abs(sums[c] - sumsRef[c]) / std::max(sumsRef[c], 1e-300);
+                if (error > tolerance) {
+                    std::snprintf(msg,
+                                  sizeof(msg),
+                                  "stride %u, %u frames, ch%u: sum %.17g, scalar %.17g (rel %.3g > %.3g)",
+                                  stride,
+                                  frames,
+                                  c,
+                                  sums[c],
+                                  sumsRef[c],
+                                  error,
+                                  tolerance);
+                    return msg;
+                }
+            }
+        }
+    }
+    return std::string();
+}
+
+void checkKernels(const Options& opt, Report& report) {
+    if (opt.record) {
+        return; // compared against the scalar kernel, nothing to record
+    }
+    for (const VuDspIsa isa : {VuDspIsa::Sse2, VuDspIsa::Avx2, VuDspIsa::Neon}) {
+        const VuEmphasisSumKernel kernel = vuEmphasisSumKernel(isa);
+        if (!kernel) {
+            continue;
+        }
+        for (unsigned int channels = 1; channels <= kVuMaxChannels; ++channels) {
+            const std::string name = std::string("kernel/") + vuDspIsaName(isa) + "/" + std::to_string(channels) + "ch";
+            if (matches(opt, name)) {
+                reportCase(report, name, compareKernel(kernel, isa, channels));
+            }
+        }
+    }
+}
+
+// -------- Rendering --------
+
+#if defined(ANALOGVU_GOLDEN_RENDER) && (ANALOGVU_GOLDEN_RENDER == 1)
+constexpr int kRenderWidth = 800;
+constexpr int kRenderHeight = 300;
+constexpr int kTimedFrames = 200;
+
+// Empty when the images agree: no channel further apart than pixelTolerance
+// on more than 0.1% of the pixels (antialiasing and font hinting vary a little)
+std::string compareImage(const QImage& golden, const QImage& actual, int pixelTolerance) {
+    if (golden.size() != actual.size()) {
+        return "size differs from the golden image";
+    }
+    const QImage a = actual.convertToFormat(QImage::Format_ARGB32);
+    const QImage g = golden.convertToFormat(QImage::Format_ARGB32);
+
+    qint64 differing = 0;
+    int worst = 0;
+    for (int y = 0; y < a.height(); ++y) {
+        const QRgb* la = reinterpret_cast<const QRgb*>(a.constScanLine(y));
+        const QRgb* lg = reinterpret_cast<const QRgb*>(g.constScanLine(y));
+        for (int x = 0; x < a.width(); ++x) {
+            const int d = std::max({std::abs(qRed(la[x]) - qRed(lg[x])),
+                                    std::abs(qGreen(la[x]) - qGreen(lg[x])),
+                                    std::abs(qBlue(la[x]) - qBlue(lg[x])),
+                                    std::abs(qAlpha(la[x]) - qAlpha(lg[x]))});
+            worst = std::max(worst, d);
+            if (d > pixelTolerance) {
+                ++differing;
+            }
+        }
+    }
+
+    const qint64 allowed = static_cast<qint64>(a.width()) * a.height() / 1000;
+    if (differing > allowed) {
+        return std::to_string(differing) + " pixels differ (max channel difference " + std::to_string(worst) + ")";
+    }
+    return std::string();
+}
+
+void checkRender(const Options& opt, Report& report) {
+    struct StyleCase {
+        const char* name;
+        VUMeterStyle style;
+    };
+    const StyleCase styles[] = {{"original", VUMeterStyle::Original},
+                                {"vintage", VUMeterStyle::Vintage},
+                                {"modern", VUMeterStyle::Modern},
+                                {"black", VUMeterStyle::Black},
+                                {"skin-model_702w", VUMeterStyle::Skin}};
+    struct LevelCase {
+        const char* name;
+        float left;
+        float right;
+    };
+    const LevelCase levels[] = {{"rest", -20.0f, -20.0f}, {"mid", -7.0f, -3.0f}, {"hot", 0.0f, 3.0f}};
+
+    for (const StyleCase& s : styles) {
+        StereoVUMeterWidget widget;
+        widget.setAttribute(Qt::WA_DontShowOnScreen);
+        widget.resize(kRenderWidth, kRenderHeight);
+
+        // One family without hinting, so labels rasterize alike across font setups
+        QFont font(QStringLiteral("DejaVu Sans"));
+        font.setStyleHint(QFont::SansSerif);
+        font.setHintingPreference(QFont::PreferNoHinting);
+        widget.setFont(font);
+        widget.clearSkin(); // the bundled model_702w
+        widget.setStyle(s.style);
+
+        QImage image(kRenderWidth, kRenderHeight, QImage::Format_ARGB32_Premultiplied);
+
+        for (const LevelCase& l : levels) {
+            const std::string name = std::string("render/") + s.name + "/" + l.name;
+            if (!matches(opt, name)) {
+                continue;
+            }
+            const fs::path path = fs::path(opt.goldenDir) / "render" / (std::string(s.name) + "-" + l.name + ".png");
+
+            widget.setLevels(l.left, l.right);
+            image.fill(Qt::black);
+            widget.render(&image);
+
+            if (opt.record) {
+                fs::create_directories(path.parent_path());
+                const bool saved = image.save(QString::fromStdString(path.string()));
+                reportCase(report, name, saved ? "" : "cannot write " + path.string());
+                continue;
+            }
+
+            // Render goldens depend on the Qt version and its fonts; a missing
+            // one fails like any other, so an unrecorded platform is noticed
+            const QImage golden(QString::fromStdString(path.string()));
+            if (golden.isNull()) {
+                reportCase(report, name, "no golden " + path.string() + " (record with --record --filter render/)");
+                continue;
+            }
+            std::string error = compareImage(golden, image, opt.pixelTolerance);
+            if (!error.empty()) {
+                // Kept for inspection next to the golden
+                const fs::path actual = fs::path(opt.outDir) / (std::string(s.name) + "-" + l.name + ".actual.png");
+                fs::create_directories(actual.parent_path());
+                if (image.save(QString::fromStdString(actual.string()))) {
+                    error += "; wrote " + actual.string();
+                }
+            }
+            reportCase(report, name, error);
+        }
+
+        // Frame time with the needles sweeping, the cached layers already built
+        const std::string timedName = std::string("render/") + s.name + "/frame";
+        if (opt.record || !matches(opt, timedName)) {
+            continue;
+        }
+        std::vector<double> ns;
+        ns.reserve(kTimedFrames);
+        for (int i = 0; i < kTimedFrames; ++i) {
+            const float vu = kMinVu + (kMaxVu - kMinVu) * static_cast<float>(i % 50) / 49.0f;
+            widget.setLevels(vu, vu);
+            const auto start = Clock::now();
+            widget.render(&image);
+            ns.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+        }
+        report.timings.push_back(percentiles(timedName, std::move(ns)));
+    }
+}
+#endif
+
+// -------- Timing history --------
+
+// Last recorded p95 per case: rows are unix_time,case,p50_us,p95_us,p99_us
+std::map<std::string, double> readHistory(const std::string& path) {
+    std::map<std::string, double> last;
+    std::ifstream f(path);
+    std::string line;
+    while (std::getline(f, line)) {
+        std::istringstream in(line);
+        std::string time, name, p50, p95;
+        if (std::getline(in, time, ',') && std::getline(in, name, ',') && std::getline(in, p50, ',') &&
+            std::getline(in, p95, ',')) {
+            last[name] = std::atof(p95.c_str());
+        }
+    }
+    return last;
+}
+
+// Prints the percentiles and returns the number of cases slower than allowed
+int reportTimings(const Options& opt, const std::vector<Timing>& timings) {
+    if (timings.empty()) {
+        return 0;
+    }
+
+    const std::map<std::string, double> previous =
+        opt.historyPath.empty() ? std::map<std::string, double>() : readHistory(opt.historyPath);
+
+    std::printf("\n%-44s %10s %10s %10s %10s\n", "timing", "p50 us", "p95 us", "p99 us", "p95 diff");
+    int regressions = 0;
+    for (const Timing& t : timings) {
+        char diff[32] = "";
+        const auto it = previous.find(t.name);
+        if (it != previous.end() && it->second > 0.0) {
+            const double percent = 100.0 * (t.p95Us - it->second) / it->second;
+            std::snprintf(diff, sizeof(diff), "%+.1f%%", percent);
+            if (opt.maxRegressionPercent >= 0.0 && percent > opt.maxRegressionPercent) {
+                ++regressions;
+                std::strncat(diff, " SLOW", sizeof(diff) - std::strlen(diff) - 1);
+            }
+        }
+        std::printf("%-44s %10.2f %10.2f %10.2f %10s\n", t.name.c_str(), t.p50Us, t.p95Us, t.p99Us, diff);
+    }
+
+    if (!opt.historyPath.empty()) {
+        std::ofstream f(opt.historyPath, std::ios::app);
+        const long long now = static_cast<long long>(std::time(nullptr));
+        char line[256];
+        for (const Timing& t : timings) {
+            std::snprintf(
+                line, sizeof(line), "%lld,%s,%.3f,%.3f,%.3f\n", now, t.name.c_str(), t.p50Us, t.p95Us, t.p99Us);
+            f << line;
+        }
+        if (!f) {
+            std::fprintf(stderr, "analog_vu_golden: cannot append to %s\n", opt.historyPath.c_str());
+        }
+    }
+    return regressions;
+}
+
+void usage() {
+    std::fprintf(stderr,
+                 "Usage: analog_vu_golden [--record] [--golden-dir <dir>] [--out <dir>] [--filter <substring>]\n"
+                 "                        [--tolerance-db <dB>] [--pixel-tolerance <0..255>]\n"
+                 "                        [--history <csv>] [--max-regression <percent>]\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+#if defined(ANALOGVU_GOLDEN_RENDER) && (ANALOGVU_GOLDEN_RENDER == 1)
+    // Render without a display unless a platform was chosen explicitly
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+#endif
+
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--record") == 0) {
+            opt.record = true;
+        } else if (std::strcmp(arg, "--golden-dir") == 0 && i + 1 < argc) {
+            opt.goldenDir = argv[++i];
+        } else if (std::strcmp(arg, "--out") == 0 && i + 1 < argc) {
+            opt.outDir = argv[++i];
+        } else if (std::strcmp(arg, "--filter") == 0 && i + 1 < argc) {
+            opt.filter = argv[++i];
+        } else if (std::strcmp(arg, "--tolerance-db") == 0 && i + 1 < argc) {
+            opt.toleranceDb = std::max(0.0, std::atof(argv[++i]));
+        } else if (std::strcmp(arg, "--pixel-tolerance") == 0 && i + 1 < argc) {
+            opt.pixelTolerance = std::clamp(std::atoi(argv[++i]), 0, 255);
+        } else if (std::strcmp(arg, "--history") == 0 && i + 1 < argc) {
+            opt.historyPath = argv[++i];
+        } else if (std::strcmp(arg, "--max-regression") == 0 && i + 1 < argc) {
+            opt.maxRegressionPercent = std::max(0.0, std::atof(argv[++i]));
+        } else {
+            usage();
+            return 2;
+        }
+    }
+
+    Report report;
+    checkDsp(opt, report);
+    checkKernels(opt, report);
+#if defined(ANALOGVU_GOLDEN_RENDER) && (ANALOGVU_GOLDEN_RENDER == 1)
+    checkRender(opt, report);
+#endif
+
+    const int regressions = reportTimings(opt, report.timings);
+
+    std::printf("\n%d passed, %d failed", report.passed, report.failed);
+    if (regressions > 0) {
+        std::printf(", %d slower than --max-regression", regressions);
+    }
+    std::printf("\n");
+    return (report.failed > 0 || regressions > 0) ? 1 : 0;
+}
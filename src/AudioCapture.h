@@ -3,13 +3,27 @@
 #include <QList>
 #include <QObject>
 #include <QString>
-#include <QList>
-#include <QSettings>
+#include <QStringList>
 
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include "VUBallistics.h"
+#include "VuAudioDsp.h"
+#include "VuDetectors.h"
+#include "VuDspWorker.h"
+#include "VuIdleMonitor.h"
+#include "VuLevelHistory.h"
+#include "VuLevelSnapshot.h"
+#include "VuSpectrumAnalyzer.h"
 
 #if defined(__APPLE__)
 // Forward declarations for CoreAudio types
@@ -22,9 +36,10 @@ struct pa_context;
 struct pa_stream;
 struct pa_sink_info;
 struct pa_source_info;
+struct pa_server_info;
 struct pa_sample_spec;
 struct pa_channel_map;
-struct VuAudioDspState;
+struct pollfd;
 #endif
 
 class AudioCapture final : public QObject {
@@ -38,6 +53,64 @@ class AudioCapture final : public QObject {
         int channels = 0;    // Number of channels
         bool isInput = true; // true for input devices, false for output
         bool isDefault = false;
+
+        bool operator==(const DeviceInfo&) const = default;
+    };
+
+    // Capture buffering presets: shorter fragments move the needle sooner at
+    // the cost of more wakeups per second
+    enum class LatencyProfile { LowLatency, Balanced, PowerSaver };
+
+    struct CaptureBuffering {
+        int fragmentMs = 10; // audio delivered per capture callback
+        int bufferCount = 3; // queued AudioQueue buffers (macOS)
+    };
+
+    static CaptureBuffering bufferingFor(LatencyProfile profile) {
+        switch (profile) {
+        case LatencyProfile::LowLatency:
+            return {5, 4};
+        case LatencyProfile::PowerSaver:
+            return {50, 3};
+        case LatencyProfile::Balanced:
+            break;
+        }
+        return {10, 3};
+    }
+
+    // CLI names: "low", "balanced", "power"
+    static QString latencyProfileName(LatencyProfile profile) {
+        switch (profile) {
+        case LatencyProfile::LowLatency:
+            return QStringLiteral("low");
+        case LatencyProfile::PowerSaver:
+            return QStringLiteral("power");
+        case LatencyProfile::Balanced:
+            break;
+        }
+        return QStringLiteral("balanced");
+    }
+
+    static bool latencyProfileFromName(const QString& name, LatencyProfile* out) {
+        for (LatencyProfile profile :
+             {LatencyProfile::LowLatency, LatencyProfile::Balanced, LatencyProfile::PowerSaver}) {
+            if (name.compare(latencyProfileName(profile), Qt::CaseInsensitive) == 0) {
+                if (out) *out = profile;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Where the time between sound and needle goes
+    struct LatencyStats {
+        double fragmentMs = 0.0; // per-callback buffer of the active stream
+        double streamMs = -1.0;  // age of the oldest delivered sample as reported by the audio API,
+                                 // fragment included (-1 = not measured yet)
+        double ringMs = 0.0;     // waiting in the capture -> DSP ring
+
+        // Capture to DSP; the fragment stands in until the API has reported
+        double totalMs() const { return (streamMs >= 0.0 ? streamMs : fragmentMs) + ringMs; }
     };
 
     struct Options final {
@@ -47,7 +120,38 @@ class AudioCapture final : public QObject {
         double monitorReferenceDbfs = -14.0; // Per-device reference for monitor
         bool referenceDbfsOverride = false;
         int sampleRate = 48000;
-        unsigned long framesPerBuffer = 512;
+
+        // Keep the per-device references in QSettings (loaded at construction,
+        // saved when changed); off, they come from the options alone
+        bool persistReferenceLevels = true;
+
+        LatencyProfile latencyProfile = LatencyProfile::Balanced;
+
+        // Frames per capture callback; 0 derives it from latencyProfile
+        unsigned long framesPerBuffer = 0;
+
+        // Advance RMS/ballistics at a fixed 1 kHz control rate instead of once per
+        // capture buffer, so needle dynamics do not depend on the fragment size
+        bool blockAccurateBallistics = false;
+
+        // Polynomial log/exp and power-domain integrators (VuMathMode::Fast)
+        // instead of the exact std:: math; see VuMathMode::Fast for the error
+        bool fastMath = false;
+
+        // Needle micro-jitter; off gives bit-reproducible levels for a given input
+        bool needleJitter = true;
+
+        // Detector the needles show; anything but Vu replaces the ballistics
+        // output with that reading, relative to the 0 VU reference
+        VuNeedleSource needleSource = VuNeedleSource::Vu;
+
+        // Detectors run in addition to whatever needleSource needs, e.g. for
+        // levels() readouts
+        VuDetectorOptions detectors;
+
+        // Silence detection per source: an idle source is only peak-checked
+        // in the capture callback and publishes no levels until it wakes
+        VuIdleOptions idle;
 
         // Optional: override device name (sink or source on Linux, device UID on macOS)
         QString deviceName;
@@ -55,6 +159,10 @@ class AudioCapture final : public QObject {
         // 0 = sink monitor/system output, 1 = source/microphone
         // Note: This may be updated during initialization based on device name
         int deviceType = 0;
+
+        // Further devices metered alongside the primary one (sources 1..n),
+        // on the same server connection and event thread
+        QStringList additionalDevices;
     };
 
     explicit AudioCapture(const Options& options, QObject* parent = nullptr);
@@ -63,9 +171,17 @@ class AudioCapture final : public QObject {
     bool start(QString* errorOut = nullptr);
     void stop();
 
-    // Switch to a different audio device at runtime
+    // Switch to a different audio device at runtime. Needle state carries over.
+    // On Linux, with a live server connection, this hot-swaps: it returns
+    // immediately, the current stream keeps metering until the new one is
+    // recording, and the result arrives as deviceChanged() or
+    // deviceSwitchFailed(). Otherwise capture is restarted on the new device.
     bool switchDevice(const QString& deviceUID, QString* errorOut = nullptr);
 
+    // Milliseconds from the last switchDevice() call to the first buffer from
+    // the new device (-1 before the first switch)
+    double lastSwitchLatencyMs() const { return lastSwitchLatencyMs_.load(std::memory_order_relaxed); }
+
     // Get the currently active device UID
     QString currentDeviceUID() const;
 
@@ -79,7 +195,8 @@ class AudioCapture final : public QObject {
     void setMicrophoneReferenceDbfs(double value);
     void setMonitorReferenceDbfs(double value);
     
-    // Load/save per-device reference levels from/to persistent storage
+    // Load/save per-device reference levels from/to persistent storage (no-ops
+    // without Options::persistReferenceLevels). Loading also applies them.
     void loadReferenceLevels();
     void saveReferenceLevels();
     
@@ -89,7 +206,90 @@ class AudioCapture final : public QObject {
     float leftVuDb() const;
     float rightVuDb() const;
 
-    // Get list of available input devices (for UI)
+    // Per-channel levels for every input channel of the capture stream (up to
+    // kVuMaxChannels). leftVuDb()/rightVuDb() are channels 0 and 1; a mono
+    // stream reports channel 0 for both.
+    unsigned int channelCount() const;
+    float channelVuDb(unsigned int channel) const;
+
+    // Latest consistent, time-stamped set of all channel levels and peak holds.
+    // Lock-free; safe to call from any thread.
+    VuLevelFrame levels() const { return levels_.read(); }
+
+    // Every metered source: index 0 is the primary device (levels()), the
+    // rest are Options::additionalDevices in order. The set is fixed for the
+    // lifetime of the object; a source whose device cannot be opened stays at
+    // the floor.
+    int sourceCount() const { return 1 + static_cast<int>(extraSources_.size()); }
+    VuLevelFrame sourceLevels(int index) const;
+    QString sourceDeviceUID(int index) const;
+
+    // Scrolling level history of a source (VuLevelHistory.h), fed by its
+    // metering; nullptr for an unknown index. Safe to read from any thread.
+    const VuLevelHistory* sourceHistory(int index) const {
+        if (index == 0) {
+            return &history_;
+        }
+        if (index < 1 || index > static_cast<int>(extraSources_.size())) {
+            return nullptr;
+        }
+        return &extraSources_[static_cast<std::size_t>(index - 1)]->history;
+    }
+
+    // Spectrum of the primary source (VuSpectrumAnalyzer.h). Costs nothing
+    // until enabled; then blocks are handed to the analyzer thread.
+    void setSpectrumEnabled(bool enabled) {
+        if (enabled) {
+            spectrum_.start();
+        } else {
+            spectrum_.stop();
+        }
+    }
+    const VuSpectrumAnalyzer& spectrum() const { return spectrum_; }
+
+    VuNeedleSource needleSource() const { return needleSource_.load(std::memory_order_relaxed); }
+
+    // Takes effect with the next block; a detector turned on here starts from
+    // silence
+    void setNeedleSource(VuNeedleSource source) { needleSource_.store(source, std::memory_order_relaxed); }
+
+    // Starts a new programme on every source: integrated loudness and the
+    // maximum true peak begin again with the next block
+    void resetLoudness() { loudnessResets_.fetch_add(1, std::memory_order_relaxed); }
+
+    // Idle state machine of a source (see VuIdleMonitor.h); safe from any thread
+    VuIdleState idleState(int index) const {
+        const VuIdleMonitor* monitor = idleMonitor(index);
+        return monitor ? monitor->state() : VuIdleState::Active;
+    }
+    VuIdleMonitor::Residency idleResidency(int index) const {
+        const VuIdleMonitor* monitor = idleMonitor(index);
+        return monitor ? monitor->residency() : VuIdleMonitor::Residency();
+    }
+
+    // Fill level and overrun counters of the capture -> DSP sample ring
+    VuDspWorker::Stats dspRingStats() const { return dspWorker_.stats(); }
+
+    LatencyProfile latencyProfile() const { return options_.latencyProfile; }
+
+    // Restarts a running capture with the new buffering
+    bool setLatencyProfile(LatencyProfile profile, QString* errorOut = nullptr);
+
+    // Measured capture latency of the running stream
+    LatencyStats latency() const;
+
+    // Input devices as last reported by the audio server. Kept current by
+    // change notifications (PulseAudio subscription on the capture context,
+    // CoreAudio property listeners), so this never talks to the server and is
+    // cheap to call from the GUI thread. Empty until the first listing arrives
+    // (devicesChanged()) or while no server connection exists.
+    QList<DeviceInfo> devices() const;
+
+    // Asks the server for a full listing; devicesChanged() follows
+    void refreshDevices();
+
+    // One-off enumeration with its own server connection (for --list-devices
+    // and other callers without a running capture)
     static QList<DeviceInfo> enumerateInputDevices();
 
     // Legacy: string output for command line
@@ -99,7 +299,20 @@ class AudioCapture final : public QObject {
     void errorOccurred(const QString& message);
     void deviceChanged(const QString& deviceUID);
 
+    // An asynchronous switch did not complete; capture stays on the old device
+    void deviceSwitchFailed(const QString& deviceUID, const QString& message);
+
+    // The device list changed (hot-plug, default device change, new listing).
+    // May be emitted from the audio API's thread.
+    void devicesChanged();
+
+    // A source went idle after a silent spell, or woke on signal. Emitted
+    // from the capture or DSP thread.
+    void sourceIdleChanged(int sourceIndex, bool idle);
+
   private:
+    struct ExtraSource;
+
 #if defined(__APPLE__)
     // CoreAudio callback
     static void audioInputCallback(void* inUserData,
@@ -109,7 +322,12 @@ class AudioCapture final : public QObject {
                                    unsigned int inNumberPacketDescriptions,
                                    const void* inPacketDescs);
 
-    void processAudioBuffer(const float* data, unsigned int frames, unsigned int channels, float sampleRate);
+    bool startExtraSource(ExtraSource& source, QString* errorOut);
+    void stopExtraSource(ExtraSource& source);
+
+    // Device list change notifications (kAudioHardwarePropertyDevices etc.)
+    void registerDeviceListeners();
+    void unregisterDeviceListeners();
 #else
     // PulseAudio callbacks
     static void context_state_callback(pa_context* c, void* userdata);
@@ -123,43 +341,314 @@ class AudioCapture final : public QObject {
                                   const pa_channel_map& channel_map,
                                   const char* source_name);
     
+    // Creates and connects a float32 record stream; nullptr on failure
+    pa_stream* open_record_stream(const pa_sample_spec& float_spec,
+                                  const pa_channel_map& channel_map,
+                                  const char* source_name,
+                                  void (*state_callback)(pa_stream*, void*),
+                                  void* userdata,
+                                  QString* errorOut);
+
     // Helper for temporary context creation during enumeration
     static pa_context* create_temporary_context(pa_mainloop*& ml);
+
+    // Resolves the device (sink name for monitors, source name, or empty for
+    // the default sink's monitor) and opens a stream on it (mainloop thread).
+    // hotSwap opens it as the pending stream instead of replacing stream_.
+    void lookUpDevice(const QByteArray& name, bool sink, bool hotSwap);
+
+    // Hot swap (mainloop thread): the pending stream records alongside stream_
+    // until it is ready, then replaces it
+    static void swap_sink_info_callback(pa_context* c, const pa_sink_info* si, int is_last, void* userdata);
+    static void swap_source_info_callback(pa_context* c, const pa_source_info* si, int is_last, void* userdata);
+    static void pending_stream_state_callback(pa_stream* s, void* userdata);
+    void openPendingStream(const pa_sample_spec& sample_spec,
+                           const pa_channel_map& channel_map,
+                           const char* source_name,
+                           int deviceType);
+    void promotePendingStream();
+    void dropPendingStream();
+    void abandonSwitch(const QString& message);
+
+    // Additional sources (mainloop thread)
+    void lookUpExtraSource(ExtraSource* source);
+    void openExtraStream(ExtraSource* source,
+                         const pa_sample_spec& sample_spec,
+                         const pa_channel_map& channel_map,
+                         const char* source_name);
+    static void closeExtraStream(ExtraSource* source);
+    static void extra_sink_info_callback(pa_context* c, const pa_sink_info* si, int is_last, void* userdata);
+    static void extra_source_info_callback(pa_context* c, const pa_source_info* si, int is_last, void* userdata);
+    static void extra_stream_state_callback(pa_stream* s, void* userdata);
+    static void extra_stream_read_callback(pa_stream* s, size_t length, void* userdata);
+
+    // Runs fn on the mainloop thread; pa_mainloop is not thread-safe, so the
+    // GUI thread must not issue context operations directly
+    void runOnMainloop(std::function<void()> fn);
+    static int mainloop_poll(pollfd* ufds, unsigned long nfds, int timeout, void* userdata);
+
+    // Device registry (mainloop thread only)
+    static void registry_server_callback(pa_context* c, const pa_server_info* info, void* userdata);
+    static void registry_list_callback(pa_context* c, const pa_source_info* si, int is_last, void* userdata);
+    static void registry_source_callback(pa_context* c, const pa_source_info* si, int is_last, void* userdata);
+    void startDeviceRegistry(pa_context* c);
+    void requestDeviceListing(pa_context* c);
+    void publishDevices();
+#endif
+
+    // Runs the metering pipeline; called on the DSP worker thread
+    void processAudioBuffer(const float* data, unsigned int frames, unsigned int channels, float sampleRate);
+
+    // The reference levels the audio path meters against, for both device
+    // types, so a switch between them needs no update. Immutable once
+    // published: a reference change (GUI thread) fills a free slot and swaps
+    // the pointer, and each block picks it up with acquireCalibration(), so
+    // the DSP worker neither locks nor allocates and never sees a
+    // half-written reference.
+    struct Calibration {
+        VuCalibration microphone;
+        VuCalibration monitor;
+
+        // 0 = system output, 1 = microphone
+        const VuCalibration& forDevice(int deviceType) const {
+            return deviceType == 1 ? microphone : monitor;
+        }
+        bool operator==(const Calibration& other) const {
+            return microphone.referenceDbfs == other.microphone.referenceDbfs &&
+                   monitor.referenceDbfs == other.monitor.referenceDbfs;
+        }
+    };
+
+    // Rebuilds the calibration from options_ and publishes it (GUI thread)
+    void publishCalibration();
+
+    // DSP worker only: the current block, marked as in use until the next call
+    const Calibration& acquireCalibration() {
+        const Calibration* current = calibration_.load();
+        for (;;) {
+            calibrationInUse_.store(current);
+            const Calibration* again = calibration_.load();
+            if (again == current)
+                return *current;
+            current = again;
+        }
+    }
+
+    // DSP, ballistics and peak hold for one block of one source
+    struct MeterState {
+        VuAudioDspState& dsp;
+        VUBallisticsBank& ballistics;
+        VuPeakHold& peakHold;
+        std::uint64_t& framesProcessed;
+        VuLevelSnapshot& levels;
+        VuDetectorState& detectors;
+        std::uint32_t& loudnessResetsSeen; // last resetLoudness() count applied
+        VuIdleMonitor& idle;
+        VuLevelHistory& history;
+        int sourceIndex;
+    };
+    void meterBlock(MeterState state,
+                    int deviceType,
+                    const float* data,
+                    unsigned int frames,
+                    unsigned int channels,
+                    float sampleRate);
+
+    // An Options::additionalDevices entry. Metered like the primary source:
+    // its capture callback only copies frames into the source's own input of
+    // dspWorker_ (input = index), and the shared worker thread runs the
+    // pipeline, so the event thread every stream shares is never held up.
+    struct ExtraSource {
+        ExtraSource(float floorDb, const VuIdleOptions& idleOptions)
+            : ballistics(floorDb), idle(idleOptions), history(floorDb) {}
+
+        AudioCapture* owner = nullptr;
+        int index = 0; // source index (1..n)
+        QString deviceUID;
+        int deviceType = 0;
+
+        // DSP worker only while capture runs
+        VuAudioDspState* dspState = nullptr;
+        VUBallisticsBank ballistics;
+        VuPeakHold peakHold;
+        std::uint64_t framesProcessed = 0;
+        VuLevelSnapshot levels;
+        VuDetectorState* detectorState = nullptr;
+        std::uint32_t loudnessResetsSeen = 0;
+        VuIdleMonitor idle;
+        VuLevelHistory history;
+
+#if defined(__APPLE__)
+        AudioQueueRef queue = nullptr;
+        unsigned int channels = 2;
+#else
+        pa_stream* stream = nullptr; // mainloop thread only
 #endif
 
+        MeterState meterState() {
+            return {*dspState,
+                    ballistics,
+                    peakHold,
+                    framesProcessed,
+                    levels,
+                    *detectorState,
+                    loudnessResetsSeen,
+                    idle,
+                    history,
+                    index};
+        }
+    };
+
+    void createExtraSources(float floorDb);
+    void destroyExtraSources();
+
+    const VuIdleMonitor* idleMonitor(int index) const {
+        if (index == 0) {
+            return &idle_;
+        }
+        if (index < 1 || index > static_cast<int>(extraSources_.size())) {
+            return nullptr;
+        }
+        return &extraSources_[static_cast<std::size_t>(index - 1)]->idle;
+    }
+
+    // Capture callback side of a source's idle monitor; false = drop the block
+    bool admitBlock(VuIdleMonitor& idle,
+                    int sourceIndex,
+                    const float* data,
+                    unsigned int frames,
+                    unsigned int channels,
+                    float sampleRate) {
+        VuIdleMonitor::Transition transition = VuIdleMonitor::Transition::None;
+        const bool admitted = idle.admit(data, frames, channels, sampleRate, &transition);
+        if (transition == VuIdleMonitor::Transition::Woke) {
+            emit sourceIdleChanged(sourceIndex, false);
+        }
+        return admitted;
+    }
+
+    void resetChannelLevels(float valueDb);
+
+    static std::int64_t steadyNowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    // Capture callback: completes the latency measurement of a pending switch
+    void noteBufferAfterSwitch() {
+        std::int64_t start = switchStartNs_.load(std::memory_order_relaxed);
+        if (start != 0 && switchStartNs_.compare_exchange_strong(start, 0, std::memory_order_relaxed)) {
+            lastSwitchLatencyMs_.store(static_cast<double>(steadyNowNs() - start) * 1e-6, std::memory_order_relaxed);
+        }
+    }
+
   private:
     Options options_;
+
+    // Written on the audio thread by a hot swap and read by the GUI, so only
+    // through setCurrentDeviceUID() and currentDeviceUID()
+    void setCurrentDeviceUID(const QString& uid) {
+        std::lock_guard<std::mutex> lock(deviceUidMutex_);
+        currentDeviceUID_ = uid;
+    }
+    mutable std::mutex deviceUidMutex_;
     QString currentDeviceUID_;
     
     // Thread-safe access for device type
     std::atomic<int> deviceType_{0};
 
-    std::atomic<float> leftVuDb_{-22.0f};
-    std::atomic<float> rightVuDb_{-22.0f};
+    // Published by the DSP worker, read by the UI
+    VuLevelSnapshot levels_;
+
+    // DSP worker only (reset by the constructor, before the worker starts)
+    VuPeakHold peakHold_;
+    std::uint64_t framesProcessed_ = 0;
+    std::uint32_t loudnessResetsSeen_ = 0;
+
+    // Current calibration, set before capture can start, pointing into a
+    // fixed pool. calibrationInUse_ is the block the DSP worker last acquired
+    // (a hazard pointer); the publisher only rewrites a slot that is neither
+    // current nor in use, so three slots always leave one free. Both are
+    // sequentially consistent so the publisher and the worker agree on which
+    // slot was seen first.
+    static constexpr std::size_t kCalibrationSlots = 3;
+    std::array<Calibration, kCalibrationSlots> calibrationSlots_{};
+    std::atomic<const Calibration*> calibration_{nullptr};
+    std::atomic<const Calibration*> calibrationInUse_{nullptr};
+
+    std::atomic<VuNeedleSource> needleSource_{VuNeedleSource::Vu};
+    std::atomic<std::uint32_t> loudnessResets_{0};
+
+    // options_.detectors as the DSP worker reads it (options_ is not shared)
+    std::atomic<VuDetectorOptions> detectors_{};
+    static_assert(std::atomic<VuDetectorOptions>::is_always_lock_free);
+
+    // Source 0; admitted in the capture callback, updated by the DSP worker
+    VuIdleMonitor idle_;
+
+    // Source 0, written by the DSP worker
+    VuLevelHistory history_;
+    VuSpectrumAnalyzer spectrum_;
 
     std::atomic<bool> running_{false};
 
+    // Written by the capture callback, read by latency()
+    std::atomic<double> streamLatencyMs_{-1.0};
+    std::atomic<double> fragmentMs_{0.0};
+
+    // switchDevice() time, armed once the new device's stream delivers and
+    // cleared by its first buffer
+    std::atomic<std::int64_t> switchStartNs_{0};
+    std::atomic<double> lastSwitchLatencyMs_{-1.0};
+
+    // Snapshot behind devices(); written on the audio API's thread
+    mutable std::mutex devicesMutex_;
+    QList<DeviceInfo> devices_;
+
 #if defined(__APPLE__)
     AudioQueueRef audioQueue_ = nullptr;
-    static constexpr int kNumBuffers = 3;
-    AudioQueueBuffer* buffers_[kNumBuffers] = {};
-
-    // Smoothed RMS values (persistent across callbacks)
-    float rmsL_smooth_ = 0.0f;
-    float rmsR_smooth_ = 0.0f;
-    float prevL_ = 0.0f;
-    float prevR_ = 0.0f;
-    bool meterAwake_ = false;
+    static constexpr int kMaxBuffers = 4;
+    AudioQueueBuffer* buffers_[kMaxBuffers] = {};
+    int bufferCount_ = 0;
+    unsigned int captureChannels_ = 2;
 #else
     std::thread thread_;
     pa_mainloop* mainloop_ = nullptr;
     pa_context* context_ = nullptr;
     pa_stream* stream_ = nullptr;
-    
-    // DSP state - per instance, not static!
-    VuAudioDspState* dspState_ = nullptr;
+
+    // pa_context_state_t of context_, mirrored by context_state_callback so
+    // other threads never call into the context while the mainloop runs
+    std::atomic<int> contextState_{0};
+
+    // Hot swap target (mainloop thread only)
+    pa_stream* pendingStream_ = nullptr;
+    QString pendingDeviceName_; // as requested; becomes options_.deviceName once promoted
+    QString pendingDeviceUID_;
+    int pendingDeviceType_ = 0;
+    std::int64_t pendingSwitchNs_ = 0;
+
+    std::mutex mainloopTasksMutex_;
+    std::vector<std::function<void()>> mainloopTasks_;
+
+    // Sources by server index, kept in step with subscription events, and the
+    // server defaults used to flag the default device
+    std::map<std::uint32_t, DeviceInfo> registrySources_;
+    QString registryDefaultSink_;
+    QString registryDefaultSource_;
+    bool registryListed_ = false;
 #endif
 
-    VUBallistics ballisticsL_;
-    VUBallistics ballisticsR_;
+    // DSP state - per instance, not static! Only touched by the DSP worker
+    // while capture is running.
+    VuAudioDspState* dspState_ = nullptr;
+    VuDetectorState* detectorState_ = nullptr;
+
+    VUBallisticsBank ballistics_;
+
+    // Drains raw frames pushed by the capture callbacks: input 0 is the
+    // primary source, input n the extra source with index n
+    VuDspWorker dspWorker_;
+
+    std::vector<std::unique_ptr<ExtraSource>> extraSources_;
 };
@@ -2,19 +2,23 @@
 
 #include "AudioCapture.h"
 #include "VuAudioDsp.h"
+#include "VuMetrics.h"
 
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <thread>
 
 #include <QByteArray>
 #include <QDebug>
 #include <QPair>
+#include <QSettings>
+#include <poll.h>
 #include <pulse/pulseaudio.h>
 
 // Named constants instead of magic numbers
 static constexpr float kAudioFloorVu = -96.0f;
 static constexpr float kAudioCeilingVu = 6.0f;
-static constexpr int kFragmentSizeMs = 10;
 static constexpr int kContextTimeoutMs = 10000;
 static constexpr int kContextPollIntervalMs = 100;
 
@@ -23,19 +27,105 @@ static constexpr int kContextPollIntervalMs = 100;
 static constexpr int kDeviceTypeMonitor = 0;    // Monitor source (captures system audio output)
 static constexpr int kDeviceTypeMicrophone = 1; // Regular source (microphone, line-in, etc.)
 
+// How a device UID is opened: monitors are looked up through their sink (for
+// its sample spec), sources directly, and an empty UID means the monitor of
+// the default sink.
+struct DeviceLookup {
+    QByteArray name;
+    bool sink = true;
+    int deviceType = kDeviceTypeMonitor;
+};
+
+// The server overran the record buffer and dropped captured data
+static void stream_overflow_callback(pa_stream*, void*) {
+    vuMetrics().add(VuCounter::CaptureOverflows);
+}
+
+static DeviceLookup deviceLookupFor(const QString& deviceUID) {
+    DeviceLookup lookup;
+    if (deviceUID.isEmpty()) {
+        return lookup;
+    }
+    if (deviceUID.endsWith(".monitor")) {
+        QString sinkName = deviceUID;
+        sinkName.chop(8); // Remove ".monitor"
+        lookup.name = sinkName.toUtf8();
+    } else {
+        lookup.name = deviceUID.toUtf8();
+        lookup.sink = false;
+        lookup.deviceType = kDeviceTypeMicrophone;
+    }
+    return lookup;
+}
+
 // -------- Constructor / Destructor --------
 
 AudioCapture::AudioCapture(const Options& options, QObject* parent)
     : QObject(parent), options_(options), currentDeviceUID_(options.deviceName), deviceType_(options.deviceType),
-      ballisticsL_(kAudioFloorVu), ballisticsR_(kAudioFloorVu), dspState_(new VuAudioDspState{}) {
+      idle_(options.idle), history_(kAudioFloorVu), dspState_(new VuAudioDspState{}),
+      detectorState_(new VuDetectorState{}), ballistics_(kAudioFloorVu) {
+    resetChannelLevels(kAudioFloorVu);
+    ballistics_.setJitterEnabled(options_.needleJitter);
+    ballistics_.setJitterSeed(VuJitterRng::seedFor(0));
+    if (options_.blockAccurateBallistics) {
+        dspState_->integrationMode = VuIntegrationMode::BlockAccurate;
+    }
+    if (options_.fastMath) {
+        dspState_->mathMode = VuMathMode::Fast;
+        ballistics_.setFastMath(true);
+    }
+    needleSource_.store(options_.needleSource, std::memory_order_relaxed);
+    detectors_.store(options_.detectors, std::memory_order_relaxed);
     loadReferenceLevels();
+    createExtraSources(kAudioFloorVu);
 }
 
 AudioCapture::~AudioCapture() {
     stop();
+    destroyExtraSources();
+    delete detectorState_;
     delete dspState_;
 }
 
+void AudioCapture::createExtraSources(float floorDb) {
+    for (const QString& uid : options_.additionalDevices) {
+        auto source = std::make_unique<ExtraSource>(floorDb, options_.idle);
+        source->owner = this;
+        source->index = static_cast<int>(extraSources_.size()) + 1;
+        source->deviceUID = uid;
+        source->deviceType = deviceLookupFor(uid).deviceType;
+        source->dspState = new VuAudioDspState{};
+        source->detectorState = new VuDetectorState{};
+        if (options_.blockAccurateBallistics) {
+            source->dspState->integrationMode = VuIntegrationMode::BlockAccurate;
+        }
+        if (options_.fastMath) {
+            source->dspState->mathMode = VuMathMode::Fast;
+            source->ballistics.setFastMath(true);
+        }
+        source->ballistics.setJitterEnabled(options_.needleJitter);
+        // Own phase per source, so several meters do not jitter in lockstep
+        source->ballistics.setJitterSeed(VuJitterRng::seedFor(static_cast<unsigned int>(source->index)));
+        source->peakHold.reset(floorDb);
+
+        VuLevelFrame frame;
+        frame.vuDb.fill(floorDb);
+        frame.peakHoldDb.fill(floorDb);
+        source->levels.publish(frame);
+
+        extraSources_.push_back(std::move(source));
+    }
+    dspWorker_.setInputCount(1 + static_cast<unsigned int>(extraSources_.size()));
+}
+
+void AudioCapture::destroyExtraSources() {
+    for (const std::unique_ptr<ExtraSource>& source : extraSources_) {
+        delete source->detectorState;
+        delete source->dspState;
+    }
+    extraSources_.clear();
+}
+
 // -------- Start / Stop --------
 
 bool AudioCapture::start(QString* errorOut) {
@@ -53,6 +143,9 @@ bool AudioCapture::start(QString* errorOut) {
         return false;
     }
 
+    pa_mainloop_set_poll_func(mainloop_, &AudioCapture::mainloop_poll, this);
+    streamLatencyMs_.store(-1.0, std::memory_order_relaxed);
+
     context_ = pa_context_new(pa_mainloop_get_api(mainloop_), "Analog VU Meter");
     if (!context_) {
         if (errorOut) {
@@ -64,6 +157,7 @@ bool AudioCapture::start(QString* errorOut) {
         return false;
     }
 
+    contextState_.store(PA_CONTEXT_UNCONNECTED, std::memory_order_relaxed);
     pa_context_set_state_callback(context_, &AudioCapture::context_state_callback, this);
 
     int connect_result = pa_context_connect(context_, nullptr, PA_CONTEXT_NOFLAGS, nullptr);
@@ -91,7 +185,7 @@ bool AudioCapture::start(QString* errorOut) {
     int waitCount = 0;
 
     while (!contextReady && waitCount < maxWait) {
-        pa_context_state_t state = pa_context_get_state(context_);
+        const int state = contextState_.load(std::memory_order_acquire);
         if (state == PA_CONTEXT_READY) {
             contextReady = true;
         } else if (state == PA_CONTEXT_FAILED || state == PA_CONTEXT_TERMINATED) {
@@ -131,56 +225,15 @@ bool AudioCapture::start(QString* errorOut) {
         return false;
     }
 
-    // Look up the device and create stream
-    if (!options_.deviceName.isEmpty()) {
-        // Check if it's a monitor source (ends with .monitor)
-        if (options_.deviceName.endsWith(".monitor")) {
-            // Extract the sink name from monitor source name
-            QString sinkName = options_.deviceName;
-            sinkName.chop(8); // Remove ".monitor"
+    // Look up the device and create stream. The device type is settled here so
+    // it is in effect when start() returns; the lookup runs on the mainloop.
+    const DeviceLookup lookup = deviceLookupFor(options_.deviceName);
+    deviceType_.store(lookup.deviceType, std::memory_order_relaxed);
+    runOnMainloop([this, lookup]() { lookUpDevice(lookup.name, lookup.sink, false); });
 
-            // Set device type to system output (monitor)
-            deviceType_.store(kDeviceTypeMonitor, std::memory_order_relaxed);
-
-            // Get sink info to access monitor source
-            pa_operation* op = pa_context_get_sink_info_by_name(
-                context_, sinkName.toUtf8().constData(), &AudioCapture::sink_info_callback, this);
-            if (op) {
-                pa_operation_unref(op);
-            }
-        } else {
-            // Regular source (microphone)
-            // Set device type to microphone (external input)
-            deviceType_.store(kDeviceTypeMicrophone, std::memory_order_relaxed);
-
-            pa_operation* op = pa_context_get_source_info_by_name(
-                context_, options_.deviceName.toUtf8().constData(), &AudioCapture::source_info_callback, this);
-            if (op) {
-                pa_operation_unref(op);
-            }
-        }
-    } else {
-        // No device specified, default to monitor of default sink (audio output)
-        // Set device type to system output (monitor)
-        deviceType_.store(kDeviceTypeMonitor, std::memory_order_relaxed);
-
-        pa_operation* op = pa_context_get_server_info(
-            context_,
-            [](pa_context* /*ctx*/, const pa_server_info* info, void* userdata) {
-                auto* self = static_cast<AudioCapture*>(userdata);
-                if (info && info->default_sink_name) {
-                    // Get sink info to access its monitor source
-                    pa_operation* op2 = pa_context_get_sink_info_by_name(
-                        self->context_, info->default_sink_name, &AudioCapture::sink_info_callback, self);
-                    if (op2) {
-                        pa_operation_unref(op2);
-                    }
-                }
-            },
-            this);
-        if (op) {
-            pa_operation_unref(op);
-        }
+    // Additional sources share the context; each gets one more stream on it
+    for (const std::unique_ptr<ExtraSource>& source : extraSources_) {
+        runOnMainloop([this, s = source.get()]() { lookUpExtraSource(s); });
     }
 
     if (errorOut) {
@@ -202,6 +255,18 @@ void AudioCapture::stop() {
         thread_.join();
     }
 
+    {
+        std::lock_guard<std::mutex> lock(mainloopTasksMutex_);
+        mainloopTasks_.clear();
+    }
+
+    // The mainloop is gone, so nothing pushes into the ring anymore
+    dspWorker_.stop();
+
+    dropPendingStream();
+    for (const std::unique_ptr<ExtraSource>& source : extraSources_) {
+        closeExtraStream(source.get());
+    }
     if (stream_) {
         pa_stream_disconnect(stream_);
         pa_stream_unref(stream_);
@@ -225,20 +290,35 @@ void AudioCapture::stop() {
 // -------- Device Switching --------
 
 bool AudioCapture::switchDevice(const QString& deviceUID, QString* errorOut) {
-    // Stop current capture
-    stop();
+    const std::int64_t requestedNs = steadyNowNs();
+
+    // Hot swap on the live connection: the current stream keeps metering while
+    // the new one connects, and the ballistics carry straight over. The device
+    // name only changes once the new stream is promoted, so a failed swap
+    // leaves the next restart on the device that is still being metered.
+    if (running_.load(std::memory_order_relaxed) &&
+        contextState_.load(std::memory_order_acquire) == PA_CONTEXT_READY) {
+        const DeviceLookup lookup = deviceLookupFor(deviceUID);
+        runOnMainloop([this, lookup, requestedNs, deviceUID]() {
+            pendingSwitchNs_ = requestedNs;
+            pendingDeviceName_ = deviceUID;
+            pendingDeviceUID_ = deviceUID;
+            lookUpDevice(lookup.name, lookup.sink, true);
+        });
+        if (errorOut) {
+            *errorOut = QString();
+        }
+        return true;
+    }
 
-    // Reset ballistics and VU meters
-    ballisticsL_.reset(kAudioFloorVu);
-    ballisticsR_.reset(kAudioFloorVu);
-    leftVuDb_.store(kAudioFloorVu, std::memory_order_relaxed);
-    rightVuDb_.store(kAudioFloorVu, std::memory_order_relaxed);
+    // No usable connection: restart capture on the new device
+    stop();
 
     // Update options with new device
     options_.deviceName = deviceUID;
-    currentDeviceUID_ = deviceUID.isEmpty() ? QString() : deviceUID;
+    setCurrentDeviceUID(deviceUID.isEmpty() ? QString() : deviceUID);
 
-    // Restart with new device
+    switchStartNs_.store(requestedNs, std::memory_order_relaxed);
     bool success = start(errorOut);
 
     if (success) {
@@ -246,17 +326,100 @@ bool AudioCapture::switchDevice(const QString& deviceUID, QString* errorOut) {
         if (deviceUID.isEmpty()) {
             // Using default - the currentDeviceUID_ will be set by callbacks
             // For now, indicate it's the default monitor
-            currentDeviceUID_ = QStringLiteral("[default monitor]");
+            setCurrentDeviceUID(QStringLiteral("[default monitor]"));
         }
-        emit deviceChanged(currentDeviceUID_);
+        emit deviceChanged(currentDeviceUID());
+    } else {
+        switchStartNs_.store(0, std::memory_order_relaxed);
     }
 
     return success;
 }
 
+void AudioCapture::lookUpDevice(const QByteArray& name, bool sink, bool hotSwap) {
+    pa_sink_info_cb_t sinkCallback = hotSwap ? &AudioCapture::swap_sink_info_callback : &AudioCapture::sink_info_callback;
+
+    pa_operation* op = nullptr;
+    if (name.isEmpty()) {
+        pa_server_info_cb_t serverCallback = nullptr;
+        if (hotSwap) {
+            serverCallback = [](pa_context* /*ctx*/, const pa_server_info* info, void* userdata) {
+                auto* self = static_cast<AudioCapture*>(userdata);
+                if (!info || !info->default_sink_name) {
+                    self->abandonSwitch(QStringLiteral("No default output device"));
+                    return;
+                }
+                pa_operation* op2 = pa_context_get_sink_info_by_name(
+                    self->context_, info->default_sink_name, &AudioCapture::swap_sink_info_callback, self);
+                if (op2) {
+                    pa_operation_unref(op2);
+                }
+            };
+        } else {
+            serverCallback = [](pa_context* /*ctx*/, const pa_server_info* info, void* userdata) {
+                auto* self = static_cast<AudioCapture*>(userdata);
+                if (info && info->default_sink_name) {
+                    // Get sink info to access its monitor source
+                    pa_operation* op2 = pa_context_get_sink_info_by_name(
+                        self->context_, info->default_sink_name, &AudioCapture::sink_info_callback, self);
+                    if (op2) {
+                        pa_operation_unref(op2);
+                    }
+                }
+            };
+        }
+        op = pa_context_get_server_info(context_, serverCallback, this);
+    } else if (sink) {
+        // Get sink info to access monitor source
+        op = pa_context_get_sink_info_by_name(context_, name.constData(), sinkCallback, this);
+    } else {
+        op = pa_context_get_source_info_by_name(
+            context_,
+            name.constData(),
+            hotSwap ? &AudioCapture::swap_source_info_callback : &AudioCapture::source_info_callback,
+            this);
+    }
+    if (op) {
+        pa_operation_unref(op);
+    } else if (hotSwap) {
+        abandonSwitch(QStringLiteral("Failed to query device: %1").arg(pa_strerror(pa_context_errno(context_))));
+    }
+}
+
+// -------- Latency --------
+
+bool AudioCapture::setLatencyProfile(LatencyProfile profile, QString* errorOut) {
+    if (profile == options_.latencyProfile) {
+        return true;
+    }
+    options_.latencyProfile = profile;
+    if (!running_.load(std::memory_order_relaxed)) {
+        return true;
+    }
+
+    // The buffer attributes are fixed at connect time
+    stop();
+    return start(errorOut);
+}
+
+AudioCapture::LatencyStats AudioCapture::latency() const {
+    LatencyStats stats;
+    stats.fragmentMs = fragmentMs_.load(std::memory_order_relaxed);
+    stats.streamMs = streamLatencyMs_.load(std::memory_order_relaxed);
+
+    const VuDspWorker::Stats ring = dspWorker_.stats();
+    if (ring.sampleRate > 0.0f) {
+        stats.ringMs = 1000.0 * static_cast<double>(ring.fillFrames) / ring.sampleRate;
+    }
+    return stats;
+}
+
 // -------- Getters / Setters --------
 
-QString AudioCapture::currentDeviceUID() const { return currentDeviceUID_; }
+QString AudioCapture::currentDeviceUID() const {
+    std::lock_guard<std::mutex> lock(deviceUidMutex_);
+    return currentDeviceUID_;
+}
 
 double AudioCapture::referenceDbfs() const { return options_.referenceDbfs; }
 
@@ -269,6 +432,7 @@ void AudioCapture::setReferenceDbfs(double value) {
         options_.monitorReferenceDbfs = value;
     }
     options_.referenceDbfsOverride = true; // Enable custom reference level
+    publishCalibration();
     saveReferenceLevels();
 }
 
@@ -279,12 +443,14 @@ double AudioCapture::monitorReferenceDbfs() const { return options_.monitorRefer
 void AudioCapture::setMicrophoneReferenceDbfs(double value) {
     options_.microphoneReferenceDbfs = value;
     options_.referenceDbfsOverride = true; // Enable custom reference level
+    publishCalibration();
     saveReferenceLevels();
 }
 
 void AudioCapture::setMonitorReferenceDbfs(double value) {
     options_.monitorReferenceDbfs = value;
     options_.referenceDbfsOverride = true; // Enable custom reference level
+    publishCalibration();
     saveReferenceLevels();
 }
 
@@ -299,19 +465,47 @@ double AudioCapture::effectiveReferenceDbfs() const {
     }
 }
 
-float AudioCapture::leftVuDb() const { return leftVuDb_.load(std::memory_order_relaxed); }
+float AudioCapture::leftVuDb() const { return levels_.read().leftVuDb(); }
+
+float AudioCapture::rightVuDb() const { return levels_.read().rightVuDb(); }
+
+unsigned int AudioCapture::channelCount() const { return levels_.read().channels; }
+
+float AudioCapture::channelVuDb(unsigned int channel) const {
+    if (channel >= kVuMaxChannels) {
+        return kAudioFloorVu;
+    }
+    return levels_.read().vuDb[channel];
+}
 
-float AudioCapture::rightVuDb() const { return rightVuDb_.load(std::memory_order_relaxed); }
+void AudioCapture::resetChannelLevels(float valueDb) {
+    // Not a DSP update (timestamp 0): the UI shows the reset value without
+    // interpolating to it
+    VuLevelFrame frame;
+    frame.vuDb.fill(valueDb);
+    frame.peakHoldDb.fill(valueDb);
+    levels_.publish(frame);
+
+    peakHold_.reset(valueDb);
+    framesProcessed_ = 0;
+    idle_.wake();
+}
 
 void AudioCapture::loadReferenceLevels() {
-    QSettings settings;
-    settings.beginGroup("AudioCapture");
-    options_.microphoneReferenceDbfs = settings.value("microphoneReferenceDbfs", 0.0).toDouble();
-    options_.monitorReferenceDbfs = settings.value("monitorReferenceDbfs", -14.0).toDouble();
-    settings.endGroup();
+    if (options_.persistReferenceLevels) {
+        QSettings settings;
+        settings.beginGroup("AudioCapture");
+        options_.microphoneReferenceDbfs = settings.value("microphoneReferenceDbfs", 0.0).toDouble();
+        options_.monitorReferenceDbfs = settings.value("monitorReferenceDbfs", -14.0).toDouble();
+        settings.endGroup();
+    }
+    publishCalibration();
 }
 
 void AudioCapture::saveReferenceLevels() {
+    if (!options_.persistReferenceLevels) {
+        return;
+    }
     QSettings settings;
     settings.beginGroup("AudioCapture");
     settings.setValue("microphoneReferenceDbfs", options_.microphoneReferenceDbfs);
@@ -319,6 +513,32 @@ void AudioCapture::saveReferenceLevels() {
     settings.endGroup();
 }
 
+void AudioCapture::publishCalibration() {
+    VuReferenceOptions ref;
+    ref.referenceDbfsOverride = options_.referenceDbfsOverride;
+
+    Calibration block;
+    ref.deviceType = kDeviceTypeMicrophone;
+    ref.referenceDbfs = options_.microphoneReferenceDbfs;
+    block.microphone = vuCalibration(ref);
+    ref.deviceType = kDeviceTypeMonitor;
+    ref.referenceDbfs = options_.monitorReferenceDbfs;
+    block.monitor = vuCalibration(ref);
+
+    const Calibration* current = calibration_.load();
+    if (current && *current == block) {
+        return;
+    }
+    const Calibration* inUse = calibrationInUse_.load();
+    for (Calibration& slot : calibrationSlots_) {
+        if (&slot != current && &slot != inUse) {
+            slot = block;
+            calibration_.store(&slot);
+            return;
+        }
+    }
+}
+
 // -------- Helper Functions --------
 
 pa_context* AudioCapture::create_temporary_context(pa_mainloop*& ml) {
@@ -370,31 +590,547 @@ void AudioCapture::create_stream_from_spec(const pa_sample_spec& sample_spec,
     pa_sample_spec nss = sample_spec;
     nss.format = PA_SAMPLE_FLOAT32;
 
+    // Device lookups may report more than one match; keep a single stream so the
+    // sample ring has exactly one producer with one format.
+    if (stream_) {
+        pa_stream_set_read_callback(stream_, nullptr, nullptr);
+        pa_stream_set_state_callback(stream_, nullptr, nullptr);
+        pa_stream_disconnect(stream_);
+        pa_stream_unref(stream_);
+        stream_ = nullptr;
+    }
+
+    dspWorker_.start(nss.channels,
+                     static_cast<float>(nss.rate),
+                     [this](const float* data, unsigned int frames, unsigned int channels, float sampleRate) {
+                         processAudioBuffer(data, frames, channels, sampleRate);
+                     });
+
+    QString error;
+    stream_ = open_record_stream(nss, channel_map, source_name, &AudioCapture::stream_state_callback, this, &error);
+    if (!stream_) {
+        emit errorOccurred(error);
+        return;
+    }
+    pa_stream_set_read_callback(stream_, &AudioCapture::stream_read_callback, this);
+}
+
+pa_stream* AudioCapture::open_record_stream(const pa_sample_spec& float_spec,
+                                            const pa_channel_map& channel_map,
+                                            const char* source_name,
+                                            void (*state_callback)(pa_stream*, void*),
+                                            void* userdata,
+                                            QString* errorOut) {
     pa_proplist* props = pa_proplist_new();
     pa_proplist_sets(props, PA_PROP_FILTER_APPLY, "echo-cancel noise-suppression=0 aec=0 agc=0");
 
-    stream_ = pa_stream_new_with_proplist(context_, "VU Meter Capture", &nss, &channel_map, props);
+    pa_stream* stream = pa_stream_new_with_proplist(context_, "VU Meter Capture", &float_spec, &channel_map, props);
     pa_proplist_free(props);
 
-    if (!stream_) {
-        emit errorOccurred(QStringLiteral("Failed to create PulseAudio stream"));
-        return;
+    if (!stream) {
+        if (errorOut) *errorOut = QStringLiteral("Failed to create PulseAudio stream");
+        return nullptr;
     }
 
-    pa_stream_set_state_callback(stream_, &AudioCapture::stream_state_callback, this);
-    pa_stream_set_read_callback(stream_, &AudioCapture::stream_read_callback, this);
+    pa_stream_set_state_callback(stream, state_callback, userdata);
+
+    pa_stream_set_overflow_callback(stream, &stream_overflow_callback, nullptr);
+
+    // fragsize is in bytes of the stream format
+    const pa_usec_t fragmentUs =
+        options_.framesPerBuffer > 0
+            ? static_cast<pa_usec_t>(options_.framesPerBuffer) * PA_USEC_PER_SEC / float_spec.rate
+            : static_cast<pa_usec_t>(bufferingFor(options_.latencyProfile).fragmentMs) * PA_USEC_PER_MSEC;
+    fragmentMs_.store(static_cast<double>(fragmentUs) / PA_USEC_PER_MSEC, std::memory_order_relaxed);
 
     pa_buffer_attr attr;
     attr.maxlength = static_cast<uint32_t>(-1);
     attr.tlength = static_cast<uint32_t>(-1);
     attr.prebuf = static_cast<uint32_t>(-1);
     attr.minreq = static_cast<uint32_t>(-1);
-    attr.fragsize = options_.sampleRate / (1000 / kFragmentSizeMs);
-
-    int ret = pa_stream_connect_record(stream_, source_name, &attr, PA_STREAM_ADJUST_LATENCY);
+    attr.fragsize = static_cast<uint32_t>(pa_usec_to_bytes(fragmentUs, &float_spec));
+
+    // Timing updates keep pa_stream_get_latency() current for latency()
+    int ret = pa_stream_connect_record(
+        stream,
+        source_name,
+        &attr,
+        static_cast<pa_stream_flags_t>(PA_STREAM_ADJUST_LATENCY | PA_STREAM_AUTO_TIMING_UPDATE |
+                                       PA_STREAM_INTERPOLATE_TIMING));
     if (ret < 0) {
-        emit errorOccurred(QStringLiteral("Failed to connect stream to %1").arg(source_name));
+        if (errorOut) *errorOut = QStringLiteral("Failed to connect stream to %1").arg(source_name);
+        pa_stream_set_state_callback(stream, nullptr, nullptr);
+        pa_stream_unref(stream);
+        return nullptr;
+    }
+    return stream;
+}
+
+// -------- Hot Swap --------
+
+void AudioCapture::openPendingStream(const pa_sample_spec& sample_spec,
+                                     const pa_channel_map& channel_map,
+                                     const char* source_name,
+                                     int deviceType) {
+    pa_sample_spec nss = sample_spec;
+    nss.format = PA_SAMPLE_FLOAT32;
+
+    // A newer switch supersedes one still connecting
+    dropPendingStream();
+
+    QString error;
+    pendingStream_ =
+        open_record_stream(nss, channel_map, source_name, &AudioCapture::pending_stream_state_callback, this, &error);
+    if (!pendingStream_) {
+        abandonSwitch(error);
+        return;
+    }
+    pendingDeviceUID_ = QString::fromUtf8(source_name);
+    pendingDeviceType_ = deviceType;
+}
+
+void AudioCapture::promotePendingStream() {
+    pa_stream* next = pendingStream_;
+    pendingStream_ = nullptr;
+
+    // The old stream stops producing before the new one starts, so the ring
+    // keeps a single producer. Its read callback runs on this thread too, so
+    // nothing is pushed between the two calls.
+    if (stream_) {
+        pa_stream_set_read_callback(stream_, nullptr, nullptr);
+        pa_stream_set_state_callback(stream_, nullptr, nullptr);
+        pa_stream_disconnect(stream_);
+        pa_stream_unref(stream_);
+    }
+    stream_ = next;
+
+    // The DSP state (RMS windows, ballistics) carries over; the worker only
+    // restarts when the ring's frame layout changes
+    const pa_sample_spec* ss = pa_stream_get_sample_spec(stream_);
+    const VuDspWorker::Stats ring = dspWorker_.stats();
+    if (ss && (!dspWorker_.isRunning() || ring.channels != ss->channels || ring.sampleRate != static_cast<float>(ss->rate))) {
+        dspWorker_.start(ss->channels,
+                         static_cast<float>(ss->rate),
+                         [this](const float* data, unsigned int frames, unsigned int channels, float sampleRate) {
+                             processAudioBuffer(data, frames, channels, sampleRate);
+                         });
+    }
+
+    pa_stream_set_state_callback(stream_, &AudioCapture::stream_state_callback, this);
+    pa_stream_set_read_callback(stream_, &AudioCapture::stream_read_callback, this);
+
+    // Read by start() and context_state_callback only, both ordered against
+    // this thread (mainloop joined, or on the mainloop itself)
+    options_.deviceName = pendingDeviceName_;
+    deviceType_.store(pendingDeviceType_, std::memory_order_relaxed);
+    setCurrentDeviceUID(pendingDeviceUID_);
+    switchStartNs_.store(pendingSwitchNs_, std::memory_order_relaxed);
+    pendingSwitchNs_ = 0;
+
+    emit deviceChanged(currentDeviceUID());
+}
+
+void AudioCapture::dropPendingStream() {
+    if (!pendingStream_) {
+        return;
+    }
+    pa_stream_set_state_callback(pendingStream_, nullptr, nullptr);
+    pa_stream_disconnect(pendingStream_);
+    pa_stream_unref(pendingStream_);
+    pendingStream_ = nullptr;
+}
+
+void AudioCapture::abandonSwitch(const QString& message) {
+    dropPendingStream();
+    pendingSwitchNs_ = 0;
+    emit deviceSwitchFailed(pendingDeviceUID_, message);
+}
+
+void AudioCapture::swap_sink_info_callback(pa_context* /*c*/, const pa_sink_info* si, int is_last, void* userdata) {
+    auto* self = static_cast<AudioCapture*>(userdata);
+
+    if (is_last > 0) {
+        return;
+    }
+
+    if (is_last < 0 || !si) {
+        self->abandonSwitch(QStringLiteral("Failed to get sink info"));
+        return;
+    }
+
+    self->openPendingStream(si->sample_spec, si->channel_map, si->monitor_source_name, kDeviceTypeMonitor);
+}
+
+void AudioCapture::swap_source_info_callback(pa_context* /*c*/, const pa_source_info* si, int is_last, void* userdata) {
+    auto* self = static_cast<AudioCapture*>(userdata);
+
+    if (is_last > 0) {
+        return;
+    }
+
+    if (is_last < 0 || !si) {
+        self->abandonSwitch(QStringLiteral("Failed to get source info"));
+        return;
+    }
+
+    self->openPendingStream(si->sample_spec, si->channel_map, si->name, kDeviceTypeMicrophone);
+}
+
+void AudioCapture::pending_stream_state_callback(pa_stream* s, void* userdata) {
+    auto* self = static_cast<AudioCapture*>(userdata);
+    if (s != self->pendingStream_) {
+        return;
+    }
+
+    switch (pa_stream_get_state(s)) {
+    case PA_STREAM_READY:
+        self->promotePendingStream();
+        break;
+    case PA_STREAM_FAILED:
+    case PA_STREAM_TERMINATED:
+        self->abandonSwitch(QStringLiteral("Could not open %1: %2")
+                                .arg(self->pendingDeviceUID_,
+                                     QString::fromUtf8(pa_strerror(pa_context_errno(self->context_)))));
+        break;
+    default:
+        break;
+    }
+}
+
+// -------- Additional Sources --------
+
+VuLevelFrame AudioCapture::sourceLevels(int index) const {
+    if (index == 0) {
+        return levels_.read();
+    }
+    if (index < 0 || index > static_cast<int>(extraSources_.size())) {
+        return VuLevelFrame{};
+    }
+    return extraSources_[index - 1]->levels.read();
+}
+
+QString AudioCapture::sourceDeviceUID(int index) const {
+    if (index == 0) {
+        return currentDeviceUID();
+    }
+    if (index < 0 || index > static_cast<int>(extraSources_.size())) {
+        return QString();
+    }
+    return extraSources_[index - 1]->deviceUID;
+}
+
+void AudioCapture::lookUpExtraSource(ExtraSource* source) {
+    const DeviceLookup lookup = deviceLookupFor(source->deviceUID);
+    if (lookup.name.isEmpty()) {
+        return;
+    }
+
+    pa_operation* op = nullptr;
+    if (lookup.sink) {
+        op = pa_context_get_sink_info_by_name(
+            context_, lookup.name.constData(), &AudioCapture::extra_sink_info_callback, source);
+    } else {
+        op = pa_context_get_source_info_by_name(
+            context_, lookup.name.constData(), &AudioCapture::extra_source_info_callback, source);
+    }
+    if (op) {
+        pa_operation_unref(op);
+    }
+}
+
+void AudioCapture::openExtraStream(ExtraSource* source,
+                                   const pa_sample_spec& sample_spec,
+                                   const pa_channel_map& channel_map,
+                                   const char* source_name) {
+    pa_sample_spec nss = sample_spec;
+    nss.format = PA_SAMPLE_FLOAT32;
+
+    closeExtraStream(source);
+
+    // Its own ring on the shared worker; restarting the worker here is safe,
+    // as every producer runs on this thread
+    dspWorker_.start(static_cast<unsigned int>(source->index),
+                     nss.channels,
+                     static_cast<float>(nss.rate),
+                     [this, source](const float* data, unsigned int frames, unsigned int channels, float sampleRate) {
+                         meterBlock(source->meterState(), source->deviceType, data, frames, channels, sampleRate);
+                     });
+
+    QString error;
+    source->stream =
+        open_record_stream(nss, channel_map, source_name, &AudioCapture::extra_stream_state_callback, source, &error);
+    if (!source->stream) {
+        emit errorOccurred(error);
+        return;
+    }
+    pa_stream_set_read_callback(source->stream, &AudioCapture::extra_stream_read_callback, source);
+}
+
+void AudioCapture::closeExtraStream(ExtraSource* source) {
+    if (!source->stream) {
+        return;
+    }
+    pa_stream_set_read_callback(source->stream, nullptr, nullptr);
+    pa_stream_set_state_callback(source->stream, nullptr, nullptr);
+    pa_stream_disconnect(source->stream);
+    pa_stream_unref(source->stream);
+    source->stream = nullptr;
+}
+
+void AudioCapture::extra_sink_info_callback(pa_context* /*c*/, const pa_sink_info* si, int is_last, void* userdata) {
+    auto* source = static_cast<ExtraSource*>(userdata);
+
+    if (is_last > 0) {
+        return;
+    }
+    if (is_last < 0 || !si) {
+        emit source->owner->errorOccurred(QStringLiteral("Failed to get sink info for %1").arg(source->deviceUID));
+        return;
+    }
+
+    source->owner->openExtraStream(source, si->sample_spec, si->channel_map, si->monitor_source_name);
+}
+
+void AudioCapture::extra_source_info_callback(pa_context* /*c*/,
+                                              const pa_source_info* si,
+                                              int is_last,
+                                              void* userdata) {
+    auto* source = static_cast<ExtraSource*>(userdata);
+
+    if (is_last > 0) {
+        return;
+    }
+    if (is_last < 0 || !si) {
+        emit source->owner->errorOccurred(QStringLiteral("Failed to get source info for %1").arg(source->deviceUID));
+        return;
+    }
+
+    source->owner->openExtraStream(source, si->sample_spec, si->channel_map, si->name);
+}
+
+void AudioCapture::extra_stream_state_callback(pa_stream* s, void* userdata) {
+    auto* source = static_cast<ExtraSource*>(userdata);
+
+    if (pa_stream_get_state(s) == PA_STREAM_FAILED) {
+        emit source->owner->errorOccurred(QStringLiteral("PulseAudio stream failed for %1").arg(source->deviceUID));
+    }
+}
+
+void AudioCapture::extra_stream_read_callback(pa_stream* s, size_t length, void* userdata) {
+    auto* source = static_cast<ExtraSource*>(userdata);
+    const void* p = nullptr;
+    VuScopedTimer timer(VuStage::Capture);
+
+    if (pa_stream_peek(s, &p, &length) < 0 || length == 0) {
+        return;
+    }
+    if (!p) {
+        pa_stream_drop(s); // a hole: no data, but the fragment must still be dropped
+        return;
+    }
+    vuMetrics().add(VuCounter::CaptureBuffers);
+
+    const pa_sample_spec* ss = pa_stream_get_sample_spec(s);
+    const unsigned int channels = ss ? ss->channels : 0;
+    const unsigned int frames = channels > 0 ? static_cast<unsigned int>(length / sizeof(float)) / channels : 0;
+    // As for the primary stream, only the copy happens here
+    if (frames > 0 && source->owner->admitBlock(source->idle,
+                                                source->index,
+                                                static_cast<const float*>(p),
+                                                frames,
+                                                channels,
+                                                static_cast<float>(ss->rate))) {
+        source->owner->dspWorker_.push(static_cast<unsigned int>(source->index), static_cast<const float*>(p), frames);
+    }
+
+    pa_stream_drop(s);
+}
+
+// -------- Mainloop Tasks --------
+
+void AudioCapture::runOnMainloop(std::function<void()> fn) {
+    if (!mainloop_) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mainloopTasksMutex_);
+        mainloopTasks_.push_back(std::move(fn));
+    }
+    pa_mainloop_wakeup(mainloop_);
+}
+
+int AudioCapture::mainloop_poll(pollfd* ufds, unsigned long nfds, int timeout, void* userdata) {
+    auto* self = static_cast<AudioCapture*>(userdata);
+
+    std::vector<std::function<void()>> tasks;
+    {
+        std::lock_guard<std::mutex> lock(self->mainloopTasksMutex_);
+        tasks.swap(self->mainloopTasks_);
     }
+    for (const auto& task : tasks) {
+        task();
+    }
+
+    // Requests made by the tasks are only written on the next iteration, so
+    // do not sleep in this one
+    return ::poll(ufds, nfds, tasks.empty() ? timeout : 0);
+}
+
+// -------- Device Registry --------
+
+QList<AudioCapture::DeviceInfo> AudioCapture::devices() const {
+    std::lock_guard<std::mutex> lock(devicesMutex_);
+    return devices_;
+}
+
+void AudioCapture::refreshDevices() {
+    if (!running_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    runOnMainloop([this]() {
+        if (context_ && pa_context_get_state(context_) == PA_CONTEXT_READY) {
+            requestDeviceListing(context_);
+        }
+    });
+}
+
+void AudioCapture::startDeviceRegistry(pa_context* c) {
+    pa_context_set_subscribe_callback(
+        c,
+        [](pa_context* ctx, pa_subscription_event_type_t t, uint32_t index, void* userdata) {
+            auto* self = static_cast<AudioCapture*>(userdata);
+            const unsigned int facility = t & PA_SUBSCRIPTION_EVENT_FACILITY_MASK;
+            const unsigned int type = t & PA_SUBSCRIPTION_EVENT_TYPE_MASK;
+
+            pa_operation* op = nullptr;
+            if (facility == PA_SUBSCRIPTION_EVENT_SERVER) {
+                // Default sink or source may have changed
+                op = pa_context_get_server_info(ctx, &AudioCapture::registry_server_callback, self);
+            } else if (facility == PA_SUBSCRIPTION_EVENT_SOURCE) {
+                if (type == PA_SUBSCRIPTION_EVENT_REMOVE) {
+                    if (self->registrySources_.erase(index) > 0 && self->registryListed_) {
+                        self->publishDevices();
+                    }
+                } else {
+                    op = pa_context_get_source_info_by_index(ctx, index, &AudioCapture::registry_source_callback, self);
+                }
+            }
+            if (op) {
+                pa_operation_unref(op);
+            }
+        },
+        this);
+
+    pa_operation* op = pa_context_subscribe(
+        c, static_cast<pa_subscription_mask_t>(PA_SUBSCRIPTION_MASK_SOURCE | PA_SUBSCRIPTION_MASK_SERVER), nullptr, nullptr);
+    if (op) {
+        pa_operation_unref(op);
+    }
+
+    requestDeviceListing(c);
+}
+
+void AudioCapture::requestDeviceListing(pa_context* c) {
+    // Nothing is published until the listing completes, so a relisting does not
+    // show a partial menu
+    registrySources_.clear();
+    registryListed_ = false;
+
+    pa_operation* op = pa_context_get_server_info(c, &AudioCapture::registry_server_callback, this);
+    if (op) {
+        pa_operation_unref(op);
+    }
+    op = pa_context_get_source_info_list(c, &AudioCapture::registry_list_callback, this);
+    if (op) {
+        pa_operation_unref(op);
+    }
+}
+
+static AudioCapture::DeviceInfo deviceInfoFromSource(const pa_source_info* si) {
+    AudioCapture::DeviceInfo device;
+    device.name = QString::fromUtf8(si->description);
+    device.uid = QString::fromUtf8(si->name);
+    device.channels = static_cast<int>(si->sample_spec.channels);
+    device.isInput = true;
+    return device;
+}
+
+void AudioCapture::registry_server_callback(pa_context* /*c*/, const pa_server_info* info, void* userdata) {
+    auto* self = static_cast<AudioCapture*>(userdata);
+    if (!info) {
+        return;
+    }
+
+    const QString sink = QString::fromUtf8(info->default_sink_name);
+    const QString source = QString::fromUtf8(info->default_source_name);
+    if (sink == self->registryDefaultSink_ && source == self->registryDefaultSource_) {
+        return;
+    }
+    self->registryDefaultSink_ = sink;
+    self->registryDefaultSource_ = source;
+
+    if (self->registryListed_) {
+        self->publishDevices();
+    }
+}
+
+void AudioCapture::registry_list_callback(pa_context* /*c*/, const pa_source_info* si, int is_last, void* userdata) {
+    auto* self = static_cast<AudioCapture*>(userdata);
+    if (is_last < 0) {
+        return;
+    }
+    if (is_last > 0) {
+        self->registryListed_ = true;
+        self->publishDevices();
+        return;
+    }
+    if (si) {
+        self->registrySources_[si->index] = deviceInfoFromSource(si);
+    }
+}
+
+void AudioCapture::registry_source_callback(pa_context* /*c*/, const pa_source_info* si, int is_last, void* userdata) {
+    auto* self = static_cast<AudioCapture*>(userdata);
+    // is_last < 0: the source went away before the query was answered
+    if (is_last != 0) {
+        return;
+    }
+    if (si) {
+        self->registrySources_[si->index] = deviceInfoFromSource(si);
+        if (self->registryListed_) {
+            self->publishDevices();
+        }
+    }
+}
+
+void AudioCapture::publishDevices() {
+    // The monitor of the default sink is what capture uses by default; the
+    // default source only counts when that monitor does not exist
+    const QString defaultMonitor = registryDefaultSink_ + ".monitor";
+    bool monitorExists = false;
+    for (const auto& entry : registrySources_) {
+        if (entry.second.uid == defaultMonitor) {
+            monitorExists = true;
+            break;
+        }
+    }
+
+    QList<DeviceInfo> list;
+    list.reserve(static_cast<qsizetype>(registrySources_.size()));
+    for (const auto& entry : registrySources_) {
+        DeviceInfo device = entry.second;
+        device.isDefault = monitorExists ? device.uid == defaultMonitor : device.uid == registryDefaultSource_;
+        list.append(device);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(devicesMutex_);
+        if (list == devices_) {
+            return;
+        }
+        devices_ = list;
+    }
+    emit devicesChanged();
 }
 
 // -------- Device Enumeration --------
@@ -598,15 +1334,124 @@ QString AudioCapture::listDevicesString() {
     return out;
 }
 
+// -------- DSP --------
+
+void AudioCapture::processAudioBuffer(const float* data, unsigned int frames, unsigned int channels, float sampleRate) {
+    spectrum_.push(data, frames, channels, sampleRate);
+    meterBlock({*dspState_,
+                ballistics_,
+                peakHold_,
+                framesProcessed_,
+                levels_,
+                *detectorState_,
+                loudnessResetsSeen_,
+                idle_,
+                history_,
+                0},
+               deviceType_.load(std::memory_order_relaxed),
+               data,
+               frames,
+               channels,
+               sampleRate);
+}
+
+void AudioCapture::meterBlock(MeterState state,
+                              int deviceType,
+                              const float* data,
+                              unsigned int frames,
+                              unsigned int channels,
+                              float sampleRate) {
+    // Lock-free; the block stays valid until the next acquire on this thread
+    const VuCalibration& ref = acquireCalibration().forDevice(deviceType);
+
+    const VuNeedleSource needle = needleSource_.load(std::memory_order_relaxed);
+    VuDetectorOptions detectors = detectors_.load(std::memory_order_relaxed);
+    detectors.enableFor(needle);
+    if (detectors.any()) {
+        const std::uint32_t resets = loudnessResets_.load(std::memory_order_relaxed);
+        if (resets != state.loudnessResetsSeen) {
+            state.loudnessResetsSeen = resets;
+            vuResetLoudness(state.detectors);
+        }
+    }
+
+    // One pass: each chunk goes through the VU integrator and the broadcast
+    // detectors while it is in L1
+    for (unsigned int pos = 0; pos < frames; pos += kVuDetectorChunkFrames) {
+        const unsigned int n = std::min(kVuDetectorChunkFrames, frames - pos);
+        const float* chunk = data + static_cast<std::size_t>(pos) * channels;
+        vuAccumulateInterleavedFloatAudio(chunk, n, channels, sampleRate, ref, state.ballistics, state.dsp);
+        if (detectors.any()) {
+            processInterleavedFloatAudioDetectors(chunk, n, channels, sampleRate, detectors, state.detectors);
+        }
+    }
+
+    std::array<float, kVuMaxChannels> vu;
+    vu.fill(kAudioFloorVu);
+    vuFinishInterleavedFloatAudio(sampleRate,
+                                  ref,
+                                  state.ballistics,
+                                  state.dsp,
+                                  kAudioFloorVu,
+                                  kAudioCeilingVu,
+                                  vu.data());
+
+    if (detectors.any()) {
+        if (needle != VuNeedleSource::Vu) {
+            const unsigned int metered = std::min(channels, kVuMaxChannels);
+            for (unsigned int c = 0; c < metered; ++c) {
+                const float reading = vuNeedleReading(state.detectors.readings, needle, c);
+                vu[c] = std::clamp(reading - ref.referenceDbfs, kAudioFloorVu, kAudioCeilingVu);
+            }
+        }
+    }
+
+    VuLevelFrame frame;
+    frame.channels = std::min(channels, kVuMaxChannels);
+    std::copy_n(vu.begin(), frame.channels, frame.vuDb.begin());
+    state.peakHold.update(vu.data(), frame.channels, frames, sampleRate, frame.peakHoldDb.data());
+
+    if (detectors.any()) {
+        const VuDetectorReadings& readings = state.detectors.readings;
+        frame.truePeakDbtp = readings.truePeakDbtp;
+        frame.ppmDbfs = readings.ppmDbfs;
+        frame.maxTruePeakDbtp = readings.maxTruePeakDbtp;
+        frame.momentaryLufs = readings.momentaryLufs;
+        frame.shortTermLufs = readings.shortTermLufs;
+        frame.integratedLufs = readings.integratedLufs;
+    }
+
+    state.framesProcessed += frames;
+    frame.frameCounter = state.framesProcessed + state.idle.droppedFrames();
+
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    frame.timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+
+    state.levels.publish(frame);
+    state.history.push(frame, frames, sampleRate);
+
+    const VuIdleMonitor::Transition idle = state.idle.noteMetered(
+        data, frames, channels, sampleRate, frame.vuDb.data(), frame.peakHoldDb.data(), frame.channels);
+    if (idle != VuIdleMonitor::Transition::None) {
+        emit sourceIdleChanged(state.sourceIndex, idle == VuIdleMonitor::Transition::WentIdle);
+    }
+}
+
 // -------- PulseAudio Callbacks --------
 
 void AudioCapture::stream_read_callback(pa_stream* s, size_t length, void* userdata) {
     auto* self = static_cast<AudioCapture*>(userdata);
     const void* p = nullptr;
+    VuScopedTimer timer(VuStage::Capture);
 
-    if (pa_stream_peek(s, &p, &length) < 0 || !p || length == 0) {
+    if (pa_stream_peek(s, &p, &length) < 0 || length == 0) {
         return;
     }
+    if (!p) {
+        pa_stream_drop(s); // a hole: no data, but the fragment must still be dropped
+        return;
+    }
+    vuMetrics().add(VuCounter::CaptureBuffers);
 
     const float* data = static_cast<const float*>(p);
     const pa_sample_spec* ss = pa_stream_get_sample_spec(s);
@@ -623,37 +1468,22 @@ void AudioCapture::stream_read_callback(pa_stream* s, size_t length, void* userd
         return;
     }
 
-    // Use per-instance DSP state (FIXED: was static!)
-    VuReferenceOptions ref;
-
-    // Read the appropriate per-device reference level based on device type
-    int deviceType = self->deviceType_.load(std::memory_order_relaxed);
-    if (deviceType == kDeviceTypeMicrophone) {
-        ref.referenceDbfs = self->options_.microphoneReferenceDbfs;
-    } else {
-        ref.referenceDbfs = self->options_.monitorReferenceDbfs;
-    }
-
-    ref.referenceDbfsOverride = self->options_.referenceDbfsOverride;
-    ref.deviceType = deviceType;
-
-    float vuL = kAudioFloorVu;
-    float vuR = kAudioFloorVu;
-    processInterleavedFloatAudioToVuDb(data,
-                                       frames,
-                                       channels,
-                                       static_cast<float>(ss->rate),
-                                       ref,
-                                       self->ballisticsL_,
-                                       self->ballisticsR_,
-                                       *self->dspState_, // Use instance member, not static!
-                                       kAudioFloorVu,
-                                       kAudioCeilingVu,
-                                       vuL,
-                                       vuR);
-
-    self->leftVuDb_.store(vuL, std::memory_order_relaxed);
-    self->rightVuDb_.store(vuR, std::memory_order_relaxed);
+    // Only copy the raw frames here; the DSP worker runs the metering pipeline
+    // so pa_stream_drop() is not held up by it. An idle source's quiet blocks
+    // are dropped here without waking the worker.
+    if (self->admitBlock(self->idle_, 0, data, frames, channels, static_cast<float>(ss->rate))) {
+        self->dspWorker_.push(data, frames);
+    }
+    self->noteBufferAfterSwitch();
+
+    // Source latency plus what is still buffered in the stream, i.e. the age of
+    // the oldest sample just read. Interpolated, so no server round trip.
+    pa_usec_t latencyUs = 0;
+    int negative = 0;
+    if (pa_stream_get_latency(s, &latencyUs, &negative) == 0) {
+        self->streamLatencyMs_.store(negative ? 0.0 : static_cast<double>(latencyUs) / PA_USEC_PER_MSEC,
+                                     std::memory_order_relaxed);
+    }
 
     pa_stream_drop(s);
 }
@@ -688,7 +1518,7 @@ void AudioCapture::sink_info_callback(pa_context* /*c*/, const pa_sink_info* si,
     self->create_stream_from_spec(si->sample_spec, si->channel_map, si->monitor_source_name);
 
     // Update current device UID
-    self->currentDeviceUID_ = QString::fromUtf8(si->monitor_source_name);
+    self->setCurrentDeviceUID(QString::fromUtf8(si->monitor_source_name));
 }
 
 void AudioCapture::source_info_callback(pa_context* /*c*/, const pa_source_info* si, int is_last, void* userdata) {
@@ -707,14 +1537,18 @@ void AudioCapture::source_info_callback(pa_context* /*c*/, const pa_source_info*
     self->create_stream_from_spec(si->sample_spec, si->channel_map, si->name);
 
     // Update current device UID
-    self->currentDeviceUID_ = QString::fromUtf8(si->name);
+    self->setCurrentDeviceUID(QString::fromUtf8(si->name));
 }
 
 void AudioCapture::context_state_callback(pa_context* c, void* userdata) {
     auto* self = static_cast<AudioCapture*>(userdata);
+    const pa_context_state_t state = pa_context_get_state(c);
+    self->contextState_.store(state, std::memory_order_release);
 
-    switch (pa_context_get_state(c)) {
+    switch (state) {
     case PA_CONTEXT_READY: {
+        self->startDeviceRegistry(c);
+
         const char* name = nullptr;
         QByteArray utf8;
         if (!self->options_.deviceName.isEmpty()) {
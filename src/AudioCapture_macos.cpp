@@ -2,9 +2,15 @@
 
 #include "AudioCapture.h"
 #include "VuAudioDsp.h"
+#include "VuMetrics.h"
 
 #include <algorithm>
+#include <array>
+#include <chrono>
 #include <cmath>
+#include <vector>
+
+#include <QSettings>
 
 #include <AudioToolbox/AudioToolbox.h>
 #include <CoreAudio/CoreAudio.h>
@@ -12,26 +18,289 @@
 static constexpr float kMinVu = -22.0f;
 static constexpr float kMaxVu = 3.0f;
 
+// Input channel count of a device (default input when uid is empty), so the
+// queue captures every interface input instead of a fixed stereo pair.
+// Falls back to stereo if the device cannot be queried.
+static UInt32 inputChannelCount(const QString& uid) {
+    AudioDeviceID deviceID = kAudioObjectUnknown;
+    AudioObjectPropertyAddress propertyAddress = {
+        kAudioHardwarePropertyDefaultInputDevice, kAudioObjectPropertyScopeGlobal, kAudioObjectPropertyElementMain};
+    UInt32 dataSize = sizeof(deviceID);
+
+    if (uid.isEmpty()) {
+        AudioObjectGetPropertyData(kAudioObjectSystemObject, &propertyAddress, 0, nullptr, &dataSize, &deviceID);
+    } else {
+        CFStringRef deviceUID =
+            CFStringCreateWithCString(kCFAllocatorDefault, uid.toUtf8().constData(), kCFStringEncodingUTF8);
+        AudioValueTranslation translation = {&deviceUID, sizeof(deviceUID), &deviceID, sizeof(deviceID)};
+        propertyAddress.mSelector = kAudioHardwarePropertyDeviceForUID;
+        dataSize = sizeof(translation);
+        AudioObjectGetPropertyData(kAudioObjectSystemObject, &propertyAddress, 0, nullptr, &dataSize, &translation);
+        CFRelease(deviceUID);
+    }
+
+    if (deviceID == kAudioObjectUnknown) {
+        return 2;
+    }
+
+    propertyAddress.mSelector = kAudioDevicePropertyStreamConfiguration;
+    propertyAddress.mScope = kAudioDevicePropertyScopeInput;
+    dataSize = 0;
+    if (AudioObjectGetPropertyDataSize(deviceID, &propertyAddress, 0, nullptr, &dataSize) != noErr || dataSize == 0) {
+        return 2;
+    }
+
+    std::vector<UInt8> bufferListData(dataSize);
+    AudioBufferList* bufferList = reinterpret_cast<AudioBufferList*>(bufferListData.data());
+    if (AudioObjectGetPropertyData(deviceID, &propertyAddress, 0, nullptr, &dataSize, bufferList) != noErr) {
+        return 2;
+    }
+
+    UInt32 inputChannels = 0;
+    for (UInt32 i = 0; i < bufferList->mNumberBuffers; ++i) {
+        inputChannels += bufferList->mBuffers[i].mNumberChannels;
+    }
+
+    return std::clamp<UInt32>(inputChannels, 1, kVuMaxChannels);
+}
+
+// System-object properties whose changes mean the input device list changed
+static const AudioObjectPropertyAddress kDeviceListProperties[] = {
+    {kAudioHardwarePropertyDevices, kAudioObjectPropertyScopeGlobal, kAudioObjectPropertyElementMain},
+    {kAudioHardwarePropertyDefaultInputDevice, kAudioObjectPropertyScopeGlobal, kAudioObjectPropertyElementMain},
+};
+
+// Runs on a CoreAudio notification thread; the re-query happens on the object's thread
+static OSStatus deviceListListener(AudioObjectID /*object*/,
+                                   UInt32 /*numberAddresses*/,
+                                   const AudioObjectPropertyAddress* /*addresses*/,
+                                   void* clientData) {
+    auto* self = static_cast<AudioCapture*>(clientData);
+    QMetaObject::invokeMethod(self, [self]() { self->refreshDevices(); }, Qt::QueuedConnection);
+    return noErr;
+}
+
 AudioCapture::AudioCapture(const Options& options, QObject* parent)
-    : QObject(parent), options_(options), currentDeviceUID_(options.deviceName), ballisticsL_(kMinVu),
-      ballisticsR_(kMinVu) {
+    : QObject(parent), options_(options), currentDeviceUID_(options.deviceName), idle_(options.idle), history_(kMinVu),
+      dspState_(new VuAudioDspState{}), detectorState_(new VuDetectorState{}), ballistics_(kMinVu) {
+    resetChannelLevels(kMinVu);
+    ballistics_.setJitterEnabled(options_.needleJitter);
+    ballistics_.setJitterSeed(VuJitterRng::seedFor(0));
+    if (options_.blockAccurateBallistics) {
+        dspState_->integrationMode = VuIntegrationMode::BlockAccurate;
+    }
+    if (options_.fastMath) {
+        dspState_->mathMode = VuMathMode::Fast;
+        ballistics_.setFastMath(true);
+    }
+    needleSource_.store(options_.needleSource, std::memory_order_relaxed);
+    detectors_.store(options_.detectors, std::memory_order_relaxed);
     loadReferenceLevels();
+    createExtraSources(kMinVu);
+
+    devices_ = enumerateInputDevices();
+    registerDeviceListeners();
+}
+
+AudioCapture::~AudioCapture() {
+    unregisterDeviceListeners();
+    stop();
+    destroyExtraSources();
+    delete detectorState_;
+    delete dspState_;
+}
+
+void AudioCapture::createExtraSources(float floorDb) {
+    for (const QString& uid : options_.additionalDevices) {
+        auto source = std::make_unique<ExtraSource>(floorDb, options_.idle);
+        source->owner = this;
+        source->index = static_cast<int>(extraSources_.size()) + 1;
+        source->deviceUID = uid;
+        source->deviceType = options_.deviceType;
+        source->dspState = new VuAudioDspState{};
+        source->detectorState = new VuDetectorState{};
+        if (options_.blockAccurateBallistics) {
+            source->dspState->integrationMode = VuIntegrationMode::BlockAccurate;
+        }
+        if (options_.fastMath) {
+            source->dspState->mathMode = VuMathMode::Fast;
+            source->ballistics.setFastMath(true);
+        }
+        source->ballistics.setJitterEnabled(options_.needleJitter);
+        // Own phase per source, so several meters do not jitter in lockstep
+        source->ballistics.setJitterSeed(VuJitterRng::seedFor(static_cast<unsigned int>(source->index)));
+        source->peakHold.reset(floorDb);
+
+        VuLevelFrame frame;
+        frame.vuDb.fill(floorDb);
+        frame.peakHoldDb.fill(floorDb);
+        source->levels.publish(frame);
+
+        extraSources_.push_back(std::move(source));
+    }
+    dspWorker_.setInputCount(1 + static_cast<unsigned int>(extraSources_.size()));
 }
 
-AudioCapture::~AudioCapture() { stop(); }
+void AudioCapture::destroyExtraSources() {
+    for (const std::unique_ptr<ExtraSource>& source : extraSources_) {
+        delete source->detectorState;
+        delete source->dspState;
+    }
+    extraSources_.clear();
+}
+
+VuLevelFrame AudioCapture::sourceLevels(int index) const {
+    if (index == 0) {
+        return levels_.read();
+    }
+    if (index < 0 || index > static_cast<int>(extraSources_.size())) {
+        return VuLevelFrame{};
+    }
+    return extraSources_[index - 1]->levels.read();
+}
+
+QString AudioCapture::sourceDeviceUID(int index) const {
+    if (index == 0) {
+        return currentDeviceUID();
+    }
+    if (index < 0 || index > static_cast<int>(extraSources_.size())) {
+        return QString();
+    }
+    return extraSources_[index - 1]->deviceUID;
+}
+
+// One more queue per additional source. Queues created without a run loop
+// share AudioToolbox's internal callback thread; like the primary queue, the
+// callback only pushes into the source's input of the DSP worker, which
+// start() has set up (and source.channels with it) before any queue runs.
+bool AudioCapture::startExtraSource(ExtraSource& source, QString* errorOut) {
+    AudioStreamBasicDescription format = {};
+    format.mSampleRate = options_.sampleRate;
+    format.mFormatID = kAudioFormatLinearPCM;
+    format.mFormatFlags = kAudioFormatFlagIsFloat | kAudioFormatFlagIsPacked;
+    format.mBitsPerChannel = 32;
+    format.mChannelsPerFrame = source.channels;
+    format.mBytesPerFrame = format.mChannelsPerFrame * sizeof(float);
+    format.mFramesPerPacket = 1;
+    format.mBytesPerPacket = format.mBytesPerFrame;
+
+    OSStatus status = AudioQueueNewInput(
+        &format,
+        [](void* inUserData,
+           AudioQueueRef inAQ,
+           AudioQueueBufferRef inBuffer,
+           const AudioTimeStamp* /*inStartTime*/,
+           UInt32 /*inNumberPacketDescriptions*/,
+           const AudioStreamPacketDescription* /*inPacketDescs*/) {
+            auto* src = static_cast<ExtraSource*>(inUserData);
+            if (!src->owner->running_.load(std::memory_order_relaxed)) {
+                return;
+            }
+            VuScopedTimer timer(VuStage::Capture);
+            vuMetrics().add(VuCounter::CaptureBuffers);
+            const unsigned int frames = inBuffer->mAudioDataByteSize / (src->channels * sizeof(float));
+            const float* data = static_cast<const float*>(inBuffer->mAudioData);
+            const float sampleRate = static_cast<float>(src->owner->options_.sampleRate);
+            if (frames > 0 && src->owner->admitBlock(src->idle, src->index, data, frames, src->channels, sampleRate)) {
+                src->owner->dspWorker_.push(static_cast<unsigned int>(src->index), data, frames);
+            }
+            AudioQueueEnqueueBuffer(inAQ, inBuffer, 0, nullptr);
+        },
+        &source,
+        nullptr,
+        nullptr,
+        0,
+        &source.queue);
+    if (status != noErr) {
+        if (errorOut) *errorOut = QStringLiteral("Failed to create audio input queue: %1").arg(status);
+        return false;
+    }
+
+    CFStringRef deviceUID =
+        CFStringCreateWithCString(kCFAllocatorDefault, source.deviceUID.toUtf8().constData(), kCFStringEncodingUTF8);
+    status = AudioQueueSetProperty(source.queue, kAudioQueueProperty_CurrentDevice, &deviceUID, sizeof(deviceUID));
+    CFRelease(deviceUID);
+
+    const CaptureBuffering buffering = bufferingFor(options_.latencyProfile);
+    const unsigned long framesPerBuffer =
+        options_.framesPerBuffer > 0
+            ? options_.framesPerBuffer
+            : static_cast<unsigned long>(format.mSampleRate * buffering.fragmentMs / 1000.0);
+    const UInt32 bufferSize = static_cast<UInt32>(framesPerBuffer) * format.mBytesPerFrame;
+
+    for (int i = 0; status == noErr && i < std::clamp(buffering.bufferCount, 2, kMaxBuffers); ++i) {
+        AudioQueueBufferRef buffer = nullptr;
+        status = AudioQueueAllocateBuffer(source.queue, bufferSize, &buffer);
+        if (status == noErr) {
+            status = AudioQueueEnqueueBuffer(source.queue, buffer, 0, nullptr);
+        }
+    }
+    if (status == noErr) {
+        status = AudioQueueStart(source.queue, nullptr);
+    }
+
+    if (status != noErr) {
+        if (errorOut) *errorOut = QStringLiteral("Failed to open %1: %2").arg(source.deviceUID).arg(status);
+        stopExtraSource(source);
+        return false;
+    }
+    return true;
+}
+
+void AudioCapture::stopExtraSource(ExtraSource& source) {
+    if (!source.queue) {
+        return;
+    }
+    AudioQueueStop(source.queue, true);
+    AudioQueueDispose(source.queue, true);
+    source.queue = nullptr;
+}
+
+void AudioCapture::registerDeviceListeners() {
+    for (const AudioObjectPropertyAddress& address : kDeviceListProperties) {
+        AudioObjectAddPropertyListener(kAudioObjectSystemObject, &address, &deviceListListener, this);
+    }
+}
+
+void AudioCapture::unregisterDeviceListeners() {
+    for (const AudioObjectPropertyAddress& address : kDeviceListProperties) {
+        AudioObjectRemovePropertyListener(kAudioObjectSystemObject, &address, &deviceListListener, this);
+    }
+}
+
+QList<AudioCapture::DeviceInfo> AudioCapture::devices() const {
+    std::lock_guard<std::mutex> lock(devicesMutex_);
+    return devices_;
+}
+
+void AudioCapture::refreshDevices() {
+    // HAL property reads are local (no server round trip), so a full
+    // re-query per notification is cheap
+    const QList<DeviceInfo> list = enumerateInputDevices();
+    {
+        std::lock_guard<std::mutex> lock(devicesMutex_);
+        if (list == devices_) {
+            return;
+        }
+        devices_ = list;
+    }
+    emit devicesChanged();
+}
 
 bool AudioCapture::start(QString* errorOut) {
     if (running_.exchange(true)) {
         return true;
     }
 
-    // Set up audio format - 32-bit float, stereo, at requested sample rate
+    // Set up audio format - 32-bit float, all device input channels, at requested sample rate
+    captureChannels_ = inputChannelCount(options_.deviceName);
+
     AudioStreamBasicDescription format = {};
     format.mSampleRate = options_.sampleRate;
     format.mFormatID = kAudioFormatLinearPCM;
     format.mFormatFlags = kAudioFormatFlagIsFloat | kAudioFormatFlagIsPacked;
     format.mBitsPerChannel = 32;
-    format.mChannelsPerFrame = 2; // Stereo
+    format.mChannelsPerFrame = captureChannels_;
     format.mBytesPerFrame = format.mChannelsPerFrame * sizeof(float);
     format.mFramesPerPacket = 1;
     format.mBytesPerPacket = format.mBytesPerFrame;
@@ -86,7 +355,7 @@ bool AudioCapture::start(QString* errorOut) {
             running_.store(false, std::memory_order_relaxed);
             return false;
         }
-        currentDeviceUID_ = options_.deviceName;
+        setCurrentDeviceUID(options_.deviceName);
     } else {
         // Get the default input device UID
         AudioDeviceID defaultInput = 0;
@@ -101,16 +370,24 @@ bool AudioCapture::start(QString* errorOut) {
             if (AudioObjectGetPropertyData(defaultInput, &propertyAddress, 0, nullptr, &dataSize, &deviceUID) ==
                     noErr &&
                 deviceUID) {
-                currentDeviceUID_ = QString::fromCFString(deviceUID);
+                setCurrentDeviceUID(QString::fromCFString(deviceUID));
                 CFRelease(deviceUID);
             }
         }
     }
 
     // Allocate and enqueue buffers
-    UInt32 bufferSize = options_.framesPerBuffer * format.mBytesPerFrame;
-
-    for (int i = 0; i < kNumBuffers; ++i) {
+    const CaptureBuffering buffering = bufferingFor(options_.latencyProfile);
+    const unsigned long framesPerBuffer =
+        options_.framesPerBuffer > 0
+            ? options_.framesPerBuffer
+            : static_cast<unsigned long>(format.mSampleRate * buffering.fragmentMs / 1000.0);
+    UInt32 bufferSize = static_cast<UInt32>(framesPerBuffer) * format.mBytesPerFrame;
+    bufferCount_ = std::clamp(buffering.bufferCount, 2, kMaxBuffers);
+    fragmentMs_.store(1000.0 * static_cast<double>(framesPerBuffer) / format.mSampleRate, std::memory_order_relaxed);
+    streamLatencyMs_.store(-1.0, std::memory_order_relaxed);
+
+    for (int i = 0; i < bufferCount_; ++i) {
         status =
             AudioQueueAllocateBuffer(audioQueue_, bufferSize, reinterpret_cast<AudioQueueBufferRef*>(&buffers_[i]));
         if (status != noErr) {
@@ -135,18 +412,48 @@ bool AudioCapture::start(QString* errorOut) {
         }
     }
 
+    // Every input of the DSP worker is set up before any queue runs: each
+    // start() restarts the worker, and a queue pushing meanwhile would lose
+    // buffers
+    for (const std::unique_ptr<ExtraSource>& source : extraSources_) {
+        ExtraSource* s = source.get();
+        s->channels = inputChannelCount(s->deviceUID);
+        dspWorker_.start(static_cast<unsigned int>(s->index),
+                         s->channels,
+                         static_cast<float>(format.mSampleRate),
+                         [this, s](const float* data, unsigned int frames, unsigned int channels, float sampleRate) {
+                             meterBlock(s->meterState(), s->deviceType, data, frames, channels, sampleRate);
+                         });
+    }
+
+    // Start the DSP worker before the queue so no buffer is lost
+    dspWorker_.start(format.mChannelsPerFrame,
+                     static_cast<float>(format.mSampleRate),
+                     [this](const float* data, unsigned int frames, unsigned int channels, float sampleRate) {
+                         processAudioBuffer(data, frames, channels, sampleRate);
+                     });
+
     // Start the queue
     status = AudioQueueStart(audioQueue_, nullptr);
     if (status != noErr) {
         if (errorOut) {
             *errorOut = QStringLiteral("Failed to start audio queue: %1").arg(status);
         }
+        dspWorker_.stop();
         AudioQueueDispose(audioQueue_, true);
         audioQueue_ = nullptr;
         running_.store(false, std::memory_order_relaxed);
         return false;
     }
 
+    // A source that cannot be opened stays at the floor; the primary keeps running
+    for (const std::unique_ptr<ExtraSource>& source : extraSources_) {
+        QString error;
+        if (!startExtraSource(*source, &error)) {
+            emit errorOccurred(error);
+        }
+    }
+
     if (errorOut) {
         *errorOut = QString();
     }
@@ -164,41 +471,74 @@ void AudioCapture::stop() {
         audioQueue_ = nullptr;
     }
 
-    for (int i = 0; i < kNumBuffers; ++i) {
+    for (const std::unique_ptr<ExtraSource>& source : extraSources_) {
+        stopExtraSource(*source);
+    }
+
+    // The queue is disposed, so nothing pushes into the ring anymore
+    dspWorker_.stop();
+
+    for (int i = 0; i < kMaxBuffers; ++i) {
         buffers_[i] = nullptr;
     }
+    bufferCount_ = 0;
 }
 
 bool AudioCapture::switchDevice(const QString& deviceUID, QString* errorOut) {
-    // Stop current capture
-    stop();
+    const std::int64_t requestedNs = steadyNowNs();
 
-    // Reset ballistics and smoothed values
-    rmsL_smooth_ = 0.0f;
-    rmsR_smooth_ = 0.0f;
-    prevL_ = 0.0f;
-    prevR_ = 0.0f;
-    meterAwake_ = false;
-    ballisticsL_.reset(kMinVu);
-    ballisticsR_.reset(kMinVu);
-    leftVuDb_.store(kMinVu, std::memory_order_relaxed);
-    rightVuDb_.store(kMinVu, std::memory_order_relaxed);
+    // Stop current capture. Creating the new queue is local and quick, so the
+    // gap is short; the ballistics and smoothed values are kept so the needle
+    // continues from where it was instead of dropping to the floor.
+    stop();
 
     // Update options with new device
     options_.deviceName = deviceUID;
 
     // Restart with new device
+    switchStartNs_.store(requestedNs, std::memory_order_relaxed);
     bool success = start(errorOut);
 
     if (success) {
-        currentDeviceUID_ = deviceUID;
+        setCurrentDeviceUID(deviceUID);
         emit deviceChanged(deviceUID);
+    } else {
+        switchStartNs_.store(0, std::memory_order_relaxed);
     }
 
     return success;
 }
 
-QString AudioCapture::currentDeviceUID() const { return currentDeviceUID_; }
+bool AudioCapture::setLatencyProfile(LatencyProfile profile, QString* errorOut) {
+    if (profile == options_.latencyProfile) {
+        return true;
+    }
+    options_.latencyProfile = profile;
+    if (!running_.load(std::memory_order_relaxed)) {
+        return true;
+    }
+
+    // Buffers are sized when the queue is created
+    stop();
+    return start(errorOut);
+}
+
+AudioCapture::LatencyStats AudioCapture::latency() const {
+    LatencyStats stats;
+    stats.fragmentMs = fragmentMs_.load(std::memory_order_relaxed);
+    stats.streamMs = streamLatencyMs_.load(std::memory_order_relaxed);
+
+    const VuDspWorker::Stats ring = dspWorker_.stats();
+    if (ring.sampleRate > 0.0f) {
+        stats.ringMs = 1000.0 * static_cast<double>(ring.fillFrames) / ring.sampleRate;
+    }
+    return stats;
+}
+
+QString AudioCapture::currentDeviceUID() const {
+    std::lock_guard<std::mutex> lock(deviceUidMutex_);
+    return currentDeviceUID_;
+}
 
 double AudioCapture::referenceDbfs() const { return options_.referenceDbfs; }
 
@@ -209,6 +549,7 @@ void AudioCapture::setReferenceDbfs(double value) {
     } else {
         options_.monitorReferenceDbfs = value;
     }
+    publishCalibration();
     saveReferenceLevels();
 }
 
@@ -218,11 +559,13 @@ double AudioCapture::monitorReferenceDbfs() const { return options_.monitorRefer
 
 void AudioCapture::setMicrophoneReferenceDbfs(double value) { 
     options_.microphoneReferenceDbfs = value; 
+    publishCalibration();
     saveReferenceLevels();
 }
 
 void AudioCapture::setMonitorReferenceDbfs(double value) { 
     options_.monitorReferenceDbfs = value; 
+    publishCalibration();
     saveReferenceLevels();
 }
 
@@ -236,9 +579,31 @@ double AudioCapture::effectiveReferenceDbfs() const {
     }
 }
 
-float AudioCapture::leftVuDb() const { return leftVuDb_.load(std::memory_order_relaxed); }
+float AudioCapture::leftVuDb() const { return levels_.read().leftVuDb(); }
+
+float AudioCapture::rightVuDb() const { return levels_.read().rightVuDb(); }
+
+unsigned int AudioCapture::channelCount() const { return levels_.read().channels; }
+
+float AudioCapture::channelVuDb(unsigned int channel) const {
+    if (channel >= kVuMaxChannels) {
+        return kMinVu;
+    }
+    return levels_.read().vuDb[channel];
+}
 
-float AudioCapture::rightVuDb() const { return rightVuDb_.load(std::memory_order_relaxed); }
+void AudioCapture::resetChannelLevels(float valueDb) {
+    // Not a DSP update (timestamp 0): the UI shows the reset value without
+    // interpolating to it
+    VuLevelFrame frame;
+    frame.vuDb.fill(valueDb);
+    frame.peakHoldDb.fill(valueDb);
+    levels_.publish(frame);
+
+    peakHold_.reset(valueDb);
+    framesProcessed_ = 0;
+    idle_.wake();
+}
 
 QList<AudioCapture::DeviceInfo> AudioCapture::enumerateInputDevices() {
     QList<DeviceInfo> result;
@@ -488,7 +853,6 @@ void AudioCapture::audioInputCallback(void* inUserData,
                                       const void* inStartTime,
                                       unsigned int inNumberPacketDescriptions,
                                       const void* inPacketDescs) {
-    (void)inStartTime;
     (void)inNumberPacketDescriptions;
     (void)inPacketDescs;
 
@@ -497,65 +861,151 @@ void AudioCapture::audioInputCallback(void* inUserData,
     if (!self->running_.load(std::memory_order_relaxed)) {
         return;
     }
+    VuScopedTimer timer(VuStage::Capture);
+    vuMetrics().add(VuCounter::CaptureBuffers);
 
     AudioQueueBufferRef buffer = reinterpret_cast<AudioQueueBufferRef>(inBuffer);
 
     const float* data = static_cast<const float*>(buffer->mAudioData);
-    const unsigned int frames = buffer->mAudioDataByteSize / (2 * sizeof(float)); // stereo
-
-    self->processAudioBuffer(data, frames, 2, static_cast<float>(self->options_.sampleRate));
+    const unsigned int frames = buffer->mAudioDataByteSize / (self->captureChannels_ * sizeof(float));
+
+    // Only copy the raw frames here; the DSP worker runs the metering pipeline.
+    // An idle source's quiet blocks are dropped here without waking the worker.
+    if (self->admitBlock(self->idle_,
+                         0,
+                         data,
+                         frames,
+                         self->captureChannels_,
+                         static_cast<float>(self->options_.sampleRate))) {
+        self->dspWorker_.push(data, frames);
+    }
+    self->noteBufferAfterSwitch();
+
+    // The start time stamps the buffer's first sample, so its age now covers
+    // the device's input latency plus the buffer itself
+    const auto* startTime = static_cast<const AudioTimeStamp*>(inStartTime);
+    if (startTime && (startTime->mFlags & kAudioTimeStampHostTimeValid)) {
+        const UInt64 now = AudioGetCurrentHostTime();
+        if (now >= startTime->mHostTime) {
+            const UInt64 ageNs = AudioConvertHostTimeToNanos(now - startTime->mHostTime);
+            self->streamLatencyMs_.store(static_cast<double>(ageNs) * 1e-6, std::memory_order_relaxed);
+        }
+    }
 
     // Re-enqueue the buffer
     AudioQueueEnqueueBuffer(inAQ, buffer, 0, nullptr);
 }
 
 void AudioCapture::processAudioBuffer(const float* data, unsigned int frames, unsigned int channels, float sampleRate) {
-    VuReferenceOptions ref;
-    ref.referenceDbfs = options_.referenceDbfs;
-    ref.referenceDbfsOverride = options_.referenceDbfsOverride;
-    ref.deviceType = options_.deviceType;
-
-    VuAudioDspState dspState;
-    dspState.prevL = prevL_;
-    dspState.prevR = prevR_;
-    dspState.rmsL_smooth = rmsL_smooth_;
-    dspState.rmsR_smooth = rmsR_smooth_;
-    dspState.meterAwake = meterAwake_;
-
-    float vuL = kMinVu;
-    float vuR = kMinVu;
-    processInterleavedFloatAudioToVuDb(data,
-                                        frames,
-                                        channels,
-                                        sampleRate,
-                                        ref,
-                                        ballisticsL_,
-                                        ballisticsR_,
-                                        dspState,
-                                        kMinVu,
-                                        kMaxVu,
-                                        vuL,
-                                        vuR);
-
-    prevL_ = dspState.prevL;
-    prevR_ = dspState.prevR;
-    rmsL_smooth_ = dspState.rmsL_smooth;
-    rmsR_smooth_ = dspState.rmsR_smooth;
-    meterAwake_ = dspState.meterAwake;
-
-    leftVuDb_.store(vuL, std::memory_order_relaxed);
-    rightVuDb_.store(vuR, std::memory_order_relaxed);
+    spectrum_.push(data, frames, channels, sampleRate);
+    meterBlock({*dspState_,
+                ballistics_,
+                peakHold_,
+                framesProcessed_,
+                levels_,
+                *detectorState_,
+                loudnessResetsSeen_,
+                idle_,
+                history_,
+                0},
+               options_.deviceType,
+               data,
+               frames,
+               channels,
+               sampleRate);
+}
+
+void AudioCapture::meterBlock(MeterState state,
+                              int deviceType,
+                              const float* data,
+                              unsigned int frames,
+                              unsigned int channels,
+                              float sampleRate) {
+    // Lock-free; the block stays valid until the next acquire on this thread
+    const VuCalibration& ref = acquireCalibration().forDevice(deviceType);
+
+    const VuNeedleSource needle = needleSource_.load(std::memory_order_relaxed);
+    VuDetectorOptions detectors = detectors_.load(std::memory_order_relaxed);
+    detectors.enableFor(needle);
+    if (detectors.any()) {
+        const std::uint32_t resets = loudnessResets_.load(std::memory_order_relaxed);
+        if (resets != state.loudnessResetsSeen) {
+            state.loudnessResetsSeen = resets;
+            vuResetLoudness(state.detectors);
+        }
+    }
+
+    // One pass: each chunk goes through the VU integrator and the broadcast
+    // detectors while it is in L1
+    for (unsigned int pos = 0; pos < frames; pos += kVuDetectorChunkFrames) {
+        const unsigned int n = std::min(kVuDetectorChunkFrames, frames - pos);
+        const float* chunk = data + static_cast<std::size_t>(pos) * channels;
+        vuAccumulateInterleavedFloatAudio(chunk, n, channels, sampleRate, ref, state.ballistics, state.dsp);
+        if (detectors.any()) {
+            processInterleavedFloatAudioDetectors(chunk, n, channels, sampleRate, detectors, state.detectors);
+        }
+    }
+
+    std::array<float, kVuMaxChannels> vu;
+    vu.fill(kMinVu);
+    vuFinishInterleavedFloatAudio(sampleRate, ref, state.ballistics, state.dsp, kMinVu, kMaxVu, vu.data());
+
+    if (detectors.any()) {
+        if (needle != VuNeedleSource::Vu) {
+            const unsigned int metered = std::min(channels, kVuMaxChannels);
+            for (unsigned int c = 0; c < metered; ++c) {
+                const float reading = vuNeedleReading(state.detectors.readings, needle, c);
+                vu[c] = std::clamp(reading - ref.referenceDbfs, kMinVu, kMaxVu);
+            }
+        }
+    }
+
+    VuLevelFrame frame;
+    frame.channels = std::min(channels, kVuMaxChannels);
+    std::copy_n(vu.begin(), frame.channels, frame.vuDb.begin());
+    state.peakHold.update(vu.data(), frame.channels, frames, sampleRate, frame.peakHoldDb.data());
+
+    if (detectors.any()) {
+        const VuDetectorReadings& readings = state.detectors.readings;
+        frame.truePeakDbtp = readings.truePeakDbtp;
+        frame.ppmDbfs = readings.ppmDbfs;
+        frame.maxTruePeakDbtp = readings.maxTruePeakDbtp;
+        frame.momentaryLufs = readings.momentaryLufs;
+        frame.shortTermLufs = readings.shortTermLufs;
+        frame.integratedLufs = readings.integratedLufs;
+    }
+
+    state.framesProcessed += frames;
+    frame.frameCounter = state.framesProcessed + state.idle.droppedFrames();
+
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    frame.timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+
+    state.levels.publish(frame);
+    state.history.push(frame, frames, sampleRate);
+
+    const VuIdleMonitor::Transition idle = state.idle.noteMetered(
+        data, frames, channels, sampleRate, frame.vuDb.data(), frame.peakHoldDb.data(), frame.channels);
+    if (idle != VuIdleMonitor::Transition::None) {
+        emit sourceIdleChanged(state.sourceIndex, idle == VuIdleMonitor::Transition::WentIdle);
+    }
 }
 
 void AudioCapture::loadReferenceLevels() {
-    QSettings settings;
-    settings.beginGroup("AudioCapture");
-    options_.microphoneReferenceDbfs = settings.value("microphoneReferenceDbfs", 0.0).toDouble();
-    options_.monitorReferenceDbfs = settings.value("monitorReferenceDbfs", -14.0).toDouble();
-    settings.endGroup();
+    if (options_.persistReferenceLevels) {
+        QSettings settings;
+        settings.beginGroup("AudioCapture");
+        options_.microphoneReferenceDbfs = settings.value("microphoneReferenceDbfs", 0.0).toDouble();
+        options_.monitorReferenceDbfs = settings.value("monitorReferenceDbfs", -14.0).toDouble();
+        settings.endGroup();
+    }
+    publishCalibration();
 }
 
 void AudioCapture::saveReferenceLevels() {
+    if (!options_.persistReferenceLevels) {
+        return;
+    }
     QSettings settings;
     settings.beginGroup("AudioCapture");
     settings.setValue("microphoneReferenceDbfs", options_.microphoneReferenceDbfs);
@@ -563,4 +1013,29 @@ void AudioCapture::saveReferenceLevels() {
     settings.endGroup();
 }
 
+void AudioCapture::publishCalibration() {
+    VuReferenceOptions ref;
+    ref.referenceDbfs = options_.referenceDbfs;
+    ref.referenceDbfsOverride = options_.referenceDbfsOverride;
+
+    Calibration block;
+    ref.deviceType = 1;
+    block.microphone = vuCalibration(ref);
+    ref.deviceType = 0;
+    block.monitor = vuCalibration(ref);
+
+    const Calibration* current = calibration_.load();
+    if (current && *current == block) {
+        return;
+    }
+    const Calibration* inUse = calibrationInUse_.load();
+    for (Calibration& slot : calibrationSlots_) {
+        if (&slot != current && &slot != inUse) {
+            slot = block;
+            calibration_.store(&slot);
+            return;
+        }
+    }
+}
+
 #endif // __APPLE__
@@ -0,0 +1,133 @@
+#include "DiagnosticsDialog.h"
+
+#include <QClipboard>
+#include <QDialogButtonBox>
+#include <QFontDatabase>
+#include <QGuiApplication>
+#include <QPlainTextEdit>
+#include <QPushButton>
+#include <QScrollBar>
+#include <QVBoxLayout>
+
+#include "AudioCapture.h"
+#include "VuMetrics.h"
+
+static QString formatUs(double ns) {
+    return QString::number(ns * 1e-3, 'f', 1);
+}
+
+DiagnosticsDialog::DiagnosticsDialog(const AudioCapture* audio, QWidget* parent) : QDialog(parent), audio_(audio) {
+    setWindowTitle(tr("Diagnostics"));
+
+    text_ = new QPlainTextEdit(this);
+    text_->setReadOnly(true);
+    text_->setLineWrapMode(QPlainTextEdit::NoWrap);
+    text_->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    text_->setMinimumSize(640, 420);
+
+    auto* buttons = new QDialogButtonBox(QDialogButtonBox::Close, this);
+    QPushButton* resetButton = buttons->addButton(tr("Reset"), QDialogButtonBox::ResetRole);
+    QPushButton* copyButton = buttons->addButton(tr("Copy JSON"), QDialogButtonBox::ActionRole);
+    connect(buttons, &QDialogButtonBox::rejected, this, &QDialog::close);
+    connect(resetButton, &QPushButton::clicked, this, [this]() {
+        vuMetrics().reset();
+        refresh();
+    });
+    connect(copyButton, &QPushButton::clicked, this, &DiagnosticsDialog::copyJson);
+
+    auto* layout = new QVBoxLayout(this);
+    layout->addWidget(text_);
+    layout->addWidget(buttons);
+
+    refreshTimer_.setInterval(kRefreshIntervalMs);
+    refreshTimer_.setTimerType(Qt::CoarseTimer);
+    connect(&refreshTimer_, &QTimer::timeout, this, &DiagnosticsDialog::refresh);
+}
+
+void DiagnosticsDialog::showEvent(QShowEvent* event) {
+    QDialog::showEvent(event);
+    refresh();
+    refreshTimer_.start();
+}
+
+void DiagnosticsDialog::hideEvent(QHideEvent* event) {
+    refreshTimer_.stop();
+    QDialog::hideEvent(event);
+}
+
+void DiagnosticsDialog::refresh() {
+    const VuMetricsSnapshot m = vuMetrics().snapshot();
+    QString out;
+
+    out += tr("Uptime %1 s\n\n").arg(m.uptimeSeconds, 0, 'f', 1);
+
+    out += QStringLiteral("%1 %2 %3 %4 %5 %6 %7 %8\n")
+               .arg(QStringLiteral("stage (us)"), -16)
+               .arg(QStringLiteral("count"), 10)
+               .arg(QStringLiteral("mean"), 9)
+               .arg(QStringLiteral("p50"), 9)
+               .arg(QStringLiteral("p90"), 9)
+               .arg(QStringLiteral("p99"), 9)
+               .arg(QStringLiteral("p99.9"), 9)
+               .arg(QStringLiteral("max"), 9);
+    for (std::size_t i = 0; i < kVuStageCount; ++i) {
+        const VuStageStats& s = m.stages[i];
+        out += QStringLiteral("%1 %2 %3 %4 %5 %6 %7 %8\n")
+                   .arg(QString::fromLatin1(vuStageName(static_cast<VuStage>(i))), -16)
+                   .arg(s.count, 10)
+                   .arg(formatUs(s.meanNs), 9)
+                   .arg(formatUs(static_cast<double>(s.p50Ns)), 9)
+                   .arg(formatUs(static_cast<double>(s.p90Ns)), 9)
+                   .arg(formatUs(static_cast<double>(s.p99Ns)), 9)
+                   .arg(formatUs(static_cast<double>(s.p999Ns)), 9)
+                   .arg(formatUs(static_cast<double>(s.maxNs)), 9);
+    }
+
+    out += QStringLiteral("\n");
+    for (std::size_t i = 0; i < kVuCounterCount; ++i) {
+        out += QStringLiteral("%1 %2\n")
+                   .arg(QString::fromLatin1(vuCounterName(static_cast<VuCounter>(i))), -20)
+                   .arg(m.counters[i], 10);
+    }
+
+    if (audio_) {
+        const VuDspWorker::Stats ring = audio_->dspRingStats();
+        out += tr("\nDSP ring: %1 of %2 frames, high water %3, %4 overruns (%5 frames)\n")
+                   .arg(ring.fillFrames)
+                   .arg(ring.capacityFrames)
+                   .arg(ring.highWaterFrames)
+                   .arg(ring.overruns)
+                   .arg(ring.droppedFrames);
+
+        const AudioCapture::LatencyStats latency = audio_->latency();
+        out += tr("Latency: fragment %1 ms, stream %2, ring %3 ms, total %4 ms\n")
+                   .arg(latency.fragmentMs, 0, 'f', 1)
+                   .arg(latency.streamMs >= 0.0 ? tr("%1 ms").arg(latency.streamMs, 0, 'f', 1) : tr("n/a"))
+                   .arg(latency.ringMs, 0, 'f', 1)
+                   .arg(latency.totalMs(), 0, 'f', 1);
+        if (audio_->lastSwitchLatencyMs() >= 0.0) {
+            out += tr("Last device switch: %1 ms\n").arg(audio_->lastSwitchLatencyMs(), 0, 'f', 1);
+        }
+
+        for (int i = 0; i < audio_->sourceCount(); ++i) {
+            const VuIdleMonitor::Residency r = audio_->idleResidency(i);
+            out += tr("Source %1 (%2): %3, idle %4 s, settling %5 s, active %6 s, %7 wakeups\n")
+                       .arg(i)
+                       .arg(audio_->sourceDeviceUID(i).isEmpty() ? tr("default") : audio_->sourceDeviceUID(i))
+                       .arg(QString::fromLatin1(vuIdleStateName(audio_->idleState(i))))
+                       .arg(r.seconds[static_cast<int>(VuIdleState::Idle)], 0, 'f', 1)
+                       .arg(r.seconds[static_cast<int>(VuIdleState::Settling)], 0, 'f', 1)
+                       .arg(r.seconds[static_cast<int>(VuIdleState::Active)], 0, 'f', 1)
+                       .arg(r.wakeups);
+        }
+    }
+
+    // Keep the scroll position across refreshes
+    const int scroll = text_->verticalScrollBar()->value();
+    text_->setPlainText(out);
+    text_->verticalScrollBar()->setValue(scroll);
+}
+
+void DiagnosticsDialog::copyJson() {
+    QGuiApplication::clipboard()->setText(QString::fromStdString(vuMetricsJson(vuMetrics().snapshot())));
+}
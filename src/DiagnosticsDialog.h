@@ -0,0 +1,33 @@
+#pragma once
+
+#include <QDialog>
+#include <QTimer>
+
+class AudioCapture;
+class QPlainTextEdit;
+
+// Live view of vuMetrics() and the capture's own counters, for tracking down
+// stutter: per-stage latency percentiles, ring overruns, server overflows and
+// missed display frames. Hidden from the menus; MainWindow opens it with
+// Ctrl+Shift+D. Refreshes twice a second while shown.
+class DiagnosticsDialog final : public QDialog {
+    Q_OBJECT
+
+  public:
+    static constexpr int kRefreshIntervalMs = 500;
+
+    // audio must outlive the dialog
+    explicit DiagnosticsDialog(const AudioCapture* audio, QWidget* parent = nullptr);
+
+  protected:
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
+
+  private:
+    void refresh();
+    void copyJson();
+
+    const AudioCapture* audio_ = nullptr;
+    QPlainTextEdit* text_ = nullptr;
+    QTimer refreshTimer_;
+};
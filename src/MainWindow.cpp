@@ -3,31 +3,63 @@
 #include <QCloseEvent>
 #include <QDebug>
 #include <QFileDialog>
+#include <QFileInfo>
+#include <QGridLayout>
+#include <QGuiApplication>
 #include <QMenu>
 #include <QMenuBar>
 #include <QMessageBox>
-#include <QTimer>
+#include <QSettings>
+#include <QShortcut>
 
 #if defined(ANALOGVU_HAS_LIBZIP) && (ANALOGVU_HAS_LIBZIP == 1)
 #include "SkinImporter.h"
 #endif
 
+#include "DiagnosticsDialog.h"
+#include "SkinLoader.h"
 #include "StereoVUMeterWidget.h"
+#include "VUFrameScheduler.h"
 #include "version.h"
 
-MainWindow::MainWindow(const AudioCapture::Options& options, QWidget* parent)
+#include <cmath>
+
+// One snapshot, so L/R and the timestamp always belong together
+static VUFrameScheduler::Sample schedulerSample(const VuLevelFrame& levels) {
+    VUFrameScheduler::Sample sample;
+    sample.timestampNs = levels.timestampNs;
+    sample.leftVuDb = levels.leftVuDb();
+    sample.rightVuDb = levels.rightVuDb();
+    return sample;
+}
+
+MainWindow::MainWindow(const AudioCapture::Options& options, const DisplayOptions& display, QWidget* parent)
     : QMainWindow(parent), audio_(options) {
     setWindowTitle(tr("Analog VU Meter"));
+    importPool_.setMaxThreadCount(1);
     meter_ = new StereoVUMeterWidget();
-    setCentralWidget(meter_);
+    meter_->setNeedleAtlasEnabled(display.needleAtlas);
+    createSourceMeters(display);
 
     // Connect device change signal to refresh menus
     connect(&audio_, &AudioCapture::deviceChanged, this, &MainWindow::refreshDeviceMenu);
     connect(&audio_, &AudioCapture::deviceChanged, this, &MainWindow::refreshReferenceMenu);
+    // Hot swaps complete on the audio thread; a failure leaves the old device running
+    connect(&audio_, &AudioCapture::deviceSwitchFailed, this, &MainWindow::onDeviceSwitchFailed);
+    // Hot-plug and default-device changes; queued when emitted by the audio thread
+    connect(&audio_, &AudioCapture::devicesChanged, this, &MainWindow::populateDeviceMenu);
+
+    skinLoader_ = new SkinLoader(&skinManager_, this);
+    connect(skinLoader_, &SkinLoader::loaded, this, &MainWindow::onSkinLoaded);
+
+    // Deliberately not in the menus: a support tool for stutter reports
+    auto* diagnosticsShortcut = new QShortcut(QKeySequence(tr("Ctrl+Shift+D")), this);
+    connect(diagnosticsShortcut, &QShortcut::activated, this, &MainWindow::showDiagnostics);
 
     // Create the menu bar
     createMenuBar();
     loadStylePreference();
+    prefetchNeighbourSkins(skinManager_.activeSkinId());
 
     QString err;
     if (!audio_.start(&err)) {
@@ -38,14 +70,86 @@ MainWindow::MainWindow(const AudioCapture::Options& options, QWidget* parent)
             QString("Audio initialization failed: %1\n\nThe VU meter will be displayed but won't show audio levels.")
                 .arg(err));
     }
-    auto* timer = new QTimer(this);
-    timer->setTimerType(Qt::PreciseTimer);
-    timer->setInterval(16);
-    connect(timer, &QTimer::timeout, this, [this]() { meter_->setLevels(audio_.leftVuDb(), audio_.rightVuDb()); });
-    timer->start();
+
+    // Repaint on the display's refresh instead of a fixed 16 ms timer
+    frameScheduler_ = new VUFrameScheduler(this, [this]() { return schedulerSample(audio_.levels()); }, this);
+    connect(frameScheduler_, &VUFrameScheduler::frame, meter_, &StereoVUMeterWidget::setLevels);
+    frameScheduler_->start();
+
+    // The extra meters' schedulers tick on the same window: Qt coalesces
+    // requestUpdate(), so every meter is updated from one UpdateRequest per
+    // display frame and painted in the same backing store flush.
+    for (int i = 0; i < sourceMeters_.size(); ++i) {
+        const int source = i + 1;
+        auto* scheduler =
+            new VUFrameScheduler(this, [this, source]() { return schedulerSample(audio_.sourceLevels(source)); }, this);
+        connect(scheduler, &VUFrameScheduler::frame, sourceMeters_[i], &StereoVUMeterWidget::setLevels);
+        scheduler->start();
+        sourceSchedulers_.append(scheduler);
+    }
+
+    // An idle source publishes nothing, so its meter stops polling as well
+    connect(&audio_, &AudioCapture::sourceIdleChanged, this, [this](int source, bool idle) {
+        VUFrameScheduler* scheduler = (source == 0) ? frameScheduler_ : sourceSchedulers_.value(source - 1);
+        if (scheduler) {
+            scheduler->setInputIdle(idle);
+        }
+    });
+}
+
+void MainWindow::createSourceMeters(const DisplayOptions& display) {
+    const int count = audio_.sourceCount();
+    if (count <= 1) {
+        setCentralWidget(meter_);
+        return;
+    }
+
+    // Near-square grid, filled row by row with the primary device first
+    auto* grid = new QWidget();
+    auto* layout = new QGridLayout(grid);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->setSpacing(2);
+
+    const int columns = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count))));
+    for (int i = 0; i < count; ++i) {
+        StereoVUMeterWidget* w = meter_;
+        if (i > 0) {
+            w = new StereoVUMeterWidget();
+            w->setNeedleAtlasEnabled(display.needleAtlas);
+            sourceMeters_.append(w);
+        }
+        w->setToolTip(audio_.sourceDeviceUID(i));
+        layout->addWidget(w, i / columns, i % columns);
+    }
+
+    setCentralWidget(grid);
+}
+
+void MainWindow::syncSourceMeters() {
+    const VUMeterStyle style = meter_->style();
+    const bool customSkin = style == VUMeterStyle::Skin && !skinManager_.activeSkinId().isEmpty();
+
+    for (StereoVUMeterWidget* w : sourceMeters_) {
+        // Pixmaps are implicitly shared, so every meter uses the same images
+        if (customSkin) {
+            w->setSkinPackage(meter_->skinPackage());
+        } else {
+            w->clearSkin();
+        }
+        w->setStyle(style);
+    }
 }
 
-MainWindow::~MainWindow() { audio_.stop(); }
+MainWindow::~MainWindow() {
+    // A folder import writes into the skin directory; let it finish
+    importPool_.waitForDone();
+
+    // Its workers use skinManager_, which is destroyed before child objects
+    delete skinLoader_;
+    skinLoader_ = nullptr;
+
+    audio_.stop();
+}
 
 void MainWindow::closeEvent(QCloseEvent* event) {
     audio_.stop();
@@ -80,10 +184,38 @@ void MainWindow::createMenuBar() {
     // Populate the reference menu
     populateReferenceMenu();
 
+    // Capture Latency submenu: buffering profile plus the measured latency,
+    // refreshed each time the menu opens
+    latencyMenu_ = audioMenu_->addMenu(tr("Capture &Latency"));
+
+    latencyActionGroup_ = new QActionGroup(this);
+    latencyActionGroup_->setExclusive(true);
+    connect(latencyActionGroup_, &QActionGroup::triggered, this, &MainWindow::onLatencyProfileSelected);
+    connect(latencyMenu_, &QMenu::aboutToShow, this, &MainWindow::updateLatencyReadout);
+
+    populateLatencyMenu();
+
+    // Needle submenu: the detector the needles follow, plus the programme
+    // loudness so far
+    needleMenu_ = audioMenu_->addMenu(tr("&Needle"));
+
+    needleActionGroup_ = new QActionGroup(this);
+    needleActionGroup_->setExclusive(true);
+    connect(needleActionGroup_, &QActionGroup::triggered, this, &MainWindow::onNeedleSourceSelected);
+    connect(needleMenu_, &QMenu::aboutToShow, this, &MainWindow::updateLoudnessReadout);
+
+    populateNeedleMenu();
+
     // Add separator and refresh action
     audioMenu_->addSeparator();
     QAction* refreshAction = audioMenu_->addAction(tr("&Refresh Devices"));
-    connect(refreshAction, &QAction::triggered, this, &MainWindow::refreshDeviceMenu);
+    connect(refreshAction, &QAction::triggered, &audio_, &AudioCapture::refreshDevices);
+
+    // Time spent idle on silence since startup, refreshed when the menu opens
+    idleReadoutAction_ = audioMenu_->addAction(QString());
+    idleReadoutAction_->setEnabled(false);
+    connect(audioMenu_, &QMenu::aboutToShow, this, &MainWindow::updateIdleReadout);
+    updateIdleReadout();
 
     // Style menu
     styleMenu_ = menuBar->addMenu(tr("&Style"));
@@ -102,6 +234,36 @@ void MainWindow::createMenuBar() {
     skinManager_.scan();
     populateStyleMenu();
 
+    styleMenu_->addSeparator();
+    rendererMenu_ = styleMenu_->addMenu(tr("&Renderer"));
+
+    rendererActionGroup_ = new QActionGroup(this);
+    rendererActionGroup_->setExclusive(true);
+    connect(rendererActionGroup_, &QActionGroup::triggered, this, &MainWindow::onRendererSelected);
+
+    // Keep the menu in sync when the GL surface falls back on its own
+    connect(meter_, &StereoVUMeterWidget::renderBackendChanged, this, &MainWindow::populateRendererMenu);
+
+    populateRendererMenu();
+
+    // Strip under the meters; the spectrum only follows the primary source
+    overlayMenu_ = styleMenu_->addMenu(tr("&Overlay"));
+    historyStripAction_ = overlayMenu_->addAction(tr("Level &History"));
+    historyStripAction_->setCheckable(true);
+    spectrumStripAction_ = overlayMenu_->addAction(tr("S&pectrum"));
+    spectrumStripAction_->setCheckable(true);
+    connect(historyStripAction_, &QAction::toggled, this, &MainWindow::onOverlayToggled);
+    connect(spectrumStripAction_, &QAction::toggled, this, &MainWindow::onOverlayToggled);
+
+    {
+        QSettings settings;
+        const QSignalBlocker blockHistory(historyStripAction_);
+        const QSignalBlocker blockSpectrum(spectrumStripAction_);
+        historyStripAction_->setChecked(settings.value("Appearance/historyStrip", false).toBool());
+        spectrumStripAction_->setChecked(settings.value("Appearance/spectrumStrip", false).toBool());
+    }
+    applyOverlayPanels();
+
     // About action - Qt automatically moves this to the app menu on macOS
     QAction* aboutAction = new QAction(tr("About Analog VU Meter"), this);
     aboutAction->setMenuRole(QAction::AboutRole);
@@ -109,6 +271,15 @@ void MainWindow::createMenuBar() {
     audioMenu_->addAction(aboutAction);
 }
 
+void MainWindow::showDiagnostics() {
+    if (!diagnostics_) {
+        diagnostics_ = new DiagnosticsDialog(&audio_, this);
+    }
+    diagnostics_->show();
+    diagnostics_->raise();
+    diagnostics_->activateWindow();
+}
+
 void MainWindow::showAbout() {
     QMessageBox::about(this,
                        tr("About Analog VU Meter"),
@@ -135,8 +306,8 @@ void MainWindow::populateDeviceMenu() {
     // Clear the menu itself
     deviceMenu_->clear();
 
-    // Get list of input devices
-    QList<AudioCapture::DeviceInfo> devices = AudioCapture::enumerateInputDevices();
+    // Cached by AudioCapture; no server round trip here
+    const QList<AudioCapture::DeviceInfo> devices = audio_.devices();
 
     QString currentUID = audio_.currentDeviceUID();
 
@@ -211,6 +382,114 @@ void MainWindow::populateReferenceMenu() {
     }
 }
 
+void MainWindow::populateLatencyMenu() {
+    struct ProfileInfo {
+        AudioCapture::LatencyProfile profile;
+        QString name;
+    };
+    const ProfileInfo profiles[] = {
+        {AudioCapture::LatencyProfile::LowLatency, tr("Low Latency (5 ms)")},
+        {AudioCapture::LatencyProfile::Balanced, tr("Balanced (10 ms)")},
+        {AudioCapture::LatencyProfile::PowerSaver, tr("Power Saver (50 ms)")},
+    };
+
+    for (const ProfileInfo& info : profiles) {
+        QAction* action = latencyMenu_->addAction(info.name);
+        action->setCheckable(true);
+        action->setData(static_cast<int>(info.profile));
+        action->setChecked(info.profile == audio_.latencyProfile());
+        latencyActionGroup_->addAction(action);
+    }
+
+    latencyMenu_->addSeparator();
+    latencyReadoutAction_ = latencyMenu_->addAction(QString());
+    latencyReadoutAction_->setEnabled(false);
+    updateLatencyReadout();
+}
+
+void MainWindow::updateLatencyReadout() {
+    const AudioCapture::LatencyStats stats = audio_.latency();
+    if (stats.streamMs < 0.0) {
+        latencyReadoutAction_->setText(tr("Measured: waiting for audio"));
+        return;
+    }
+    latencyReadoutAction_->setText(tr("Measured: %1 ms (stream %2 + queue %3)")
+                                       .arg(stats.totalMs(), 0, 'f', 1)
+                                       .arg(stats.streamMs, 0, 'f', 1)
+                                       .arg(stats.ringMs, 0, 'f', 1));
+}
+
+void MainWindow::populateNeedleMenu() {
+    struct SourceInfo {
+        VuNeedleSource source;
+        QString name;
+    };
+    const SourceInfo sources[] = {
+        {VuNeedleSource::Vu, tr("VU")},
+        {VuNeedleSource::Ppm, tr("PPM")},
+        {VuNeedleSource::TruePeak, tr("True Peak")},
+        {VuNeedleSource::MomentaryLoudness, tr("Momentary Loudness")},
+        {VuNeedleSource::ShortTermLoudness, tr("Short-term Loudness")},
+    };
+
+    for (const SourceInfo& info : sources) {
+        QAction* action = needleMenu_->addAction(info.name);
+        action->setCheckable(true);
+        action->setData(static_cast<int>(info.source));
+        action->setChecked(info.source == audio_.needleSource());
+        needleActionGroup_->addAction(action);
+    }
+
+    needleMenu_->addSeparator();
+    loudnessReadoutAction_ = needleMenu_->addAction(QString());
+    loudnessReadoutAction_->setEnabled(false);
+    QAction* resetAction = needleMenu_->addAction(tr("&Reset Loudness"));
+    connect(resetAction, &QAction::triggered, &audio_, &AudioCapture::resetLoudness);
+    updateLoudnessReadout();
+}
+
+void MainWindow::updateLoudnessReadout() {
+    const VuLevelFrame frame = audio_.levels();
+    if (frame.integratedLufs <= kVuDetectorFloorDb) {
+        loudnessReadoutAction_->setText(tr("Integrated: not measured"));
+        return;
+    }
+    QString text = tr("Integrated: %1 LUFS").arg(frame.integratedLufs, 0, 'f', 1);
+    if (frame.maxTruePeakDbtp > kVuDetectorFloorDb) {
+        text += tr(", true peak %1 dBTP").arg(frame.maxTruePeakDbtp, 0, 'f', 1);
+    }
+    loudnessReadoutAction_->setText(text);
+}
+
+void MainWindow::updateIdleReadout() {
+    const VuIdleMonitor::Residency r = audio_.idleResidency(0);
+    const double total = r.totalSeconds();
+    if (total <= 0.0) {
+        idleReadoutAction_->setText(tr("Idle: waiting for audio"));
+        return;
+    }
+    const auto percent = [total](double seconds) { return QString::number(100.0 * seconds / total, 'f', 0); };
+    idleReadoutAction_->setText(tr("Idle %1%, settling %2%, active %3% (%4 wakeups)")
+                                    .arg(percent(r.seconds[static_cast<int>(VuIdleState::Idle)]))
+                                    .arg(percent(r.seconds[static_cast<int>(VuIdleState::Settling)]))
+                                    .arg(percent(r.seconds[static_cast<int>(VuIdleState::Active)]))
+                                    .arg(r.wakeups));
+}
+
+void MainWindow::onNeedleSourceSelected(QAction* action) {
+    audio_.setNeedleSource(static_cast<VuNeedleSource>(action->data().toInt()));
+}
+
+void MainWindow::onLatencyProfileSelected(QAction* action) {
+    const auto profile = static_cast<AudioCapture::LatencyProfile>(action->data().toInt());
+
+    QString err;
+    if (!audio_.setLatencyProfile(profile, &err)) {
+        QMessageBox::warning(
+            this, tr("Capture Restart Failed"), tr("Failed to apply %1\n\nError: %2").arg(action->text()).arg(err));
+    }
+}
+
 void MainWindow::onDeviceSelected(QAction* action) {
     QString deviceUID = action->data().toString();
 
@@ -234,6 +513,15 @@ void MainWindow::onDeviceSelected(QAction* action) {
     }
 }
 
+void MainWindow::onDeviceSwitchFailed(const QString& deviceUID, const QString& message) {
+    QMessageBox::warning(this,
+                         tr("Device Switch Failed"),
+                         tr("Failed to switch to device: %1\n\nError: %2").arg(deviceUID).arg(message));
+
+    // Refresh menu to restore correct selection
+    refreshDeviceMenu();
+}
+
 void MainWindow::onReferenceSelected(QAction* action) {
     int referenceDb = action->data().toInt();
     audio_.setReferenceDbfs(static_cast<double>(referenceDb));
@@ -308,8 +596,11 @@ void MainWindow::populateStyleMenu() {
     skinStyleMenu_->addSeparator();
     QAction* importSkinAction = skinStyleMenu_->addAction(tr("Import Skin..."));
     connect(importSkinAction, &QAction::triggered, this, &MainWindow::importSkin);
+    QAction* importFolderAction = skinStyleMenu_->addAction(tr("Import Skin Folder..."));
+    connect(importFolderAction, &QAction::triggered, this, &MainWindow::importSkinFolder);
 #if !defined(ANALOGVU_HAS_LIBZIP) || (ANALOGVU_HAS_LIBZIP == 0)
     importSkinAction->setEnabled(false);
+    importFolderAction->setEnabled(false);
 #endif
 }
 
@@ -324,9 +615,11 @@ void MainWindow::onVectorStyleSelected(QAction* action) {
         skinStyleActionGroup_->checkedAction()->setChecked(false);
     }
 
+    skinLoader_->cancel();
     skinManager_.clearActiveSkin();
     meter_->clearSkin();
     meter_->setStyle(style);
+    syncSourceMeters();
     saveStylePreference();
 }
 
@@ -340,9 +633,11 @@ void MainWindow::onSkinSelected(QAction* action) {
 
     const QString skinId = action->data().toString();
     if (skinId == QStringLiteral("__default__")) {
+        skinLoader_->cancel();
         skinManager_.clearActiveSkin();
         meter_->clearSkin();
         meter_->setStyle(VUMeterStyle::Skin);
+        syncSourceMeters();
         saveStylePreference();
         return;
     }
@@ -350,7 +645,11 @@ void MainWindow::onSkinSelected(QAction* action) {
     if (skinId.isEmpty())
         return;
 
-    const SkinManager::LoadedSkin loaded = skinManager_.loadSkin(skinId);
+    // Decoded on a worker; the current skin keeps rendering until onSkinLoaded()
+    skinLoader_->load(skinId);
+}
+
+void MainWindow::onSkinLoaded(const QString& skinId, const SkinManager::LoadedSkin& loaded) {
     if (!loaded.ok) {
         QMessageBox::warning(this, tr("Skin Load Failed"), loaded.error);
         populateStyleMenu();
@@ -360,7 +659,24 @@ void MainWindow::onSkinSelected(QAction* action) {
     skinManager_.setActiveSkinId(skinId);
     meter_->setSkinPackage(loaded.package);
     meter_->setStyle(VUMeterStyle::Skin);
+    syncSourceMeters();
     saveStylePreference();
+
+    prefetchNeighbourSkins(skinId);
+}
+
+void MainWindow::prefetchNeighbourSkins(const QString& skinId) {
+    // The skins above and below in the Skin menu are the likeliest next picks
+    const QList<SkinManager::SkinInfo> skins = skinManager_.availableSkins();
+    for (qsizetype i = 0; i < skins.size(); ++i) {
+        if (skins[i].id != skinId)
+            continue;
+        if (i > 0)
+            skinLoader_->prefetch(skins[i - 1].id);
+        if (i + 1 < skins.size())
+            skinLoader_->prefetch(skins[i + 1].id);
+        return;
+    }
 }
 
 void MainWindow::importSkin() {
@@ -374,7 +690,7 @@ void MainWindow::importSkin() {
                          tr("Skin import is disabled because libzip was not found at build time."));
     return;
 #else
-    SkinImporter importer;
+    SkinImporter importer(&skinManager_.cache());
     const SkinImporter::ImportResult r = importer.importAimpZip(filePath);
     if (!r.ok) {
         QMessageBox::warning(this, tr("Import Failed"), r.error);
@@ -382,22 +698,155 @@ void MainWindow::importSkin() {
     }
 
     skinManager_.scan();
+    skinLoader_->cancel();
+    skinLoader_->clear();
 
-    const SkinManager::LoadedSkin loaded = skinManager_.loadSkin(r.skinName);
-    if (!loaded.ok) {
-        QMessageBox::warning(this, tr("Skin Load Failed"), loaded.error);
-        populateStyleMenu();
-        return;
-    }
+    // The importer already decoded and cached the images; use them instead of re-reading the PNGs
+    SkinManager::DecodedSkin decoded;
+    decoded.ok = true;
+    decoded.package = r.package;
+    decoded.images = r.images;
+
+    const SkinManager::LoadedSkin loaded = SkinManager::uploadDecodedSkin(std::move(decoded));
 
     skinManager_.setActiveSkinId(r.skinName);
     meter_->setSkinPackage(loaded.package);
     meter_->setStyle(VUMeterStyle::Skin);
+    syncSourceMeters();
     populateStyleMenu();
     saveStylePreference();
 #endif
 }
 
+void MainWindow::importSkinFolder() {
+    if (skinImportRunning_) {
+        QMessageBox::information(this, tr("Import Skins"), tr("A skin import is already running."));
+        return;
+    }
+
+    const QString dirPath = QFileDialog::getExistingDirectory(this, tr("Import AIMP Skins From Folder"));
+    if (dirPath.isEmpty())
+        return;
+
+#if !defined(ANALOGVU_HAS_LIBZIP) || (ANALOGVU_HAS_LIBZIP == 0)
+    QMessageBox::warning(this,
+                         tr("Import Unavailable"),
+                         tr("Skin import is disabled because libzip was not found at build time."));
+    return;
+#else
+    const QStringList zips = SkinImporter::findZipFiles(dirPath);
+    if (zips.isEmpty()) {
+        QMessageBox::information(this, tr("Import Skins"), tr("No ZIP files found in %1").arg(dirPath));
+        return;
+    }
+
+    // Archives are imported and cached on all cores off the GUI thread, so the
+    // meters keep animating; only the menus are updated once the batch is done.
+    // The cache is copied (it is just its directory) so the pool never touches
+    // skinManager_.
+    skinImportRunning_ = true;
+    QGuiApplication::setOverrideCursor(Qt::BusyCursor);
+
+    importPool_.start([this, zips, cache = skinManager_.cache()]() {
+        SkinImporter importer(&cache);
+        QList<SkinImporter::ImportResult> results = importer.importAimpZips(zips);
+        QMetaObject::invokeMethod(
+            this,
+            [this, results = std::move(results)]() {
+                skinManager_.scan();
+                skinLoader_->clear();
+
+                int imported = 0;
+                QStringList failures;
+                for (const SkinImporter::ImportResult& r : results) {
+                    if (!r.ok) {
+                        failures.push_back(
+                            QStringLiteral("%1: %2").arg(QFileInfo(r.zipFilePath).fileName(), r.error));
+                        continue;
+                    }
+                    ++imported;
+                }
+                QGuiApplication::restoreOverrideCursor();
+                skinImportRunning_ = false;
+
+                populateStyleMenu();
+
+                QString summary = tr("Imported %1 of %2 skins.").arg(imported).arg(results.size());
+                if (!failures.isEmpty())
+                    summary += QStringLiteral("\n\n") + failures.join(QStringLiteral("\n"));
+                QMessageBox::information(this, tr("Import Skins"), summary);
+            },
+            Qt::QueuedConnection);
+    });
+#endif
+}
+
+void MainWindow::populateRendererMenu() {
+    if (!rendererMenu_ || !rendererActionGroup_)
+        return;
+
+    for (QAction* a : rendererActionGroup_->actions()) {
+        rendererActionGroup_->removeAction(a);
+    }
+    rendererMenu_->clear();
+
+    struct RendererInfo {
+        QString name;
+        VUMeterRenderBackend backend;
+    };
+
+    const RendererInfo renderers[] = {
+        {tr("Software (QPainter)"), VUMeterRenderBackend::Raster},
+        {tr("GPU (OpenGL)"), VUMeterRenderBackend::OpenGL},
+    };
+
+    for (const RendererInfo& info : renderers) {
+        QAction* action = rendererMenu_->addAction(info.name);
+        action->setCheckable(true);
+        action->setData(static_cast<int>(info.backend));
+        action->setEnabled(StereoVUMeterWidget::isRenderBackendAvailable(info.backend));
+        action->setChecked(info.backend == meter_->renderBackend());
+        rendererActionGroup_->addAction(action);
+    }
+}
+
+void MainWindow::onRendererSelected(QAction* action) {
+    const auto backend = static_cast<VUMeterRenderBackend>(action->data().toInt());
+
+    QString err;
+    if (!meter_->setRenderBackend(backend, &err)) {
+        QMessageBox::warning(this, tr("Renderer"), err);
+        populateRendererMenu();
+        return;
+    }
+
+    QSettings settings;
+    settings.setValue("Appearance/renderer", backend == VUMeterRenderBackend::OpenGL ? "opengl" : "raster");
+}
+
+void MainWindow::onOverlayToggled() {
+    applyOverlayPanels();
+
+    QSettings settings;
+    settings.setValue("Appearance/historyStrip", historyStripAction_->isChecked());
+    settings.setValue("Appearance/spectrumStrip", spectrumStripAction_->isChecked());
+}
+
+void MainWindow::applyOverlayPanels() {
+    const bool history = historyStripAction_->isChecked();
+    const bool spectrum = spectrumStripAction_->isChecked();
+
+    // The analyzer thread only runs while its strip is shown
+    audio_.setSpectrumEnabled(spectrum);
+
+    meter_->setOverlaySources(audio_.sourceHistory(0), &audio_.spectrum());
+    meter_->setOverlayPanels(history, spectrum);
+    for (int i = 0; i < sourceMeters_.size(); ++i) {
+        sourceMeters_[i]->setOverlaySources(audio_.sourceHistory(i + 1), nullptr);
+        sourceMeters_[i]->setOverlayPanels(history, false);
+    }
+}
+
 void MainWindow::saveStylePreference() {
     QSettings settings;
     settings.beginGroup("Appearance");
@@ -453,8 +902,20 @@ void MainWindow::loadStylePreference() {
         meter_->setStyle(style);
     }
 
+    const QString renderer = settings.value("renderer", "raster").toString();
+
     settings.endGroup();
 
-    // Update the menu to reflect the loaded style
+    if (renderer == "opengl") {
+        QString err;
+        if (!meter_->setRenderBackend(VUMeterRenderBackend::OpenGL, &err)) {
+            qDebug() << "OpenGL renderer unavailable:" << err;
+        }
+    }
+
+    syncSourceMeters();
+
+    // Update the menus to reflect the loaded style
     populateStyleMenu();
+    populateRendererMenu();
 }
@@ -1,12 +1,17 @@
 #pragma once
 
 #include <QActionGroup>
+#include <QList>
 #include <QMainWindow>
+#include <QThreadPool>
 
 #include "AudioCapture.h"
 #include "SkinManager.h"
 
+class DiagnosticsDialog;
+class SkinLoader;
 class StereoVUMeterWidget;
+class VUFrameScheduler;
 class QCloseEvent;
 class QMenu;
 class QAction;
@@ -15,44 +20,102 @@ class MainWindow final : public QMainWindow {
     Q_OBJECT
 
   public:
-    explicit MainWindow(const AudioCapture::Options& options, QWidget* parent = nullptr);
+    // Rendering options for the meter widget
+    struct DisplayOptions final {
+        // Skin mode: blit pre-rotated needle sprites instead of rotating per frame
+        bool needleAtlas = false;
+    };
+
+    explicit MainWindow(const AudioCapture::Options& options,
+                        const DisplayOptions& display = DisplayOptions(),
+                        QWidget* parent = nullptr);
     ~MainWindow() override;
 
+    // The capture behind the meters, e.g. for VuLevelExporter
+    const AudioCapture& audio() const { return audio_; }
+
   protected:
     void closeEvent(QCloseEvent* event) override;
 
   private slots:
     void onDeviceSelected(QAction* action);
+    void onDeviceSwitchFailed(const QString& deviceUID, const QString& message);
     void onReferenceSelected(QAction* action);
+    void onLatencyProfileSelected(QAction* action);
+    void onNeedleSourceSelected(QAction* action);
     void onVectorStyleSelected(QAction* action);
     void onSkinSelected(QAction* action);
+    void onSkinLoaded(const QString& skinId, const SkinManager::LoadedSkin& loaded);
+    void onRendererSelected(QAction* action);
+    void onOverlayToggled();
     void importSkin();
+    void importSkinFolder();
     void refreshDeviceMenu();
     void refreshReferenceMenu();
     void showAbout();
+    void showDiagnostics();
 
   private:
     void createMenuBar();
     void populateDeviceMenu();
     void populateReferenceMenu();
+    void populateLatencyMenu();
+    void updateLatencyReadout();
+    void populateNeedleMenu();
+    void updateLoudnessReadout();
+    void updateIdleReadout();
     void populateStyleMenu();
     void saveStylePreference();
     void loadStylePreference();
+    void populateRendererMenu();
+    void applyOverlayPanels();
+    void prefetchNeighbourSkins(const QString& skinId);
+
+    // Grid of meters for AudioCapture's additional sources (sources 1..n)
+    void createSourceMeters(const DisplayOptions& display);
+    void syncSourceMeters();
 
     AudioCapture audio_;
     StereoVUMeterWidget* meter_ = nullptr;
+    VUFrameScheduler* frameScheduler_ = nullptr;
+
+    // Schedulers of sourceMeters_, in the same order
+    QList<VUFrameScheduler*> sourceSchedulers_;
+
+    // One per additional source; they follow meter_'s style and skin
+    QList<StereoVUMeterWidget*> sourceMeters_;
 
     SkinManager skinManager_;
+    SkinLoader* skinLoader_ = nullptr;
+
+    // Runs folder imports off the GUI thread, one batch at a time
+    QThreadPool importPool_;
+    bool skinImportRunning_ = false;
+
+    // Created on first use (Ctrl+Shift+D)
+    DiagnosticsDialog* diagnostics_ = nullptr;
 
     // Menu components
     QMenu* audioMenu_ = nullptr;
     QMenu* deviceMenu_ = nullptr;
     QMenu* referenceMenu_ = nullptr;
+    QMenu* latencyMenu_ = nullptr;
+    QAction* latencyReadoutAction_ = nullptr;
+    QMenu* needleMenu_ = nullptr;
+    QAction* loudnessReadoutAction_ = nullptr;
+    QAction* idleReadoutAction_ = nullptr;
     QMenu* styleMenu_ = nullptr;
     QMenu* vectorStyleMenu_ = nullptr;
     QMenu* skinStyleMenu_ = nullptr;
+    QMenu* rendererMenu_ = nullptr;
+    QMenu* overlayMenu_ = nullptr;
+    QAction* historyStripAction_ = nullptr;
+    QAction* spectrumStripAction_ = nullptr;
     QActionGroup* deviceActionGroup_ = nullptr;
     QActionGroup* referenceActionGroup_ = nullptr;
+    QActionGroup* latencyActionGroup_ = nullptr;
+    QActionGroup* needleActionGroup_ = nullptr;
     QActionGroup* vectorStyleActionGroup_ = nullptr;
     QActionGroup* skinStyleActionGroup_ = nullptr;
+    QActionGroup* rendererActionGroup_ = nullptr;
 };
@@ -0,0 +1,406 @@
+#include "SkinCache.h"
+
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr char kBlobMagic[4] = {'A', 'V', 'S', 'K'};
+constexpr quint32 kManifestMagic = 0x4156534Du; // "AVSM"
+constexpr quint32 kByteOrderMark = 0x01020304u;
+constexpr qsizetype kPixelAlignment = 64;
+
+// Fixed-size part of a blob: header, then one BlobImage per asset, then the
+// QDataStream metadata, then the pixel data.
+struct BlobHeader {
+    char magic[4];
+    quint32 version;
+    quint64 fingerprint;
+    quint32 imageCount;
+    quint32 metaSize;
+    quint32 byteOrderMark;
+    quint32 reserved;
+};
+
+struct BlobImage {
+    qint32 width;
+    qint32 height;
+    qint32 bytesPerLine;
+    qint32 reserved;
+    quint64 offset;
+};
+
+static_assert(sizeof(BlobHeader) == 32);
+static_assert(sizeof(BlobImage) == 24);
+
+quint64 fnv1a(quint64 hash, const void* data, std::size_t size) {
+    const auto* p = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= p[i];
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+constexpr quint64 kFnvOffset = 0xCBF29CE484222325ull;
+
+QStringList assetFileNames(bool isStereo) {
+    if (isStereo) {
+        return {QStringLiteral("L_face.png"),
+                QStringLiteral("L_needle.png"),
+                QStringLiteral("L_cap.png"),
+                QStringLiteral("R_face.png"),
+                QStringLiteral("R_needle.png"),
+                QStringLiteral("R_cap.png")};
+    }
+    return {QStringLiteral("face.png"), QStringLiteral("needle.png"), QStringLiteral("cap.png")};
+}
+
+QList<const VUMeterSkin*> packageMeters(const VUSkinPackage& package) {
+    if (std::holds_alternative<VUSkinSingleMeters>(package.meters)) {
+        return {&std::get<VUSkinSingleMeters>(package.meters).vu};
+    }
+    const VUSkinStereoMeters& stereo = std::get<VUSkinStereoMeters>(package.meters);
+    return {&stereo.left, &stereo.right};
+}
+
+void writeCalibration(QDataStream& ds, const VUMeterCalibration& c) {
+    ds << qint32(c.minAngle) << qint32(c.minLevel) << qint32(c.zeroAngle) << qint32(c.zeroLevel)
+       << qint32(c.maxAngle) << qint32(c.maxLevel) << qint32(c.pivotX) << qint32(c.pivotY)
+       << double(c.mobilityNegative) << double(c.mobilityPositive);
+}
+
+void readCalibration(QDataStream& ds, VUMeterCalibration& c) {
+    qint32 v[8] = {};
+    double mobility[2] = {};
+    for (qint32& x : v) {
+        ds >> x;
+    }
+    ds >> mobility[0] >> mobility[1];
+
+    c.minAngle = v[0];
+    c.minLevel = v[1];
+    c.zeroAngle = v[2];
+    c.zeroLevel = v[3];
+    c.maxAngle = v[4];
+    c.maxLevel = v[5];
+    c.pivotX = v[6];
+    c.pivotY = v[7];
+    c.mobilityNegative = mobility[0];
+    c.mobilityPositive = mobility[1];
+}
+
+// Keeps a blob mapped while any QImage/QPixmap built from it is alive
+struct MappedBlob {
+    QFile file;
+    uchar* data = nullptr;
+
+    ~MappedBlob() {
+        if (data) {
+            file.unmap(data);
+        }
+    }
+};
+
+void releaseMappedBlob(void* info) { delete static_cast<std::shared_ptr<MappedBlob>*>(info); }
+
+} // namespace
+
+SkinCache::SkinCache(const QString& cacheDir) : cacheDir_(cacheDir) {}
+
+QString SkinCache::defaultCacheDir() {
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QStringLiteral("/") +
+           QCoreApplication::applicationName() + QStringLiteral("/skins");
+}
+
+QString SkinCache::blobPath(const QString& id) const { return QDir(cacheDir_).filePath(id + QStringLiteral(".skb")); }
+
+quint64 SkinCache::fileStamp(const QString& path) {
+    const QFileInfo fi(path);
+    if (!fi.exists()) {
+        return 0;
+    }
+    const qint64 size = fi.size();
+    const qint64 mtime = fi.lastModified().toMSecsSinceEpoch();
+
+    quint64 h = fnv1a(kFnvOffset, &size, sizeof(size));
+    return fnv1a(h, &mtime, sizeof(mtime));
+}
+
+quint64 SkinCache::skinFingerprint(const QString& skinDir, bool isStereo) {
+    const QDir dir(skinDir);
+    quint64 h = fnv1a(kFnvOffset, &kVersion, sizeof(kVersion));
+
+    QStringList files = assetFileNames(isStereo);
+    files.prepend(QStringLiteral("skin.json"));
+    for (const QString& name : files) {
+        const quint64 stamp = fileStamp(dir.filePath(name));
+        h = fnv1a(h, &stamp, sizeof(stamp));
+    }
+    return h;
+}
+
+// -------- Manifest --------
+
+QHash<QString, SkinCache::ManifestEntry> SkinCache::readManifest() const {
+    QHash<QString, ManifestEntry> entries;
+
+    QFile f(QDir(cacheDir_).filePath(QStringLiteral("manifest.bin")));
+    if (!f.open(QIODevice::ReadOnly)) {
+        return entries;
+    }
+    const QByteArray data = f.readAll();
+
+    QDataStream ds(data);
+    ds.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint32 count = 0;
+    ds >> magic >> version >> count;
+    if (magic != kManifestMagic || version != kVersion) {
+        return entries;
+    }
+
+    for (quint32 i = 0; i < count && ds.status() == QDataStream::Ok; ++i) {
+        ManifestEntry e;
+        ds >> e.id >> e.name >> e.skinDir >> e.isStereo >> e.jsonStamp;
+        if (ds.status() == QDataStream::Ok) {
+            entries.insert(e.id, e);
+        }
+    }
+
+    if (ds.status() != QDataStream::Ok) {
+        entries.clear();
+    }
+    return entries;
+}
+
+bool SkinCache::writeManifest(const QList<ManifestEntry>& entries, QString* errorOut) const {
+    if (!QDir().mkpath(cacheDir_)) {
+        if (errorOut)
+            *errorOut = QStringLiteral("Cannot create skin cache directory: %1").arg(cacheDir_);
+        return false;
+    }
+
+    QSaveFile f(QDir(cacheDir_).filePath(QStringLiteral("manifest.bin")));
+    if (!f.open(QIODevice::WriteOnly)) {
+        if (errorOut)
+            *errorOut = f.errorString();
+        return false;
+    }
+
+    QDataStream ds(&f);
+    ds.setVersion(QDataStream::Qt_6_0);
+    ds << kManifestMagic << kVersion << quint32(entries.size());
+    for (const ManifestEntry& e : entries) {
+        ds << e.id << e.name << e.skinDir << e.isStereo << e.jsonStamp;
+    }
+
+    if (!f.commit()) {
+        if (errorOut)
+            *errorOut = f.errorString();
+        return false;
+    }
+    return true;
+}
+
+// -------- Package blobs --------
+
+bool SkinCache::storePackage(const QString& id,
+                             quint64 fingerprint,
+                             const VUSkinPackage& package,
+                             const VUSkinImages& images,
+                             QString* errorOut) const {
+    const QList<const VUMeterSkin*> meters = packageMeters(package);
+
+    // Metadata (without image offsets, which follow from its size)
+    QByteArray meta;
+    {
+        QDataStream ds(&meta, QIODevice::WriteOnly);
+        ds.setVersion(QDataStream::Qt_6_0);
+        ds << package.name << package.importedFrom << bool(meters.size() == 2) << quint32(meters.size());
+        for (const VUMeterSkin* m : meters) {
+            writeCalibration(ds, m->calibration);
+            ds << m->scaleTable;
+        }
+    }
+
+    // No-op conversions for images that came from SkinManager's decoder
+    std::vector<QImage> pixels;
+    for (qsizetype i = 0; i < meters.size(); ++i) {
+        const VUMeterImages& m = images.meters[i];
+        for (const QImage* image : {&m.face, &m.needle, &m.cap}) {
+            pixels.push_back(image->convertToFormat(QImage::Format_ARGB32_Premultiplied));
+        }
+    }
+
+    BlobHeader header{};
+    std::memcpy(header.magic, kBlobMagic, sizeof(header.magic));
+    header.version = kVersion;
+    header.fingerprint = fingerprint;
+    header.imageCount = static_cast<quint32>(pixels.size());
+    header.metaSize = static_cast<quint32>(meta.size());
+    header.byteOrderMark = kByteOrderMark;
+
+    auto align = [](qint64 v) { return (v + kPixelAlignment - 1) / kPixelAlignment * kPixelAlignment; };
+
+    std::vector<BlobImage> table(pixels.size());
+    qint64 offset = align(sizeof(BlobHeader) + sizeof(BlobImage) * table.size() + meta.size());
+    for (std::size_t i = 0; i < pixels.size(); ++i) {
+        if (pixels[i].isNull()) {
+            if (errorOut)
+                *errorOut = QStringLiteral("Skin package has a missing image");
+            return false;
+        }
+        table[i] = BlobImage{pixels[i].width(), pixels[i].height(), static_cast<qint32>(pixels[i].bytesPerLine()), 0,
+                             static_cast<quint64>(offset)};
+        offset = align(offset + pixels[i].sizeInBytes());
+    }
+
+    if (!QDir().mkpath(cacheDir_)) {
+        if (errorOut)
+            *errorOut = QStringLiteral("Cannot create skin cache directory: %1").arg(cacheDir_);
+        return false;
+    }
+
+    QSaveFile f(blobPath(id));
+    if (!f.open(QIODevice::WriteOnly)) {
+        if (errorOut)
+            *errorOut = f.errorString();
+        return false;
+    }
+
+    f.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    f.write(reinterpret_cast<const char*>(table.data()), static_cast<qint64>(sizeof(BlobImage) * table.size()));
+    f.write(meta);
+
+    const QByteArray padding(kPixelAlignment, '\0');
+    for (std::size_t i = 0; i < pixels.size(); ++i) {
+        const qint64 gap = static_cast<qint64>(table[i].offset) - f.pos();
+        f.write(padding.constData(), gap);
+        f.write(reinterpret_cast<const char*>(pixels[i].constBits()), pixels[i].sizeInBytes());
+    }
+
+    if (!f.commit()) {
+        if (errorOut)
+            *errorOut = f.errorString();
+        return false;
+    }
+    return true;
+}
+
+bool SkinCache::loadPackage(const QString& id, quint64 fingerprint, VUSkinPackage* out, VUSkinImages* images) const {
+    if (!out || !images) {
+        return false;
+    }
+
+    auto blob = std::make_shared<MappedBlob>();
+    blob->file.setFileName(blobPath(id));
+    if (!blob->file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const qint64 size = blob->file.size();
+    if (size < static_cast<qint64>(sizeof(BlobHeader))) {
+        return false;
+    }
+    blob->data = blob->file.map(0, size);
+    if (!blob->data) {
+        return false;
+    }
+
+    BlobHeader header{};
+    std::memcpy(&header, blob->data, sizeof(header));
+    if (std::memcmp(header.magic, kBlobMagic, sizeof(header.magic)) != 0 || header.version != kVersion ||
+        header.byteOrderMark != kByteOrderMark || header.fingerprint != fingerprint) {
+        return false;
+    }
+
+    const qint64 tableSize = static_cast<qint64>(sizeof(BlobImage)) * header.imageCount;
+    if (static_cast<qint64>(sizeof(BlobHeader)) + tableSize + header.metaSize > size) {
+        return false;
+    }
+
+    std::vector<BlobImage> table(header.imageCount);
+    std::memcpy(table.data(), blob->data + sizeof(BlobHeader), static_cast<std::size_t>(tableSize));
+
+    const QByteArray meta = QByteArray::fromRawData(
+        reinterpret_cast<const char*>(blob->data + sizeof(BlobHeader) + tableSize), header.metaSize);
+    QDataStream ds(meta);
+    ds.setVersion(QDataStream::Qt_6_0);
+
+    VUSkinPackage pkg;
+    bool isStereo = false;
+    quint32 meterCount = 0;
+    ds >> pkg.name >> pkg.importedFrom >> isStereo >> meterCount;
+    if (ds.status() != QDataStream::Ok || meterCount != (isStereo ? 2u : 1u) || header.imageCount != meterCount * 3) {
+        return false;
+    }
+
+    // Wraps one stored image; it keeps the mapping alive via the cleanup hook.
+    // The mapping is read-only, so the image is built on const data: anything
+    // that paints on it detaches to a copy instead of writing to the page.
+    auto mapImage = [&](const BlobImage& bi, QImage* image) {
+        const qint64 bytes = static_cast<qint64>(bi.bytesPerLine) * bi.height;
+        if (bi.width <= 0 || bi.height <= 0 || bi.bytesPerLine < bi.width * 4 ||
+            static_cast<qint64>(bi.offset) + bytes > size || bi.offset % kPixelAlignment != 0) {
+            return false;
+        }
+        *image = QImage(static_cast<const uchar*>(blob->data + bi.offset),
+                        bi.width,
+                        bi.height,
+                        bi.bytesPerLine,
+                        QImage::Format_ARGB32_Premultiplied,
+                        &releaseMappedBlob,
+                        new std::shared_ptr<MappedBlob>(blob));
+        return !image->isNull();
+    };
+
+    VUMeterSkin meters[2];
+    VUSkinImages mapped;
+    for (quint32 i = 0; i < meterCount; ++i) {
+        readCalibration(ds, meters[i].calibration);
+        ds >> meters[i].scaleTable;
+        if (ds.status() != QDataStream::Ok) {
+            return false;
+        }
+        if (!mapImage(table[i * 3 + 0], &mapped.meters[i].face) ||
+            !mapImage(table[i * 3 + 1], &mapped.meters[i].needle) ||
+            !mapImage(table[i * 3 + 2], &mapped.meters[i].cap)) {
+            return false;
+        }
+    }
+
+    if (isStereo) {
+        pkg.meters = VUSkinStereoMeters{meters[0], meters[1]};
+    } else {
+        pkg.meters = VUSkinSingleMeters{meters[0]};
+    }
+
+    *out = pkg;
+    *images = std::move(mapped);
+    return true;
+}
+
+void SkinCache::prune(const QList<QString>& keepIds) const {
+    const QDir dir(cacheDir_);
+    const QStringList blobs = dir.entryList({QStringLiteral("*.skb")}, QDir::Files);
+    for (const QString& name : blobs) {
+        const QString id = name.left(name.size() - 4);
+        if (!keepIds.contains(id)) {
+            QFile::remove(dir.filePath(name));
+        }
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QString>
+
+#include "VUMeterSkin.h"
+
+// Versioned binary cache for installed skins, so start-up and skin switching
+// do not have to parse skin.json or decode PNGs.
+//
+// - manifest.bin: one record per skin directory (id, name, type) keyed by the
+//   size/mtime stamp of its skin.json; SkinManager::scan() reads it in one go
+//   and only parses the JSON of skins whose stamp changed.
+// - <id>.skb: the parsed package plus pre-decoded premultiplied ARGB32 pixels
+//   at 64-byte aligned offsets. Loading maps the file and wraps the pixels in
+//   QImages that point into the mapping (no decode, no copy); the mapping is
+//   released with the last image or pixmap that uses it.
+//
+// Both are invalidated by a fingerprint of the source files' sizes and mtimes,
+// and by kVersion. The cache is machine-local (native byte order).
+class SkinCache {
+  public:
+    static constexpr quint32 kVersion = 1;
+
+    struct ManifestEntry {
+        QString id;
+        QString name;
+        QString skinDir;
+        bool isStereo = false;
+        quint64 jsonStamp = 0;
+    };
+
+    explicit SkinCache(const QString& cacheDir = defaultCacheDir());
+
+    static QString defaultCacheDir();
+    QString cacheDir() const { return cacheDir_; }
+
+    // Empty if the manifest is missing, unreadable or from another version
+    QHash<QString, ManifestEntry> readManifest() const;
+    bool writeManifest(const QList<ManifestEntry>& entries, QString* errorOut = nullptr) const;
+
+    // Size + mtime stamp of one file (0 if missing)
+    static quint64 fileStamp(const QString& path);
+
+    // Stamp over skin.json and every asset file of a skin directory
+    static quint64 skinFingerprint(const QString& skinDir, bool isStereo);
+
+    // Fills out (metadata only, pixmaps left null) and images from <id>.skb if it
+    // exists and matches fingerprint. Safe to call from worker threads.
+    bool loadPackage(const QString& id, quint64 fingerprint, VUSkinPackage* out, VUSkinImages* images) const;
+    bool storePackage(const QString& id,
+                      quint64 fingerprint,
+                      const VUSkinPackage& package,
+                      const VUSkinImages& images,
+                      QString* errorOut = nullptr) const;
+
+    // Deletes blobs whose id is not in keepIds
+    void prune(const QList<QString>& keepIds) const;
+
+  private:
+    QString blobPath(const QString& id) const;
+
+    QString cacheDir_;
+};
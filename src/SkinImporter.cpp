@@ -1,18 +1,20 @@
 #include "SkinImporter.h"
 
 #include "VUMeterScale.h"
-#include "VUMeterSkin.h"
 
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QHash>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
-#include <QMap>
-#include <QSettings>
 #include <QStandardPaths>
-#include <QTemporaryDir>
+#include <QThread>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <vector>
 
 #if defined(ANALOGVU_HAS_LIBZIP) && (ANALOGVU_HAS_LIBZIP == 1)
 #include <zip.h>
@@ -36,175 +38,64 @@ QString sanitizedDirName(const QString& in) {
     return out;
 }
 
-QDir findAimpRootDir(const QDir& extractedRoot) {
-    const QFileInfoList entries = extractedRoot.entryInfoList(QDir::NoDotAndDotDot | QDir::AllEntries);
-    if (entries.size() == 1 && entries[0].isDir()) {
-        return QDir(entries[0].absoluteFilePath());
-    }
-    return extractedRoot;
-}
-
-QMap<QString, QString> lowerNameToActualFile(const QDir& dir) {
-    QMap<QString, QString> map;
-    const QFileInfoList files = dir.entryInfoList(QDir::Files);
-    for (const QFileInfo& fi : files) {
-        map.insert(fi.fileName().toLower(), fi.fileName());
-    }
-    return map;
-}
-
-#if defined(ANALOGVU_HAS_LIBZIP) && (ANALOGVU_HAS_LIBZIP == 1)
-bool isSafeZipEntryPath(const QString& entryName) {
-    if (entryName.isEmpty())
-        return false;
-    if (entryName.startsWith('/') || entryName.startsWith('\\'))
-        return false;
-
-    const QString cleaned = QDir::cleanPath(entryName);
-    if (cleaned == QStringLiteral(".") || cleaned.isEmpty())
-        return false;
-    if (cleaned.startsWith(QStringLiteral("../")) || cleaned == QStringLiteral(".."))
-        return false;
-    if (cleaned.contains(QStringLiteral("/../")))
-        return false;
-
-    // Avoid Windows drive paths like C:\...
-    if (cleaned.size() >= 2 && cleaned[1] == ':')
-        return false;
-
-    return true;
+VUMeterCalibration defaultCalibration() {
+    VUMeterCalibration c;
+    c.minAngle = -47;
+    c.minLevel = -20;
+    c.zeroAngle = 20;
+    c.zeroLevel = 0;
+    c.maxAngle = 47;
+    c.maxLevel = 3;
+    c.pivotX = 310;
+    c.pivotY = 362;
+    c.mobilityNegative = 0.05;
+    c.mobilityPositive = 0.10;
+    return c;
 }
 
-class ZipReader {
-  public:
-    static bool extractAll(const QString& zipFilePath, const QDir& destDir, QString* errorOut) {
-        if (!destDir.exists()) {
-            if (!QDir().mkpath(destDir.absolutePath())) {
-                if (errorOut)
-                    *errorOut = QStringLiteral("Failed to create destination directory: %1").arg(destDir.absolutePath());
-                return false;
-            }
-        }
-
-        int err = 0;
-        zip_t* za = zip_open(zipFilePath.toUtf8().constData(), ZIP_RDONLY, &err);
-        if (!za) {
-            if (errorOut) {
-                zip_error_t ze;
-                zip_error_init_with_code(&ze, err);
-                const QString msg = QString::fromUtf8(zip_error_strerror(&ze));
-                zip_error_fini(&ze);
-                *errorOut = QStringLiteral("Failed to open ZIP: %1 (%2)").arg(zipFilePath, msg);
-            }
-            return false;
-        }
-
-        const zip_int64_t n = zip_get_num_entries(za, 0);
-        for (zip_uint64_t i = 0; i < static_cast<zip_uint64_t>(n); ++i) {
-            zip_stat_t st;
-            if (zip_stat_index(za, i, 0, &st) != 0)
-                continue;
-
-            const QString entryName = QString::fromUtf8(st.name ? st.name : "");
-            if (entryName.isEmpty())
-                continue;
-
-            if (!isSafeZipEntryPath(entryName)) {
-                if (errorOut)
-                    *errorOut = QStringLiteral("Unsafe ZIP entry path: %1").arg(entryName);
-                zip_close(za);
-                return false;
-            }
-
-            const QString outPath = destDir.filePath(entryName);
-            if (entryName.endsWith('/')) {
-                if (!QDir().mkpath(outPath)) {
-                    if (errorOut)
-                        *errorOut = QStringLiteral("Failed to create directory: %1").arg(outPath);
-                    zip_close(za);
-                    return false;
-                }
-                continue;
-            }
+// skin.ini, parsed from memory. Section and key names are matched
+// case-insensitively, as AIMP (a Windows player) does.
+using IniSection = QHash<QString, QString>;
+using IniFile = QHash<QString, IniSection>;
 
-            const QFileInfo outFi(outPath);
-            QDir parentDir = outFi.dir();
-            if (!parentDir.exists()) {
-                if (!QDir().mkpath(parentDir.absolutePath())) {
-                    if (errorOut)
-                        *errorOut = QStringLiteral("Failed to create directory: %1").arg(parentDir.absolutePath());
-                    zip_close(za);
-                    return false;
-                }
-            }
+IniFile parseIni(const QByteArray& data) {
+    IniFile ini;
+    QString section = QStringLiteral("general");
 
-            zip_file_t* zf = zip_fopen_index(za, i, 0);
-            if (!zf) {
-                if (errorOut)
-                    *errorOut = QStringLiteral("Failed to open ZIP entry: %1").arg(entryName);
-                zip_close(za);
-                return false;
-            }
-
-            QFile out(outPath);
-            if (!out.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
-                zip_fclose(zf);
-                if (errorOut)
-                    *errorOut = QStringLiteral("Failed to write file: %1").arg(outPath);
-                zip_close(za);
-                return false;
-            }
+    QString text = QString::fromUtf8(data);
+    if (text.startsWith(QChar(0xFEFF)))
+        text.remove(0, 1);
 
-            char buf[64 * 1024];
-            while (true) {
-                const zip_int64_t bytes = zip_fread(zf, buf, sizeof(buf));
-                if (bytes < 0) {
-                    zip_fclose(zf);
-                    if (errorOut)
-                        *errorOut = QStringLiteral("Failed reading ZIP entry: %1").arg(entryName);
-                    zip_close(za);
-                    return false;
-                }
-                if (bytes == 0)
-                    break;
-
-                if (out.write(buf, bytes) != bytes) {
-                    zip_fclose(zf);
-                    if (errorOut)
-                        *errorOut = QStringLiteral("Short write: %1").arg(outPath);
-                    zip_close(za);
-                    return false;
-                }
-            }
+    const QStringList lines = text.split('\n');
+    for (QString line : lines) {
+        line = line.trimmed();
+        if (line.isEmpty() || line.startsWith(';') || line.startsWith('#'))
+            continue;
 
-            zip_fclose(zf);
+        if (line.startsWith('[') && line.endsWith(']')) {
+            section = line.mid(1, line.size() - 2).trimmed().toLower();
+            continue;
         }
 
-        zip_close(za);
-        return true;
-    }
-};
-#endif
+        const qsizetype eq = line.indexOf('=');
+        if (eq <= 0)
+            continue;
 
-bool tryCopyFile(const QString& srcPath, const QString& dstPath, QString* errorOut) {
-    if (QFileInfo(dstPath).exists()) {
-        QFile::remove(dstPath);
-    }
-    if (!QFile::copy(srcPath, dstPath)) {
-        if (errorOut)
-            *errorOut = QStringLiteral("Failed to copy %1 -> %2").arg(srcPath, dstPath);
-        return false;
+        QString value = line.mid(eq + 1).trimmed();
+        if (value.size() >= 2 && value.startsWith('"') && value.endsWith('"'))
+            value = value.mid(1, value.size() - 2);
+        ini[section].insert(line.left(eq).trimmed().toLower(), value);
     }
-    return true;
+    return ini;
 }
 
-int readIntAny(const QSettings& ini, const QStringList& keys, int fallback, QStringList* warnings) {
+int readIntAny(const IniSection& ini, const QStringList& keys, int fallback, QStringList* warnings) {
     for (const QString& k : keys) {
-        const QVariant v = ini.value(k);
-        if (!v.isValid())
+        const auto it = ini.constFind(k.toLower());
+        if (it == ini.constEnd())
             continue;
         bool ok = false;
-        const int out = v.toInt(&ok);
+        const int out = it->toInt(&ok);
         if (ok)
             return out;
         if (warnings)
@@ -213,13 +104,13 @@ int readIntAny(const QSettings& ini, const QStringList& keys, int fallback, QStr
     return fallback;
 }
 
-qreal readRealAny(const QSettings& ini, const QStringList& keys, qreal fallback, QStringList* warnings) {
+qreal readRealAny(const IniSection& ini, const QStringList& keys, qreal fallback, QStringList* warnings) {
     for (const QString& k : keys) {
-        const QVariant v = ini.value(k);
-        if (!v.isValid())
+        const auto it = ini.constFind(k.toLower());
+        if (it == ini.constEnd())
             continue;
         bool ok = false;
-        const qreal out = v.toDouble(&ok);
+        const qreal out = it->toDouble(&ok);
         if (ok)
             return out;
         if (warnings)
@@ -228,25 +119,10 @@ qreal readRealAny(const QSettings& ini, const QStringList& keys, qreal fallback,
     return fallback;
 }
 
-VUMeterCalibration defaultCalibration() {
-    VUMeterCalibration c;
-    c.minAngle = -47;
-    c.minLevel = -20;
-    c.zeroAngle = 20;
-    c.zeroLevel = 0;
-    c.maxAngle = 47;
-    c.maxLevel = 3;
-    c.pivotX = 310;
-    c.pivotY = 362;
-    c.mobilityNegative = 0.05;
-    c.mobilityPositive = 0.10;
-    return c;
-}
-
-VUMeterCalibration parseCalibrationGroup(QSettings& ini, const QString& groupName, QStringList* warnings) {
+VUMeterCalibration parseCalibrationGroup(const IniFile& iniFile, const QString& groupName, QStringList* warnings) {
     VUMeterCalibration c = defaultCalibration();
 
-    ini.beginGroup(groupName);
+    const IniSection ini = iniFile.value(groupName.toLower());
     c.minAngle = readIntAny(ini, {"MinAngle"}, c.minAngle, warnings);
     c.minLevel = readIntAny(ini, {"MinLevel"}, c.minLevel, warnings);
     c.zeroAngle = readIntAny(ini, {"ZeroAngle"}, c.zeroAngle, warnings);
@@ -257,17 +133,17 @@ VUMeterCalibration parseCalibrationGroup(QSettings& ini, const QString& groupNam
     c.pivotY = readIntAny(ini, {"PivotPointY"}, c.pivotY, warnings);
     c.mobilityNegative = readRealAny(ini, {"MobilityNegative"}, c.mobilityNegative, warnings);
     c.mobilityPositive = readRealAny(ini, {"MobilityPositive"}, c.mobilityPositive, warnings);
-    ini.endGroup();
 
     return c;
 }
 
-VUMeterScaleTable buildScaleTableFromIni(QSettings& ini, const QString& groupName, const VUMeterCalibration& calib) {
-    (void)ini;
-    (void)groupName;
-    return {{static_cast<float>(calib.minLevel), static_cast<float>(calib.minAngle)},
-            {static_cast<float>(calib.zeroLevel), static_cast<float>(calib.zeroAngle)},
-            {static_cast<float>(calib.maxLevel), static_cast<float>(calib.maxAngle)}};
+// Sorted by level, as SkinManager's parser returns it
+VUMeterScaleTable buildScaleTable(const VUMeterCalibration& calib) {
+    VUMeterScaleTable t = {{static_cast<float>(calib.minLevel), static_cast<float>(calib.minAngle)},
+                           {static_cast<float>(calib.zeroLevel), static_cast<float>(calib.zeroAngle)},
+                           {static_cast<float>(calib.maxLevel), static_cast<float>(calib.maxAngle)}};
+    std::sort(t.begin(), t.end(), [](const auto& a0, const auto& a1) { return a0.first < a1.first; });
+    return t;
 }
 
 QJsonObject calibrationToJson(const VUMeterCalibration& c) {
@@ -310,10 +186,215 @@ QJsonObject meterJson(const QString& face, const QString& needle, const QString&
     return o;
 }
 
+#if defined(ANALOGVU_HAS_LIBZIP) && (ANALOGVU_HAS_LIBZIP == 1)
+bool isSafeZipEntryPath(const QString& entryName) {
+    if (entryName.isEmpty())
+        return false;
+    if (entryName.startsWith('/') || entryName.startsWith('\\'))
+        return false;
+
+    const QString cleaned = QDir::cleanPath(entryName);
+    if (cleaned == QStringLiteral(".") || cleaned.isEmpty())
+        return false;
+    if (cleaned.startsWith(QStringLiteral("../")) || cleaned == QStringLiteral(".."))
+        return false;
+    if (cleaned.contains(QStringLiteral("/../")))
+        return false;
+
+    // Avoid Windows drive paths like C:\...
+    if (cleaned.size() >= 2 && cleaned[1] == ':')
+        return false;
+
+    return true;
+}
+
+// Read-only view of an archive's top-level skin directory. Entry names are
+// listed once; only the entries asked for are decompressed, into memory.
+class ZipArchive {
+  public:
+    ZipArchive() = default;
+    ZipArchive(const ZipArchive&) = delete;
+    ZipArchive& operator=(const ZipArchive&) = delete;
+    ~ZipArchive() {
+        if (za_)
+            zip_close(za_);
+    }
+
+    bool open(const QString& zipFilePath, QString* errorOut) {
+        int err = 0;
+        za_ = zip_open(zipFilePath.toUtf8().constData(), ZIP_RDONLY, &err);
+        if (!za_) {
+            if (errorOut) {
+                zip_error_t ze;
+                zip_error_init_with_code(&ze, err);
+                const QString msg = QString::fromUtf8(zip_error_strerror(&ze));
+                zip_error_fini(&ze);
+                *errorOut = QStringLiteral("Failed to open ZIP: %1 (%2)").arg(zipFilePath, msg);
+            }
+            return false;
+        }
+
+        struct Entry {
+            QString name;
+            zip_uint64_t index;
+        };
+        std::vector<Entry> files;
+        QStringList topLevel;
+
+        const zip_int64_t n = zip_get_num_entries(za_, 0);
+        for (zip_uint64_t i = 0; i < static_cast<zip_uint64_t>(n); ++i) {
+            const char* rawName = zip_get_name(za_, i, 0);
+            const QString entryName = QString::fromUtf8(rawName ? rawName : "");
+            if (entryName.isEmpty())
+                continue;
+
+            if (!isSafeZipEntryPath(entryName)) {
+                if (errorOut)
+                    *errorOut = QStringLiteral("Unsafe ZIP entry path: %1").arg(entryName);
+                return false;
+            }
+
+            const QString cleaned = QDir::cleanPath(entryName);
+            const QString first = cleaned.section('/', 0, 0);
+            if (!topLevel.contains(first))
+                topLevel.push_back(first);
+            // A file at the root means there is no wrapping directory
+            if (!entryName.endsWith('/') && !cleaned.contains('/'))
+                topLevel.push_back(QString());
+
+            if (!entryName.endsWith('/'))
+                files.push_back({cleaned, i});
+        }
+
+        // Like extracting and descending into a single top-level directory
+        QString prefix;
+        if (topLevel.size() == 1 && !files.empty())
+            prefix = topLevel.first() + QStringLiteral("/");
+
+        for (const Entry& e : files) {
+            if (!e.name.startsWith(prefix))
+                continue;
+            const QString rel = e.name.mid(prefix.size());
+            if (!rel.isEmpty() && !rel.contains('/'))
+                byLowerName_.insert(rel.toLower(), e.index);
+        }
+        return true;
+    }
+
+    bool contains(const QString& nameLower) const { return byLowerName_.contains(nameLower); }
+
+    bool read(const QString& nameLower, QByteArray* out, QString* errorOut) const {
+        const auto it = byLowerName_.constFind(nameLower);
+        if (it == byLowerName_.constEnd()) {
+            if (errorOut)
+                *errorOut = QStringLiteral("%1 not found in ZIP").arg(nameLower);
+            return false;
+        }
+
+        zip_stat_t st;
+        zip_stat_init(&st);
+        if (zip_stat_index(za_, *it, 0, &st) != 0 || !(st.valid & ZIP_STAT_SIZE)) {
+            if (errorOut)
+                *errorOut = QStringLiteral("Failed to stat ZIP entry: %1").arg(nameLower);
+            return false;
+        }
+        if (st.size > static_cast<zip_uint64_t>(SkinImporter::kMaxEntryBytes)) {
+            if (errorOut)
+                *errorOut = QStringLiteral("ZIP entry too large: %1").arg(nameLower);
+            return false;
+        }
+
+        zip_file_t* zf = zip_fopen_index(za_, *it, 0);
+        if (!zf) {
+            if (errorOut)
+                *errorOut = QStringLiteral("Failed to open ZIP entry: %1").arg(nameLower);
+            return false;
+        }
+
+        QByteArray data(static_cast<qsizetype>(st.size), Qt::Uninitialized);
+        zip_int64_t got = 0;
+        while (got < static_cast<zip_int64_t>(st.size)) {
+            const zip_int64_t bytes = zip_fread(zf, data.data() + got, st.size - static_cast<zip_uint64_t>(got));
+            if (bytes <= 0)
+                break;
+            got += bytes;
+        }
+        zip_fclose(zf);
+
+        if (got != static_cast<zip_int64_t>(st.size)) {
+            if (errorOut)
+                *errorOut = QStringLiteral("Failed reading ZIP entry: %1").arg(nameLower);
+            return false;
+        }
+
+        *out = std::move(data);
+        return true;
+    }
+
+  private:
+    zip_t* za_ = nullptr;
+    QHash<QString, zip_uint64_t> byLowerName_;
+};
+#endif
+
+bool writeFile(const QString& path, const QByteArray& data, QString* errorOut) {
+    QFile f(path);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate) || f.write(data) != data.size()) {
+        if (errorOut)
+            *errorOut = QStringLiteral("Failed to write file: %1").arg(path);
+        return false;
+    }
+    return true;
+}
+
+// One face/needle/cap image: the archive bytes (written out verbatim) and
+// the decoded pixels
+struct AssetFile {
+    QString zipNameLower;
+    QString targetName;
+    QByteArray bytes;
+    QImage image;
+};
+
 } // namespace
 
 SkinImporter::ImportResult SkinImporter::importAimpZip(const QString& zipFilePath) const {
+    return importOne(zipFilePath, true, true);
+}
+
+QList<SkinImporter::ImportResult> SkinImporter::importAimpZips(const QStringList& zipFilePaths, int maxThreads) const {
+    // Parallel across archives; each archive then decodes its images serially
+    std::vector<ImportResult> results(static_cast<std::size_t>(zipFilePaths.size()));
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(maxThreads > 0 ? maxThreads : QThread::idealThreadCount());
+
+    for (qsizetype i = 0; i < zipFilePaths.size(); ++i) {
+        pool.start([this, &zipFilePaths, &results, i]() {
+            results[static_cast<std::size_t>(i)] = importOne(zipFilePaths[i], false, false);
+        });
+    }
+    pool.waitForDone();
+
+    return QList<ImportResult>(results.begin(), results.end());
+}
+
+QStringList SkinImporter::findZipFiles(const QString& dirPath) {
+    const QDir dir(dirPath);
+    QStringList out;
+    const QFileInfoList files = dir.entryInfoList({QStringLiteral("*.zip"), QStringLiteral("*.ZIP")}, QDir::Files, QDir::Name);
+    for (const QFileInfo& fi : files) {
+        if (!out.contains(fi.absoluteFilePath()))
+            out.push_back(fi.absoluteFilePath());
+    }
+    return out;
+}
+
+SkinImporter::ImportResult SkinImporter::importOne(const QString& zipFilePath,
+                                                    bool parallelDecode,
+                                                    bool keepImages) const {
     ImportResult result;
+    result.zipFilePath = zipFilePath;
 
     const QFileInfo zipInfo(zipFilePath);
     if (!zipInfo.exists() || !zipInfo.isFile()) {
@@ -321,59 +402,29 @@ SkinImporter::ImportResult SkinImporter::importAimpZip(const QString& zipFilePat
         return result;
     }
 
-    QTemporaryDir tmp;
-    if (!tmp.isValid()) {
-        result.error = QStringLiteral("Failed to create temp directory");
-        return result;
-    }
-
 #if !defined(ANALOGVU_HAS_LIBZIP) || (ANALOGVU_HAS_LIBZIP == 0)
+    (void)parallelDecode;
     result.error = QStringLiteral("Skin import is disabled because libzip was not found at build time.");
     return result;
 #else
-    QString zipError;
-    if (!ZipReader::extractAll(zipFilePath, QDir(tmp.path()), &zipError)) {
-        result.error = zipError;
+    ZipArchive zip;
+    if (!zip.open(zipFilePath, &result.error))
         return result;
-    }
-#endif
-
-    const QDir extractedRoot(tmp.path());
-    const QDir aimpRoot = findAimpRootDir(extractedRoot);
-    const QMap<QString, QString> fileMap = lowerNameToActualFile(aimpRoot);
 
-    auto requireFile = [&](const QString& nameLower, QString* actualOut) -> bool {
-        const auto it = fileMap.constFind(nameLower);
-        if (it == fileMap.constEnd())
-            return false;
-        if (actualOut)
-            *actualOut = it.value();
-        return true;
-    };
-
-    QString iniActual;
-    if (!requireFile(QStringLiteral("skin.ini"), &iniActual)) {
+    if (!zip.contains(QStringLiteral("skin.ini"))) {
         result.error = QStringLiteral("skin.ini not found in ZIP");
         return result;
     }
 
-    bool isStereo = false;
-    QString s0, s1, s2;
-    QString l0, l1, l2;
-    QString r0, r1, r2;
-
-    const bool hasSingle = requireFile(QStringLiteral("0.png"), &s0) &&
-                           requireFile(QStringLiteral("1.png"), &s1) &&
-                           requireFile(QStringLiteral("2.png"), &s2);
+    const bool hasSingle = zip.contains(QStringLiteral("0.png")) && zip.contains(QStringLiteral("1.png")) &&
+                           zip.contains(QStringLiteral("2.png"));
 
     // Stereo detection is based on L_/R_ filename prefixes (case-insensitive).
-    const bool hasStereo = requireFile(QStringLiteral("l_0.png"), &l0) &&
-                           requireFile(QStringLiteral("l_1.png"), &l1) &&
-                           requireFile(QStringLiteral("l_2.png"), &l2) &&
-                           requireFile(QStringLiteral("r_0.png"), &r0) &&
-                           requireFile(QStringLiteral("r_1.png"), &r1) &&
-                           requireFile(QStringLiteral("r_2.png"), &r2);
+    const bool hasStereo = zip.contains(QStringLiteral("l_0.png")) && zip.contains(QStringLiteral("l_1.png")) &&
+                           zip.contains(QStringLiteral("l_2.png")) && zip.contains(QStringLiteral("r_0.png")) &&
+                           zip.contains(QStringLiteral("r_1.png")) && zip.contains(QStringLiteral("r_2.png"));
 
+    bool isStereo = false;
     if (hasStereo) {
         isStereo = true;
     } else if (hasSingle) {
@@ -383,8 +434,56 @@ SkinImporter::ImportResult SkinImporter::importAimpZip(const QString& zipFilePat
         return result;
     }
 
-    const QString iniPath = aimpRoot.filePath(iniActual);
-    QSettings ini(iniPath, QSettings::IniFormat);
+    // libzip handles are not thread-safe, so entries are read in sequence;
+    // decoding (the expensive part) is what runs in parallel
+    std::vector<AssetFile> assets;
+    if (isStereo) {
+        assets = {{QStringLiteral("l_0.png"), QStringLiteral("L_face.png"), {}, {}},
+                  {QStringLiteral("l_1.png"), QStringLiteral("L_needle.png"), {}, {}},
+                  {QStringLiteral("l_2.png"), QStringLiteral("L_cap.png"), {}, {}},
+                  {QStringLiteral("r_0.png"), QStringLiteral("R_face.png"), {}, {}},
+                  {QStringLiteral("r_1.png"), QStringLiteral("R_needle.png"), {}, {}},
+                  {QStringLiteral("r_2.png"), QStringLiteral("R_cap.png"), {}, {}}};
+    } else {
+        assets = {{QStringLiteral("0.png"), QStringLiteral("face.png"), {}, {}},
+                  {QStringLiteral("1.png"), QStringLiteral("needle.png"), {}, {}},
+                  {QStringLiteral("2.png"), QStringLiteral("cap.png"), {}, {}}};
+    }
+
+    QByteArray iniBytes;
+    if (!zip.read(QStringLiteral("skin.ini"), &iniBytes, &result.error))
+        return result;
+    for (AssetFile& a : assets) {
+        if (!zip.read(a.zipNameLower, &a.bytes, &result.error))
+            return result;
+    }
+
+    // Same pixel format SkinManager decodes to, so the images can go straight
+    // into the skin cache
+    auto decode = [](AssetFile* a) {
+        a->image = QImage::fromData(a->bytes).convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    };
+    if (parallelDecode) {
+        QThreadPool pool;
+        pool.setMaxThreadCount(std::min<int>(static_cast<int>(assets.size()), QThread::idealThreadCount()));
+        for (AssetFile& a : assets) {
+            pool.start([&decode, &a]() { decode(&a); });
+        }
+        pool.waitForDone();
+    } else {
+        for (AssetFile& a : assets) {
+            decode(&a);
+        }
+    }
+
+    for (const AssetFile& a : assets) {
+        if (a.image.isNull()) {
+            result.error = QStringLiteral("Invalid image in ZIP: %1").arg(a.zipNameLower);
+            return result;
+        }
+    }
+
+    const IniFile ini = parseIni(iniBytes);
 
     VUMeterCalibration singleCalib;
     VUMeterCalibration leftCalib;
@@ -400,19 +499,9 @@ SkinImporter::ImportResult SkinImporter::importAimpZip(const QString& zipFilePat
         rightCalib = singleCalib;
     }
 
-    VUMeterScaleTable singleTable;
-    VUMeterScaleTable leftTable;
-    VUMeterScaleTable rightTable;
-
-    if (isStereo) {
-        leftTable = buildScaleTableFromIni(ini, QStringLiteral("VU_L"), leftCalib);
-        rightTable = buildScaleTableFromIni(ini, QStringLiteral("VU_R"), rightCalib);
-        singleTable = leftTable;
-    } else {
-        singleTable = buildScaleTableFromIni(ini, QStringLiteral("VU"), singleCalib);
-        leftTable = singleTable;
-        rightTable = singleTable;
-    }
+    const VUMeterScaleTable singleTable = buildScaleTable(singleCalib);
+    const VUMeterScaleTable leftTable = buildScaleTable(leftCalib);
+    const VUMeterScaleTable rightTable = buildScaleTable(rightCalib);
 
     const QString baseName = sanitizedDirName(zipInfo.completeBaseName());
     const QString skinsRootPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + QStringLiteral("/skins");
@@ -425,37 +514,31 @@ SkinImporter::ImportResult SkinImporter::importAimpZip(const QString& zipFilePat
         }
     }
 
+    // mkdir() fails if the directory exists, so the name is claimed atomically
+    // even when several imports of same-named archives run in parallel
     QString finalDirName = baseName;
-    for (int i = 2; skinsRoot.exists(finalDirName); ++i) {
+    for (int i = 2; !skinsRoot.mkdir(finalDirName); ++i) {
+        if (!skinsRoot.exists(finalDirName)) {
+            result.error = QStringLiteral("Failed to create skin directory: %1").arg(skinsRoot.filePath(finalDirName));
+            return result;
+        }
         finalDirName = QStringLiteral("%1-%2").arg(baseName).arg(i);
     }
 
     const QString skinDirPath = skinsRoot.filePath(finalDirName);
     QDir skinDir(skinDirPath);
-    if (!QDir().mkpath(skinDirPath)) {
-        result.error = QStringLiteral("Failed to create skin directory: %1").arg(skinDirPath);
-        return result;
-    }
 
-    QString copyError;
+    auto fail = [&](const QString& error) {
+        skinDir.removeRecursively();
+        result.error = error;
+        return result;
+    };
 
-    if (isStereo) {
-        if (!tryCopyFile(aimpRoot.filePath(l0), skinDir.filePath(QStringLiteral("L_face.png")), &copyError) ||
-            !tryCopyFile(aimpRoot.filePath(l1), skinDir.filePath(QStringLiteral("L_needle.png")), &copyError) ||
-            !tryCopyFile(aimpRoot.filePath(l2), skinDir.filePath(QStringLiteral("L_cap.png")), &copyError) ||
-            !tryCopyFile(aimpRoot.filePath(r0), skinDir.filePath(QStringLiteral("R_face.png")), &copyError) ||
-            !tryCopyFile(aimpRoot.filePath(r1), skinDir.filePath(QStringLiteral("R_needle.png")), &copyError) ||
-            !tryCopyFile(aimpRoot.filePath(r2), skinDir.filePath(QStringLiteral("R_cap.png")), &copyError)) {
-            result.error = copyError;
-            return result;
-        }
-    } else {
-        if (!tryCopyFile(aimpRoot.filePath(s0), skinDir.filePath(QStringLiteral("face.png")), &copyError) ||
-            !tryCopyFile(aimpRoot.filePath(s1), skinDir.filePath(QStringLiteral("needle.png")), &copyError) ||
-            !tryCopyFile(aimpRoot.filePath(s2), skinDir.filePath(QStringLiteral("cap.png")), &copyError)) {
-            result.error = copyError;
-            return result;
-        }
+    // The archive's PNG bytes are written as-is: one write per asset
+    QString writeError;
+    for (const AssetFile& a : assets) {
+        if (!writeFile(skinDir.filePath(a.targetName), a.bytes, &writeError))
+            return fail(writeError);
     }
 
     // schemaVersion 2: the on-disk JSON is explicit and minimal.
@@ -480,19 +563,44 @@ SkinImporter::ImportResult SkinImporter::importAimpZip(const QString& zipFilePat
     root.insert(QStringLiteral("meters"), meters);
     root.insert(QStringLiteral("importedFrom"), zipInfo.fileName());
 
-    const QString jsonPath = skinDir.filePath(QStringLiteral("skin.json"));
-    QFile jsonFile(jsonPath);
-    if (!jsonFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
-        result.error = QStringLiteral("Failed to write skin.json");
-        return result;
+    const QJsonDocument doc(root);
+    if (!writeFile(skinDir.filePath(QStringLiteral("skin.json")), doc.toJson(QJsonDocument::Indented), &writeError))
+        return fail(QStringLiteral("Failed to write skin.json"));
+
+    result.package.name = finalDirName;
+    result.package.importedFrom = zipInfo.fileName();
+    if (isStereo) {
+        VUSkinStereoMeters stereo;
+        stereo.left.calibration = leftCalib;
+        stereo.left.scaleTable = leftTable;
+        stereo.right.calibration = rightCalib;
+        stereo.right.scaleTable = rightTable;
+        result.package.meters = stereo;
+    } else {
+        VUSkinSingleMeters single;
+        single.vu.calibration = singleCalib;
+        single.vu.scaleTable = singleTable;
+        result.package.meters = single;
+    }
+    for (std::size_t i = 0; i < assets.size(); ++i) {
+        VUMeterImages& m = result.images.meters[i / 3];
+        QImage* slot[3] = {&m.face, &m.needle, &m.cap};
+        *slot[i % 3] = std::move(assets[i].image);
     }
 
-    const QJsonDocument doc(root);
-    jsonFile.write(doc.toJson(QJsonDocument::Indented));
-    jsonFile.close();
+    // The id is the directory name, as SkinManager::scan() assigns it
+    if (cache_) {
+        QString cacheError;
+        const quint64 fingerprint = SkinCache::skinFingerprint(skinDirPath, isStereo);
+        if (!cache_->storePackage(finalDirName, fingerprint, result.package, result.images, &cacheError))
+            result.warnings.push_back(QStringLiteral("Skin cache not written: %1").arg(cacheError));
+    }
+    if (!keepImages)
+        result.images = VUSkinImages{};
 
     result.ok = true;
     result.skinName = finalDirName;
     result.skinDir = skinDirPath;
     return result;
+#endif
 }
@@ -1,17 +1,56 @@
 #pragma once
 
+#include <QList>
 #include <QString>
 #include <QStringList>
 
+#include "SkinCache.h"
+#include "VUMeterSkin.h"
+
+// Imports AIMP VU meter skins (ZIP with skin.ini and 0/1/2.png or L_/R_ sets).
+//
+// Only skin.ini and the face/needle/cap images are read, straight from the
+// archive into memory; nothing is extracted to a temp directory. The images
+// are decoded once to validate them and, given a cache, written to it on the
+// importing thread so the skin's first load reads no PNGs. The skin directory
+// is written in one pass, with skin.json last so a partially written skin is
+// never picked up by SkinManager::scan().
 class SkinImporter {
   public:
     struct ImportResult {
         bool ok = false;
+        QString zipFilePath;
         QString skinName;
         QString skinDir;
         QString error;
         QStringList warnings;
+
+        // What SkinManager would decode from skinDir (pixmaps left null).
+        // images is only filled by importAimpZip(), so the caller can show
+        // the skin without reading it back.
+        VUSkinPackage package;
+        VUSkinImages images;
     };
 
+    // cache, if given, must outlive the importer; SkinCache is safe to write
+    // from several threads as long as the ids differ, which they do here.
+    explicit SkinImporter(const SkinCache* cache = nullptr) : cache_(cache) {}
+
+    // Entries larger than this are rejected rather than read into memory
+    static constexpr qint64 kMaxEntryBytes = 64ll * 1024 * 1024;
+
     ImportResult importAimpZip(const QString& zipFilePath) const;
+
+    // Imports the archives on up to maxThreads workers (0 = one per core).
+    // Results are returned in input order, without their decoded images, so a
+    // large folder does not keep every image alive until the batch is done.
+    QList<ImportResult> importAimpZips(const QStringList& zipFilePaths, int maxThreads = 0) const;
+
+    // Every *.zip directly inside dirPath, sorted by name
+    static QStringList findZipFiles(const QString& dirPath);
+
+  private:
+    ImportResult importOne(const QString& zipFilePath, bool parallelDecode, bool keepImages) const;
+
+    const SkinCache* cache_ = nullptr;
 };
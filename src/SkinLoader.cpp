@@ -0,0 +1,105 @@
+#include "SkinLoader.h"
+
+#include <QThread>
+
+#include <utility>
+
+SkinLoader::SkinLoader(const SkinManager* manager, QObject* parent) : QObject(parent), manager_(manager) {
+    pool_.setMaxThreadCount(kMaxThreads);
+    // Decoding must not compete with the audio and DSP threads
+    pool_.setThreadPriority(QThread::LowPriority);
+}
+
+SkinLoader::~SkinLoader() {
+    // Workers post back to this object; make sure none are left running
+    pool_.clear();
+    pool_.waitForDone();
+}
+
+void SkinLoader::load(const QString& skinId) {
+    wantedId_ = skinId;
+
+    const auto it = ready_.find(skinId);
+    if (it != ready_.end()) {
+        SkinManager::DecodedSkin decoded = std::move(*it);
+        ready_.erase(it);
+        readyOrder_.removeOne(skinId);
+
+        wantedId_.clear();
+        emit loaded(skinId, SkinManager::uploadDecodedSkin(std::move(decoded)));
+        return;
+    }
+
+    // Already decoding as a prefetch; onDecoded() hands it over
+    if (inFlight_.contains(skinId))
+        return;
+
+    SkinManager::SkinInfo info;
+    if (!manager_->findSkin(skinId, &info)) {
+        wantedId_.clear();
+        SkinManager::LoadedSkin failed;
+        failed.error = QStringLiteral("Unknown skin id: %1").arg(skinId);
+        emit loaded(skinId, failed);
+        return;
+    }
+
+    startDecode(info);
+}
+
+void SkinLoader::prefetch(const QString& skinId) {
+    if (ready_.contains(skinId) || inFlight_.contains(skinId))
+        return;
+
+    SkinManager::SkinInfo info;
+    if (manager_->findSkin(skinId, &info))
+        startDecode(info);
+}
+
+void SkinLoader::clear() {
+    ++generation_;
+    inFlight_.clear();
+    ready_.clear();
+    readyOrder_.clear();
+
+    const QString wanted = wantedId_;
+    if (!wanted.isEmpty())
+        load(wanted);
+}
+
+void SkinLoader::startDecode(const SkinManager::SkinInfo& info) {
+    inFlight_.insert(info.id);
+
+    const SkinManager* manager = manager_;
+    const quint64 generation = generation_;
+    pool_.start([this, manager, info, generation]() {
+        SkinManager::DecodedSkin decoded = manager->decodeSkin(info);
+        QMetaObject::invokeMethod(
+            this,
+            [this, id = info.id, decoded = std::move(decoded), generation]() mutable {
+                onDecoded(id, std::move(decoded), generation);
+            },
+            Qt::QueuedConnection);
+    });
+}
+
+void SkinLoader::onDecoded(const QString& skinId, SkinManager::DecodedSkin&& decoded, quint64 generation) {
+    if (generation != generation_)
+        return;
+    inFlight_.remove(skinId);
+
+    if (skinId == wantedId_) {
+        wantedId_.clear();
+        emit loaded(skinId, SkinManager::uploadDecodedSkin(std::move(decoded)));
+        return;
+    }
+
+    // Failed prefetches are not kept; a later load() reports the error
+    if (!decoded.ok)
+        return;
+
+    ready_.insert(skinId, std::move(decoded));
+    readyOrder_.push_back(skinId);
+    while (readyOrder_.size() > kMaxPrefetched) {
+        ready_.remove(readyOrder_.takeFirst());
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QThreadPool>
+
+#include "SkinManager.h"
+
+// Loads skins on a small worker pool so switching never stalls the GUI thread
+// (and with it the meter's frame scheduler). Workers only decode into QImages
+// via SkinManager::decodeSkin(); the upload to QPixmap happens on the GUI
+// thread when the result is delivered.
+//
+// prefetch() decodes skins ahead of time (e.g. the menu neighbours of the
+// active one) into a small bounded set, so a later load() of one of them
+// completes without touching the disk.
+class SkinLoader final : public QObject {
+    Q_OBJECT
+
+  public:
+    static constexpr int kMaxThreads = 2;
+    static constexpr int kMaxPrefetched = 4;
+
+    // manager must outlive the loader; its scan() may run while workers decode
+    explicit SkinLoader(const SkinManager* manager, QObject* parent = nullptr);
+    ~SkinLoader() override;
+
+    // Emits loaded() once skinId is ready (immediately if it was prefetched).
+    // A newer load() or cancel() supersedes a pending one; its result is kept
+    // as a prefetch instead.
+    void load(const QString& skinId);
+    void cancel() { wantedId_.clear(); }
+    QString pendingSkinId() const { return wantedId_; }
+
+    void prefetch(const QString& skinId);
+
+    // Drops prefetched and in-flight results, e.g. after a rescan. A pending
+    // load() is restarted.
+    void clear();
+
+  signals:
+    void loaded(const QString& skinId, const SkinManager::LoadedSkin& skin);
+
+  private:
+    void startDecode(const SkinManager::SkinInfo& info);
+    void onDecoded(const QString& skinId, SkinManager::DecodedSkin&& decoded, quint64 generation);
+
+    const SkinManager* manager_;
+    QThreadPool pool_;
+
+    QString wantedId_;
+    QSet<QString> inFlight_;
+    QHash<QString, SkinManager::DecodedSkin> ready_;
+    QList<QString> readyOrder_; // oldest first, for eviction
+
+    // Bumped by clear() so results started before it are dropped
+    quint64 generation_ = 0;
+};
@@ -13,7 +13,9 @@
 
 namespace {
 
-bool loadPixmap(QPixmap* out, const QString& absPath, QStringList* warnings) {
+// Decodes into the format the raster paint engine draws from, so the GUI
+// thread's QPixmap::fromImage() can adopt the data without converting it.
+bool loadImage(QImage* out, const QString& absPath, QStringList* warnings) {
     if (!out)
         return false;
     if (!QFileInfo::exists(absPath)) {
@@ -21,11 +23,13 @@ bool loadPixmap(QPixmap* out, const QString& absPath, QStringList* warnings) {
             warnings->push_back(QStringLiteral("Missing asset: %1").arg(absPath));
         return false;
     }
-    if (!out->load(absPath)) {
+    QImage image;
+    if (!image.load(absPath)) {
         if (warnings)
             warnings->push_back(QStringLiteral("Failed to load image: %1").arg(absPath));
         return false;
     }
+    *out = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
     return true;
 }
 
@@ -147,9 +151,10 @@ bool parseMeterStrict(const QJsonObject& meterObj,
                       const QString& expectedNeedle,
                       const QString& expectedCap,
                       VUMeterSkin* out,
+                      VUMeterImages* images,
                       QString* errorOut,
                       QStringList* warnings) {
-    if (!out)
+    if (!out || !images)
         return false;
 
     const QJsonValue assetsV = meterObj.value(QStringLiteral("assets"));
@@ -201,8 +206,8 @@ bool parseMeterStrict(const QJsonObject& meterObj,
     const QString needleAbs = skinDir.filePath(needleRel);
     const QString capAbs = skinDir.filePath(capRel);
 
-    if (!loadPixmap(&out->assets.face, faceAbs, warnings) || !loadPixmap(&out->assets.needle, needleAbs, warnings) ||
-        !loadPixmap(&out->assets.cap, capAbs, warnings)) {
+    if (!loadImage(&images->face, faceAbs, warnings) || !loadImage(&images->needle, needleAbs, warnings) ||
+        !loadImage(&images->cap, capAbs, warnings)) {
         if (errorOut)
             *errorOut = QStringLiteral("Failed to load one or more required skin assets");
         return false;
@@ -231,11 +236,31 @@ void SkinManager::scan() {
 
     const QFileInfoList dirs = root.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name);
 
+    // Skins whose skin.json is unchanged since the last scan come from the
+    // manifest; only new or edited ones are parsed.
+    const QHash<QString, SkinCache::ManifestEntry> cached = cache_.readManifest();
+    QList<SkinCache::ManifestEntry> manifest;
+    bool manifestChanged = false;
+
     for (const QFileInfo& di : dirs) {
         const QDir skinDir(di.absoluteFilePath());
         const QString jsonPath = skinDir.filePath(QStringLiteral("skin.json"));
-        if (!QFileInfo::exists(jsonPath))
+        const quint64 jsonStamp = SkinCache::fileStamp(jsonPath);
+        if (jsonStamp == 0)
+            continue;
+
+        const auto hit = cached.constFind(di.fileName());
+        if (hit != cached.constEnd() && hit->jsonStamp == jsonStamp && hit->skinDir == di.absoluteFilePath()) {
+            SkinInfo info;
+            info.id = hit->id;
+            info.name = hit->name;
+            info.isStereo = hit->isStereo;
+            info.skinDir = hit->skinDir;
+            skins_.push_back(info);
+            manifest.push_back(*hit);
             continue;
+        }
+        manifestChanged = true;
 
         QFile f(jsonPath);
         if (!f.open(QIODevice::ReadOnly))
@@ -266,19 +291,71 @@ void SkinManager::scan() {
         info.isStereo = (type == QStringLiteral("stereo"));
         info.skinDir = di.absoluteFilePath();
         skins_.push_back(info);
+        manifest.push_back({info.id, info.name, info.skinDir, info.isStereo, jsonStamp});
     }
-}
 
-SkinManager::LoadedSkin SkinManager::loadSkin(const QString& skinId) const {
-    LoadedSkin out;
+    if (manifestChanged || manifest.size() != cached.size()) {
+        cache_.writeManifest(manifest);
 
+        QList<QString> ids;
+        for (const SkinInfo& info : skins_)
+            ids.push_back(info.id);
+        cache_.prune(ids);
+    }
+}
+
+bool SkinManager::findSkin(const QString& skinId, SkinInfo* out) const {
     const auto it = std::find_if(skins_.begin(), skins_.end(), [&](const SkinInfo& i) { return i.id == skinId; });
-    if (it == skins_.end()) {
+    if (it == skins_.end())
+        return false;
+    if (out)
+        *out = *it;
+    return true;
+}
+
+SkinManager::LoadedSkin SkinManager::loadSkin(const QString& skinId) const {
+    SkinInfo info;
+    if (!findSkin(skinId, &info)) {
+        LoadedSkin out;
         out.error = QStringLiteral("Unknown skin id: %1").arg(skinId);
         return out;
     }
+    return uploadDecodedSkin(decodeSkin(info));
+}
+
+SkinManager::DecodedSkin SkinManager::decodeSkin(const SkinInfo& info) const {
+    DecodedSkin out;
+
+    // The blob only holds skins that parsed cleanly, so a hit needs no validation
+    const quint64 fingerprint = SkinCache::skinFingerprint(info.skinDir, info.isStereo);
+    if (cache_.loadPackage(info.id, fingerprint, &out.package, &out.images)) {
+        out.ok = true;
+        return out;
+    }
+
+    out = parseSkin(info);
+    if (out.ok && out.warnings.isEmpty())
+        cache_.storePackage(info.id, fingerprint, out.package, out.images);
+    return out;
+}
+
+SkinManager::LoadedSkin SkinManager::uploadDecodedSkin(DecodedSkin&& decoded) {
+    LoadedSkin out;
+    out.ok = decoded.ok;
+    out.error = decoded.error;
+    out.warnings = decoded.warnings;
+    if (!out.ok)
+        return out;
+
+    out.package = std::move(decoded.package);
+    uploadSkinImages(&out.package, std::move(decoded.images));
+    return out;
+}
+
+SkinManager::DecodedSkin SkinManager::parseSkin(const SkinInfo& info) const {
+    DecodedSkin out;
 
-    const QDir skinDir(it->skinDir);
+    const QDir skinDir(info.skinDir);
     const QString jsonPath = skinDir.filePath(QStringLiteral("skin.json"));
 
     QFile f(jsonPath);
@@ -351,6 +428,7 @@ SkinManager::LoadedSkin SkinManager::loadSkin(const QString& skinId) const {
                               QStringLiteral("needle.png"),
                               QStringLiteral("cap.png"),
                               &vu,
+                              &out.images.meters[0],
                               &parseError,
                               &out.warnings)) {
             out.error = parseError;
@@ -377,6 +455,7 @@ SkinManager::LoadedSkin SkinManager::loadSkin(const QString& skinId) const {
                               QStringLiteral("L_needle.png"),
                               QStringLiteral("L_cap.png"),
                               &left,
+                              &out.images.meters[0],
                               &parseError,
                               &out.warnings)) {
             out.error = parseError;
@@ -388,6 +467,7 @@ SkinManager::LoadedSkin SkinManager::loadSkin(const QString& skinId) const {
                               QStringLiteral("R_needle.png"),
                               QStringLiteral("R_cap.png"),
                               &right,
+                              &out.images.meters[1],
                               &parseError,
                               &out.warnings)) {
             out.error = parseError;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "SkinCache.h"
 #include "VUMeterSkin.h"
 
 #include <QList>
@@ -23,6 +24,16 @@ class SkinManager {
         VUSkinPackage package;
     };
 
+    // Result of decodeSkin(): the package without pixmaps plus its decoded images
+    struct DecodedSkin {
+        bool ok = false;
+        QString error;
+        QStringList warnings;
+
+        VUSkinPackage package;
+        VUSkinImages images;
+    };
+
     SkinManager();
 
     void scan();
@@ -36,11 +47,28 @@ class SkinManager {
         activeSkinId_.clear();
     }
 
+    bool findSkin(const QString& skinId, SkinInfo* out) const;
+
+    // Synchronous decode + upload; GUI thread only
     LoadedSkin loadSkin(const QString& skinId) const;
 
+    // Reads and decodes a skin (binary cache first, then skin.json and PNGs)
+    // without creating pixmaps, so it can run on any thread.
+    DecodedSkin decodeSkin(const SkinInfo& info) const;
+
+    // For seeding the binary cache with freshly imported skins (SkinImporter)
+    const SkinCache& cache() const { return cache_; }
+
+    // GUI thread only: turns a decoded skin's images into the package's pixmaps
+    static LoadedSkin uploadDecodedSkin(DecodedSkin&& decoded);
+
     static QString skinsRootPath();
 
   private:
+    DecodedSkin parseSkin(const SkinInfo& info) const;
+
     QList<SkinInfo> skins_;
     QString activeSkinId_;
+
+    SkinCache cache_;
 };
@@ -4,16 +4,38 @@
 #include <cmath>
 
 #include <QFontDatabase>
+#include <QImage>
+#include <QPaintEvent>
 #include <QPainter>
+#include <QDebug>
+#include <QLoggingCategory>
 #include <QPainterPath>
+#include <QResizeEvent>
+#include <QThreadPool>
+#include <QTransform>
 #include <qnamespace.h>
 #include <qpixmap.h>
 #include <qtypes.h>
 
+#include "VUMeterOverlayStrip.h"
 #include "VUMeterScale.h"
+#include "VuMetrics.h"
+
+#if defined(ANALOGVU_HAS_OPENGL) && (ANALOGVU_HAS_OPENGL == 1)
+#include "VUMeterGLSurface.h"
+#endif
+
+// Atlas build results; enable with QT_LOGGING_RULES="analogvu.atlas.debug=true"
+Q_LOGGING_CATEGORY(lcNeedleAtlas, "analogvu.atlas", QtInfoMsg)
 
 static constexpr float kPi = 3.14159265358979323846f;
 
+// Needle moves below this many device pixels at the tip are not repainted
+static constexpr qreal kMinNeedleMovePx = 0.25;
+
+// Extra margin around needle dirty rects for antialiasing and the shadow offset
+static constexpr qreal kNeedleDirtyMargin = 4.0;
+
 static QPointF polarFromBottomPivot(const QPointF& pivot, float radius, float thetaDeg) {
     const float theta = thetaDeg * (kPi / 180.0f);
     const float sx = std::sin(theta);
@@ -21,30 +43,117 @@ static QPointF polarFromBottomPivot(const QPointF& pivot, float radius, float th
     return QPointF(pivot.x() + radius * sx, pivot.y() - radius * cy);
 }
 
+// Bounding rect of the non-transparent pixels of a pixmap, in pixmap pixels
+static QRectF opaqueBounds(const QPixmap& pixmap) {
+    const QImage img = pixmap.toImage().convertToFormat(QImage::Format_ARGB32);
+    int left = img.width();
+    int right = -1;
+    int top = img.height();
+    int bottom = -1;
+
+    for (int y = 0; y < img.height(); ++y) {
+        const QRgb* line = reinterpret_cast<const QRgb*>(img.constScanLine(y));
+        for (int x = 0; x < img.width(); ++x) {
+            if (qAlpha(line[x]) != 0) {
+                left = std::min(left, x);
+                right = std::max(right, x);
+                top = std::min(top, y);
+                bottom = std::max(bottom, y);
+            }
+        }
+    }
+
+    if (right < left) {
+        return QRectF();
+    }
+    return QRectF(left, top, right - left + 1, bottom - top + 1);
+}
+
 void StereoVUMeterWidget::setSkinPackage(const VUSkinPackage& skin) {
     skin_ = skin;
-    update();
+    compileSkinScales();
+    scaledAssets_[0] = VUMeterScaledAssets{};
+    scaledAssets_[1] = VUMeterScaledAssets{};
+    invalidateLayers();
 }
 
 void StereoVUMeterWidget::clearSkin() {
     loadDefaultSkin();
-    update();
+    scaledAssets_[0] = VUMeterScaledAssets{};
+    scaledAssets_[1] = VUMeterScaledAssets{};
+    invalidateLayers();
 }
 
 StereoVUMeterWidget::StereoVUMeterWidget(QWidget* parent) : QWidget(parent) {
     setAttribute(Qt::WA_OpaquePaintEvent);
     setAttribute(Qt::WA_NoSystemBackground);
 
+    strip_ = new VUMeterOverlayStrip(this);
+    strip_->hide();
+
     loadDefaultSkin();
 }
 
+void StereoVUMeterWidget::setOverlayPanels(bool history, bool spectrum) {
+    if (strip_->showsHistory() == history && strip_->showsSpectrum() == spectrum) {
+        return;
+    }
+    strip_->setPanels(history, spectrum);
+    layoutStrip();
+    invalidateLayers();
+}
+
+void StereoVUMeterWidget::setOverlaySources(const VuLevelHistory* history, const VuSpectrumAnalyzer* spectrum) {
+    strip_->setSources(history, spectrum);
+}
+
+qreal StereoVUMeterWidget::stripHeight() const {
+    const int panels = strip_->panelCount();
+    if (panels == 0) {
+        return 0.0;
+    }
+    return std::round(panels * std::max<qreal>(36.0, height() * 0.12));
+}
+
+void StereoVUMeterWidget::layoutStrip() {
+    const int h = static_cast<int>(stripHeight());
+    if (h == 0) {
+        strip_->hide();
+        return;
+    }
+    strip_->setGeometry(0, height() - h, width(), h);
+    strip_->show();
+    strip_->raise();
+}
+
+void StereoVUMeterWidget::setNeedleAtlasEnabled(bool enabled) {
+    if (needleAtlasEnabled_ != enabled) {
+        needleAtlasEnabled_ = enabled;
+        invalidateLayers();
+    }
+}
+
+qint64 StereoVUMeterWidget::needleAtlasBytes() const {
+    qint64 total = needleAtlas_[0] ? needleAtlas_[0]->bytes() : 0;
+    if (needleAtlas_[1] && needleAtlas_[1] != needleAtlas_[0]) {
+        total += needleAtlas_[1]->bytes();
+    }
+    return total;
+}
+
 void StereoVUMeterWidget::setStyle(VUMeterStyle style) {
     if (style_ != style) {
         style_ = style;
-        update();
+        invalidateLayers();
     }
 }
 
+void StereoVUMeterWidget::resizeEvent(QResizeEvent* event) {
+    QWidget::resizeEvent(event);
+    layoutStrip();
+    invalidateLayers();
+}
+
 StereoVUMeterWidget::StyleParams StereoVUMeterWidget::getStyleParams() const {
     StyleParams params;
 
@@ -113,15 +222,62 @@ StereoVUMeterWidget::StyleParams StereoVUMeterWidget::getStyleParams() const {
 void StereoVUMeterWidget::setLevels(float leftVuDb, float rightVuDb) {
     left_ = leftVuDb;
     right_ = rightVuDb;
-    update();
+
+    if (strip_->isVisible()) {
+        strip_->refresh();
+    }
+
+    if (gl_) {
+        // The GPU surface covers the widget, so paintEvent() never builds the layers
+        ensureLayers(devicePixelRatioF());
+    } else if (!layersValid_) {
+        update();
+        return;
+    }
+
+    // Repaint only the sweep between the painted and the new needle position,
+    // and nothing at all for sub-pixel moves
+    const float vus[2] = {left_, right_};
+    QRegion dirty;
+    bool moved = false;
+
+    for (int i = 0; i < 2; ++i) {
+        const float angle = needleAngle(i, vus[i]);
+        const qreal minDeltaDeg = (kMinNeedleMovePx / (needleLength_[i] * layerDpr_)) * (180.0 / kPi);
+
+        if (std::abs(angle - paintedAngle_[i]) < minDeltaDeg) {
+            continue;
+        }
+
+        moved = true;
+        if (!gl_) {
+            dirty += needleDirtyRect(i, paintedAngle_[i]).united(needleDirtyRect(i, angle)).toAlignedRect();
+        }
+    }
+
+    if (gl_) {
+        if (moved) {
+            updateGlScene();
+        }
+    } else if (!dirty.isEmpty()) {
+        update(dirty);
+    }
 }
 
-void StereoVUMeterWidget::paintEvent(QPaintEvent*) {
-    QPainter p(this);
-    p.setRenderHint(QPainter::Antialiasing, true);
-    p.setRenderHint(QPainter::TextAntialiasing, true);
+void StereoVUMeterWidget::skinMeters(const VUMeterSkin* (&meters)[2]) const {
+    if (std::holds_alternative<VUSkinSingleMeters>(skin_.meters)) {
+        const VUMeterSkin& m = std::get<VUSkinSingleMeters>(skin_.meters).vu;
+        meters[0] = &m;
+        meters[1] = &m;
+    } else {
+        const VUSkinStereoMeters& ms = std::get<VUSkinStereoMeters>(skin_.meters);
+        meters[0] = &ms.left;
+        meters[1] = &ms.right;
+    }
+}
 
-    const QRectF r = rect();
+void StereoVUMeterWidget::computeMeterRects(QRectF& leftRect, QRectF& rightRect) const {
+    const QRectF r = QRectF(rect()).adjusted(0.0, 0.0, 0.0, -stripHeight());
 
     // --- Common layout calculations (shared by all styles) ---
     const qreal outerPad = std::max<qreal>(14.0, r.width() * 0.02);
@@ -158,92 +314,507 @@ void StereoVUMeterWidget::paintEvent(QPaintEvent*) {
 
     const qreal y = inner.center().y() - meterH / 2.0;
 
-    const QRectF leftRect(inner.left(), y, meterW, meterH);
-    const QRectF rightRect(leftRect.right() + gap, y, meterW, meterH);
+    leftRect = QRectF(inner.left(), y, meterW, meterH);
+    rightRect = QRectF(leftRect.right() + gap, y, meterW, meterH);
+}
+
+void StereoVUMeterWidget::invalidateLayers() {
+    layersValid_ = false;
+
+    if (gl_) {
+        ensureLayers(devicePixelRatioF());
+        updateGlScene();
+    } else {
+        update();
+    }
+}
+
+void StereoVUMeterWidget::ensureLayers(qreal dpr) {
+    if (layersValid_ && layerDpr_ == dpr) {
+        return;
+    }
+
+    computeMeterRects(meterRects_[0], meterRects_[1]);
+
+    const QSize pixelSize = (QSizeF(size()) * dpr).toSize();
+
+    baseLayer_ = QPixmap(pixelSize);
+    baseLayer_.setDevicePixelRatio(dpr);
+    overlayLayer_ = QPixmap(pixelSize);
+    overlayLayer_.setDevicePixelRatio(dpr);
+    overlayLayer_.fill(Qt::transparent);
+
+    QPainter base(&baseLayer_);
+    QPainter overlay(&overlayLayer_);
+    for (QPainter* p : {&base, &overlay}) {
+        p->setRenderHint(QPainter::Antialiasing, true);
+        p->setRenderHint(QPainter::TextAntialiasing, true);
+        p->setFont(font());
+    }
 
-    // --- Mode switch ---
     if (style_ != VUMeterStyle::Skin) {
         // All vector-drawn styles (Original, Sony, Vintage, Modern, Black)
 
         // Background gradient
+        const QRectF r = rect();
         QLinearGradient bg(r.topLeft(), r.bottomRight());
         bg.setColorAt(0.0, QColor(20, 20, 22));
         bg.setColorAt(1.0, QColor(6, 6, 7));
-        p.fillRect(r, bg);
+        base.fillRect(r, bg);
+
+        for (int i = 0; i < 2; ++i) {
+            drawMeterFace(base, meterRects_[i]);
+            drawMeterScale(overlay, meterRects_[i]);
 
-        // Vector-drawn meters
-        drawMeter(p, leftRect, left_);
-        drawMeter(p, rightRect, right_);
+            const VectorGeometry g = vectorGeometry(meterRects_[i]);
+            needleLength_[i] = g.radius * 0.98;
+        }
     } else {
         // --- Skin mode ---
-        p.fillRect(r, Qt::black);
+        base.fillRect(rect(), Qt::black);
 
         const VUMeterSkin* meters[2] = {nullptr, nullptr};
-        if (std::holds_alternative<VUSkinSingleMeters>(skin_.meters)) {
-            const VUMeterSkin& m = std::get<VUSkinSingleMeters>(skin_.meters).vu;
-            meters[0] = &m;
-            meters[1] = &m;
+        skinMeters(meters);
+
+        for (int i = 0; i < 2; ++i) {
+            // Snap to device pixels so the pre-scaled face and cap blit 1:1
+            QRectF& r = meterRects_[i];
+            r = QRectF(std::round(r.left() * dpr) / dpr,
+                       std::round(r.top() * dpr) / dpr,
+                       std::round(r.width() * dpr) / dpr,
+                       std::round(r.height() * dpr) / dpr);
+
+            const VUMeterAssets& assets = meters[i]->assets;
+            const QSize meterPixels = (r.size() * dpr).toSize();
+
+            VUMeterScaledAssets& scaled = scaledAssets_[i];
+            if (!scaled.matches(assets, meterPixels, dpr)) {
+                // Single-meter skins draw the same assets twice; scale them once
+                if (i == 1 && meters[1] == meters[0] && scaledAssets_[0].matches(assets, meterPixels, dpr)) {
+                    scaled = scaledAssets_[0];
+                } else {
+                    scaled = scaleMeterAssets(assets, meterPixels, dpr);
+                }
+            }
+
+            base.drawPixmap(r.topLeft(), scaled.face);
+            overlay.drawPixmap(r.topLeft(), scaled.cap);
+
+            // Opaque needle area in widget coordinates at 0 degrees
+            const QRectF bounds = opaqueBounds(scaled.needle);
+            skinNeedleBounds_[i] = QRectF(r.left() + bounds.left() / dpr,
+                                          r.top() + bounds.top() / dpr,
+                                          bounds.width() / dpr,
+                                          bounds.height() / dpr);
+
+            const QPointF pivot = skinPivot(r, *meters[i]);
+            qreal length = 1.0;
+            for (const QPointF& c : {skinNeedleBounds_[i].topLeft(),
+                                     skinNeedleBounds_[i].topRight(),
+                                     skinNeedleBounds_[i].bottomLeft(),
+                                     skinNeedleBounds_[i].bottomRight()}) {
+                length = std::max(length, std::hypot(c.x() - pivot.x(), c.y() - pivot.y()));
+            }
+            needleLength_[i] = length;
+        }
+    }
+
+    const VUMeterSkin* meters[2] = {nullptr, nullptr};
+    skinMeters(meters);
+    requestNeedleAtlas(meters, dpr);
+
+    if (gl_) {
+        uploadGlLayers(dpr);
+    }
+
+    layerDpr_ = dpr;
+    layersValid_ = true;
+}
+
+void StereoVUMeterWidget::requestNeedleAtlas(const VUMeterSkin* (&meters)[2], qreal dpr) {
+    needleAtlas_[0].reset();
+    needleAtlas_[1].reset();
+
+    // A new generation makes any build still in flight stop at its next sprite
+    const std::shared_ptr<NeedleAtlasSlot> slot = atlasSlot_;
+    quint64 generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(slot->mutex);
+        generation = ++slot->generation;
+        slot->atlas[0].reset();
+        slot->atlas[1].reset();
+        slot->ready.store(false, std::memory_order_relaxed);
+    }
+
+    // The GPU backend rotates the needle texture itself
+    if (!needleAtlasEnabled_ || style_ != VUMeterStyle::Skin || gl_) {
+        return;
+    }
+
+    // QPixmap is GUI-thread only; hand the worker QImages
+    auto paramsFor = [&](int i) {
+        const VUMeterSkin& skin = *meters[i];
+        const QPixmap& needle = scaledAssets_[i].needle;
+
+        VUNeedleAtlas::Params params;
+        params.needle = needle.toImage();
+        params.pivot = QPointF(skin.calibration.pivotX * needle.width() / qreal(skin.assets.face.width()),
+                               skin.calibration.pivotY * needle.height() / qreal(skin.assets.face.height()));
+        params.devicePixelRatio = dpr;
+        params.minAngleDeg = static_cast<float>(skin.calibration.minAngle);
+        params.maxAngleDeg = static_cast<float>(skin.calibration.maxAngle);
+        return params;
+    };
+
+    const auto superseded = [slot, generation]() {
+        return slot->generation.load(std::memory_order_relaxed) != generation;
+    };
+    VUNeedleAtlas::Params left = paramsFor(0);
+    left.cancelled = superseded;
+    const bool shared = (meters[0] == meters[1]);
+    VUNeedleAtlas::Params right = shared ? VUNeedleAtlas::Params{} : paramsFor(1);
+    right.cancelled = superseded;
+
+    QThreadPool::globalInstance()->start([slot, generation, left, right, shared]() {
+        std::shared_ptr<const VUNeedleAtlas> atlasL = VUNeedleAtlas::build(left);
+        if (slot->generation.load(std::memory_order_relaxed) != generation) {
+            return;
+        }
+        std::shared_ptr<const VUNeedleAtlas> atlasR = shared ? atlasL : VUNeedleAtlas::build(right);
+
+        std::lock_guard<std::mutex> lock(slot->mutex);
+        if (slot->generation != generation) {
+            return;
+        }
+        slot->atlas[0] = std::move(atlasL);
+        slot->atlas[1] = std::move(atlasR);
+        slot->ready.store(true, std::memory_order_release);
+    });
+}
+
+void StereoVUMeterWidget::takeNeedleAtlas() {
+    if (!atlasSlot_->ready.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(atlasSlot_->mutex);
+        needleAtlas_[0] = std::move(atlasSlot_->atlas[0]);
+        needleAtlas_[1] = std::move(atlasSlot_->atlas[1]);
+        atlasSlot_->ready.store(false, std::memory_order_relaxed);
+    }
+
+    for (int i = 0; i < 2; ++i) {
+        if (needleAtlas_[i]) {
+            qCDebug(lcNeedleAtlas).nospace() << "Needle atlas " << i << ": " << needleAtlas_[i]->spriteCount()
+                                             << " sprites, " << needleAtlas_[i]->stepDeg() << " deg step, "
+                                             << needleAtlas_[i]->bytes() / 1024 << " KiB";
         } else {
-            const VUSkinStereoMeters& ms = std::get<VUSkinStereoMeters>(skin_.meters);
-            meters[0] = &ms.left;
-            meters[1] = &ms.right;
+            qCDebug(lcNeedleAtlas) << "Needle atlas" << i
+                                   << "not built (exceeds memory bound); rotating needle per frame";
+        }
+    }
+}
+
+float StereoVUMeterWidget::needleAngle(int meter, float vuDb) const {
+    if (style_ != VUMeterStyle::Skin) {
+        return singleScale_.angleDeg(vuDb);
+    }
+    return skinScales_[meter].angleDeg(vuDb);
+}
+
+void StereoVUMeterWidget::compileSkinScales() {
+    const VUMeterSkin* meters[2] = {nullptr, nullptr};
+    skinMeters(meters);
+
+    skinScales_[0] = VUMeterCompiledScale(meters[0]->scaleTable);
+    skinScales_[1] = (meters[1] == meters[0]) ? skinScales_[0] : VUMeterCompiledScale(meters[1]->scaleTable);
+}
+
+QRectF StereoVUMeterWidget::needleDirtyRect(int meter, float angleDeg) const {
+    const QRectF& r = meterRects_[meter];
+
+    if (style_ != VUMeterStyle::Skin) {
+        // The needle is a line from the pivot, clipped to the face
+        const VectorGeometry g = vectorGeometry(r);
+        const QPointF tip = polarFromBottomPivot(g.pivot, g.radius * 0.98, angleDeg);
+        const qreal pad = std::max<qreal>(3.0, r.width() * 0.008) + kNeedleDirtyMargin;
+
+        return QRectF(g.pivot, tip).normalized().adjusted(-pad, -pad, pad, pad).intersected(g.face);
+    }
+
+    const VUMeterSkin* meters[2] = {nullptr, nullptr};
+    skinMeters(meters);
+    const QPointF pivot = skinPivot(r, *meters[meter]);
+
+    QTransform t;
+    t.translate(pivot.x(), pivot.y());
+    t.rotate(angleDeg);
+    t.translate(-pivot.x(), -pivot.y());
+
+    return t.mapRect(skinNeedleBounds_[meter])
+        .adjusted(-kNeedleDirtyMargin, -kNeedleDirtyMargin, kNeedleDirtyMargin, kNeedleDirtyMargin)
+        .intersected(r);
+}
+
+bool StereoVUMeterWidget::isRenderBackendAvailable(VUMeterRenderBackend backend) {
+    if (backend == VUMeterRenderBackend::Raster) {
+        return true;
+    }
+#if defined(ANALOGVU_HAS_OPENGL) && (ANALOGVU_HAS_OPENGL == 1)
+    return VUMeterGLSurface::isSupported();
+#else
+    return false;
+#endif
+}
+
+VUMeterRenderBackend StereoVUMeterWidget::renderBackend() const {
+    return gl_ ? VUMeterRenderBackend::OpenGL : VUMeterRenderBackend::Raster;
+}
+
+bool StereoVUMeterWidget::setRenderBackend(VUMeterRenderBackend backend, QString* errorOut) {
+    if (errorOut) {
+        *errorOut = QString();
+    }
+    if (backend == renderBackend()) {
+        return true;
+    }
+
+    if (backend == VUMeterRenderBackend::Raster) {
+        delete gl_;
+        gl_ = nullptr;
+        invalidateLayers();
+        emit renderBackendChanged(VUMeterRenderBackend::Raster);
+        return true;
+    }
+
+#if defined(ANALOGVU_HAS_OPENGL) && (ANALOGVU_HAS_OPENGL == 1)
+    if (!VUMeterGLSurface::isSupported()) {
+        if (errorOut) {
+            *errorOut = tr("No OpenGL context could be created; using the software renderer.");
+        }
+        return false;
+    }
+
+    gl_ = new VUMeterGLSurface(this);
+    gl_->setGeometry(rect());
+
+    // Queued: the surface must not be deleted from inside its own initializeGL()
+    connect(
+        gl_,
+        &VUMeterGLSurface::initializationFailed,
+        this,
+        [this](const QString& reason) {
+            qDebug() << "OpenGL renderer failed, falling back to QPainter:" << reason;
+            setRenderBackend(VUMeterRenderBackend::Raster);
+        },
+        Qt::QueuedConnection);
+
+    gl_->show();
+    strip_->raise();
+    invalidateLayers();
+    emit renderBackendChanged(VUMeterRenderBackend::OpenGL);
+    return true;
+#else
+    if (errorOut) {
+        *errorOut = tr("This build has no OpenGL renderer.");
+    }
+    return false;
+#endif
+}
+
+#if defined(ANALOGVU_HAS_OPENGL) && (ANALOGVU_HAS_OPENGL == 1)
+void StereoVUMeterWidget::uploadGlLayers(qreal dpr) {
+    gl_->setGeometry(rect());
+
+    // Vector needles are clipped to the rounded face, like setClipPath() in drawMeterNeedle()
+    QImage mask;
+    if (style_ != VUMeterStyle::Skin) {
+        mask = QImage(baseLayer_.size(), QImage::Format_ARGB32_Premultiplied);
+        mask.setDevicePixelRatio(dpr);
+        mask.fill(Qt::transparent);
+
+        QPainter p(&mask);
+        p.setRenderHint(QPainter::Antialiasing, true);
+        p.setPen(Qt::NoPen);
+        p.setBrush(Qt::white);
+        for (const QRectF& r : meterRects_) {
+            const VectorGeometry g = vectorGeometry(r);
+            p.drawRoundedRect(g.face, g.faceRadius, g.faceRadius);
         }
+    }
+
+    gl_->setLayers(baseLayer_.toImage(), overlayLayer_.toImage(), mask);
+
+    for (int i = 0; i < 2; ++i) {
+        gl_->setNeedleTexture(i, style_ == VUMeterStyle::Skin ? scaledAssets_[i].needle.toImage() : QImage());
+    }
+}
+
+void StereoVUMeterWidget::updateGlScene() {
+    const float vus[2] = {left_, right_};
+    std::vector<VUMeterGLSurface::Quad> quads;
+
+    for (int i = 0; i < 2; ++i) {
+        const QRectF& r = meterRects_[i];
+        const float angle = needleAngle(i, vus[i]);
+        paintedAngle_[i] = angle;
+
+        if (style_ == VUMeterStyle::Skin) {
+            const VUMeterSkin* meters[2] = {nullptr, nullptr};
+            skinMeters(meters);
+
+            VUMeterGLSurface::Quad needle;
+            needle.rect = r;
+            needle.pivot = skinPivot(r, *meters[i]);
+            needle.angleDeg = angle;
+            needle.texture = i;
+            quads.push_back(needle);
+            continue;
+        }
+
+        // Vector needle: a bar of the pen width from the pivot to the tip, plus its shadow
+        const VectorGeometry g = vectorGeometry(r);
+        const qreal width = std::max<qreal>(3.0, r.width() * 0.008);
+        const qreal length = g.radius * 0.98;
+
+        VUMeterGLSurface::Quad needle;
+        needle.rect = QRectF(g.pivot.x() - width / 2.0, g.pivot.y() - length, width, length);
+        needle.pivot = g.pivot;
+        needle.angleDeg = angle;
+        needle.masked = true;
+
+        VUMeterGLSurface::Quad shadow = needle;
+        shadow.offset = QPointF(2.0, 2.0);
+        shadow.color = (style_ == VUMeterStyle::Black) ? QColor(0, 0, 0, 120) : QColor(0, 0, 0, 80);
+        needle.color = (style_ == VUMeterStyle::Black) ? QColor(235, 235, 240) : QColor(10, 10, 10);
+
+        quads.push_back(shadow);
+        quads.push_back(needle);
+    }
+
+    gl_->setQuads(std::move(quads));
+}
+#else
+void StereoVUMeterWidget::uploadGlLayers(qreal) {}
+
+void StereoVUMeterWidget::updateGlScene() {}
+#endif
+
+void StereoVUMeterWidget::paintEvent(QPaintEvent* event) {
+    VuScopedTimer timer(VuStage::Paint);
+    vuMetrics().add(VuCounter::Paints);
+
+    const qreal dpr = devicePixelRatioF();
+    ensureLayers(dpr);
+    takeNeedleAtlas();
+
+    QPainter p(this);
+
+    // Blits only the exposed part of a cached layer
+    auto blitLayer = [&](const QPixmap& layer) {
+        for (const QRect& r : event->region()) {
+            p.drawPixmap(QRectF(r), layer, QRectF(QPointF(r.topLeft()) * dpr, QSizeF(r.size()) * dpr));
+        }
+    };
+
+    blitLayer(baseLayer_);
+
+    p.setRenderHint(QPainter::Antialiasing, true);
+    p.setRenderHint(QPainter::TextAntialiasing, true);
+
+    const float vus[2] = {left_, right_};
 
-        const QRectF rects[2] = {leftRect, rightRect};
-        const float vus[2] = {left_, right_};
+    // --- Mode switch ---
+    if (style_ != VUMeterStyle::Skin) {
+        for (int i = 0; i < 2; ++i) {
+            drawMeterNeedle(p, meterRects_[i], vus[i]);
+        }
+    } else {
+        const VUMeterSkin* meters[2] = {nullptr, nullptr};
+        skinMeters(meters);
 
         for (int i = 0; i < 2; ++i) {
-            p.drawPixmap(rects[i], meters[i]->assets.face, meters[i]->assets.face.rect());
-            drawMeterImageOnly(p, rects[i], vus[i], *meters[i]);
+            drawMeterImageOnly(
+                p, meterRects_[i], needleAngle(i, vus[i]), *meters[i], scaledAssets_[i], needleAtlas_[i].get());
         }
     }
+
+    for (int i = 0; i < 2; ++i) {
+        paintedAngle_[i] = needleAngle(i, vus[i]);
+    }
+
+    blitLayer(overlayLayer_);
+}
+
+QPointF StereoVUMeterWidget::skinPivot(const QRectF& rect, const VUMeterSkin& skin) {
+    const qreal scaleX = rect.width() / skin.assets.face.width();
+    const qreal scaleY = rect.height() / skin.assets.face.height();
+
+    return QPointF(rect.left() + skin.calibration.pivotX * scaleX, rect.top() + skin.calibration.pivotY * scaleY);
 }
 
+// Needle only; the face and cap come from the cached layers
 void StereoVUMeterWidget::drawMeterImageOnly(QPainter& p,
                                              const QRectF& rect,
-                                             float vuDb,
-                                             const VUMeterSkin& skin) {
+                                             float angleDeg,
+                                             const VUMeterSkin& skin,
+                                             const VUMeterScaledAssets& scaled,
+                                             const VUNeedleAtlas* atlas) {
+    // --- Pre-rotated sprite, if the atlas covers this angle ---
+    if (atlas) {
+        if (const VUNeedleAtlas::Sprite* sprite = atlas->nearest(angleDeg)) {
+            const qreal dpr = sprite->image.devicePixelRatio();
+            p.drawImage(rect.topLeft() + QPointF(sprite->offset) / dpr, sprite->image);
+            return;
+        }
+    }
+
     p.save();
 
     // --- Compute pivot in widget coordinates ---
-    const qreal scaleX = rect.width() / skin.assets.face.width();
-    const qreal scaleY = rect.height() / skin.assets.face.height();
+    const QPointF pivot = skinPivot(rect, skin);
 
-    const QPointF pivot(rect.left() + skin.calibration.pivotX * scaleX, rect.top() + skin.calibration.pivotY * scaleY);
+    // --- Rotate ONLY the needle ---
+    // Rotate around pivot
+    p.translate(pivot);
+    p.rotate(angleDeg);
+    p.translate(-pivot);
 
-    // --- Compute rotation angle ---
-    const float angleDeg = vuToAngleDeg(vuDb, skin.scaleTable);
+    // Pre-scaled needle: the painter only has to rotate, not rescale
+    p.setRenderHint(QPainter::SmoothPixmapTransform, true);
+    p.drawPixmap(rect.topLeft(), scaled.needle);
 
-    // --- Rotate ONLY the needle ---
-    {
-        p.save();
+    p.restore();
+}
 
-        // Rotate around pivot
-        p.translate(pivot);
-        p.rotate(angleDeg);
-        p.translate(-pivot);
+StereoVUMeterWidget::VectorGeometry StereoVUMeterWidget::vectorGeometry(const QRectF& rect) {
+    VectorGeometry g;
 
-        // Draw needle exactly as before (same rect)
-        p.drawPixmap(rect, skin.assets.needle, skin.assets.needle.rect());
+    // --- Frame ---
+    g.frameRadius = std::min(rect.width(), rect.height()) * 0.06;
 
-        p.restore(); // <-- restores painter so cap is NOT rotated
-    }
+    // --- Face ---
+    const qreal inset = std::max<qreal>(10.0, rect.width() * 0.04);
+    g.face = rect.adjusted(inset, inset, -inset, -inset);
+    g.faceRadius = g.frameRadius * 0.75;
 
-    // --- Draw cap overlay (no rotation) ---
-    p.drawPixmap(rect, skin.assets.cap, skin.assets.cap.rect());
+    // --- Geometry ---
+    g.pivot = QPointF(g.face.center().x(), g.face.bottom() + g.face.height() * 0.35);
+    g.radius = std::min(g.face.width(), g.face.height()) * 1.00;
 
-    p.restore();
+    return g;
 }
 
-void StereoVUMeterWidget::drawMeter(QPainter& p, const QRectF& rect, float vuDb) {
+// Static layer below the needle: frame and face
+void StereoVUMeterWidget::drawMeterFace(QPainter& p, const QRectF& rect) {
     p.save();
     
     // Get style-dependent parameters
     const StyleParams sp = getStyleParams();
+    const VectorGeometry g = vectorGeometry(rect);
 
     // --- Frame ---
-    const qreal frameRadius = std::min(rect.width(), rect.height()) * 0.06;
-
     QLinearGradient frameGrad(rect.topLeft(), rect.bottomRight());
     frameGrad.setColorAt(0.0, QColor(60, 62, 66));
     frameGrad.setColorAt(0.5, QColor(26, 27, 29));
@@ -251,54 +822,67 @@ void StereoVUMeterWidget::drawMeter(QPainter& p, const QRectF& rect, float vuDb)
 
     p.setPen(QPen(QColor(0, 0, 0, 160), 2.0));
     p.setBrush(frameGrad);
-    p.drawRoundedRect(rect, frameRadius, frameRadius);
+    p.drawRoundedRect(rect, g.frameRadius, g.frameRadius);
 
     // --- Face ---
-    const qreal inset = std::max<qreal>(10.0, rect.width() * 0.04);
-    const QRectF face = rect.adjusted(inset, inset, -inset, -inset);
-    const qreal faceRadius = frameRadius * 0.75;
-
-    QLinearGradient faceGrad(face.topLeft(), face.bottomLeft());
+    QLinearGradient faceGrad(g.face.topLeft(), g.face.bottomLeft());
     faceGrad.setColorAt(0.0, sp.faceColorTop);
     faceGrad.setColorAt(1.0, sp.faceColorBottom);
 
     p.setPen(QPen(QColor(0, 0, 0, 90), 1.5));
     p.setBrush(faceGrad);
-    p.drawRoundedRect(face, faceRadius, faceRadius);
+    p.drawRoundedRect(g.face, g.faceRadius, g.faceRadius);
 
-    // --- Geometry ---
-    const QPointF pivot(face.center().x(), face.bottom() + face.height() * 0.35);
-    const qreal radius = std::min(face.width(), face.height()) * 1.00;
+    p.restore();
+}
+
+// Dynamic part, drawn every frame between the two layers
+void StereoVUMeterWidget::drawMeterNeedle(QPainter& p, const QRectF& rect, float vuDb) {
+    const VectorGeometry g = vectorGeometry(rect);
+    const QRectF& face = g.face;
+    const QPointF& pivot = g.pivot;
+    const qreal radius = g.radius;
 
-    const float theta = vuToAngleDeg(vuDb, singleScaleTable_);
+    const float theta = singleScale_.angleDeg(vuDb);
 
     // --- Draw needle with clipping to face area ---
     // This makes the needle visible only within the face, hiding the pivot area
-    {
-        p.save();
-        
-        // Create clipping path for the face (rounded rectangle)
-        QPainterPath clipPath;
-        clipPath.addRoundedRect(face, faceRadius, faceRadius);
-        p.setClipPath(clipPath);
-        
-        // --- Needle shadow ---
-        const QPointF needleTip = polarFromBottomPivot(pivot, radius * 0.98, theta);
-        const QPointF shadowTip = needleTip + QPointF(2.0, 2.0);
-
-        // For Black style, use lighter shadow; for others, dark shadow
-        QColor shadowColor = (style_ == VUMeterStyle::Black) ? QColor(0, 0, 0, 120) : QColor(0, 0, 0, 80);
-        p.setPen(QPen(shadowColor, std::max<qreal>(3.0, rect.width() * 0.008), Qt::SolidLine, Qt::RoundCap));
-        p.drawLine(pivot + QPointF(2.0, 2.0), shadowTip);
-
-        // --- Needle ---
-        // For Black style, use white needle; for others, black needle
-        QColor needleColor = (style_ == VUMeterStyle::Black) ? QColor(235, 235, 240) : QColor(10, 10, 10);
-        p.setPen(QPen(needleColor, std::max<qreal>(3.0, rect.width() * 0.008), Qt::SolidLine, Qt::RoundCap));
-        p.drawLine(pivot, needleTip);
-        
-        p.restore();  // Restore clipping
-    }
+    p.save();
+    
+    // Create clipping path for the face (rounded rectangle)
+    QPainterPath clipPath;
+    clipPath.addRoundedRect(face, g.faceRadius, g.faceRadius);
+    p.setClipPath(clipPath, Qt::IntersectClip);
+    
+    // --- Needle shadow ---
+    const QPointF needleTip = polarFromBottomPivot(pivot, radius * 0.98, theta);
+    const QPointF shadowTip = needleTip + QPointF(2.0, 2.0);
+
+    // For Black style, use lighter shadow; for others, dark shadow
+    QColor shadowColor = (style_ == VUMeterStyle::Black) ? QColor(0, 0, 0, 120) : QColor(0, 0, 0, 80);
+    p.setPen(QPen(shadowColor, std::max<qreal>(3.0, rect.width() * 0.008), Qt::SolidLine, Qt::RoundCap));
+    p.drawLine(pivot + QPointF(2.0, 2.0), shadowTip);
+
+    // --- Needle ---
+    // For Black style, use white needle; for others, black needle
+    QColor needleColor = (style_ == VUMeterStyle::Black) ? QColor(235, 235, 240) : QColor(10, 10, 10);
+    p.setPen(QPen(needleColor, std::max<qreal>(3.0, rect.width() * 0.008), Qt::SolidLine, Qt::RoundCap));
+    p.drawLine(pivot, needleTip);
+    
+    p.restore();  // Restore clipping
+}
+
+// Static layer above the needle: bezel, arcs, ticks, labels and "VU" text
+void StereoVUMeterWidget::drawMeterScale(QPainter& p, const QRectF& rect) {
+    p.save();
+    
+    // Get style-dependent parameters
+    const StyleParams sp = getStyleParams();
+    const VectorGeometry g = vectorGeometry(rect);
+    const QRectF& face = g.face;
+    const QPointF& pivot = g.pivot;
+    const qreal radius = g.radius;
+    const qreal frameRadius = g.frameRadius;
 
     // --- Bezel (drawn after needle so it appears on top) ---
     const qreal bezelInset = std::max<qreal>(6.0, rect.width() * 0.02);
@@ -331,8 +915,8 @@ void StereoVUMeterWidget::drawMeter(QPainter& p, const QRectF& rect, float vuDb)
 
     // Scale angles
     const float aMin = -48.0f;
-    const float a0 = vuToAngleDeg(0.0f, singleScaleTable_); // +18°
-    const float a3 = vuToAngleDeg(3.0f, singleScaleTable_); // +47°
+    const float a0 = singleScale_.angleDeg(0.0f); // +18°
+    const float a3 = singleScale_.angleDeg(3.0f); // +47°
 
     auto arcStart = [](float logicalEndDeg) { return int((90.0f - logicalEndDeg) * 16.0f); };
     auto arcSpan = [](float logicalStartDeg, float logicalEndDeg) {
@@ -353,7 +937,7 @@ void StereoVUMeterWidget::drawMeter(QPainter& p, const QRectF& rect, float vuDb)
         bool major = (v == -20.0f || v == -10.0f || v == -7.0f || v == -5.0f || v == -3.0f || v == -2.0f ||
                       v == -1.0f || v == 0.0f || v == 1.0f || v == 2.0f || v == 3.0f);
 
-        const float a = vuToAngleDeg(v, singleScaleTable_);
+        const float a = singleScale_.angleDeg(v);
 
         const QPointF p1 = polarFromBottomPivot(pivot, tickR1, a);
         const QPointF p2 = polarFromBottomPivot(pivot, major ? tickR2Major : tickR2Minor, a);
@@ -461,5 +1045,6 @@ void StereoVUMeterWidget::loadDefaultSkin() {
     skin_.importedFrom.clear();
     skin_.meters = VUSkinSingleMeters{s};
 
-    singleScaleTable_ = builtInDefaultScaleTable();
+    singleScale_ = builtInDefaultScale();
+    compileSkinScales();
 }
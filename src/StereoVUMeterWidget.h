@@ -1,15 +1,26 @@
 #pragma once
 
 #include <QFont>
+#include <QPixmap>
+#include <QRectF>
 #include <QWidget>
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+
 #include "VUMeterScale.h"
 #include "VUMeterSkin.h"
+#include "VUNeedleAtlas.h"
 
 class QPaintEvent;
 class QPainter;
-class QRectF;
+class QResizeEvent;
 class QString;
+class VUMeterGLSurface;
+class VUMeterOverlayStrip;
+class VuLevelHistory;
+class VuSpectrumAnalyzer;
 
 // VU Meter visual styles
 enum class VUMeterStyle {
@@ -20,6 +31,12 @@ enum class VUMeterStyle {
     Skin      // Image based graphics
 };
 
+// Drawing backend for the meter
+enum class VUMeterRenderBackend {
+    Raster, // QPainter on the raster engine (always available)
+    OpenGL  // GPU compositing through VUMeterGLSurface (ANALOGVU_HAS_OPENGL builds)
+};
+
 class StereoVUMeterWidget final : public QWidget {
     Q_OBJECT
 
@@ -32,18 +49,133 @@ class StereoVUMeterWidget final : public QWidget {
     void clearSkin();
 
     void setSkinPackage(const VUSkinPackage& skin);
+    const VUSkinPackage& skinPackage() const { return skin_; }
+
+    // Skin mode: blit needle sprites pre-rendered across the calibrated angle
+    // range instead of rotating the needle every frame. The atlas is built on
+    // a background thread after each skin/size change; until it is ready (or
+    // if it does not fit VUNeedleAtlas::kDefaultMaxBytes) the needle is rotated.
+    void setNeedleAtlasEnabled(bool enabled);
+    bool needleAtlasEnabled() const { return needleAtlasEnabled_; }
+
+    // Memory held by the active needle atlases
+    qint64 needleAtlasBytes() const;
+
+    // Switch the drawing backend at runtime. Selecting OpenGL fails (and
+    // keeps Raster) when the build has no OpenGL support or no GPU context
+    // can be created; a later GPU failure falls back to Raster as well.
+    bool setRenderBackend(VUMeterRenderBackend backend, QString* errorOut = nullptr);
+    VUMeterRenderBackend renderBackend() const;
+    static bool isRenderBackendAvailable(VUMeterRenderBackend backend);
+
+    // Strip under the meters with the level history and/or the spectrum
+    // (VUMeterOverlayStrip); the meters shrink to make room. The sources may
+    // be null and must outlive the widget or be reset first.
+    void setOverlayPanels(bool history, bool spectrum);
+    void setOverlaySources(const VuLevelHistory* history, const VuSpectrumAnalyzer* spectrum);
+
+  signals:
+    // Emitted whenever the active backend changes, including automatic fallback
+    void renderBackendChanged(VUMeterRenderBackend backend);
 
   protected:
     void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
 
   private:
     float left_ = -20.0f;
     float right_ = -20.0f;
     VUMeterStyle style_ = VUMeterStyle::Skin;
 
-    void drawMeter(QPainter& p, const QRectF& rect, float vuDb);
-    void drawMeterImageOnly(QPainter& p, const QRectF& rect, float vuDb, const VUMeterSkin& skin);
-    VUMeterScaleTable singleScaleTable_;
+    // Vector styles are drawn in three parts: the face below the needle and the
+    // scale (bezel, arcs, ticks, labels, "VU" text) above it are static and
+    // rendered into the cached layers; only the needle is drawn per frame.
+    struct VectorGeometry {
+        QRectF face;
+        qreal frameRadius;
+        qreal faceRadius;
+        QPointF pivot;
+        qreal radius;
+    };
+    static VectorGeometry vectorGeometry(const QRectF& rect);
+
+    void drawMeterFace(QPainter& p, const QRectF& rect);
+    void drawMeterNeedle(QPainter& p, const QRectF& rect, float vuDb);
+    void drawMeterScale(QPainter& p, const QRectF& rect);
+
+    // Skin needle at a precomputed angle; face and cap are part of the cached layers
+    void drawMeterImageOnly(QPainter& p,
+                            const QRectF& rect,
+                            float angleDeg,
+                            const VUMeterSkin& skin,
+                            const VUMeterScaledAssets& scaled,
+                            const VUNeedleAtlas* atlas);
+    static QPointF skinPivot(const QRectF& rect, const VUMeterSkin& skin);
+
+    void skinMeters(const VUMeterSkin* (&meters)[2]) const;
+    void computeMeterRects(QRectF& leftRect, QRectF& rightRect) const;
+
+    // --- Cached static layers ---
+    // Rebuilt on resize, style/skin change or a new device pixel ratio. Each
+    // frame blits the exposed part of baseLayer_, draws the needles and blits
+    // overlayLayer_ on top.
+    void invalidateLayers();
+    void ensureLayers(qreal dpr);
+
+    float needleAngle(int meter, float vuDb) const;
+    QRectF needleDirtyRect(int meter, float angleDeg) const;
+
+    QPixmap baseLayer_;
+    QPixmap overlayLayer_;
+    bool layersValid_ = false;
+    qreal layerDpr_ = 1.0;
+
+    QRectF meterRects_[2];
+
+    // Skin assets pre-scaled to meterRects_ at layerDpr_; kept across layer
+    // rebuilds while the meter size, DPR and source pixmaps are unchanged
+    VUMeterScaledAssets scaledAssets_[2];
+    QRectF skinNeedleBounds_[2]; // opaque needle area at 0 degrees, widget coordinates
+    qreal needleLength_[2] = {1.0, 1.0};
+
+    // --- GPU backend ---
+    // The surface composites the same cached layers; only needle quads change per frame.
+    void uploadGlLayers(qreal dpr);
+    void updateGlScene();
+
+    VUMeterGLSurface* gl_ = nullptr;
+
+    // --- Overlay strip ---
+    // A child above the meters (and the GPU surface), refreshed from setLevels()
+    qreal stripHeight() const;
+    void layoutStrip();
+
+    VUMeterOverlayStrip* strip_ = nullptr;
+
+    // --- Needle sprite atlas ---
+    // Filled by the background build; shared with the worker so a build can
+    // finish after a newer request (or the widget) has gone away.
+    struct NeedleAtlasSlot {
+        std::mutex mutex;
+        std::atomic<quint64> generation{0}; // written under mutex; builds poll it to stop early
+        std::shared_ptr<const VUNeedleAtlas> atlas[2];
+        std::atomic<bool> ready{false};
+    };
+
+    void requestNeedleAtlas(const VUMeterSkin* (&meters)[2], qreal dpr);
+    void takeNeedleAtlas();
+
+    bool needleAtlasEnabled_ = false;
+    std::shared_ptr<NeedleAtlasSlot> atlasSlot_ = std::make_shared<NeedleAtlasSlot>();
+    std::shared_ptr<const VUNeedleAtlas> needleAtlas_[2];
+
+    // Needle angles of the last paint, for dirty-region tracking
+    float paintedAngle_[2] = {0.0f, 0.0f};
+
+    // Scale tables compiled once per skin/style change for per-frame lookups
+    VUMeterCompiledScale singleScale_;
+    VUMeterCompiledScale skinScales_[2];
+    void compileSkinScales();
 
     // Style-dependent parameters
     struct StyleParams {
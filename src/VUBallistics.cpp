@@ -1,53 +1,112 @@
 #include "VUBallistics.h"
 
 #include <algorithm>
+#include <cstddef>
 #include <cmath>
-#include <cstdlib>
 
-VUBallistics::VUBallistics(float initialDb) : value_(initialDb), peak_(initialDb) {}
+#include "VuFastMath.h"
 
-void VUBallistics::reset(float valueDb) {
-    value_ = valueDb;
-    peak_ = valueDb;
-}
+// --- Vintage hi-fi timing ---
+// These values are based on measurements of Pioneer / Sansui meters.
+static constexpr float kAttackTau = 0.080f;  // Pioneer fast attack (~80 ms)
+static constexpr float kReleaseTau = 0.320f; // Pioneer medium release (~320 ms)
+
+// --- Peak follower for overshoot ---
+static constexpr float kPeakAttackTau = 0.010f;  // slightly faster peak rise
+static constexpr float kPeakReleaseTau = 0.200f; // slightly faster fall
+
+// Vintage hi-fi meters often overshoot by 5–10% on transients.
+static constexpr float kOvershootMix = 0.07f; // Pioneer overshoot ~7%
+
+// Needle "life": ±0.001 dB is enough to feel alive without looking fake.
+static constexpr float kJitterDb = 0.001f;
 
-static float onePole(float y, float x, float dt, float tau) {
+// Default control step for step() (1 kHz control rate)
+static constexpr float kDefaultControlDt = 0.001f;
+
+static float onePoleCoefficient(float dt, float tau) {
     if (tau <= 0.0f) {
-        return x;
+        return 0.0f;
+    }
+    return std::exp(-dt / tau);
+}
+
+static float onePole(float y, float x, float a) { return a * y + (1.0f - a) * x; }
+
+VUBallisticsBank::VUBallisticsBank(float initialDb) {
+    reset(initialDb);
+    setControlStep(kDefaultControlDt);
+}
+
+void VUBallisticsBank::reset(float valueDb) {
+    value_.fill(valueDb);
+    peak_.fill(valueDb);
+}
+
+void VUBallisticsBank::reset(unsigned int channel, float valueDb) {
+    if (channel >= kVuMaxChannels) {
+        return;
+    }
+    value_[channel] = valueDb;
+    peak_[channel] = valueDb;
+}
+
+void VUBallisticsBank::output(float* outDb, unsigned int channels) {
+    for (unsigned int c = 0; c < channels; ++c) {
+        outDb[c] = value_[c] + kOvershootMix * (peak_[c] - value_[c]);
+    }
+
+    if (jitterEnabled_) {
+        for (unsigned int c = 0; c < channels; ++c) {
+            outDb[c] += rng_.symmetric(kJitterDb);
+        }
     }
-    const float a = std::exp(-dt / tau);
-    return a * y + (1.0f - a) * x;
 }
 
 // Vintage Hi-Fi VU ballistics
 // Smooth, slightly eager attack, gentle decay, tasteful overshoot, no drift.
-
-float VUBallistics::process(float targetDb, float dtSeconds) {
+void VUBallisticsBank::process(const float* targetDb, float* outDb, unsigned int channels, float dtSeconds) {
+    channels = std::min(channels, kVuMaxChannels);
     dtSeconds = std::max(0.000001f, dtSeconds);
 
-    // --- Vintage hi-fi timing ---
-    // These values are based on measurements of Pioneer / Sansui meters.
-    const float attackTau = 0.080f;  // Pioneer fast attack (~80 ms)
-    const float releaseTau = 0.320f; // Pioneer medium release (~320 ms)
+    // Four coefficients per distinct dt instead of two std::exp per channel
+    if (dtSeconds != processDt_) {
+        processDt_ = dtSeconds;
+        const float taus[] = {kAttackTau, kReleaseTau, kPeakAttackTau, kPeakReleaseTau};
+        for (std::size_t i = 0; i < processA_.size(); ++i) {
+            processA_[i] = fastMath_ ? vuFastExp(-dtSeconds / taus[i]) : onePoleCoefficient(dtSeconds, taus[i]);
+        }
+    }
+    const float attackA = processA_[0];
+    const float releaseA = processA_[1];
+    const float peakAttackA = processA_[2];
+    const float peakReleaseA = processA_[3];
+
+    for (unsigned int c = 0; c < channels; ++c) {
+        const float x = targetDb[c];
+        value_[c] = onePole(value_[c], x, (x > value_[c]) ? attackA : releaseA);
+        peak_[c] = onePole(peak_[c], x, (x > peak_[c]) ? peakAttackA : peakReleaseA);
+    }
 
-    const float tau = (targetDb > value_) ? attackTau : releaseTau;
-    value_ = onePole(value_, targetDb, dtSeconds, tau);
+    output(outDb, channels);
+}
 
-    // --- Peak follower for overshoot ---
-    const float peakAttackTau = 0.010f;  // slightly faster peak rise
-    const float peakReleaseTau = 0.200f; // slightly faster fall
-    const float peakTau = (targetDb > peak_) ? peakAttackTau : peakReleaseTau;
-    peak_ = onePole(peak_, targetDb, dtSeconds, peakTau);
+void VUBallisticsBank::setControlStep(float dtSeconds) {
+    controlDt_ = std::max(0.000001f, dtSeconds);
+    attackA_ = onePoleCoefficient(controlDt_, kAttackTau);
+    releaseA_ = onePoleCoefficient(controlDt_, kReleaseTau);
+    peakAttackA_ = onePoleCoefficient(controlDt_, kPeakAttackTau);
+    peakReleaseA_ = onePoleCoefficient(controlDt_, kPeakReleaseTau);
+}
 
-    // --- Overshoot mix ---
-    // Vintage hi-fi meters often overshoot by 5–10% on transients.
-    const float overshootMix = 0.07f; // Pioneer overshoot ~7%
-    float out = value_ + overshootMix * (peak_ - value_);
+void VUBallisticsBank::step(const float* targetDb, float* outDb, unsigned int channels) {
+    channels = std::min(channels, kVuMaxChannels);
 
-    // --- Micro-jitter (needle vibration) ---
-    // ±0.02 dB is enough to feel alive without looking fake.
-    float jitter = ((rand() % 40) / 20000.0f) - 0.001f; // ±0.001 dB
-    out += jitter;
+    for (unsigned int c = 0; c < channels; ++c) {
+        const float x = targetDb[c];
+        value_[c] = onePole(value_[c], x, (x > value_[c]) ? attackA_ : releaseA_);
+        peak_[c] = onePole(peak_[c], x, (x > peak_[c]) ? peakAttackA_ : peakReleaseA_);
+    }
 
-    return out;
+    output(outDb, channels);
 }
@@ -1,13 +1,96 @@
 #pragma once
 
-class VUBallistics final {
+#include <array>
+#include <cstdint>
+
+// Upper bound on channels metered per stream. Fixed so per-channel DSP and
+// ballistics state never allocates (covers 5.1/7.1 and 16/32-channel interfaces).
+inline constexpr unsigned int kVuMaxChannels = 32;
+
+// Needle micro-jitter source: xorshift32, one per ballistics instance, so
+// meters on different threads never share state and a fixed seed gives
+// bit-reproducible output.
+class VuJitterRng final {
+  public:
+    static constexpr std::uint32_t kDefaultSeed = 0x9E3779B9u;
+
+    explicit VuJitterRng(std::uint32_t seed = kDefaultSeed) { setSeed(seed); }
+
+    // Distinct, reproducible seed for stream n (meter source index); 0 keeps
+    // kDefaultSeed so a single-source run is unchanged
+    static constexpr std::uint32_t seedFor(unsigned int stream) { return kDefaultSeed + stream * 0x85EBCA6Bu; }
+
+    // xorshift has a single zero fixed point; remap it
+    void setSeed(std::uint32_t seed) { state_ = seed ? seed : kDefaultSeed; }
+
+    std::uint32_t next() {
+        std::uint32_t x = state_;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        state_ = x;
+        return x;
+    }
+
+    // Uniform in [-amplitude, amplitude)
+    float symmetric(float amplitude) {
+        const float unit = static_cast<float>(next() >> 8) * (1.0f / 16777216.0f); // [0, 1)
+        return amplitude * (2.0f * unit - 1.0f);
+    }
+
+  private:
+    std::uint32_t state_ = kDefaultSeed;
+};
+
+// Structure-of-arrays bank of needle ballistics channels with identical
+// timing. Each call advances the first `channels` entries in one loop; a
+// single meter is a bank metered with channels = 1.
+class VUBallisticsBank final {
   public:
-    explicit VUBallistics(float initialDb = -20.0f);
+    explicit VUBallisticsBank(float initialDb = -20.0f);
 
-    float process(float targetDb, float dtSeconds);
     void reset(float valueDb);
+    void reset(unsigned int channel, float valueDb);
+
+    void process(const float* targetDb, float* outDb, unsigned int channels, float dtSeconds);
+
+    // Block-accurate mode: precompute the one-pole coefficients for a fixed
+    // control step, then advance one step per step() call without std::exp.
+    void setControlStep(float dtSeconds);
+    float controlStep() const { return controlDt_; }
+    void step(const float* targetDb, float* outDb, unsigned int channels);
+
+    // Micro-jitter on the output. Disable for golden renders; reseed to
+    // reproduce a run exactly. One generator is shared by the channels.
+    void setJitterEnabled(bool enabled) { jitterEnabled_ = enabled; }
+    bool jitterEnabled() const { return jitterEnabled_; }
+    void setJitterSeed(std::uint32_t seed) { rng_.setSeed(seed); }
+
+    // Compute process() coefficients with vuFastExp (VuMathMode::Fast)
+    void setFastMath(bool enabled) {
+        fastMath_ = enabled;
+        processDt_ = 0.0f;
+    }
+    bool fastMath() const { return fastMath_; }
 
   private:
-    float value_;
-    float peak_;
+    void output(float* outDb, unsigned int channels);
+
+    std::array<float, kVuMaxChannels> value_;
+    std::array<float, kVuMaxChannels> peak_;
+
+    VuJitterRng rng_;
+    bool jitterEnabled_ = true;
+
+    float controlDt_ = 0.0f;
+    float attackA_ = 0.0f;
+    float releaseA_ = 0.0f;
+    float peakAttackA_ = 0.0f;
+    float peakReleaseA_ = 0.0f;
+
+    // process() coefficients for the last dt; a steady fragment size needs
+    // no std::exp at all
+    bool fastMath_ = false;
+    float processDt_ = 0.0f;
+    std::array<float, 4> processA_{}; // attack, release, peak attack, peak release
 };
@@ -0,0 +1,227 @@
+#include "VUFrameScheduler.h"
+
+#include "VuMetrics.h"
+
+#include <QEvent>
+#include <QScreen>
+#include <QWidget>
+#include <QWindow>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+std::int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// An interval this many frame periods long counts as a missed frame
+constexpr double kMissedFrameFactor = 1.5;
+
+} // namespace
+
+VUFrameScheduler::VUFrameScheduler(QWidget* target, SourceFn source, QObject* parent)
+    : QObject(parent), target_(target), source_(std::move(source)) {
+    idleTimer_.setInterval(kIdleIntervalMs);
+    idleTimer_.setTimerType(Qt::CoarseTimer);
+    connect(&idleTimer_, &QTimer::timeout, this, &VUFrameScheduler::tick);
+
+    // The native window only exists once the widget is shown
+    target_->installEventFilter(this);
+}
+
+void VUFrameScheduler::start() {
+    running_ = true;
+    attachWindow();
+    setMode(windowVisible() ? visibleMode() : Mode::Paused);
+}
+
+void VUFrameScheduler::stop() {
+    running_ = false;
+    setMode(Mode::Paused);
+}
+
+void VUFrameScheduler::setInputIdle(bool idle) {
+    inputIdle_ = idle;
+    if (!running_ || mode_ == Mode::Paused) {
+        return;
+    }
+    if (idle) {
+        // One last tick so the needles are drawn where the DSP left them
+        tick();
+        setMode(Mode::Dormant);
+    } else {
+        setMode(Mode::Active);
+    }
+}
+
+double VUFrameScheduler::refreshRateHz() const {
+    if (!window_ || !window_->screen()) {
+        return 0.0;
+    }
+    return window_->screen()->refreshRate();
+}
+
+void VUFrameScheduler::attachWindow() {
+    QWindow* window = target_->windowHandle();
+    if (!window || window == window_) {
+        return;
+    }
+
+    if (window_) {
+        window_->removeEventFilter(this);
+        disconnect(window_, nullptr, this, nullptr);
+    }
+
+    window_ = window;
+    window_->installEventFilter(this);
+    connect(window_, &QWindow::visibilityChanged, this, [this](QWindow::Visibility) {
+        if (running_) {
+            setMode(windowVisible() ? visibleMode() : Mode::Paused);
+        }
+    });
+}
+
+bool VUFrameScheduler::windowVisible() const {
+    return window_ && window_->isExposed() && window_->visibility() != QWindow::Minimized &&
+           window_->visibility() != QWindow::Hidden;
+}
+
+bool VUFrameScheduler::eventFilter(QObject* watched, QEvent* event) {
+    if (watched == target_) {
+        if (event->type() == QEvent::Show && running_) {
+            attachWindow();
+        }
+        return false;
+    }
+
+    if (watched == window_) {
+        switch (event->type()) {
+        case QEvent::UpdateRequest:
+            // Runs before QWidgetWindow syncs the backing store, so needle
+            // updates made here are painted in this same frame
+            if (mode_ == Mode::Active) {
+                noteActiveFrame(steadyNowNs());
+                tick();
+            }
+            break;
+        case QEvent::Expose:
+            if (running_ && mode_ == Mode::Paused && windowVisible()) {
+                setMode(visibleMode());
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    return false;
+}
+
+void VUFrameScheduler::setMode(Mode mode) {
+    if (!running_) {
+        mode = Mode::Paused;
+    }
+
+    if (mode == mode_) {
+        return;
+    }
+    mode_ = mode;
+    staticFrames_ = 0;
+    lastFrameNs_ = 0;
+
+    if (mode_ == Mode::Idle) {
+        idleTimer_.start();
+    } else {
+        idleTimer_.stop();
+    }
+
+    if (mode_ == Mode::Active && window_) {
+        window_->requestUpdate();
+    }
+
+    emit modeChanged(mode_);
+}
+
+void VUFrameScheduler::noteActiveFrame(std::int64_t nowNs) {
+    const std::int64_t last = lastFrameNs_;
+    lastFrameNs_ = nowNs;
+    if (last == 0 || nowNs <= last) {
+        return;
+    }
+
+    const std::int64_t intervalNs = nowNs - last;
+    vuMetrics().record(VuStage::FrameInterval, static_cast<std::uint64_t>(intervalNs));
+
+    const double refresh = refreshRateHz();
+    if (refresh <= 0.0) {
+        return;
+    }
+    const double periodNs = 1e9 / refresh;
+    if (static_cast<double>(intervalNs) > kMissedFrameFactor * periodNs) {
+        const auto missed = static_cast<std::uint64_t>(std::llround(static_cast<double>(intervalNs) / periodNs)) - 1;
+        vuMetrics().add(VuCounter::MissedFrames, std::max<std::uint64_t>(missed, 1));
+    }
+}
+
+void VUFrameScheduler::interpolate(std::int64_t nowNs, float& left, float& right) const {
+    const std::int64_t gap = last_.timestampNs - prev_.timestampNs;
+
+    if (prev_.timestampNs == 0 || gap <= 0 || gap > kMaxInterpGapNs) {
+        left = last_.leftVuDb;
+        right = last_.rightVuDb;
+        return;
+    }
+
+    // Render one DSP interval behind: at last_.timestampNs the needle is at
+    // prev_, and it reaches last_ one interval later.
+    const float t = std::clamp(static_cast<float>(nowNs - last_.timestampNs) / static_cast<float>(gap), 0.0f, 1.0f);
+    left = prev_.leftVuDb + (last_.leftVuDb - prev_.leftVuDb) * t;
+    right = prev_.rightVuDb + (last_.rightVuDb - prev_.rightVuDb) * t;
+}
+
+void VUFrameScheduler::tick() {
+    if (!running_) {
+        return;
+    }
+
+    if (!windowVisible()) {
+        setMode(Mode::Paused);
+        return;
+    }
+
+    const Sample s = source_();
+    if (s.timestampNs == 0 || s.timestampNs != last_.timestampNs) {
+        prev_ = last_;
+        last_ = s;
+    }
+
+    float left = 0.0f;
+    float right = 0.0f;
+    interpolate(steadyNowNs(), left, right);
+
+    const bool moved =
+        std::abs(left - shownLeft_) >= kStaticDeltaDb || std::abs(right - shownRight_) >= kStaticDeltaDb;
+    shownLeft_ = left;
+    shownRight_ = right;
+
+    emit frame(left, right);
+
+    if (moved) {
+        staticFrames_ = 0;
+        if (mode_ == Mode::Idle) {
+            setMode(Mode::Active);
+            return;
+        }
+    } else if (mode_ == Mode::Active && ++staticFrames_ >= kIdleAfterFrames) {
+        setMode(Mode::Idle);
+        return;
+    }
+
+    if (mode_ == Mode::Active) {
+        window_->requestUpdate();
+    }
+}
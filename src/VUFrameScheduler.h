@@ -0,0 +1,106 @@
+#pragma once
+
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+
+#include <cstdint>
+#include <functional>
+
+class QWidget;
+class QWindow;
+
+// Paces meter repaints to the display instead of a fixed timer.
+//
+// While the needles move, the scheduler ticks on QWindow::requestUpdate(),
+// which Qt delivers at the screen's refresh rate (frame callbacks on Wayland,
+// the display link on macOS, a refresh-rate timer elsewhere). Each tick reads
+// the latest DSP levels and interpolates between the last two DSP updates by
+// their timestamps, so the needle moves every frame even when the capture
+// fragment period is longer than the frame period.
+//
+// When the levels stop changing (or the input is silent) it drops to a slow
+// poll, and while the window is hidden or minimized it stops waking up at all.
+// Once the capture side reports the input idle (VuIdleMonitor) the poll stops
+// too, until the input wakes it.
+class VUFrameScheduler final : public QObject {
+    Q_OBJECT
+
+  public:
+    enum class Mode {
+        Active, // one tick per display frame
+        Idle,    // levels static: slow poll to notice new audio
+        Paused,  // window not exposed: no wakeups
+        Dormant  // input idle: no wakeups until setInputIdle(false)
+    };
+
+    struct Sample {
+        float leftVuDb = -20.0f;
+        float rightVuDb = -20.0f;
+        std::int64_t timestampNs = 0; // steady_clock time of the DSP update, 0 if unknown
+    };
+
+    using SourceFn = std::function<Sample()>;
+
+    static constexpr int kIdleIntervalMs = 100;
+    static constexpr int kIdleAfterFrames = 30;      // static frames before going idle
+    static constexpr float kStaticDeltaDb = 0.01f;   // above the ballistics' micro-jitter
+    static constexpr std::int64_t kMaxInterpGapNs = 100'000'000; // 100 ms
+
+    // target is the meter's top-level widget; its native window drives the ticks
+    VUFrameScheduler(QWidget* target, SourceFn source, QObject* parent = nullptr);
+
+    void start();
+    void stop();
+
+    Mode mode() const { return mode_; }
+
+    // Driven by AudioCapture::sourceIdleChanged(); waking resumes ticking at once
+    void setInputIdle(bool idle);
+
+    // Refresh rate of the screen the window is on (0 before the window exists)
+    double refreshRateHz() const;
+
+  signals:
+    void frame(float leftVuDb, float rightVuDb);
+    void modeChanged(VUFrameScheduler::Mode mode);
+
+  protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+  private:
+    void attachWindow();
+    void tick();
+    void setMode(Mode mode);
+
+    // Records the interval since the previous active frame, and the display
+    // frames it skipped, in vuMetrics()
+    void noteActiveFrame(std::int64_t nowNs);
+    bool windowVisible() const;
+
+    // Mode for an exposed window
+    Mode visibleMode() const { return inputIdle_ ? Mode::Dormant : Mode::Active; }
+
+    // Interpolated display levels for the given steady_clock time
+    void interpolate(std::int64_t nowNs, float& left, float& right) const;
+
+    QWidget* target_ = nullptr;
+    QPointer<QWindow> window_;
+    SourceFn source_;
+    QTimer idleTimer_;
+
+    bool running_ = false;
+    bool inputIdle_ = false;
+    Mode mode_ = Mode::Paused;
+
+    // Last two distinct DSP updates
+    Sample prev_;
+    Sample last_;
+
+    float shownLeft_ = -20.0f;
+    float shownRight_ = -20.0f;
+    int staticFrames_ = 0;
+
+    // steady_clock time of the last active tick, 0 after a mode change
+    std::int64_t lastFrameNs_ = 0;
+};
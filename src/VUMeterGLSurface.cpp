@@ -0,0 +1,318 @@
+#include "VUMeterGLSurface.h"
+
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLShaderProgram>
+#include <QOpenGLTexture>
+#include <QTransform>
+
+#include "VuMetrics.h"
+
+// GLSL 1.10 / ES 2.0 subset so the same source works on desktop compatibility
+// profiles and GLES. Positions are logical widget pixels; v_screen maps them
+// to the full-widget mask texture.
+static const char* kVertexShader = R"(
+attribute highp vec2 a_pos;
+attribute highp vec2 a_uv;
+uniform highp vec2 u_viewport;
+varying highp vec2 v_uv;
+varying highp vec2 v_screen;
+void main() {
+    v_uv = a_uv;
+    v_screen = a_pos / u_viewport;
+    gl_Position = vec4(v_screen.x * 2.0 - 1.0, 1.0 - v_screen.y * 2.0, 0.0, 1.0);
+}
+)";
+
+static const char* kFragmentShader = R"(
+uniform sampler2D u_tex;
+uniform sampler2D u_mask;
+uniform lowp vec4 u_color;
+uniform lowp float u_textured;
+uniform lowp float u_masked;
+varying highp vec2 v_uv;
+varying highp vec2 v_screen;
+void main() {
+    lowp vec4 c = mix(u_color, texture2D(u_tex, v_uv), u_textured);
+    c.a *= mix(1.0, texture2D(u_mask, v_screen).a, u_masked);
+    gl_FragColor = c;
+}
+)";
+
+// x, y, u, v per vertex; quads are drawn as 4-vertex triangle strips
+static constexpr int kFloatsPerVertex = 4;
+static constexpr int kVerticesPerQuad = 4;
+
+static void appendQuad(std::vector<float>& out, const QPointF (&corners)[4]) {
+    static constexpr float kUv[4][2] = {{0.0f, 0.0f}, {1.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 1.0f}};
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<float>(corners[i].x()));
+        out.push_back(static_cast<float>(corners[i].y()));
+        out.push_back(kUv[i][0]);
+        out.push_back(kUv[i][1]);
+    }
+}
+
+static std::unique_ptr<QOpenGLTexture> makeTexture(const QImage& image, QOpenGLTexture::Filter filter) {
+    if (image.isNull()) {
+        return nullptr;
+    }
+
+    // Rows are uploaded top-down and sampled with v = 0 at the top, matching
+    // the widget coordinate system, so no mirroring is needed
+    auto texture = std::make_unique<QOpenGLTexture>(image, QOpenGLTexture::DontGenerateMipMaps);
+    texture->setMinMagFilters(filter, filter);
+    texture->setWrapMode(QOpenGLTexture::ClampToEdge);
+    return texture;
+}
+
+bool VUMeterGLSurface::isSupported() {
+    static const bool supported = [] {
+        QOpenGLContext context;
+        if (!context.create()) {
+            return false;
+        }
+
+        QOffscreenSurface surface;
+        surface.setFormat(context.format());
+        surface.create();
+        if (!surface.isValid() || !context.makeCurrent(&surface)) {
+            return false;
+        }
+
+        context.doneCurrent();
+        return true;
+    }();
+    return supported;
+}
+
+VUMeterGLSurface::VUMeterGLSurface(QWidget* parent) : QOpenGLWidget(parent) {
+    // Needles fill the whole surface; nothing behind it needs to show through
+    setAttribute(Qt::WA_OpaquePaintEvent);
+}
+
+VUMeterGLSurface::~VUMeterGLSurface() {
+    if (context()) {
+        makeCurrent();
+        releaseGL();
+        doneCurrent();
+    }
+}
+
+void VUMeterGLSurface::setLayers(const QImage& base, const QImage& overlay, const QImage& mask) {
+    pendingBase_ = base;
+    pendingOverlay_ = overlay;
+    pendingMask_ = mask;
+    layersPending_ = true;
+    update();
+}
+
+void VUMeterGLSurface::setNeedleTexture(int index, const QImage& image) {
+    if (index < 0 || index >= kMaxNeedleTextures) {
+        return;
+    }
+    pendingNeedles_[index] = image;
+    needlesPending_[index] = true;
+    update();
+}
+
+void VUMeterGLSurface::setQuads(std::vector<Quad> quads) {
+    quads_ = std::move(quads);
+    update();
+}
+
+void VUMeterGLSurface::initializeGL() {
+    initializeOpenGLFunctions();
+
+    // The context may be recreated (e.g. when reparented); drop old resources with it
+    connect(context(), &QOpenGLContext::aboutToBeDestroyed, this, [this]() {
+        makeCurrent();
+        releaseGL();
+        doneCurrent();
+    });
+
+    program_ = std::make_unique<QOpenGLShaderProgram>();
+    if (!program_->addShaderFromSourceCode(QOpenGLShader::Vertex, kVertexShader) ||
+        !program_->addShaderFromSourceCode(QOpenGLShader::Fragment, kFragmentShader) ||
+        !program_->link()) {
+        const QString reason = program_->log();
+        program_.reset();
+        emit initializationFailed(reason);
+        return;
+    }
+
+    if (!layerVbo_.create() || !needleVbo_.create()) {
+        program_.reset();
+        emit initializationFailed(QStringLiteral("Failed to create vertex buffers"));
+        return;
+    }
+    layerVbo_.setUsagePattern(QOpenGLBuffer::StaticDraw);
+    needleVbo_.setUsagePattern(QOpenGLBuffer::DynamicDraw);
+
+    // Textures survive a context loss only as pending images
+    layersPending_ = true;
+    for (bool& pending : needlesPending_) {
+        pending = true;
+    }
+    layerQuadSize_ = QSize();
+
+    ready_ = true;
+}
+
+void VUMeterGLSurface::releaseGL() {
+    ready_ = false;
+    base_.reset();
+    overlay_.reset();
+    mask_.reset();
+    for (auto& needle : needles_) {
+        needle.reset();
+    }
+    layerVbo_.destroy();
+    needleVbo_.destroy();
+    program_.reset();
+}
+
+void VUMeterGLSurface::uploadPending() {
+    if (layersPending_) {
+        base_ = makeTexture(pendingBase_, QOpenGLTexture::Nearest);
+        overlay_ = makeTexture(pendingOverlay_, QOpenGLTexture::Nearest);
+        mask_ = makeTexture(pendingMask_, QOpenGLTexture::Linear);
+        layersPending_ = false;
+    }
+
+    for (int i = 0; i < kMaxNeedleTextures; ++i) {
+        if (needlesPending_[i]) {
+            needles_[i] = makeTexture(pendingNeedles_[i], QOpenGLTexture::Linear);
+            needlesPending_[i] = false;
+        }
+    }
+}
+
+void VUMeterGLSurface::applyQuadState(const Quad& quad, QOpenGLTexture* texture) {
+    program_->setUniformValue("u_textured", texture ? 1.0f : 0.0f);
+    program_->setUniformValue("u_masked", (quad.masked && mask_) ? 1.0f : 0.0f);
+    program_->setUniformValue("u_color", quad.color);
+
+    if (texture) {
+        glActiveTexture(GL_TEXTURE0);
+        texture->bind();
+    }
+}
+
+void VUMeterGLSurface::paintGL() {
+    VuScopedTimer timer(VuStage::Paint);
+    vuMetrics().add(VuCounter::Paints);
+
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    if (!ready_) {
+        return;
+    }
+
+    uploadPending();
+
+    const QSize logical = size();
+    if (logical.isEmpty()) {
+        return;
+    }
+
+    // --- Full-surface quad for the layers, rewritten only on resize ---
+    if (layerQuadSize_ != logical) {
+        std::vector<float> vertices;
+        const QPointF corners[4] = {
+            QPointF(0.0, 0.0), QPointF(logical.width(), 0.0), QPointF(0.0, logical.height()),
+            QPointF(logical.width(), logical.height())};
+        appendQuad(vertices, corners);
+
+        layerVbo_.bind();
+        layerVbo_.allocate(vertices.data(), static_cast<int>(vertices.size() * sizeof(float)));
+        layerVbo_.release();
+        layerQuadSize_ = logical;
+    }
+
+    // --- Needle quads, rotated on the CPU (a handful of vertices per frame) ---
+    std::vector<float> needleVertices;
+    needleVertices.reserve(quads_.size() * kVerticesPerQuad * kFloatsPerVertex);
+    for (const Quad& q : quads_) {
+        QTransform t;
+        t.translate(q.offset.x(), q.offset.y());
+        t.translate(q.pivot.x(), q.pivot.y());
+        t.rotate(q.angleDeg);
+        t.translate(-q.pivot.x(), -q.pivot.y());
+
+        const QPointF corners[4] = {
+            t.map(q.rect.topLeft()), t.map(q.rect.topRight()), t.map(q.rect.bottomLeft()), t.map(q.rect.bottomRight())};
+        appendQuad(needleVertices, corners);
+    }
+
+    if (!needleVertices.empty()) {
+        needleVbo_.bind();
+        needleVbo_.allocate(needleVertices.data(), static_cast<int>(needleVertices.size() * sizeof(float)));
+        needleVbo_.release();
+    }
+
+    glDisable(GL_DEPTH_TEST);
+    glEnable(GL_BLEND);
+    // QOpenGLTexture uploads QImages as straight (non-premultiplied) RGBA
+    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+    program_->bind();
+    program_->setUniformValue("u_viewport", QSizeF(logical));
+    program_->setUniformValue("u_tex", 0);
+    program_->setUniformValue("u_mask", 1);
+
+    if (mask_) {
+        glActiveTexture(GL_TEXTURE1);
+        mask_->bind();
+    }
+
+    const int posLoc = program_->attributeLocation("a_pos");
+    const int uvLoc = program_->attributeLocation("a_uv");
+    const int stride = kFloatsPerVertex * sizeof(float);
+
+    auto bindVertices = [&](QOpenGLBuffer& vbo) {
+        vbo.bind();
+        program_->enableAttributeArray(posLoc);
+        program_->enableAttributeArray(uvLoc);
+        program_->setAttributeBuffer(posLoc, GL_FLOAT, 0, 2, stride);
+        program_->setAttributeBuffer(uvLoc, GL_FLOAT, 2 * sizeof(float), 2, stride);
+    };
+
+    // --- Base layer ---
+    bindVertices(layerVbo_);
+    if (base_) {
+        applyQuadState(Quad{}, base_.get());
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, kVerticesPerQuad);
+    }
+
+    // --- Needles ---
+    if (!needleVertices.empty()) {
+        bindVertices(needleVbo_);
+        for (std::size_t i = 0; i < quads_.size(); ++i) {
+            const Quad& q = quads_[i];
+            QOpenGLTexture* texture = nullptr;
+            if (q.texture >= 0) {
+                texture = (q.texture < kMaxNeedleTextures) ? needles_[q.texture].get() : nullptr;
+                if (!texture) {
+                    continue;
+                }
+            }
+
+            applyQuadState(q, texture);
+            glDrawArrays(GL_TRIANGLE_STRIP, static_cast<GLint>(i * kVerticesPerQuad), kVerticesPerQuad);
+        }
+    }
+
+    // --- Overlay layer ---
+    bindVertices(layerVbo_);
+    if (overlay_) {
+        applyQuadState(Quad{}, overlay_.get());
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, kVerticesPerQuad);
+    }
+
+    program_->disableAttributeArray(posLoc);
+    program_->disableAttributeArray(uvLoc);
+    layerVbo_.release();
+    program_->release();
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <QColor>
+#include <QImage>
+#include <QOpenGLBuffer>
+#include <QOpenGLFunctions>
+#include <QOpenGLWidget>
+#include <QPointF>
+#include <QRectF>
+#include <QSize>
+
+#include <memory>
+#include <vector>
+
+class QOpenGLShaderProgram;
+class QOpenGLTexture;
+
+// OpenGL drawing surface for StereoVUMeterWidget.
+//
+// The widget keeps owning layout and the static layers; this surface only
+// composites them on the GPU: the cached base layer, the needles as rotated
+// quads (textured for skins, solid for vector styles, optionally clipped to
+// a face mask), then the cached overlay layer. Layers and needle images are
+// uploaded once per change; a frame only rewrites a few needle vertices.
+class VUMeterGLSurface final : public QOpenGLWidget, protected QOpenGLFunctions {
+    Q_OBJECT
+
+  public:
+    static constexpr int kMaxNeedleTextures = 2;
+
+    struct Quad {
+        QRectF rect;         // unrotated, logical widget coordinates
+        QPointF pivot;       // rotation centre, logical widget coordinates
+        float angleDeg = 0.0f;
+        QPointF offset;      // translation after rotation (needle shadow)
+        int texture = -1;    // needle texture index, or -1 for a solid quad
+        QColor color;        // solid quads only
+        bool masked = false; // clip to the face mask
+    };
+
+    // True if an OpenGL context can be created on this system (cached).
+    static bool isSupported();
+
+    explicit VUMeterGLSurface(QWidget* parent = nullptr);
+    ~VUMeterGLSurface() override;
+
+    // Images are in device pixels. The mask's alpha clips masked quads; pass a
+    // null image when nothing is masked.
+    void setLayers(const QImage& base, const QImage& overlay, const QImage& mask);
+    void setNeedleTexture(int index, const QImage& image);
+
+    void setQuads(std::vector<Quad> quads);
+
+  signals:
+    // Emitted from initializeGL() when shaders or buffers cannot be set up
+    void initializationFailed(const QString& reason);
+
+  protected:
+    void initializeGL() override;
+    void paintGL() override;
+
+  private:
+    void uploadPending();
+    void releaseGL();
+    // Sets the per-quad uniforms and binds its texture to unit 0
+    void applyQuadState(const Quad& quad, QOpenGLTexture* texture);
+
+    std::unique_ptr<QOpenGLShaderProgram> program_;
+    QOpenGLBuffer layerVbo_{QOpenGLBuffer::VertexBuffer};
+    QOpenGLBuffer needleVbo_{QOpenGLBuffer::VertexBuffer};
+    bool ready_ = false;
+
+    std::unique_ptr<QOpenGLTexture> base_;
+    std::unique_ptr<QOpenGLTexture> overlay_;
+    std::unique_ptr<QOpenGLTexture> mask_;
+    std::unique_ptr<QOpenGLTexture> needles_[kMaxNeedleTextures];
+
+    // CPU-side copies waiting for the next paintGL() with a current context
+    QImage pendingBase_;
+    QImage pendingOverlay_;
+    QImage pendingMask_;
+    QImage pendingNeedles_[kMaxNeedleTextures];
+    bool layersPending_ = false;
+    bool needlesPending_[kMaxNeedleTextures] = {};
+
+    std::vector<Quad> quads_;
+    QSize layerQuadSize_;
+};
@@ -0,0 +1,190 @@
+#include "VUMeterOverlayStrip.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QPaintEvent>
+#include <QPainter>
+#include <QResizeEvent>
+
+#include "VuMetrics.h"
+
+// History rows cover the meter scale
+static constexpr float kHistoryLowVu = -20.0f;
+static constexpr float kHistoryHighVu = 3.0f;
+
+static constexpr float kSpectrumLowDb = -90.0f;
+static constexpr float kSpectrumHighDb = 0.0f;
+
+static qreal levelY(const QRectF& rect, float db, float low, float high) {
+    const float t = (std::clamp(db, low, high) - low) / (high - low);
+    return rect.bottom() - t * rect.height();
+}
+
+VUMeterOverlayStrip::VUMeterOverlayStrip(QWidget* parent) : QWidget(parent) {
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setAttribute(Qt::WA_NoSystemBackground);
+    buckets_.resize(VuLevelHistory::kCapacity);
+}
+
+void VUMeterOverlayStrip::setSources(const VuLevelHistory* history, const VuSpectrumAnalyzer* spectrum) {
+    history_ = history;
+    spectrum_ = spectrum;
+    spectrumFrame_ = VuSpectrumFrame();
+    imageValid_ = false;
+    refresh();
+}
+
+void VUMeterOverlayStrip::setPanels(bool history, bool spectrum) {
+    if (showHistory_ == history && showSpectrum_ == spectrum) {
+        return;
+    }
+    showHistory_ = history;
+    showSpectrum_ = spectrum;
+    imageValid_ = false;
+    refresh();
+}
+
+void VUMeterOverlayStrip::resizeEvent(QResizeEvent* event) {
+    QWidget::resizeEvent(event);
+    imageValid_ = false;
+    refresh();
+}
+
+void VUMeterOverlayStrip::refresh() {
+    if (panelCount() == 0 || width() <= 0 || height() <= 0) {
+        return;
+    }
+
+    const qint64 intervalMs = static_cast<qint64>(1000.0 / kRefreshHz);
+    if (imageValid_ && sinceRender_.isValid() && sinceRender_.elapsed() < intervalMs) {
+        return;
+    }
+
+    bool changed = !imageValid_;
+
+    if (showHistory_ && history_) {
+        const unsigned int level = VuLevelHistory::levelFor(kHistorySeconds, static_cast<unsigned int>(width()));
+        const std::uint64_t count = history_->bucketCount(level);
+        changed = changed || level != historyLevel_ || count != historyCount_;
+        historyLevel_ = level;
+        historyCount_ = count;
+    }
+
+    if (showSpectrum_ && spectrum_) {
+        const VuSpectrumFrame frame = spectrum_->read();
+        changed = changed || frame.sequence != spectrumFrame_.sequence;
+        spectrumFrame_ = frame;
+    }
+
+    if (changed) {
+        render();
+    }
+}
+
+void VUMeterOverlayStrip::render() {
+    VuScopedTimer timer(VuStage::Overlay);
+
+    const qreal dpr = devicePixelRatioF();
+    const QSize pixelSize = (QSizeF(size()) * dpr).toSize();
+    if (image_.size() != pixelSize || image_.devicePixelRatio() != dpr) {
+        image_ = QImage(pixelSize, QImage::Format_ARGB32_Premultiplied);
+        image_.setDevicePixelRatio(dpr);
+    }
+    image_.fill(QColor(10, 10, 12));
+
+    QPainter p(&image_);
+    p.setRenderHint(QPainter::Antialiasing, false);
+
+    // Panels stack top to bottom with a 1 px separator
+    const QRectF r = rect();
+    const qreal panelH = r.height() / panelCount();
+    qreal top = r.top();
+    if (showHistory_) {
+        drawHistory(p, QRectF(r.left(), top, r.width(), panelH - 1.0));
+        top += panelH;
+    }
+    if (showSpectrum_) {
+        drawSpectrum(p, QRectF(r.left(), top, r.width(), panelH - 1.0));
+    }
+
+    imageValid_ = true;
+    sinceRender_.restart();
+    update();
+}
+
+void VUMeterOverlayStrip::drawHistory(QPainter& p, const QRectF& rect) {
+    if (!history_ || rect.height() <= 2.0) {
+        return;
+    }
+
+    // Mono sources draw one row; wider ones channels 0 and 1, like the meters
+    const unsigned int rows = history_->channels() >= 2 ? 2 : 1;
+    const qreal rowH = rect.height() / rows;
+
+    const unsigned int level = historyLevel_;
+    const unsigned int span = static_cast<unsigned int>(
+        std::min<double>(VuLevelHistory::kCapacity,
+                         std::ceil(kHistorySeconds / VuLevelHistory::bucketSeconds(level))));
+    const qreal columnW = rect.width() / span;
+
+    const QColor levelColor(70, 190, 90);
+    const QColor hotColor(220, 60, 40);
+    const QColor peakColor(235, 235, 200);
+
+    for (unsigned int row = 0; row < rows; ++row) {
+        const QRectF band(rect.left(), rect.top() + row * rowH, rect.width(), rowH - (row + 1 < rows ? 1.0 : 0.0));
+
+        // 0 VU reference line
+        const qreal zeroY = levelY(band, 0.0f, kHistoryLowVu, kHistoryHighVu);
+        p.fillRect(QRectF(band.left(), zeroY, band.width(), 1.0), QColor(60, 60, 64));
+
+        const unsigned int n = history_->read(level, row, buckets_.data(), span);
+        for (unsigned int i = 0; i < n; ++i) {
+            const VuLevelHistory::Bucket& b = buckets_[i];
+            const qreal x = band.right() - (n - i) * columnW;
+            const qreal yMax = levelY(band, b.vuMax, kHistoryLowVu, kHistoryHighVu);
+            const qreal yMin = levelY(band, b.vuMin, kHistoryLowVu, kHistoryHighVu);
+            const qreal w = std::max<qreal>(1.0, columnW);
+
+            if (b.vuMax > kHistoryLowVu) {
+                p.fillRect(QRectF(x, yMax, w, std::max<qreal>(1.0, yMin - yMax + 1.0)),
+                           b.vuMax > 0.0f ? hotColor : levelColor);
+            }
+            if (b.peakMax > kHistoryLowVu) {
+                p.fillRect(QRectF(x, levelY(band, b.peakMax, kHistoryLowVu, kHistoryHighVu), w, 1.0), peakColor);
+            }
+        }
+    }
+}
+
+void VUMeterOverlayStrip::drawSpectrum(QPainter& p, const QRectF& rect) {
+    if (!spectrum_ || rect.height() <= 2.0) {
+        return;
+    }
+
+    const qreal bandW = rect.width() / VuSpectrumFrame::kBands;
+    const QColor barColor(80, 150, 220);
+
+    for (unsigned int b = 0; b < VuSpectrumFrame::kBands; ++b) {
+        const float db = spectrumFrame_.bandDb[b];
+        if (spectrumFrame_.sequence == 0 || db <= kSpectrumLowDb) {
+            continue;
+        }
+        const qreal y = levelY(rect, db, kSpectrumLowDb, kSpectrumHighDb);
+        const qreal x = rect.left() + b * bandW;
+        p.fillRect(QRectF(x, y, std::max<qreal>(1.0, bandW - 1.0), rect.bottom() - y), barColor);
+    }
+}
+
+void VUMeterOverlayStrip::paintEvent(QPaintEvent* event) {
+    if (!imageValid_) {
+        render();
+    }
+
+    QPainter p(this);
+    const qreal dpr = image_.devicePixelRatio();
+    for (const QRect& r : event->region()) {
+        p.drawImage(QRectF(r), image_, QRectF(QPointF(r.topLeft()) * dpr, QSizeF(r.size()) * dpr));
+    }
+}
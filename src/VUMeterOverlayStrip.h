@@ -0,0 +1,69 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QImage>
+#include <QWidget>
+
+#include <cstdint>
+#include <vector>
+
+#include "VuLevelHistory.h"
+#include "VuSpectrumAnalyzer.h"
+
+class QPainter;
+class QPaintEvent;
+class QResizeEvent;
+
+// Strip under the meters: a scrolling VU/peak history and/or the spectrum.
+//
+// Both panels are drawn into a cached image that refresh() re-renders at
+// most kRefreshHz times a second, and only when the history gained a bucket
+// or the spectrum a new frame; paintEvent() just blits it. A render reads at
+// most one bucket per pixel column per channel (VuLevelHistory::levelFor),
+// so its cost is bounded by the strip width rather than the span shown.
+class VUMeterOverlayStrip final : public QWidget {
+    Q_OBJECT
+
+  public:
+    static constexpr double kHistorySeconds = 60.0;
+    static constexpr double kRefreshHz = 30.0;
+
+    explicit VUMeterOverlayStrip(QWidget* parent = nullptr);
+
+    // Either may be null; the sources must outlive the strip or be reset first
+    void setSources(const VuLevelHistory* history, const VuSpectrumAnalyzer* spectrum);
+
+    void setPanels(bool history, bool spectrum);
+    bool showsHistory() const { return showHistory_; }
+    bool showsSpectrum() const { return showSpectrum_; }
+    int panelCount() const { return (showHistory_ ? 1 : 0) + (showSpectrum_ ? 1 : 0); }
+
+    // Called per UI frame; re-renders (and repaints) when due and changed
+    void refresh();
+
+  protected:
+    void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+
+  private:
+    void render();
+    void drawHistory(QPainter& p, const QRectF& rect);
+    void drawSpectrum(QPainter& p, const QRectF& rect);
+
+    const VuLevelHistory* history_ = nullptr;
+    const VuSpectrumAnalyzer* spectrum_ = nullptr;
+    bool showHistory_ = false;
+    bool showSpectrum_ = false;
+
+    QImage image_;
+    bool imageValid_ = false;
+    QElapsedTimer sinceRender_;
+
+    // What the cached image shows
+    unsigned int historyLevel_ = 0;
+    std::uint64_t historyCount_ = 0;
+    VuSpectrumFrame spectrumFrame_;
+
+    // One channel's buckets; sized once to VuLevelHistory::kCapacity
+    std::vector<VuLevelHistory::Bucket> buckets_;
+};
@@ -1,19 +1,14 @@
 #include "VUMeterScale.h"
 
+#include <algorithm>
+
 VUMeterScaleTable builtInDefaultScaleTable() {
-    return {{-20, -47},
-            {-10, -34},
-            {-7, -25},
-            {-6, -21},
-            {-5, -16},
-            {-4, -11},
-            {-3, -5},
-            {-2, 2},
-            {-1, 9},
-            {0, 18},
-            {1, 27},
-            {2, 38},
-            {3, 47}};
+    VUMeterScaleTable table;
+    table.reserve(static_cast<int>(kBuiltInDefaultScale.size()));
+    for (const VUMeterScalePoint& p : kBuiltInDefaultScale) {
+        table.append({p.vuDb, p.angleDeg});
+    }
+    return table;
 }
 
 float vuToAngleDeg(float vuDb, const VUMeterScaleTable& table) {
@@ -44,3 +39,83 @@ float vuToAngleDeg(float vuDb, const VUMeterScaleTable& table) {
 
     return table.last().second;
 }
+
+// -------- VUMeterCompiledScale --------
+
+VUMeterCompiledScale::VUMeterCompiledScale(const VUMeterScaleTable& table) {
+    vu_.reserve(table.size());
+    angle_.reserve(table.size());
+    for (const auto& point : table) {
+        vu_.push_back(point.first);
+        angle_.push_back(point.second);
+    }
+
+    sorted_ = std::is_sorted(vu_.begin(), vu_.end()) && vu_.size() <= 65536;
+    if (vu_.size() < 2 || !sorted_ || !(vu_.back() > vu_.front())) {
+        return;
+    }
+
+    bucketScale_ = static_cast<float>(kBuckets) / (vu_.back() - vu_.front());
+
+    // First segment whose upper end reaches the bucket start
+    std::size_t segment = 0;
+    for (int b = 0; b < kBuckets; ++b) {
+        const float start = vu_.front() + static_cast<float>(b) / bucketScale_;
+        while (segment + 2 < vu_.size() && start > vu_[segment + 1]) {
+            ++segment;
+        }
+        bucketSegment_[b] = static_cast<std::uint16_t>(segment);
+    }
+}
+
+float VUMeterCompiledScale::referenceAngleDeg(float vuDb) const {
+    for (std::size_t i = 0; i + 1 < vu_.size(); ++i) {
+        if (vuDb >= vu_[i] && vuDb <= vu_[i + 1]) {
+            const float t = (vuDb - vu_[i]) / (vu_[i + 1] - vu_[i]);
+            return angle_[i] + t * (angle_[i + 1] - angle_[i]);
+        }
+    }
+    return angle_.back();
+}
+
+float VUMeterCompiledScale::angleDeg(float vuDb) const {
+    if (vu_.empty()) {
+        return 0.0f;
+    }
+
+    // Clamp to table range (NaN maps to the top, as in vuToAngleDeg)
+    if (vuDb <= vu_.front()) {
+        return angle_.front();
+    }
+    if (!(vuDb < vu_.back())) {
+        return angle_.back();
+    }
+
+    if (bucketScale_ <= 0.0f) {
+        return referenceAngleDeg(vuDb);
+    }
+
+    const int b = std::min(kBuckets - 1, static_cast<int>((vuDb - vu_.front()) * bucketScale_));
+    std::size_t i = bucketSegment_[b];
+
+    // The bucket index is rounded, so the exact segment can be a step either way:
+    // find the first segment i with vu_[i] < vuDb <= vu_[i + 1]
+    while (i > 0 && vuDb <= vu_[i]) {
+        --i;
+    }
+    while (vuDb > vu_[i + 1]) {
+        ++i;
+    }
+
+    const float v0 = vu_[i];
+    const float a0 = angle_[i];
+    const float v1 = vu_[i + 1];
+    const float a1 = angle_[i + 1];
+    const float t = (vuDb - v0) / (v1 - v0);
+    return a0 + t * (a1 - a0);
+}
+
+const VUMeterCompiledScale& builtInDefaultScale() {
+    static const VUMeterCompiledScale scale(builtInDefaultScaleTable());
+    return scale;
+}
@@ -3,13 +3,73 @@
 #include <QPair>
 #include <QVector>
 
+#include <array>
+#include <cstdint>
+#include <vector>
+
 // Data-driven scale mapping: VU (dB) -> needle angle (degrees).
 //
 // The default table values represent the built-in calibration shipped with the app.
-// TODO: Future work: load calibration tables from external files (skin packages).
+// Skin packages carry their own tables (see SkinManager).
 
 using VUMeterScaleTable = QVector<QPair<float, float>>;
 
+struct VUMeterScalePoint {
+    float vuDb;
+    float angleDeg;
+};
+
+// Built-in calibration, available at compile time
+inline constexpr std::array<VUMeterScalePoint, 13> kBuiltInDefaultScale = {{
+    {-20, -47},
+    {-10, -34},
+    {-7, -25},
+    {-6, -21},
+    {-5, -16},
+    {-4, -11},
+    {-3, -5},
+    {-2, 2},
+    {-1, 9},
+    {0, 18},
+    {1, 27},
+    {2, 38},
+    {3, 47},
+}};
+
 VUMeterScaleTable builtInDefaultScaleTable();
 
+// Reference lookup: linear segment search. Prefer VUMeterCompiledScale on
+// per-frame paths.
 float vuToAngleDeg(float vuDb, const VUMeterScaleTable& table);
+
+// A VUMeterScaleTable compiled once for O(1) lookups.
+//
+// The VU range is split into kBuckets uniform buckets, each remembering the
+// segment that covers its start, so a lookup indexes the bucket and steps at
+// most a few segments to the exact one. The segment is then interpolated with
+// the same arithmetic as vuToAngleDeg(), so results are identical to the
+// reference for any sorted table. Unsorted tables fall back to the reference
+// search.
+class VUMeterCompiledScale final {
+  public:
+    static constexpr int kBuckets = 256;
+
+    VUMeterCompiledScale() = default;
+    explicit VUMeterCompiledScale(const VUMeterScaleTable& table);
+
+    float angleDeg(float vuDb) const;
+
+    bool isEmpty() const { return vu_.empty(); }
+
+  private:
+    float referenceAngleDeg(float vuDb) const;
+
+    std::vector<float> vu_;
+    std::vector<float> angle_;
+    std::array<std::uint16_t, kBuckets> bucketSegment_{};
+    float bucketScale_ = 0.0f; // buckets per dB
+    bool sorted_ = true;
+};
+
+// Compiled kBuiltInDefaultScale (built on first use)
+const VUMeterCompiledScale& builtInDefaultScale();
@@ -0,0 +1,53 @@
+#include "VUMeterSkin.h"
+
+static QPixmap scaledForDpr(const QPixmap& source, const QSize& pixelSize, qreal dpr) {
+    if (source.isNull()) {
+        return QPixmap();
+    }
+
+    QPixmap out = source.scaled(pixelSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    out.setDevicePixelRatio(dpr);
+    return out;
+}
+
+bool VUMeterScaledAssets::matches(const VUMeterAssets& source, const QSize& size, qreal dpr) const {
+    return !isNull() && pixelSize == size && devicePixelRatio == dpr && faceKey == source.face.cacheKey() &&
+           needleKey == source.needle.cacheKey() && capKey == source.cap.cacheKey();
+}
+
+VUMeterScaledAssets scaleMeterAssets(const VUMeterAssets& assets, const QSize& pixelSize, qreal dpr) {
+    VUMeterScaledAssets out;
+    out.pixelSize = pixelSize;
+    out.devicePixelRatio = dpr;
+    out.faceKey = assets.face.cacheKey();
+    out.needleKey = assets.needle.cacheKey();
+    out.capKey = assets.cap.cacheKey();
+
+    if (pixelSize.isEmpty()) {
+        return out;
+    }
+
+    out.face = scaledForDpr(assets.face, pixelSize, dpr);
+    out.needle = scaledForDpr(assets.needle, pixelSize, dpr);
+    out.cap = scaledForDpr(assets.cap, pixelSize, dpr);
+    return out;
+}
+
+static void uploadMeterImages(VUMeterAssets* assets, VUMeterImages&& images) {
+    assets->face = QPixmap::fromImage(std::move(images.face));
+    assets->needle = QPixmap::fromImage(std::move(images.needle));
+    assets->cap = QPixmap::fromImage(std::move(images.cap));
+}
+
+void uploadSkinImages(VUSkinPackage* package, VUSkinImages&& images) {
+    if (!package) {
+        return;
+    }
+
+    if (auto* single = std::get_if<VUSkinSingleMeters>(&package->meters)) {
+        uploadMeterImages(&single->vu.assets, std::move(images.meters[0]));
+    } else if (auto* stereo = std::get_if<VUSkinStereoMeters>(&package->meters)) {
+        uploadMeterImages(&stereo->left.assets, std::move(images.meters[0]));
+        uploadMeterImages(&stereo->right.assets, std::move(images.meters[1]));
+    }
+}
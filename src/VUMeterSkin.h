@@ -1,6 +1,8 @@
 #pragma once
 
+#include <QImage>
 #include <QPixmap>
+#include <QSize>
 #include <QtGlobal>
 
 #include "VUMeterScale.h"
@@ -29,6 +31,29 @@ struct VUMeterAssets {
     QPixmap cap;
 };
 
+// Face/needle/cap resampled once to a meter's size in device pixels, so the
+// per-frame draws blit (face, cap) or only rotate (needle) instead of
+// rescaling the full-size skin images.
+struct VUMeterScaledAssets {
+    QSize pixelSize;
+    qreal devicePixelRatio = 0.0;
+
+    // cacheKey() of the source face/needle/cap the images were scaled from
+    qint64 faceKey = 0;
+    qint64 needleKey = 0;
+    qint64 capKey = 0;
+
+    QPixmap face;
+    QPixmap needle;
+    QPixmap cap;
+
+    bool isNull() const { return face.isNull(); }
+    bool matches(const VUMeterAssets& source, const QSize& size, qreal dpr) const;
+};
+
+// Scales all three assets to pixelSize (device pixels) and tags them with dpr.
+VUMeterScaledAssets scaleMeterAssets(const VUMeterAssets& assets, const QSize& pixelSize, qreal dpr);
+
 struct VUMeterSkin {
     VUMeterAssets assets;
     VUMeterCalibration calibration;
@@ -54,3 +79,20 @@ struct VUSkinPackage {
     // - scale tables are owned per meter; no mirroring or inferred duplication is permitted
     std::variant<VUSkinSingleMeters, VUSkinStereoMeters> meters;
 };
+
+// Decoded skin images. Unlike QPixmap, QImage may be created on any thread, so
+// skin loaders decode into these on a worker and the GUI thread turns them into
+// the package's pixmaps with uploadSkinImages().
+struct VUMeterImages {
+    QImage face;
+    QImage needle;
+    QImage cap;
+};
+
+struct VUSkinImages {
+    // [0] = "vu" (single) or "left", [1] = "right"
+    VUMeterImages meters[2];
+};
+
+// GUI thread only. Images already in ARGB32_Premultiplied are adopted without a copy.
+void uploadSkinImages(VUSkinPackage* package, VUSkinImages&& images);
@@ -0,0 +1,133 @@
+#include "VUNeedleAtlas.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QPainter>
+#include <QRectF>
+#include <QTransform>
+
+static QTransform rotationAbout(const QPointF& pivot, float angleDeg) {
+    QTransform t;
+    t.translate(pivot.x(), pivot.y());
+    t.rotate(angleDeg);
+    t.translate(-pivot.x(), -pivot.y());
+    return t;
+}
+
+// Bounding rect of the non-transparent pixels, in image pixels
+static QRect opaqueRect(const QImage& img) {
+    int left = img.width();
+    int right = -1;
+    int top = img.height();
+    int bottom = -1;
+
+    for (int y = 0; y < img.height(); ++y) {
+        const QRgb* line = reinterpret_cast<const QRgb*>(img.constScanLine(y));
+        for (int x = 0; x < img.width(); ++x) {
+            if (qAlpha(line[x]) != 0) {
+                left = std::min(left, x);
+                right = std::max(right, x);
+                top = std::min(top, y);
+                bottom = std::max(bottom, y);
+            }
+        }
+    }
+
+    if (right < left) {
+        return QRect();
+    }
+    return QRect(QPoint(left, top), QPoint(right, bottom));
+}
+
+// Integer sprite rect that holds the needle's opaque area rotated by angleDeg
+static QRect spriteRect(const QRect& opaque, const QPointF& pivot, float angleDeg) {
+    // One pixel of slack for smooth-transform edge pixels
+    return rotationAbout(pivot, angleDeg).mapRect(QRectF(opaque)).toAlignedRect().adjusted(-1, -1, 1, 1);
+}
+
+std::shared_ptr<const VUNeedleAtlas> VUNeedleAtlas::build(const Params& params) {
+    if (params.needle.isNull() || params.maxAngleDeg <= params.minAngleDeg) {
+        return nullptr;
+    }
+
+    // Work in device pixels throughout; the ratio is only applied to the finished sprites
+    QImage needle = params.needle.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    needle.setDevicePixelRatio(1.0);
+    const QRect opaque = opaqueRect(needle);
+    if (opaque.isEmpty()) {
+        return nullptr;
+    }
+
+    const float range = params.maxAngleDeg - params.minAngleDeg;
+
+    // --- Pick the finest step that fits the memory bound ---
+    // Sprite sizes follow from the rotated bounds, so the footprint is known
+    // before anything is rendered.
+    auto footprint = [&](float step) {
+        const int count = static_cast<int>(std::floor(range / step)) + 1;
+        qint64 total = 0;
+        for (int i = 0; i < count; ++i) {
+            const QRect r = spriteRect(opaque, params.pivot, params.minAngleDeg + i * step);
+            total += static_cast<qint64>(r.width()) * r.height() * 4;
+        }
+        return total;
+    };
+
+    float step = std::max(params.stepDeg, 0.01f);
+    while (footprint(step) > params.maxBytes) {
+        step *= 1.25f;
+        if (step > kMaxStepDeg) {
+            return nullptr;
+        }
+    }
+
+    std::shared_ptr<VUNeedleAtlas> atlas(new VUNeedleAtlas());
+    atlas->minAngleDeg_ = params.minAngleDeg;
+    atlas->stepDeg_ = step;
+
+    const int count = static_cast<int>(std::floor(range / step)) + 1;
+    atlas->sprites_.reserve(count);
+
+    for (int i = 0; i < count; ++i) {
+        if (params.cancelled && params.cancelled()) {
+            return nullptr;
+        }
+        const float angle = params.minAngleDeg + i * step;
+        const QRect r = spriteRect(opaque, params.pivot, angle);
+
+        Sprite sprite;
+        sprite.offset = r.topLeft();
+        sprite.image = QImage(r.size(), QImage::Format_ARGB32_Premultiplied);
+        sprite.image.fill(Qt::transparent);
+
+        {
+            QPainter p(&sprite.image);
+            p.setRenderHint(QPainter::Antialiasing, true);
+            p.setRenderHint(QPainter::SmoothPixmapTransform, true);
+            p.translate(-r.topLeft());
+            p.setTransform(rotationAbout(params.pivot, angle), true);
+            p.drawImage(QPointF(0.0, 0.0), needle);
+        }
+
+        sprite.image.setDevicePixelRatio(params.devicePixelRatio);
+        atlas->bytes_ += sprite.image.sizeInBytes();
+        atlas->sprites_.push_back(std::move(sprite));
+    }
+
+    return atlas;
+}
+
+const VUNeedleAtlas::Sprite* VUNeedleAtlas::nearest(float angleDeg) const {
+    if (sprites_.empty()) {
+        return nullptr;
+    }
+
+    const float pos = (angleDeg - minAngleDeg_) / stepDeg_;
+    const long index = std::lround(pos);
+    if (index < 0 || index >= static_cast<long>(sprites_.size())) {
+        return nullptr;
+    }
+
+    return &sprites_[static_cast<std::size_t>(index)];
+}
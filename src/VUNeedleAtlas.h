@@ -0,0 +1,61 @@
+#pragma once
+
+#include <QImage>
+#include <QPoint>
+#include <QPointF>
+#include <QtGlobal>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+// Skin needle pre-rendered at fixed angular steps across the calibrated
+// minAngle..maxAngle range. Each sprite is trimmed to its opaque pixels, so
+// a frame only blits the nearest sprite instead of rotating the needle.
+//
+// Sprites are QImages (ARGB32 premultiplied) so the atlas can be built off
+// the GUI thread. Memory is bounded by Params::maxBytes: when the requested
+// step does not fit, the step is widened; past kMaxStepDeg the build is
+// rejected and the caller keeps rotating the needle per frame.
+class VUNeedleAtlas final {
+  public:
+    static constexpr float kDefaultStepDeg = 0.1f;
+    static constexpr float kMaxStepDeg = 0.5f;
+    static constexpr qint64 kDefaultMaxBytes = 48ll * 1024 * 1024;
+
+    struct Params {
+        QImage needle;  // pre-scaled needle, device pixels
+        QPointF pivot;  // rotation pivot in needle image pixels
+        qreal devicePixelRatio = 1.0;
+        float minAngleDeg = -47.0f;
+        float maxAngleDeg = 47.0f;
+        float stepDeg = kDefaultStepDeg;
+        qint64 maxBytes = kDefaultMaxBytes;
+        // Polled between sprites; returning true abandons the build
+        std::function<bool()> cancelled;
+    };
+
+    struct Sprite {
+        QImage image;  // devicePixelRatio set, so it can be drawn in logical coordinates
+        QPoint offset; // top-left relative to the needle image, device pixels
+    };
+
+    // Returns nullptr if the needle is empty, does not fit the memory bound or
+    // the build was cancelled.
+    static std::shared_ptr<const VUNeedleAtlas> build(const Params& params);
+
+    // Sprite closest to angleDeg, or nullptr outside the calibrated range
+    const Sprite* nearest(float angleDeg) const;
+
+    float stepDeg() const { return stepDeg_; }
+    int spriteCount() const { return static_cast<int>(sprites_.size()); }
+    qint64 bytes() const { return bytes_; }
+
+  private:
+    VUNeedleAtlas() = default;
+
+    float minAngleDeg_ = 0.0f;
+    float stepDeg_ = kDefaultStepDeg;
+    qint64 bytes_ = 0;
+    std::vector<Sprite> sprites_;
+};
@@ -1,114 +1,297 @@
 #include "VuAudioDsp.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
 
-#include "VUBallistics.h"
+#include "VuDspKernels.h"
+#include "VuFastMath.h"
 
-void processInterleavedFloatAudioToVuDb(const float* data,
-                                       unsigned int frames,
-                                       unsigned int channels,
-                                       float sampleRate,
-                                       const VuReferenceOptions& ref,
-                                       VUBallistics& ballisticsL,
-                                       VUBallistics& ballisticsR,
-                                       VuAudioDspState& state,
-                                       float minVu,
-                                       float maxVu,
-                                       float& outVuL,
-                                       float& outVuR) {
-    if (!data || frames == 0 || channels == 0 || sampleRate <= 0.0f) {
-        outVuL = minVu;
-        outVuR = minVu;
-        return;
+namespace {
+
+// Vintage VU RMS integration
+constexpr float kWakeThreshold = 0.002f; // about -54 dBFS
+constexpr float kVuTau = 0.020f;
+constexpr float kMaxDt = 0.050f; // clamp per-callback dt to 50 ms
+
+// Noise floor applied to smoothed RMS
+constexpr float kNoiseFloor = 0.001f;
+
+// The same thresholds as mean square, for VuMathMode::Fast
+constexpr float kWakePower = kWakeThreshold * kWakeThreshold;
+constexpr float kNoiseFloorPower = kNoiseFloor * kNoiseFloor;
+constexpr float kEpsPower = 1e-24f; // (1e-12)^2, the exact path's floor
+
+// RMS integrator, noise floor and RMS -> VU conversion shared by both integration modes.
+// Writes the VU target per channel and returns true if any channel is above the wake threshold.
+bool integrateRms(const float* rms,
+                  unsigned int channels,
+                  float alpha,
+                  float gain,
+                  VuAudioDspState& state,
+                  float* targetVu) {
+    const float eps = 1e-12f;
+    bool active = false;
+
+    for (unsigned int c = 0; c < channels; ++c) {
+        const float r = rms[c];
+        float& smooth = state.rmsSmooth[c];
+
+        if (r > kWakeThreshold) {
+            smooth = r * r;
+        }
+        smooth = alpha * smooth + (1.0f - alpha) * (r * r);
+
+        float rmsVu = std::sqrt(smooth);
+        if (rmsVu < kNoiseFloor) {
+            rmsVu = 0.0f;
+        }
+        active = active || rmsVu > kWakeThreshold;
+
+        // --- Convert to VU (the gain applies the reference) ---
+        targetVu[c] = 20.0f * std::log10(std::max(rmsVu * gain, eps));
     }
 
-    // --- Compute raw RMS for this buffer ---
-    double sumL = 0.0;
-    double sumR = 0.0;
+    return active;
+}
+
+// integrateRms() for VuMathMode::Fast, on mean squares: the smoothing was
+// already in the power domain, so the square roots go and power is converted
+// straight to dB. Branch-free, so the loop vectorizes.
+bool integratePower(const float* power,
+                    unsigned int channels,
+                    float alpha,
+                    float gain,
+                    VuAudioDspState& state,
+                    float* targetVu) {
+    const float gainPower = gain * gain;
+    bool active = false;
 
-    for (unsigned int i = 0; i < frames; ++i) {
-        const float rawL = data[i * channels + 0];
-        const float rawR = (channels > 1) ? data[i * channels + 1] : rawL;
+    for (unsigned int c = 0; c < channels; ++c) {
+        const float p = power[c];
+        float& smooth = state.rmsSmooth[c];
 
-        // Transient pre-emphasis (very subtle)
-        const float l = rawL + 0.15f * (rawL - state.prevL);
-        const float r = rawR + 0.15f * (rawR - state.prevR);
+        smooth = p > kWakePower ? p : smooth;
+        smooth = alpha * smooth + (1.0f - alpha) * p;
 
-        state.prevL = rawL;
-        state.prevR = rawR;
+        const float level = smooth < kNoiseFloorPower ? 0.0f : smooth;
+        active |= level > kWakePower;
 
-        sumL += static_cast<double>(l) * static_cast<double>(l);
-        sumR += static_cast<double>(r) * static_cast<double>(r);
+        targetVu[c] = vuFastPowerDb(std::max(level * gainPower, kEpsPower));
     }
 
-    const float rmsL = std::sqrt(static_cast<float>(sumL / frames));
-    const float rmsR = std::sqrt(static_cast<float>(sumR / frames));
+    return active;
+}
+
+// Mean square per channel to VU targets in the state's math mode
+bool integrate(const double* sums,
+               double frames,
+               unsigned int channels,
+               float alpha,
+               float gain,
+               VuAudioDspState& state,
+               float* targetVu) {
+    std::array<float, kVuMaxChannels> level;
+    if (state.mathMode == VuMathMode::Fast) {
+        for (unsigned int c = 0; c < channels; ++c) {
+            level[c] = static_cast<float>(sums[c] / frames);
+        }
+        return integratePower(level.data(), channels, alpha, gain, state, targetVu);
+    }
 
-    // --- Vintage VU RMS integration (250 ms) ---
-    const float wakeThreshold = 0.002f; // about -54 dBFS
+    for (unsigned int c = 0; c < channels; ++c) {
+        level[c] = std::sqrt(static_cast<float>(sums[c] / frames));
+    }
+    return integrateRms(level.data(), channels, alpha, gain, state, targetVu);
+}
 
-    if (rmsL > wakeThreshold) {
-        state.rmsL_smooth = rmsL * rmsL;
+void wakeIfNeeded(bool active,
+                  const float* targetVu,
+                  unsigned int channels,
+                  VUBallisticsBank& ballistics,
+                  VuAudioDspState& state) {
+    if (!state.meterAwake && active) {
+        for (unsigned int c = 0; c < channels; ++c) {
+            ballistics.reset(c, targetVu[c]);
+        }
+        state.meterAwake = true;
     }
-    if (rmsR > wakeThreshold) {
-        state.rmsR_smooth = rmsR * rmsR;
+}
+
+// Sum of squares of one more piece of the callback's buffer
+void accumulatePerCallback(const float* data, unsigned int frames, unsigned int stride, VuAudioDspState& state) {
+    // Transient pre-emphasis (very subtle) + sum of squares, see VuDspKernels.h
+    vuActiveEmphasisSumKernel()(data, frames, stride, state.channels, state.prev.data(), state.callbackSum.data());
+    state.callbackFill += frames;
+}
+
+void finishPerCallback(float sampleRate, float gain, VUBallisticsBank& ballistics, VuAudioDspState& state) {
+    const unsigned int channels = state.channels;
+    const unsigned int frames = state.callbackFill;
+    if (frames == 0) {
+        return;
     }
 
-    const float vuTau = 0.020f;
     float dt = static_cast<float>(frames) / sampleRate;
-    dt = std::min(dt, 0.050f); // clamp to 50 ms
-    const float alpha = std::exp(-dt / vuTau);
+    dt = std::min(dt, kMaxDt);
+    if (dt != state.alphaDt) {
+        state.alphaDt = dt;
+        state.alpha = state.mathMode == VuMathMode::Fast ? vuFastExp(-dt / kVuTau) : std::exp(-dt / kVuTau);
+    }
+
+    std::array<float, kVuMaxChannels> targetVu;
+    const bool active =
+        integrate(state.callbackSum.data(), frames, channels, state.alpha, gain, state, targetVu.data());
+    wakeIfNeeded(active, targetVu.data(), channels, ballistics, state);
+
+    // --- Apply ballistics using per-callback dt ---
+    ballistics.process(targetVu.data(), state.lastVu.data(), channels, dt);
 
-    state.rmsL_smooth = alpha * state.rmsL_smooth + (1.0f - alpha) * (rmsL * rmsL);
-    state.rmsR_smooth = alpha * state.rmsR_smooth + (1.0f - alpha) * (rmsR * rmsR);
+    state.callbackFill = 0;
+    state.callbackSum.fill(0.0);
+}
+
+void processBlockAccurate(const float* data,
+                          unsigned int frames,
+                          unsigned int stride,
+                          float sampleRate,
+                          float gain,
+                          VUBallisticsBank& ballistics,
+                          VuAudioDspState& state) {
+    const unsigned int channels = state.channels;
+
+    // --- Coefficients are computed once per sample rate ---
+    if (state.coeffSampleRate != sampleRate || state.controlBlockFrames == 0) {
+        const float controlRate = std::clamp(state.controlRateHz, 1.0f, sampleRate);
+        state.controlBlockFrames = std::max(1u, static_cast<unsigned int>(std::lround(sampleRate / controlRate)));
 
-    float rmsL_vu = std::sqrt(state.rmsL_smooth);
-    float rmsR_vu = std::sqrt(state.rmsR_smooth);
+        // Use the exact block duration so the integrators stay on time
+        const float controlDt = static_cast<float>(state.controlBlockFrames) / sampleRate;
+        state.rmsAlpha = std::exp(-controlDt / kVuTau);
+        state.coeffSampleRate = sampleRate;
 
-    // --- Noise floor applied to smoothed RMS ---
-    const float noiseFloor = 0.001f;
-    if (rmsL_vu < noiseFloor) {
-        rmsL_vu = 0.0f;
+        state.blockFill = 0;
+        state.blockSum.fill(0.0);
+
+        ballistics.setControlStep(controlDt);
     }
-    if (rmsR_vu < noiseFloor) {
-        rmsR_vu = 0.0f;
+
+    const unsigned int blockFrames = state.controlBlockFrames;
+    const VuEmphasisSumKernel kernel = vuActiveEmphasisSumKernel();
+
+    std::array<float, kVuMaxChannels> targetVu;
+
+    while (frames > 0) {
+        // Run the kernel up to the end of the current control block
+        const unsigned int n = std::min(frames, blockFrames - state.blockFill);
+        kernel(data, n, stride, channels, state.prev.data(), state.blockSum.data());
+        data += static_cast<std::size_t>(n) * stride;
+        frames -= n;
+
+        state.blockFill += n;
+        if (state.blockFill < blockFrames) {
+            break;
+        }
+
+        // --- One control step ---
+        const bool active =
+            integrate(state.blockSum.data(), blockFrames, channels, state.rmsAlpha, gain, state, targetVu.data());
+        wakeIfNeeded(active, targetVu.data(), channels, ballistics, state);
+
+        ballistics.step(targetVu.data(), state.lastVu.data(), channels);
+
+        state.blockFill = 0;
+        state.blockSum.fill(0.0);
     }
+}
 
-    // --- Convert to dBFS ---
-    const float eps = 1e-12f;
-    const float dbfsL = 20.0f * std::log10(std::max(rmsL_vu, eps));
-    const float dbfsR = 20.0f * std::log10(std::max(rmsR_vu, eps));
+} // namespace
 
+float vuEffectiveReferenceDbfs(const VuReferenceOptions& ref) {
     // --- Reference level for hi-fi VU behavior ---
-    float effectiveRefDbfs;
     if (ref.referenceDbfsOverride) {
-        effectiveRefDbfs = static_cast<float>(ref.referenceDbfs);
+        return static_cast<float>(ref.referenceDbfs);
     } else if (ref.deviceType == 1) {
         // Microphone mode
-        effectiveRefDbfs = -0.0f;
-    } else {
-        // System output mode
-        effectiveRefDbfs = -14.0f;
+        return -0.0f;
     }
+    // System output mode
+    return -14.0f;
+}
 
-    const float targetVuL = dbfsL - effectiveRefDbfs;
-    const float targetVuR = dbfsR - effectiveRefDbfs;
+VuCalibration vuCalibration(float referenceDbfs) {
+    VuCalibration calibration;
+    calibration.referenceDbfs = referenceDbfs;
+    calibration.gain = std::pow(10.0f, -referenceDbfs / 20.0f);
+    return calibration;
+}
 
-    if (!state.meterAwake && (rmsL_vu > 0.002f || rmsR_vu > 0.002f)) {
-        ballisticsL.reset(targetVuL);
-        ballisticsR.reset(targetVuR);
-        state.meterAwake = true;
+void processInterleavedFloatAudioToVuDb(const float* data,
+                                       unsigned int frames,
+                                       unsigned int channels,
+                                       float sampleRate,
+                                       const VuCalibration& calibration,
+                                       VUBallisticsBank& ballistics,
+                                       VuAudioDspState& state,
+                                       float minVu,
+                                       float maxVu,
+                                       float* outVu) {
+    if (!data || frames == 0 || channels == 0 || sampleRate <= 0.0f) {
+        const unsigned int metered = std::min(channels, kVuMaxChannels);
+        std::fill(outVu, outVu + metered, minVu);
+        return;
     }
 
-    // --- Apply ballistics using per-callback dt ---
-    float vuL = ballisticsL.process(targetVuL, dt);
-    float vuR = ballisticsR.process(targetVuR, dt);
+    vuAccumulateInterleavedFloatAudio(data, frames, channels, sampleRate, calibration, ballistics, state);
+    vuFinishInterleavedFloatAudio(sampleRate, calibration, ballistics, state, minVu, maxVu, outVu);
+}
 
-    // --- Clamp to meter scale ---
-    vuL = std::clamp(vuL, minVu, maxVu);
-    vuR = std::clamp(vuR, minVu, maxVu);
+void vuAccumulateInterleavedFloatAudio(const float* data,
+                                       unsigned int frames,
+                                       unsigned int channels,
+                                       float sampleRate,
+                                       const VuCalibration& calibration,
+                                       VUBallisticsBank& ballistics,
+                                       VuAudioDspState& state) {
+    if (!data || frames == 0 || channels == 0 || sampleRate <= 0.0f) {
+        return;
+    }
 
-    outVuL = vuL;
-    outVuR = vuR;
+    // A new channel layout invalidates every per-channel integrator
+    const unsigned int metered = std::min(channels, kVuMaxChannels);
+    if (state.channels != metered) {
+        state.channels = metered;
+        state.prev.fill(0.0f);
+        state.rmsSmooth.fill(0.0f);
+        state.blockSum.fill(0.0);
+        state.blockFill = 0;
+        state.callbackSum.fill(0.0);
+        state.callbackFill = 0;
+        state.lastVu.fill(-1000.0f);
+        state.meterAwake = false;
+    }
+
+    if (state.integrationMode == VuIntegrationMode::BlockAccurate) {
+        processBlockAccurate(data, frames, channels, sampleRate, calibration.gain, ballistics, state);
+    } else {
+        accumulatePerCallback(data, frames, channels, state);
+    }
+}
+
+void vuFinishInterleavedFloatAudio(float sampleRate,
+                                   const VuCalibration& calibration,
+                                   VUBallisticsBank& ballistics,
+                                   VuAudioDspState& state,
+                                   float minVu,
+                                   float maxVu,
+                                   float* outVu) {
+    if (state.integrationMode == VuIntegrationMode::PerCallback) {
+        finishPerCallback(sampleRate, calibration.gain, ballistics, state);
+    }
+
+    // --- Clamp to meter scale ---
+    for (unsigned int c = 0; c < state.channels; ++c) {
+        outVu[c] = std::clamp(state.lastVu[c], minVu, maxVu);
+    }
 }
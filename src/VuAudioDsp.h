@@ -1,6 +1,8 @@
 #pragma once
 
-class VUBallistics;
+#include <array>
+
+#include "VUBallistics.h"
 
 struct VuReferenceOptions {
     double referenceDbfs = -18.0;
@@ -10,25 +12,120 @@ struct VuReferenceOptions {
     int deviceType = 0;
 };
 
+// dBFS shown as 0 VU: the override, else 0 dBFS for microphones and -14 dBFS
+// for system output
+float vuEffectiveReferenceDbfs(const VuReferenceOptions& ref);
+
+// A reference level prepared for the audio path. The linear gain folds the
+// reference into the level before the log: 20 log10(rms * gain) is the VU
+// reading, so there is no dB conversion of the reference per block.
+struct VuCalibration {
+    float referenceDbfs = 0.0f;
+    float gain = 1.0f; // 10^(-referenceDbfs / 20)
+};
+
+VuCalibration vuCalibration(float referenceDbfs);
+inline VuCalibration vuCalibration(const VuReferenceOptions& ref) {
+    return vuCalibration(vuEffectiveReferenceDbfs(ref));
+}
+
+// How the RMS integrator and ballistics are advanced.
+enum class VuIntegrationMode {
+    // One update per processed buffer with dt = buffer duration (clamped to 50 ms).
+    // Needle dynamics depend on the capture fragment size.
+    PerCallback,
+
+    // Advance at a fixed internal control rate with precomputed coefficients.
+    // Needle dynamics are independent of how the audio is batched.
+    BlockAccurate
+};
+
+// How levels are computed within either integration mode.
+enum class VuMathMode {
+    // std::sqrt/log10/exp; the reference output
+    Exact,
+
+    // The integrators stay in the power domain (no square roots) and power is
+    // converted to dB with the polynomial log2 of VuFastMath.h, once per
+    // integrator update: the ballistics act on dB, so the log cannot wait for
+    // the display frame. Readings are within 1.2e-5 dB of Exact, the bound of
+    // vuFastPowerDb; this is the bound the rest of the tree refers to.
+    Fast
+};
+
+// Per-channel state is stored as structure-of-arrays indexed by channel.
+// Only the first `channels` entries of each array are meaningful.
 struct VuAudioDspState {
-    float prevL = 0.0f;
-    float prevR = 0.0f;
+    VuAudioDspState() { lastVu.fill(-1000.0f); }
 
-    float rmsL_smooth = 0.0f;
-    float rmsR_smooth = 0.0f;
+    // Channels metered by the last call (input channels clamped to kVuMaxChannels)
+    unsigned int channels = 0;
+
+    std::array<float, kVuMaxChannels> prev{};
+    std::array<float, kVuMaxChannels> rmsSmooth{};
 
     bool meterAwake = false;
+
+    VuIntegrationMode integrationMode = VuIntegrationMode::PerCallback;
+    VuMathMode mathMode = VuMathMode::Exact;
+    float controlRateHz = 1000.0f;
+
+    // --- Per-callback integration state ---
+    // RMS coefficient for the last buffer duration; recomputed only when it
+    // changes.
+    float alphaDt = 0.0f;
+    float alpha = 0.0f;
+
+    // The buffer accumulated so far, integrated as one by vuFinishInterleavedFloatAudio()
+    unsigned int callbackFill = 0;
+    std::array<double, kVuMaxChannels> callbackSum{};
+
+    // --- Block-accurate integration state ---
+    // Coefficients are recomputed only when the sample rate changes.
+    float coeffSampleRate = 0.0f;
+    unsigned int controlBlockFrames = 0;
+    float rmsAlpha = 0.0f;
+
+    // Partially filled control block carried over between buffers
+    unsigned int blockFill = 0;
+    std::array<double, kVuMaxChannels> blockSum{};
+
+    // Last ballistics output, returned (clamped) when a buffer completes no
+    // control block. Starts far below any meter scale so it clamps to minVu.
+    std::array<float, kVuMaxChannels> lastVu;
 };
 
+// Meters every channel of an interleaved buffer in one pass. Channels beyond
+// kVuMaxChannels are skipped. outVu receives min(channels, kVuMaxChannels)
+// values; a change in channel count resets the per-channel state.
 void processInterleavedFloatAudioToVuDb(const float* data,
                                        unsigned int frames,
                                        unsigned int channels,
                                        float sampleRate,
-                                       const VuReferenceOptions& ref,
-                                       VUBallistics& ballisticsL,
-                                       VUBallistics& ballisticsR,
+                                       const VuCalibration& calibration,
+                                       VUBallisticsBank& ballistics,
                                        VuAudioDspState& state,
                                        float minVu,
                                        float maxVu,
-                                       float& outVuL,
-                                       float& outVuR);
+                                       float* outVu);
+
+// The same metering fed in consecutive chunks, for callers that run other
+// per-chunk work over the buffer while it is in cache (AudioCapture's broadcast
+// detectors): accumulate each chunk, then finish once per buffer. Matches one
+// processInterleavedFloatAudioToVuDb() call over the whole buffer up to the
+// rounding of the per-chunk sums; finishing an empty buffer repeats the last
+// levels.
+void vuAccumulateInterleavedFloatAudio(const float* data,
+                                       unsigned int frames,
+                                       unsigned int channels,
+                                       float sampleRate,
+                                       const VuCalibration& calibration,
+                                       VUBallisticsBank& ballistics,
+                                       VuAudioDspState& state);
+void vuFinishInterleavedFloatAudio(float sampleRate,
+                                   const VuCalibration& calibration,
+                                   VUBallisticsBank& ballistics,
+                                   VuAudioDspState& state,
+                                   float minVu,
+                                   float maxVu,
+                                   float* outVu);
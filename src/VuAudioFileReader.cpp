@@ -0,0 +1,411 @@
+#include "VuAudioFileReader.h"
+
+#include <QFile>
+#include <QFileInfo>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined(ANALOGVU_HAS_FLAC) && (ANALOGVU_HAS_FLAC == 1)
+#include <FLAC/stream_decoder.h>
+#endif
+
+namespace {
+
+constexpr std::uint16_t kWaveFormatPcm = 0x0001;
+constexpr std::uint16_t kWaveFormatFloat = 0x0003;
+constexpr std::uint16_t kWaveFormatExtensible = 0xFFFE;
+
+std::uint16_t readU16(const char* p) {
+    const auto* b = reinterpret_cast<const unsigned char*>(p);
+    return static_cast<std::uint16_t>(b[0] | (b[1] << 8));
+}
+
+std::uint32_t readU32(const char* p) {
+    const auto* b = reinterpret_cast<const unsigned char*>(p);
+    return static_cast<std::uint32_t>(b[0]) | (static_cast<std::uint32_t>(b[1]) << 8) |
+           (static_cast<std::uint32_t>(b[2]) << 16) | (static_cast<std::uint32_t>(b[3]) << 24);
+}
+
+std::uint64_t readU64(const char* p) {
+    return static_cast<std::uint64_t>(readU32(p)) | (static_cast<std::uint64_t>(readU32(p + 4)) << 32);
+}
+
+// -------- WAV / RF64 --------
+
+class WavReader final : public VuAudioFileReader {
+  public:
+    bool open(const QString& path, QString* errorOut);
+    unsigned int read(float* out, unsigned int maxFrames) override;
+
+  private:
+    bool parseHeader(QString* errorOut);
+    void convert(const char* in, float* out, std::size_t samples) const;
+
+    QFile file_;
+    std::uint16_t format_ = 0;
+    unsigned int bitsPerSample_ = 0;
+    unsigned int blockAlign_ = 0;
+    std::uint64_t dataRemaining_ = 0;
+    std::vector<char> raw_;
+};
+
+bool WavReader::open(const QString& path, QString* errorOut) {
+    file_.setFileName(path);
+    if (!file_.open(QIODevice::ReadOnly)) {
+        if (errorOut)
+            *errorOut = QStringLiteral("Cannot open %1: %2").arg(path, file_.errorString());
+        return false;
+    }
+    return parseHeader(errorOut);
+}
+
+bool WavReader::parseHeader(QString* errorOut) {
+    auto fail = [errorOut](const QString& message) {
+        if (errorOut)
+            *errorOut = message;
+        return false;
+    };
+
+    char riff[12];
+    if (file_.read(riff, sizeof(riff)) != sizeof(riff) || std::memcmp(riff + 8, "WAVE", 4) != 0) {
+        return fail(QStringLiteral("Not a WAV file"));
+    }
+
+    const bool rf64 = std::memcmp(riff, "RF64", 4) == 0;
+    if (!rf64 && std::memcmp(riff, "RIFF", 4) != 0) {
+        return fail(QStringLiteral("Not a WAV file"));
+    }
+
+    bool haveFormat = false;
+    std::uint64_t ds64DataSize = 0;
+
+    for (;;) {
+        char header[8];
+        if (file_.read(header, sizeof(header)) != sizeof(header)) {
+            return fail(QStringLiteral("WAV file has no data chunk"));
+        }
+        const std::uint32_t size = readU32(header + 4);
+
+        if (std::memcmp(header, "ds64", 4) == 0) {
+            char ds64[24];
+            if (size < sizeof(ds64) || file_.read(ds64, sizeof(ds64)) != sizeof(ds64)) {
+                return fail(QStringLiteral("Truncated RF64 ds64 chunk"));
+            }
+            ds64DataSize = readU64(ds64 + 8);
+            file_.skip(size - sizeof(ds64) + (size & 1u));
+            continue;
+        }
+
+        if (std::memcmp(header, "fmt ", 4) == 0) {
+            if (size < 16) {
+                return fail(QStringLiteral("Truncated WAV fmt chunk"));
+            }
+            const QByteArray fmt = file_.read(size);
+            if (fmt.size() != static_cast<qsizetype>(size)) {
+                return fail(QStringLiteral("Truncated WAV fmt chunk"));
+            }
+            file_.skip(size & 1u);
+
+            format_ = readU16(fmt.constData());
+            channels_ = readU16(fmt.constData() + 2);
+            sampleRate_ = static_cast<float>(readU32(fmt.constData() + 4));
+            blockAlign_ = readU16(fmt.constData() + 12);
+            bitsPerSample_ = readU16(fmt.constData() + 14);
+
+            // The sub-format GUID starts with the plain format tag
+            if (format_ == kWaveFormatExtensible && size >= 40) {
+                format_ = readU16(fmt.constData() + 24);
+            }
+            haveFormat = true;
+            continue;
+        }
+
+        if (std::memcmp(header, "data", 4) == 0) {
+            if (!haveFormat) {
+                return fail(QStringLiteral("WAV data chunk precedes the fmt chunk"));
+            }
+
+            std::uint64_t dataSize = size;
+            if (rf64 && size == 0xFFFFFFFFu) {
+                dataSize = ds64DataSize;
+            }
+
+            // Files still being written often carry a zero or oversized length
+            const std::uint64_t available = static_cast<std::uint64_t>(file_.size() - file_.pos());
+            if (dataSize == 0 || dataSize > available) {
+                dataSize = available;
+            }
+            dataRemaining_ = dataSize;
+            break;
+        }
+
+        if (!file_.skip(static_cast<qint64>(size) + (size & 1u))) {
+            return fail(QStringLiteral("Truncated WAV chunk"));
+        }
+    }
+
+    const bool pcm = (format_ == kWaveFormatPcm) &&
+                     (bitsPerSample_ == 8 || bitsPerSample_ == 16 || bitsPerSample_ == 24 || bitsPerSample_ == 32);
+    const bool flt = (format_ == kWaveFormatFloat) && (bitsPerSample_ == 32 || bitsPerSample_ == 64);
+    if (!pcm && !flt) {
+        return fail(QStringLiteral("Unsupported WAV encoding (format %1, %2 bits)").arg(format_).arg(bitsPerSample_));
+    }
+    if (channels_ == 0 || sampleRate_ <= 0.0f || blockAlign_ != channels_ * (bitsPerSample_ / 8)) {
+        return fail(QStringLiteral("Invalid WAV format header"));
+    }
+
+    totalFrames_ = dataRemaining_ / blockAlign_;
+    return true;
+}
+
+void WavReader::convert(const char* in, float* out, std::size_t samples) const {
+    const auto* b = reinterpret_cast<const unsigned char*>(in);
+
+    if (format_ == kWaveFormatFloat) {
+        if (bitsPerSample_ == 32) {
+            for (std::size_t i = 0; i < samples; ++i) {
+                const std::uint32_t bits = readU32(in + i * 4);
+                std::memcpy(&out[i], &bits, sizeof(float));
+            }
+        } else {
+            for (std::size_t i = 0; i < samples; ++i) {
+                const std::uint64_t bits = readU64(in + i * 8);
+                double d = 0.0;
+                std::memcpy(&d, &bits, sizeof(double));
+                out[i] = static_cast<float>(d);
+            }
+        }
+        return;
+    }
+
+    switch (bitsPerSample_) {
+    case 8: // unsigned
+        for (std::size_t i = 0; i < samples; ++i) {
+            out[i] = (static_cast<float>(b[i]) - 128.0f) * (1.0f / 128.0f);
+        }
+        break;
+    case 16:
+        for (std::size_t i = 0; i < samples; ++i) {
+            out[i] = static_cast<float>(static_cast<std::int16_t>(readU16(in + i * 2))) * (1.0f / 32768.0f);
+        }
+        break;
+    case 24:
+        for (std::size_t i = 0; i < samples; ++i) {
+            const unsigned char* s = b + i * 3;
+            const std::int32_t v = static_cast<std::int32_t>((static_cast<std::uint32_t>(s[0]) << 8) |
+                                                             (static_cast<std::uint32_t>(s[1]) << 16) |
+                                                             (static_cast<std::uint32_t>(s[2]) << 24)) >>
+                                   8;
+            out[i] = static_cast<float>(v) * (1.0f / 8388608.0f);
+        }
+        break;
+    case 32:
+        for (std::size_t i = 0; i < samples; ++i) {
+            out[i] = static_cast<float>(static_cast<std::int32_t>(readU32(in + i * 4))) * (1.0f / 2147483648.0f);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+unsigned int WavReader::read(float* out, unsigned int maxFrames) {
+    const std::uint64_t frames = std::min<std::uint64_t>(maxFrames, dataRemaining_ / blockAlign_);
+    if (frames == 0) {
+        return 0;
+    }
+
+    const std::size_t bytes = static_cast<std::size_t>(frames) * blockAlign_;
+    if (raw_.size() < bytes) {
+        raw_.resize(bytes);
+    }
+
+    const qint64 got = file_.read(raw_.data(), static_cast<qint64>(bytes));
+    if (got <= 0) {
+        if (got < 0) {
+            error_ = file_.errorString();
+        }
+        dataRemaining_ = 0;
+        return 0;
+    }
+
+    const unsigned int framesRead = static_cast<unsigned int>(static_cast<std::uint64_t>(got) / blockAlign_);
+    dataRemaining_ -= static_cast<std::uint64_t>(framesRead) * blockAlign_;
+    convert(raw_.data(), out, static_cast<std::size_t>(framesRead) * channels_);
+    return framesRead;
+}
+
+// -------- FLAC --------
+
+#if defined(ANALOGVU_HAS_FLAC) && (ANALOGVU_HAS_FLAC == 1)
+class FlacReader final : public VuAudioFileReader {
+  public:
+    ~FlacReader() override;
+
+    bool open(const QString& path, QString* errorOut);
+    unsigned int read(float* out, unsigned int maxFrames) override;
+
+  private:
+    static FLAC__StreamDecoderWriteStatus writeCallback(const FLAC__StreamDecoder* decoder,
+                                                        const FLAC__Frame* frame,
+                                                        const FLAC__int32* const buffer[],
+                                                        void* clientData);
+    static void metadataCallback(const FLAC__StreamDecoder* decoder,
+                                 const FLAC__StreamMetadata* metadata,
+                                 void* clientData);
+    static void errorCallback(const FLAC__StreamDecoder* decoder,
+                              FLAC__StreamDecoderErrorStatus status,
+                              void* clientData);
+
+    FLAC__StreamDecoder* decoder_ = nullptr;
+    unsigned int bitsPerSample_ = 0;
+
+    // Last recoverable decoder complaint (lost sync, bad CRC); libFLAC resyncs
+    QString lastDecodeError_;
+
+    // One decoded FLAC frame (at most 65535 samples per channel) waiting to be read
+    std::vector<float> pending_;
+    std::size_t pendingPos_ = 0;
+};
+
+FlacReader::~FlacReader() {
+    if (decoder_) {
+        FLAC__stream_decoder_finish(decoder_);
+        FLAC__stream_decoder_delete(decoder_);
+    }
+}
+
+bool FlacReader::open(const QString& path, QString* errorOut) {
+    decoder_ = FLAC__stream_decoder_new();
+    if (!decoder_) {
+        if (errorOut)
+            *errorOut = QStringLiteral("Out of memory creating the FLAC decoder");
+        return false;
+    }
+
+    const QByteArray nativePath = QFile::encodeName(path);
+    const FLAC__StreamDecoderInitStatus status = FLAC__stream_decoder_init_file(
+        decoder_, nativePath.constData(), &FlacReader::writeCallback, &FlacReader::metadataCallback,
+        &FlacReader::errorCallback, this);
+    if (status != FLAC__STREAM_DECODER_INIT_STATUS_OK) {
+        if (errorOut)
+            *errorOut = QStringLiteral("Cannot open FLAC file %1: %2")
+                            .arg(path, QString::fromLatin1(FLAC__StreamDecoderInitStatusString[status]));
+        return false;
+    }
+
+    if (!FLAC__stream_decoder_process_until_end_of_metadata(decoder_) || channels_ == 0 || sampleRate_ <= 0.0f) {
+        if (errorOut)
+            *errorOut = lastDecodeError_.isEmpty() ? QStringLiteral("Invalid FLAC stream header") : lastDecodeError_;
+        return false;
+    }
+    return true;
+}
+
+FLAC__StreamDecoderWriteStatus FlacReader::writeCallback(const FLAC__StreamDecoder*,
+                                                         const FLAC__Frame* frame,
+                                                         const FLAC__int32* const buffer[],
+                                                         void* clientData) {
+    auto* self = static_cast<FlacReader*>(clientData);
+    const unsigned int channels = self->channels_;
+    const unsigned int blocksize = frame->header.blocksize;
+    const float scale = 1.0f / static_cast<float>(1u << (std::max(1u, self->bitsPerSample_) - 1));
+
+    // Drop what was already read before appending
+    self->pending_.erase(self->pending_.begin(), self->pending_.begin() + self->pendingPos_);
+    self->pendingPos_ = 0;
+
+    const std::size_t base = self->pending_.size();
+    self->pending_.resize(base + static_cast<std::size_t>(blocksize) * channels);
+    float* out = self->pending_.data() + base;
+
+    for (unsigned int i = 0; i < blocksize; ++i) {
+        for (unsigned int c = 0; c < channels; ++c) {
+            out[i * channels + c] = static_cast<float>(buffer[c][i]) * scale;
+        }
+    }
+    return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
+}
+
+void FlacReader::metadataCallback(const FLAC__StreamDecoder*, const FLAC__StreamMetadata* metadata, void* clientData) {
+    auto* self = static_cast<FlacReader*>(clientData);
+    if (metadata->type == FLAC__METADATA_TYPE_STREAMINFO) {
+        self->channels_ = metadata->data.stream_info.channels;
+        self->sampleRate_ = static_cast<float>(metadata->data.stream_info.sample_rate);
+        self->bitsPerSample_ = metadata->data.stream_info.bits_per_sample;
+        self->totalFrames_ = metadata->data.stream_info.total_samples;
+    }
+}
+
+void FlacReader::errorCallback(const FLAC__StreamDecoder*, FLAC__StreamDecoderErrorStatus status, void* clientData) {
+    // Not fatal: the decoder skips to the next frame
+    auto* self = static_cast<FlacReader*>(clientData);
+    self->lastDecodeError_ = QString::fromLatin1(FLAC__StreamDecoderErrorStatusString[status]);
+}
+
+unsigned int FlacReader::read(float* out, unsigned int maxFrames) {
+    const std::size_t wanted = static_cast<std::size_t>(maxFrames) * channels_;
+    std::size_t written = 0;
+
+    while (written < wanted) {
+        if (pendingPos_ == pending_.size()) {
+            if (FLAC__stream_decoder_get_state(decoder_) == FLAC__STREAM_DECODER_END_OF_STREAM) {
+                break;
+            }
+            if (!FLAC__stream_decoder_process_single(decoder_)) {
+                error_ = QString::fromLatin1(FLAC__stream_decoder_get_resolved_state_string(decoder_));
+                break;
+            }
+            continue;
+        }
+
+        const std::size_t n = std::min(wanted - written, pending_.size() - pendingPos_);
+        std::memcpy(out + written, pending_.data() + pendingPos_, n * sizeof(float));
+        pendingPos_ += n;
+        written += n;
+    }
+
+    return static_cast<unsigned int>(written / channels_);
+}
+#endif
+
+} // namespace
+
+std::unique_ptr<VuAudioFileReader> VuAudioFileReader::open(const QString& path, QString* errorOut) {
+    QFile probe(path);
+    if (!probe.open(QIODevice::ReadOnly)) {
+        if (errorOut)
+            *errorOut = QStringLiteral("Cannot open %1: %2").arg(path, probe.errorString());
+        return nullptr;
+    }
+    const QByteArray magic = probe.read(4);
+    probe.close();
+
+    if (magic == "RIFF" || magic == "RF64") {
+        auto reader = std::make_unique<WavReader>();
+        if (!reader->open(path, errorOut)) {
+            return nullptr;
+        }
+        return reader;
+    }
+
+    if (magic == "fLaC") {
+#if defined(ANALOGVU_HAS_FLAC) && (ANALOGVU_HAS_FLAC == 1)
+        auto reader = std::make_unique<FlacReader>();
+        if (!reader->open(path, errorOut)) {
+            return nullptr;
+        }
+        return reader;
+#else
+        if (errorOut)
+            *errorOut = QStringLiteral("FLAC support is not available (built without libFLAC)");
+        return nullptr;
+#endif
+    }
+
+    if (errorOut)
+        *errorOut = QStringLiteral("Unsupported audio file format: %1").arg(QFileInfo(path).fileName());
+    return nullptr;
+}
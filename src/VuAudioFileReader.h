@@ -0,0 +1,44 @@
+#pragma once
+
+#include <QString>
+
+#include <cstdint>
+#include <memory>
+
+// Streaming decoder for recorded audio, used by the offline analyzer.
+//
+// Reads interleaved float frames in caller-sized chunks; memory use does not
+// depend on the file length. WAV (PCM 8/16/24/32-bit, float 32/64, extensible
+// and RF64) is always available; FLAC needs libFLAC (ANALOGVU_HAS_FLAC).
+class VuAudioFileReader {
+  public:
+    virtual ~VuAudioFileReader() = default;
+
+    VuAudioFileReader(const VuAudioFileReader&) = delete;
+    VuAudioFileReader& operator=(const VuAudioFileReader&) = delete;
+
+    // Picks the decoder from the file header. Returns nullptr and sets errorOut
+    // if the file cannot be opened or the format is not supported.
+    static std::unique_ptr<VuAudioFileReader> open(const QString& path, QString* errorOut = nullptr);
+
+    unsigned int channels() const { return channels_; }
+    float sampleRate() const { return sampleRate_; }
+
+    // Length in frames, 0 if the container does not say
+    std::uint64_t totalFrames() const { return totalFrames_; }
+
+    // Reads up to maxFrames interleaved frames into out (channels() floats per
+    // frame). Returns the number of frames read; 0 at the end of the stream or
+    // on a decode error (see error()).
+    virtual unsigned int read(float* out, unsigned int maxFrames) = 0;
+
+    QString error() const { return error_; }
+
+  protected:
+    VuAudioFileReader() = default;
+
+    unsigned int channels_ = 0;
+    float sampleRate_ = 0.0f;
+    std::uint64_t totalFrames_ = 0;
+    QString error_;
+};
@@ -0,0 +1,202 @@
+#include "VuCommandLine.h"
+
+#include <algorithm>
+
+VuCommandLine::VuCommandLine()
+    : listDevicesOpt_(QStringList() << "list-devices", "List audio devices and exit."),
+      deviceOpt_(QStringList() << "device", "Audio device index (legacy, unused).", "index"),
+#if defined(__APPLE__)
+      deviceNameOpt_(QStringList() << "device-name", "Audio device UID.", "uid"),
+#else
+      deviceNameOpt_(QStringList() << "device-name", "PulseAudio device name (sink/source).", "name"),
+#endif
+      addDeviceOpt_(QStringList() << "add-device",
+                    "Meter another device as well (same format as --device-name). May be repeated.",
+                    "name"),
+      deviceTypeOpt_(QStringList() << "device-type", "Device type: 0=system output, 1=microphone.", "type", "0"),
+      refOpt_(QStringList() << "ref-dbfs", "Reference dBFS for 0 VU.", "db", "-18"),
+      blockBallisticsOpt_(
+          QStringList() << "block-ballistics",
+          "Advance ballistics at a fixed 1 kHz control rate (independent of the capture fragment size)."),
+      fastMathOpt_(QStringList() << "fast-math",
+                   "Meter with polynomial log/exp in the power domain (within 1.2e-5 dB of the exact path)."),
+      noJitterOpt_(QStringList() << "no-jitter",
+                   "Disable needle micro-jitter (reproducible levels for a given input)."),
+      latencyProfileOpt_(QStringList() << "latency-profile",
+                         "Capture buffering: low (5 ms fragments), balanced (10 ms) or power (50 ms, fewest wakeups).",
+                         "profile",
+                         "balanced"),
+      idleAfterOpt_(
+          QStringList() << "idle-after",
+          "Seconds of silence before a source stops metering and repainting until signal returns (0 = never).",
+          "seconds",
+          "10"),
+      needleOpt_(QStringList() << "needle",
+                 "What the needles follow: vu, ppm, true-peak, momentary or short-term (loudness).",
+                 "source",
+                 "vu"),
+      ppmTypeOpt_(QStringList() << "ppm-type",
+                  "PPM ballistics: 1 (IEC Type I / DIN) or 2 (IEC Type II / BBC, EBU).",
+                  "type",
+                  "2"),
+      exportOpt_(QStringList() << "export", "Send meter frames over UDP to host:port. May be repeated.", "host:port"),
+      exportFormatOpt_(
+          QStringList() << "export-format", "Frame format for --export: binary or osc.", "format", "binary"),
+      exportBatchOpt_(QStringList() << "export-batch", "Frames per packet for --export targets.", "n", "1"),
+      exportRateOpt_(QStringList() << "export-rate", "Frames per second exported from each source.", "hz", "30"),
+      exportListenOpt_(QStringList() << "export-listen",
+                       "Accept UDP subscriptions (\"subscribe [binary|osc] [batch]\") on this port, "
+                       "on loopback unless an address is given.",
+                       "[address:]port"),
+      logLevelsOpt_(QStringList() << "log-levels",
+                    "Headless: print every source's levels to stdout every n milliseconds.",
+                    "ms"),
+      metricsJsonOpt_(QStringList() << "metrics-json",
+                      "On exit, write stage timings and xrun/frame-drop counters as JSON to a file (- for stdout).",
+                      "file") {}
+
+void VuCommandLine::addOptions(QCommandLineParser& parser) const {
+    parser.addOption(listDevicesOpt_);
+    parser.addOption(deviceOpt_);
+    parser.addOption(deviceNameOpt_);
+    parser.addOption(addDeviceOpt_);
+    parser.addOption(deviceTypeOpt_);
+    parser.addOption(refOpt_);
+    parser.addOption(blockBallisticsOpt_);
+    parser.addOption(fastMathOpt_);
+    parser.addOption(noJitterOpt_);
+    parser.addOption(latencyProfileOpt_);
+    parser.addOption(idleAfterOpt_);
+    parser.addOption(needleOpt_);
+    parser.addOption(ppmTypeOpt_);
+    parser.addOption(exportOpt_);
+    parser.addOption(exportFormatOpt_);
+    parser.addOption(exportBatchOpt_);
+    parser.addOption(exportRateOpt_);
+    parser.addOption(exportListenOpt_);
+    parser.addOption(logLevelsOpt_);
+    parser.addOption(metricsJsonOpt_);
+}
+
+bool VuCommandLine::apply(const QCommandLineParser& parser,
+                          AudioCapture::Options* capture,
+                          VuOutputOptions* output,
+                          QString* errorOut) const {
+    // Legacy device index (unused but kept for compatibility)
+    if (parser.isSet(deviceOpt_)) {
+        bool ok = false;
+        const int idx = parser.value(deviceOpt_).toInt(&ok);
+        if (ok) {
+            capture->deviceIndex = idx;
+        }
+    }
+
+    // Device name/UID
+    if (parser.isSet(deviceNameOpt_)) {
+        capture->deviceName = parser.value(deviceNameOpt_);
+    }
+
+    capture->additionalDevices = parser.values(addDeviceOpt_);
+
+    if (parser.isSet(deviceTypeOpt_)) {
+        bool ok = false;
+        const int type = parser.value(deviceTypeOpt_).toInt(&ok);
+        if (ok) {
+            capture->deviceType = type;
+        }
+    }
+
+    if (parser.isSet(refOpt_)) {
+        bool ok = false;
+        const double ref = parser.value(refOpt_).toDouble(&ok);
+        if (ok) {
+            capture->referenceDbfs = ref;
+            capture->referenceDbfsOverride = true;
+        }
+    }
+
+    if (parser.isSet(blockBallisticsOpt_)) {
+        capture->blockAccurateBallistics = true;
+    }
+
+    if (parser.isSet(fastMathOpt_)) {
+        capture->fastMath = true;
+    }
+
+    if (parser.isSet(noJitterOpt_)) {
+        capture->needleJitter = false;
+    }
+
+    if (!AudioCapture::latencyProfileFromName(parser.value(latencyProfileOpt_), &capture->latencyProfile)) {
+        if (errorOut) *errorOut = QStringLiteral("Unknown --latency-profile: %1").arg(parser.value(latencyProfileOpt_));
+        return false;
+    }
+
+    if (parser.isSet(idleAfterOpt_)) {
+        bool ok = false;
+        const double seconds = parser.value(idleAfterOpt_).toDouble(&ok);
+        if (ok && seconds >= 0.0) {
+            capture->idle.idleAfterSeconds = static_cast<float>(seconds);
+        }
+    }
+
+    if (!vuNeedleSourceFromName(parser.value(needleOpt_).toUtf8().constData(), &capture->needleSource)) {
+        if (errorOut) *errorOut = QStringLiteral("Unknown --needle: %1").arg(parser.value(needleOpt_));
+        return false;
+    }
+
+    const QString ppmType = parser.value(ppmTypeOpt_);
+    if (ppmType == QLatin1String("1")) {
+        capture->detectors.ppmType = VuPpmType::Type1;
+    } else if (ppmType != QLatin1String("2")) {
+        if (errorOut) *errorOut = QStringLiteral("Unknown --ppm-type: %1").arg(ppmType);
+        return false;
+    }
+
+    VuLevelExporter::Format exportFormat = VuLevelExporter::Format::Binary;
+    if (!VuLevelExporter::formatFromName(parser.value(exportFormatOpt_), &exportFormat)) {
+        if (errorOut) *errorOut = QStringLiteral("Unknown --export-format: %1").arg(parser.value(exportFormatOpt_));
+        return false;
+    }
+    const unsigned int exportBatch = std::max(1u, parser.value(exportBatchOpt_).toUInt());
+    for (const QString& value : parser.values(exportOpt_)) {
+        VuLevelExporter::Target target;
+        if (!VuLevelExporter::parseTarget(value, &target)) {
+            if (errorOut) *errorOut = QStringLiteral("Invalid --export target (expected host:port): %1").arg(value);
+            return false;
+        }
+        target.format = exportFormat;
+        target.batch = exportBatch;
+        output->exporter.targets.append(target);
+    }
+
+    if (parser.isSet(exportRateOpt_)) {
+        bool ok = false;
+        const double rate = parser.value(exportRateOpt_).toDouble(&ok);
+        if (ok && rate > 0.0) {
+            output->exporter.rateHz = rate;
+        }
+    }
+
+    if (parser.isSet(exportListenOpt_)) {
+        const QString value = parser.value(exportListenOpt_);
+        if (!VuLevelExporter::parseListen(value, &output->exporter.listenHost, &output->exporter.listenPort)) {
+            if (errorOut) *errorOut = QStringLiteral("Invalid --export-listen address: %1").arg(value);
+            return false;
+        }
+    }
+
+    if (parser.isSet(logLevelsOpt_)) {
+        const QString value = parser.value(logLevelsOpt_);
+        bool ok = false;
+        const double ms = value.toDouble(&ok);
+        if (!ok || ms <= 0.0) {
+            if (errorOut) *errorOut = QStringLiteral("Invalid --log-levels interval: %1").arg(value);
+            return false;
+        }
+        output->logIntervalMs = ms;
+    }
+
+    output->metricsJsonPath = parser.value(metricsJsonOpt_);
+    return true;
+}
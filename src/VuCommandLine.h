@@ -0,0 +1,49 @@
+#pragma once
+
+#include <QCommandLineOption>
+#include <QCommandLineParser>
+#include <QString>
+
+#include "AudioCapture.h"
+#include "VuHeadless.h"
+
+// Command line options shared by analog_vu_meter and analog_vu_headless:
+// device selection, calibration, ballistics, detectors, level export, level
+// logging and metrics. Each front end adds its own options alongside.
+class VuCommandLine final {
+  public:
+    VuCommandLine();
+
+    void addOptions(QCommandLineParser& parser) const;
+
+    bool listDevices(const QCommandLineParser& parser) const { return parser.isSet(listDevicesOpt_); }
+
+    // Applies the parsed values over capture and output. Returns false and
+    // sets errorOut for a value that cannot be used (exit status 2).
+    bool apply(const QCommandLineParser& parser,
+               AudioCapture::Options* capture,
+               VuOutputOptions* output,
+               QString* errorOut = nullptr) const;
+
+  private:
+    QCommandLineOption listDevicesOpt_;
+    QCommandLineOption deviceOpt_;
+    QCommandLineOption deviceNameOpt_;
+    QCommandLineOption addDeviceOpt_;
+    QCommandLineOption deviceTypeOpt_;
+    QCommandLineOption refOpt_;
+    QCommandLineOption blockBallisticsOpt_;
+    QCommandLineOption fastMathOpt_;
+    QCommandLineOption noJitterOpt_;
+    QCommandLineOption latencyProfileOpt_;
+    QCommandLineOption idleAfterOpt_;
+    QCommandLineOption needleOpt_;
+    QCommandLineOption ppmTypeOpt_;
+    QCommandLineOption exportOpt_;
+    QCommandLineOption exportFormatOpt_;
+    QCommandLineOption exportBatchOpt_;
+    QCommandLineOption exportRateOpt_;
+    QCommandLineOption exportListenOpt_;
+    QCommandLineOption logLevelsOpt_;
+    QCommandLineOption metricsJsonOpt_;
+};
@@ -0,0 +1,442 @@
+#include "VuDetectors.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+namespace {
+
+// ITU-R BS.1770-4 Annex 2 interpolation filter, one row per phase, taps in
+// x[n], x[n-1], ... order
+constexpr float kTruePeakCoeffs[kVuTruePeakPhases][kVuTruePeakTaps] = {
+    {0.0017089843750f, 0.0109863281250f, -0.0196533203125f, 0.0332031250000f, -0.0594482421875f, 0.1373291015625f,
+     0.9721679687500f, -0.1022949218750f, 0.0476074218750f, -0.0266113281250f, 0.0148925781250f, -0.0083007812500f},
+    {-0.0291748046875f, 0.0292968750000f, -0.0517578125000f, 0.0891113281250f, -0.1665039062500f, 0.4650878906250f,
+     0.7797851562500f, -0.2003173828125f, 0.1015625000000f, -0.0582275390625f, 0.0330810546875f, -0.0189208984375f},
+    {-0.0189208984375f, 0.0330810546875f, -0.0582275390625f, 0.1015625000000f, -0.2003173828125f, 0.7797851562500f,
+     0.4650878906250f, -0.1665039062500f, 0.0891113281250f, -0.0517578125000f, 0.0292968750000f, -0.0291748046875f},
+    {-0.0083007812500f, 0.0148925781250f, -0.0266113281250f, 0.0476074218750f, -0.1022949218750f, 0.9721679687500f,
+     0.1373291015625f, -0.0594482421875f, 0.0332031250000f, -0.0196533203125f, 0.0109863281250f, 0.0017089843750f},
+};
+
+constexpr unsigned int kChunkFrames = kVuDetectorChunkFrames;
+
+// Display hold release of the true-peak reading
+constexpr float kTruePeakReleaseDb = 20.0f;
+constexpr float kTruePeakReleaseSeconds = 1.5f;
+
+// BS.1770 loudness offset
+constexpr double kLoudnessOffset = -0.691;
+
+// Attack time constants of a one-pole follower on the rectified signal,
+// fitted so a 10 ms 5 kHz tone burst reads the spec value against a steady
+// tone (-1 dB for Type I, -2.5 dB for Type II)
+struct PpmBallistics {
+    float attackSeconds;
+    float fallDb;
+    float fallSeconds;
+};
+
+PpmBallistics ppmBallistics(VuPpmType type) {
+    if (type == VuPpmType::Type1) {
+        return {0.00169f, 20.0f, 1.5f};
+    }
+    return {0.00334f, 24.0f, 2.8f};
+}
+
+// Per-sample multiplier for a fall of db decibels in seconds
+float releaseMultiplier(float db, float seconds, float sampleRate) {
+    return std::pow(10.0f, -db / (20.0f * seconds * sampleRate));
+}
+
+float linearToDb(float v) {
+    return v > 0.0f ? std::max(kVuDetectorFloorDb, 20.0f * std::log10(v)) : kVuDetectorFloorDb;
+}
+
+float energyToLufs(double energy) {
+    if (energy <= 0.0) {
+        return kVuDetectorFloorDb;
+    }
+    return std::max(kVuDetectorFloorDb, static_cast<float>(kLoudnessOffset + 10.0 * std::log10(energy)));
+}
+
+// BS.1770 K-weighting for any sample rate (the standard gives 48 kHz
+// coefficients; these are the analog prototypes they were derived from)
+void designKWeighting(double fs, std::array<double, 5>& shelf, std::array<double, 5>& highPass) {
+    const double pi = 3.14159265358979323846;
+
+    {
+        const double f0 = 1681.974450955533;
+        const double gainDb = 3.999843853973347;
+        const double q = 0.7071752369554196;
+        const double k = std::tan(pi * f0 / fs);
+        const double vh = std::pow(10.0, gainDb / 20.0);
+        const double vb = std::pow(vh, 0.4996667741545416);
+        const double a0 = 1.0 + k / q + k * k;
+        shelf = {(vh + vb * k / q + k * k) / a0,
+                 2.0 * (k * k - vh) / a0,
+                 (vh - vb * k / q + k * k) / a0,
+                 2.0 * (k * k - 1.0) / a0,
+                 (1.0 - k / q + k * k) / a0};
+    }
+    {
+        const double f0 = 38.13547087602444;
+        const double q = 0.5003270373238773;
+        const double k = std::tan(pi * f0 / fs);
+        const double a0 = 1.0 + k / q + k * k;
+        highPass = {1.0, -2.0, 1.0, 2.0 * (k * k - 1.0) / a0, (1.0 - k / q + k * k) / a0};
+    }
+}
+
+// BS.1770 channel weights for the usual WAV/SMPTE orders: 5.0 is
+// L R C Ls Rs, 5.1 is L R C LFE Ls Rs (LFE excluded); anything else counts
+// every channel once
+void channelWeights(unsigned int channels, std::array<double, kVuMaxChannels>& weights) {
+    weights.fill(1.0);
+    if (channels == 5) {
+        weights[3] = weights[4] = 1.41;
+    } else if (channels == 6) {
+        weights[3] = 0.0;
+        weights[4] = weights[5] = 1.41;
+    }
+}
+
+void configure(float sampleRate, unsigned int channels, VuPpmType ppmType, VuDetectorState& state) {
+    state.sampleRate = sampleRate;
+    state.channels = channels;
+    state.ppmType = ppmType;
+
+    for (auto& h : state.tpHistory) {
+        h.fill(0.0f);
+    }
+    state.tpHold.fill(0.0f);
+    state.tpRelease = releaseMultiplier(kTruePeakReleaseDb, kTruePeakReleaseSeconds, sampleRate);
+
+    const PpmBallistics ppm = ppmBallistics(ppmType);
+    state.ppm.fill(0.0f);
+    state.ppmAttack = 1.0f - std::exp(-1.0f / (ppm.attackSeconds * sampleRate));
+    state.ppmRelease = releaseMultiplier(ppm.fallDb, ppm.fallSeconds, sampleRate);
+
+    designKWeighting(sampleRate, state.shelf, state.highPass);
+    for (auto& s : state.kState) {
+        s.fill(0.0);
+    }
+    channelWeights(channels, state.channelWeight);
+
+    state.subBlockFrames = std::max(1u, static_cast<unsigned int>(std::lround(sampleRate * 0.1f)));
+    state.subBlockFill = 0;
+    state.subBlockSum = 0.0;
+    state.subBlocks.fill(0.0);
+    state.subBlockPos = 0;
+    state.subBlockCount = 0;
+
+    vuResetLoudness(state);
+
+    VuDetectorReadings& r = state.readings;
+    r.channels = channels;
+    r.truePeakDbtp.fill(kVuDetectorFloorDb);
+    r.ppmDbfs.fill(kVuDetectorFloorDb);
+    r.momentaryLufs = kVuDetectorFloorDb;
+    r.shortTermLufs = kVuDetectorFloorDb;
+}
+
+double meanOfLastSubBlocks(const VuDetectorState& state, unsigned int count) {
+    count = std::min(count, state.subBlockCount);
+    if (count == 0) {
+        return 0.0;
+    }
+    double sum = 0.0;
+    unsigned int pos = state.subBlockPos;
+    for (unsigned int i = 0; i < count; ++i) {
+        pos = (pos == 0 ? kVuLoudnessSubBlocks : pos) - 1;
+        sum += state.subBlocks[pos];
+    }
+    return sum / count;
+}
+
+float integratedLoudness(const VuDetectorState& state) {
+    // Absolute gate: the histogram only holds blocks above it
+    double energy = 0.0;
+    std::uint64_t blocks = 0;
+    for (unsigned int b = 0; b < kVuLoudnessBins; ++b) {
+        energy += state.gateEnergy[b];
+        blocks += state.gateCount[b];
+    }
+    if (blocks == 0) {
+        return kVuDetectorFloorDb;
+    }
+
+    // Relative gate 10 LU below the absolute-gated loudness, to bin resolution
+    const float relativeGate = energyToLufs(energy / static_cast<double>(blocks)) - 10.0f;
+    const int first = std::max(0, static_cast<int>(std::ceil((relativeGate - kVuLoudnessGateLufs) * 10.0f)));
+
+    energy = 0.0;
+    blocks = 0;
+    for (unsigned int b = static_cast<unsigned int>(first); b < kVuLoudnessBins; ++b) {
+        energy += state.gateEnergy[b];
+        blocks += state.gateCount[b];
+    }
+    return blocks > 0 ? energyToLufs(energy / static_cast<double>(blocks)) : kVuDetectorFloorDb;
+}
+
+// Closes a 100 ms sub-block: updates momentary/short-term and feeds the
+// 400 ms gating block that ends here into the histogram
+void finishSubBlock(VuDetectorState& state) {
+    state.subBlocks[state.subBlockPos] = state.subBlockSum / state.subBlockFrames;
+    state.subBlockPos = (state.subBlockPos + 1) % kVuLoudnessSubBlocks;
+    state.subBlockCount = std::min(state.subBlockCount + 1, kVuLoudnessSubBlocks);
+    state.subBlockFill = 0;
+    state.subBlockSum = 0.0;
+
+    const double momentary = meanOfLastSubBlocks(state, 4);
+    state.readings.momentaryLufs = energyToLufs(momentary);
+    state.readings.shortTermLufs = energyToLufs(meanOfLastSubBlocks(state, kVuLoudnessSubBlocks));
+
+    if (state.subBlockCount >= 4) {
+        const float lufs = energyToLufs(momentary);
+        if (lufs > kVuLoudnessGateLufs) {
+            const int bin = std::clamp(
+                static_cast<int>((lufs - kVuLoudnessGateLufs) * 10.0f), 0, static_cast<int>(kVuLoudnessBins) - 1);
+            ++state.gateCount[bin];
+            state.gateEnergy[bin] += momentary;
+            state.readings.integratedLufs = integratedLoudness(state);
+        }
+    }
+}
+
+} // namespace
+
+VuDetectorState::VuDetectorState() {
+    readings.truePeakDbtp.fill(kVuDetectorFloorDb);
+    readings.ppmDbfs.fill(kVuDetectorFloorDb);
+}
+
+void VuDetectorOptions::enableFor(VuNeedleSource source) {
+    switch (source) {
+    case VuNeedleSource::Ppm:
+        ppm = true;
+        break;
+    case VuNeedleSource::TruePeak:
+        truePeak = true;
+        break;
+    case VuNeedleSource::MomentaryLoudness:
+    case VuNeedleSource::ShortTermLoudness:
+        loudness = true;
+        break;
+    case VuNeedleSource::Vu:
+        break;
+    }
+}
+
+void vuResetLoudness(VuDetectorState& state) {
+    state.gateCount.fill(0);
+    state.gateEnergy.fill(0.0);
+    state.tpProgramMax = 0.0f;
+    state.readings.integratedLufs = kVuDetectorFloorDb;
+    state.readings.maxTruePeakDbtp = kVuDetectorFloorDb;
+}
+
+namespace {
+
+// Highest of the four interpolated phases over the n samples in x
+// (x[-kVuTruePeakTaps + 1 .. -1] holds the preceding input). The filter runs
+// in fixed 16-sample lanes so it vectorizes without a scalar tail; x must be
+// readable up to the next multiple of 16.
+float truePeakBlock(const float* x, unsigned int n) {
+    constexpr unsigned int kLane = 16;
+    float peak = 0.0f;
+    for (unsigned int base = 0; base < n; base += kLane) {
+        const float* in = x + base;
+        float lanePeak[kLane] = {};
+        for (unsigned int p = 0; p < kVuTruePeakPhases; ++p) {
+            float y[kLane] = {};
+            for (unsigned int t = 0; t < kVuTruePeakTaps; ++t) {
+                const float coeff = kTruePeakCoeffs[p][t];
+                const float* tap = in - t;
+                for (unsigned int i = 0; i < kLane; ++i) {
+                    y[i] += coeff * tap[i];
+                }
+            }
+            for (unsigned int i = 0; i < kLane; ++i) {
+                lanePeak[i] = std::max(lanePeak[i], std::abs(y[i]));
+            }
+        }
+        const unsigned int valid = std::min(kLane, n - base);
+        for (unsigned int i = 0; i < valid; ++i) {
+            peak = std::max(peak, lanePeak[i]);
+        }
+    }
+    return peak;
+}
+
+void processChunk(const float* data,
+                  unsigned int frames,
+                  unsigned int stride,
+                  const VuDetectorOptions& options,
+                  VuDetectorState& state) {
+    // History ahead of the block for the interpolation filter
+    constexpr unsigned int kHistory = kVuTruePeakTaps - 1;
+    float scratch[kHistory + kChunkFrames] = {};
+    float* x = scratch + kHistory;
+    double energy[kChunkFrames];
+    if (options.loudness) {
+        std::fill(energy, energy + frames, 0.0);
+    }
+
+    const float holdDecay = std::pow(state.tpRelease, static_cast<float>(frames));
+
+    for (unsigned int c = 0; c < state.channels; ++c) {
+        for (unsigned int i = 0; i < frames; ++i) {
+            x[i] = data[static_cast<std::size_t>(i) * stride + c];
+        }
+
+        if (options.truePeak) {
+            std::array<float, kHistory>& history = state.tpHistory[c];
+            std::copy(history.begin(), history.end(), scratch);
+            const float blockPeak = truePeakBlock(x, frames);
+            // The history runs straight into the block, so this also works
+            // for blocks shorter than the history
+            std::copy(scratch + frames, scratch + frames + kHistory, history.begin());
+
+            // Hold decays per block; within one block the error is below 0.1 dB
+            state.tpHold[c] = std::max(blockPeak, state.tpHold[c] * holdDecay);
+            state.tpProgramMax = std::max(state.tpProgramMax, blockPeak);
+        }
+
+        if (options.ppm) {
+            const float attack = state.ppmAttack;
+            const float release = state.ppmRelease;
+            float q = state.ppm[c];
+            for (unsigned int i = 0; i < frames; ++i) {
+                const float r = std::abs(x[i]);
+                q = (r > q) ? q + attack * (r - q) : q * release;
+            }
+            state.ppm[c] = q;
+        }
+
+        if (options.loudness && state.channelWeight[c] > 0.0) {
+            const std::array<double, 5>& sh = state.shelf;
+            const std::array<double, 5>& hp = state.highPass;
+            const double weight = state.channelWeight[c];
+            std::array<double, 4> z = state.kState[c];
+            for (unsigned int i = 0; i < frames; ++i) {
+                const double in = x[i];
+                const double s = sh[0] * in + z[0];
+                z[0] = sh[1] * in - sh[3] * s + z[1];
+                z[1] = sh[2] * in - sh[4] * s;
+                const double k = hp[0] * s + z[2];
+                z[2] = hp[1] * s - hp[3] * k + z[3];
+                z[3] = hp[2] * s - hp[4] * k;
+                energy[i] += weight * k * k;
+            }
+            state.kState[c] = z;
+        }
+    }
+
+    if (options.loudness) {
+        unsigned int i = 0;
+        while (i < frames) {
+            const unsigned int n = std::min(frames - i, state.subBlockFrames - state.subBlockFill);
+            for (unsigned int j = 0; j < n; ++j) {
+                state.subBlockSum += energy[i + j];
+            }
+            i += n;
+            state.subBlockFill += n;
+            if (state.subBlockFill == state.subBlockFrames) {
+                finishSubBlock(state);
+            }
+        }
+    }
+}
+
+} // namespace
+
+void processInterleavedFloatAudioDetectors(const float* data,
+                                           unsigned int frames,
+                                           unsigned int channels,
+                                           float sampleRate,
+                                           const VuDetectorOptions& options,
+                                           VuDetectorState& state) {
+    const unsigned int metered = std::min(channels, kVuMaxChannels);
+    if (!data || frames == 0 || metered == 0 || sampleRate <= 0.0f || !options.any()) {
+        return;
+    }
+
+    if (state.sampleRate != sampleRate || state.channels != metered || state.ppmType != options.ppmType) {
+        configure(sampleRate, metered, options.ppmType, state);
+    }
+
+    for (unsigned int pos = 0; pos < frames; pos += kChunkFrames) {
+        const unsigned int n = std::min(kChunkFrames, frames - pos);
+        processChunk(data + static_cast<std::size_t>(pos) * channels, n, channels, options, state);
+    }
+
+    VuDetectorReadings& r = state.readings;
+    if (options.truePeak) {
+        for (unsigned int c = 0; c < metered; ++c) {
+            r.truePeakDbtp[c] = linearToDb(state.tpHold[c]);
+        }
+        r.maxTruePeakDbtp = linearToDb(state.tpProgramMax);
+    }
+    if (options.ppm) {
+        for (unsigned int c = 0; c < metered; ++c) {
+            r.ppmDbfs[c] = linearToDb(state.ppm[c]);
+        }
+    }
+}
+
+float vuNeedleReading(const VuDetectorReadings& readings, VuNeedleSource source, unsigned int channel) {
+    channel = std::min(channel, kVuMaxChannels - 1);
+    switch (source) {
+    case VuNeedleSource::Ppm:
+        return readings.ppmDbfs[channel];
+    case VuNeedleSource::TruePeak:
+        return readings.truePeakDbtp[channel];
+    case VuNeedleSource::MomentaryLoudness:
+        return readings.momentaryLufs;
+    case VuNeedleSource::ShortTermLoudness:
+        return readings.shortTermLufs;
+    case VuNeedleSource::Vu:
+        break;
+    }
+    return kVuDetectorFloorDb;
+}
+
+namespace {
+
+struct NeedleSourceName {
+    VuNeedleSource source;
+    const char* name;
+};
+
+constexpr NeedleSourceName kNeedleSourceNames[] = {
+    {VuNeedleSource::Vu, "vu"},
+    {VuNeedleSource::Ppm, "ppm"},
+    {VuNeedleSource::TruePeak, "true-peak"},
+    {VuNeedleSource::MomentaryLoudness, "momentary"},
+    {VuNeedleSource::ShortTermLoudness, "short-term"},
+};
+
+} // namespace
+
+const char* vuNeedleSourceName(VuNeedleSource source) {
+    for (const NeedleSourceName& n : kNeedleSourceNames) {
+        if (n.source == source) {
+            return n.name;
+        }
+    }
+    return "vu";
+}
+
+bool vuNeedleSourceFromName(const char* name, VuNeedleSource* out) {
+    for (const NeedleSourceName& n : kNeedleSourceNames) {
+        if (std::strcmp(n.name, name) == 0) {
+            if (out) {
+                *out = n.source;
+            }
+            return true;
+        }
+    }
+    return false;
+}
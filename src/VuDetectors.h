@@ -0,0 +1,147 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "VUBallistics.h"
+
+// Broadcast detectors metered alongside the VU path:
+//   - true peak: 4x polyphase oversampling with the ITU-R BS.1770-4 Annex 2
+//     interpolation filter (48 taps, 12 per phase)
+//   - PPM: IEC 60268-10 quasi-peak programme meter ballistics
+//   - loudness: EBU R128 / BS.1770 K-weighting, momentary (400 ms), short-term
+//     (3 s) and gated integrated loudness
+//
+// The buffer is read once: it is walked in short chunks, each chunk is
+// de-interleaved per channel into a stack scratch block that stays in L1, and
+// every enabled detector runs over that block. The oversampling filter is
+// evaluated across consecutive samples so it vectorizes. All state, including
+// the integrated-loudness gating histogram, is held in fixed-size arrays in
+// VuDetectorState, so processing never allocates.
+
+inline constexpr unsigned int kVuTruePeakTaps = 12; // per phase
+inline constexpr unsigned int kVuTruePeakPhases = 4;
+
+// Readings below this (silence) are reported as this value
+inline constexpr float kVuDetectorFloorDb = -120.0f;
+
+// Integrated loudness gating histogram: 0.1 LU bins from the -70 LUFS absolute
+// gate up to +5 LUFS (louder blocks land in the top bin with their exact energy)
+inline constexpr float kVuLoudnessGateLufs = -70.0f;
+inline constexpr unsigned int kVuLoudnessBins = 750;
+
+// Short-term window in 100 ms sub-blocks
+inline constexpr unsigned int kVuLoudnessSubBlocks = 30;
+
+// What the needle follows. Detector readings are shown relative to the same
+// 0 VU reference dBFS as the VU path, so e.g. a -23 dBFS reference puts a
+// programme at -23 LUFS on 0 VU.
+enum class VuNeedleSource {
+    Vu,
+    Ppm,
+    TruePeak,
+    MomentaryLoudness,
+    ShortTermLoudness
+};
+
+enum class VuPpmType {
+    Type1, // IEC 60268-10 Type I (DIN 45406): 10 ms burst reads -1 dB, falls 20 dB in 1.5 s
+    Type2  // IEC 60268-10 Type II (BBC/EBU): 10 ms burst reads -2.5 dB, falls 24 dB in 2.8 s
+};
+
+struct VuDetectorOptions {
+    bool truePeak = false;
+    bool ppm = false;
+    bool loudness = false;
+    VuPpmType ppmType = VuPpmType::Type2;
+
+    bool any() const { return truePeak || ppm || loudness; }
+
+    // Turns on whatever the needle source needs
+    void enableFor(VuNeedleSource source);
+};
+
+struct VuDetectorReadings {
+    unsigned int channels = 0;
+
+    // dBTP, held and released at 20 dB / 1.5 s so the reading can be seen
+    std::array<float, kVuMaxChannels> truePeakDbtp{};
+    // Highest true peak of any channel since the last vuResetLoudness()
+    float maxTruePeakDbtp = kVuDetectorFloorDb;
+
+    // dBFS of a full-scale sine's peak (quasi-peak, rectified)
+    std::array<float, kVuMaxChannels> ppmDbfs{};
+
+    float momentaryLufs = kVuDetectorFloorDb;
+    float shortTermLufs = kVuDetectorFloorDb;
+    float integratedLufs = kVuDetectorFloorDb;
+};
+
+struct VuDetectorState {
+    VuDetectorState();
+
+    // Layout the coefficients were computed for; a change resets every detector
+    float sampleRate = 0.0f;
+    unsigned int channels = 0;
+    VuPpmType ppmType = VuPpmType::Type2;
+
+    // --- True peak ---
+    // Last kVuTruePeakTaps - 1 input samples per channel, oldest first
+    std::array<std::array<float, kVuTruePeakTaps - 1>, kVuMaxChannels> tpHistory{};
+    std::array<float, kVuMaxChannels> tpHold{}; // linear
+    float tpRelease = 1.0f;                     // per-sample hold multiplier
+    float tpProgramMax = 0.0f;
+
+    // --- PPM ---
+    std::array<float, kVuMaxChannels> ppm{}; // linear
+    float ppmAttack = 1.0f;
+    float ppmRelease = 1.0f;
+
+    // --- Loudness ---
+    // K-weighting: high shelf then high pass, as {b0, b1, b2, a1, a2}
+    std::array<double, 5> shelf{};
+    std::array<double, 5> highPass{};
+    // Transposed direct form II state {shelf z1, z2, high pass z1, z2}
+    std::array<std::array<double, 4>, kVuMaxChannels> kState{};
+    std::array<double, kVuMaxChannels> channelWeight{};
+
+    unsigned int subBlockFrames = 0; // 100 ms
+    unsigned int subBlockFill = 0;
+    double subBlockSum = 0.0;
+
+    // Mean weighted energy of the last sub-blocks (ring, newest at subBlockPos - 1)
+    std::array<double, kVuLoudnessSubBlocks> subBlocks{};
+    unsigned int subBlockPos = 0;
+    unsigned int subBlockCount = 0;
+
+    // 400 ms gating blocks (75% overlap) above the absolute gate
+    std::array<std::uint32_t, kVuLoudnessBins> gateCount{};
+    std::array<double, kVuLoudnessBins> gateEnergy{};
+
+    VuDetectorReadings readings;
+};
+
+// Frames per scratch block; small enough for the block and the filter
+// outputs to stay in L1. Callers that run other work over the same audio can
+// feed it in chunks of this size at no extra cost.
+inline constexpr unsigned int kVuDetectorChunkFrames = 256;
+
+// Runs the enabled detectors over an interleaved buffer and writes the
+// readings after the last frame to state.readings. Channels beyond
+// kVuMaxChannels are skipped.
+void processInterleavedFloatAudioDetectors(const float* data,
+                                           unsigned int frames,
+                                           unsigned int channels,
+                                           float sampleRate,
+                                           const VuDetectorOptions& options,
+                                           VuDetectorState& state);
+
+// Starts a new programme: clears the integrated loudness and the maximum true peak
+void vuResetLoudness(VuDetectorState& state);
+
+// The reading a non-VU needle source shows for a channel, in dBFS / LUFS
+float vuNeedleReading(const VuDetectorReadings& readings, VuNeedleSource source, unsigned int channel);
+
+// "vu", "ppm", "true-peak", "momentary", "short-term"
+const char* vuNeedleSourceName(VuNeedleSource source);
+bool vuNeedleSourceFromName(const char* name, VuNeedleSource* out);
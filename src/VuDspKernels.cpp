@@ -0,0 +1,351 @@
+#include "VuDspKernels.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <numeric>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define ANALOGVU_DSP_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define ANALOGVU_DSP_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+constexpr float kPreEmphasis = 0.15f;
+
+// Longest lane/channel period the vector kernels accumulate per position
+// (lcm(channels, lanes) for up to 32 channels and 8 lanes).
+constexpr unsigned int kMaxLanePeriod = 256;
+
+// Reference implementation; also handles stride != channels, and the
+// buffers the vector loops do not cover.
+void emphasisSumScalar(const float* data,
+                       unsigned int frames,
+                       unsigned int stride,
+                       unsigned int channels,
+                       float* prev,
+                       double* sums) {
+    for (unsigned int i = 0; i < frames; ++i) {
+        const float* frame = data + static_cast<std::size_t>(i) * stride;
+
+        for (unsigned int c = 0; c < channels; ++c) {
+            const float raw = frame[c];
+            const float e = raw + kPreEmphasis * (raw - prev[c]);
+            prev[c] = raw;
+
+            sums[c] += static_cast<double>(e) * static_cast<double>(e);
+        }
+    }
+}
+
+// The vector kernels treat the interleaved buffer as one flat sample stream:
+// a vector at flat index k and the same load shifted back by `channels`
+// floats give the current and previous sample for each lane, so no shuffle
+// is needed for any channel count. Lane j of the vector at k belongs to
+// channel (k + j) % channels, which repeats with period lcm(channels, lanes).
+// When channels divides the lane count (mono, stereo, quad, 8ch on AVX2) that
+// period is one vector and the accumulators stay in registers; otherwise
+// (5.1, 7.1 on SSE2, odd counts) they are kept per period position in memory.
+// Frame 0 (which needs prev[]) goes through the scalar kernel.
+
+unsigned int lanePeriod(unsigned int channels, unsigned int lanes) {
+    return channels / std::gcd(channels, lanes) * lanes;
+}
+
+// Scalar pre-emphasis for flat indices [begin, total) and the hand-over of prev[].
+void finishFlat(const float* data,
+                std::size_t begin,
+                std::size_t total,
+                unsigned int channels,
+                float* prev,
+                double* sums) {
+    for (std::size_t k = begin; k < total; ++k) {
+        const float raw = data[k];
+        const float e = raw + kPreEmphasis * (raw - data[k - channels]);
+        sums[k % channels] += static_cast<double>(e) * static_cast<double>(e);
+    }
+
+    for (unsigned int c = 0; c < channels; ++c) {
+        prev[c] = data[total - channels + c];
+    }
+}
+
+// Folds per-position accumulators back into channels; acc[j] belongs to channel j % channels.
+void foldPeriod(const double* acc, unsigned int period, unsigned int channels, double* sums) {
+    for (unsigned int j = 0; j < period; ++j) {
+        sums[j % channels] += acc[j];
+    }
+}
+
+#if defined(ANALOGVU_DSP_X86) && defined(__SSE2__)
+void emphasisSumSse2(const float* data,
+                     unsigned int frames,
+                     unsigned int stride,
+                     unsigned int channels,
+                     float* prev,
+                     double* sums) {
+    const unsigned int period = (stride == channels) ? lanePeriod(channels, 4) : 0;
+    if (period == 0 || period > kMaxLanePeriod || frames < 2 || (frames - 1) * channels < 8) {
+        emphasisSumScalar(data, frames, stride, channels, prev, sums);
+        return;
+    }
+
+    emphasisSumScalar(data, 1, channels, channels, prev, sums);
+
+    const __m128 k4 = _mm_set1_ps(kPreEmphasis);
+    const std::size_t total = static_cast<std::size_t>(frames) * channels;
+    std::size_t k = channels;
+
+    alignas(16) double acc[kMaxLanePeriod];
+    if (period == 4) {
+        __m128d acc0 = _mm_setzero_pd();
+        __m128d acc1 = _mm_setzero_pd();
+
+        for (; k + 4 <= total; k += 4) {
+            const __m128 cur = _mm_loadu_ps(data + k);
+            const __m128 prv = _mm_loadu_ps(data + k - channels);
+            const __m128 e = _mm_add_ps(cur, _mm_mul_ps(k4, _mm_sub_ps(cur, prv)));
+
+            const __m128d lo = _mm_cvtps_pd(e);
+            const __m128d hi = _mm_cvtps_pd(_mm_movehl_ps(e, e));
+            acc0 = _mm_add_pd(acc0, _mm_mul_pd(lo, lo));
+            acc1 = _mm_add_pd(acc1, _mm_mul_pd(hi, hi));
+        }
+
+        _mm_store_pd(acc + 0, acc0);
+        _mm_store_pd(acc + 2, acc1);
+    } else {
+        std::fill(acc, acc + period, 0.0);
+
+        for (unsigned int pos = 0; k + 4 <= total; k += 4) {
+            const __m128 cur = _mm_loadu_ps(data + k);
+            const __m128 prv = _mm_loadu_ps(data + k - channels);
+            const __m128 e = _mm_add_ps(cur, _mm_mul_ps(k4, _mm_sub_ps(cur, prv)));
+
+            const __m128d lo = _mm_cvtps_pd(e);
+            const __m128d hi = _mm_cvtps_pd(_mm_movehl_ps(e, e));
+            _mm_store_pd(acc + pos, _mm_add_pd(_mm_load_pd(acc + pos), _mm_mul_pd(lo, lo)));
+            _mm_store_pd(acc + pos + 2, _mm_add_pd(_mm_load_pd(acc + pos + 2), _mm_mul_pd(hi, hi)));
+
+            pos += 4;
+            if (pos == period) {
+                pos = 0;
+            }
+        }
+    }
+
+    foldPeriod(acc, period, channels, sums);
+    finishFlat(data, k, total, channels, prev, sums);
+}
+
+__attribute__((target("avx2"))) void emphasisSumAvx2(const float* data,
+                                                     unsigned int frames,
+                                                     unsigned int stride,
+                                                     unsigned int channels,
+                                                     float* prev,
+                                                     double* sums) {
+    const unsigned int period = (stride == channels) ? lanePeriod(channels, 8) : 0;
+    if (period == 0 || period > kMaxLanePeriod || frames < 2 || (frames - 1) * channels < 16) {
+        emphasisSumScalar(data, frames, stride, channels, prev, sums);
+        return;
+    }
+
+    emphasisSumScalar(data, 1, channels, channels, prev, sums);
+
+    const __m256 k8 = _mm256_set1_ps(kPreEmphasis);
+    const std::size_t total = static_cast<std::size_t>(frames) * channels;
+    std::size_t k = channels;
+
+    alignas(32) double acc[kMaxLanePeriod];
+    if (period == 8) {
+        __m256d acc0 = _mm256_setzero_pd();
+        __m256d acc1 = _mm256_setzero_pd();
+
+        for (; k + 8 <= total; k += 8) {
+            const __m256 cur = _mm256_loadu_ps(data + k);
+            const __m256 prv = _mm256_loadu_ps(data + k - channels);
+            const __m256 e = _mm256_add_ps(cur, _mm256_mul_ps(k8, _mm256_sub_ps(cur, prv)));
+
+            const __m256d lo = _mm256_cvtps_pd(_mm256_castps256_ps128(e));
+            const __m256d hi = _mm256_cvtps_pd(_mm256_extractf128_ps(e, 1));
+            acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(lo, lo));
+            acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(hi, hi));
+        }
+
+        _mm256_store_pd(acc + 0, acc0);
+        _mm256_store_pd(acc + 4, acc1);
+    } else {
+        std::fill(acc, acc + period, 0.0);
+
+        for (unsigned int pos = 0; k + 8 <= total; k += 8) {
+            const __m256 cur = _mm256_loadu_ps(data + k);
+            const __m256 prv = _mm256_loadu_ps(data + k - channels);
+            const __m256 e = _mm256_add_ps(cur, _mm256_mul_ps(k8, _mm256_sub_ps(cur, prv)));
+
+            const __m256d lo = _mm256_cvtps_pd(_mm256_castps256_ps128(e));
+            const __m256d hi = _mm256_cvtps_pd(_mm256_extractf128_ps(e, 1));
+            _mm256_store_pd(acc + pos, _mm256_add_pd(_mm256_load_pd(acc + pos), _mm256_mul_pd(lo, lo)));
+            _mm256_store_pd(acc + pos + 4, _mm256_add_pd(_mm256_load_pd(acc + pos + 4), _mm256_mul_pd(hi, hi)));
+
+            pos += 8;
+            if (pos == period) {
+                pos = 0;
+            }
+        }
+    }
+
+    // The helpers below are legacy SSE code; leaving the upper YMM halves
+    // dirty would make every SSE instruction after the kernel pay the
+    // AVX-SSE transition penalty
+    _mm256_zeroupper();
+
+    foldPeriod(acc, period, channels, sums);
+    finishFlat(data, k, total, channels, prev, sums);
+}
+#endif
+
+#if defined(ANALOGVU_DSP_NEON)
+void emphasisSumNeon(const float* data,
+                     unsigned int frames,
+                     unsigned int stride,
+                     unsigned int channels,
+                     float* prev,
+                     double* sums) {
+    const unsigned int period = (stride == channels) ? lanePeriod(channels, 4) : 0;
+    if (period == 0 || period > kMaxLanePeriod || frames < 2 || (frames - 1) * channels < 8) {
+        emphasisSumScalar(data, frames, stride, channels, prev, sums);
+        return;
+    }
+
+    emphasisSumScalar(data, 1, channels, channels, prev, sums);
+
+    const float32x4_t k4 = vdupq_n_f32(kPreEmphasis);
+    const std::size_t total = static_cast<std::size_t>(frames) * channels;
+    std::size_t k = channels;
+
+    alignas(16) double acc[kMaxLanePeriod];
+    if (period == 4) {
+        float64x2_t acc0 = vdupq_n_f64(0.0);
+        float64x2_t acc1 = vdupq_n_f64(0.0);
+
+        for (; k + 4 <= total; k += 4) {
+            const float32x4_t cur = vld1q_f32(data + k);
+            const float32x4_t prv = vld1q_f32(data + k - channels);
+            // Separate multiply and add (no vfma) to match the scalar rounding
+            const float32x4_t e = vaddq_f32(cur, vmulq_f32(k4, vsubq_f32(cur, prv)));
+
+            const float64x2_t lo = vcvt_f64_f32(vget_low_f32(e));
+            const float64x2_t hi = vcvt_high_f64_f32(e);
+            // Products of two floats are exact in double, so fused accumulation rounds identically
+            acc0 = vfmaq_f64(acc0, lo, lo);
+            acc1 = vfmaq_f64(acc1, hi, hi);
+        }
+
+        vst1q_f64(acc + 0, acc0);
+        vst1q_f64(acc + 2, acc1);
+    } else {
+        std::fill(acc, acc + period, 0.0);
+
+        for (unsigned int pos = 0; k + 4 <= total; k += 4) {
+            const float32x4_t cur = vld1q_f32(data + k);
+            const float32x4_t prv = vld1q_f32(data + k - channels);
+            const float32x4_t e = vaddq_f32(cur, vmulq_f32(k4, vsubq_f32(cur, prv)));
+
+            const float64x2_t lo = vcvt_f64_f32(vget_low_f32(e));
+            const float64x2_t hi = vcvt_high_f64_f32(e);
+            vst1q_f64(acc + pos, vfmaq_f64(vld1q_f64(acc + pos), lo, lo));
+            vst1q_f64(acc + pos + 2, vfmaq_f64(vld1q_f64(acc + pos + 2), hi, hi));
+
+            pos += 4;
+            if (pos == period) {
+                pos = 0;
+            }
+        }
+    }
+
+    foldPeriod(acc, period, channels, sums);
+    finishFlat(data, k, total, channels, prev, sums);
+}
+#endif
+
+bool isaSupported(VuDspIsa isa) {
+    switch (isa) {
+    case VuDspIsa::Scalar:
+        return true;
+#if defined(ANALOGVU_DSP_X86) && defined(__SSE2__)
+    case VuDspIsa::Sse2:
+        return true;
+    case VuDspIsa::Avx2:
+        return __builtin_cpu_supports("avx2");
+#endif
+#if defined(ANALOGVU_DSP_NEON)
+    case VuDspIsa::Neon:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+std::atomic<VuDspIsa>& activeIsa() {
+    static std::atomic<VuDspIsa> isa{vuBestDspIsa()};
+    return isa;
+}
+
+} // namespace
+
+VuEmphasisSumKernel vuEmphasisSumKernel(VuDspIsa isa) {
+    if (!isaSupported(isa)) {
+        return nullptr;
+    }
+
+    switch (isa) {
+#if defined(ANALOGVU_DSP_X86) && defined(__SSE2__)
+    case VuDspIsa::Sse2:
+        return &emphasisSumSse2;
+    case VuDspIsa::Avx2:
+        return &emphasisSumAvx2;
+#endif
+#if defined(ANALOGVU_DSP_NEON)
+    case VuDspIsa::Neon:
+        return &emphasisSumNeon;
+#endif
+    default:
+        return &emphasisSumScalar;
+    }
+}
+
+VuDspIsa vuBestDspIsa() {
+    for (VuDspIsa isa : {VuDspIsa::Neon, VuDspIsa::Sse2}) {
+        if (isaSupported(isa)) {
+            return isa;
+        }
+    }
+    return VuDspIsa::Scalar;
+}
+
+VuDspIsa vuActiveDspIsa() { return activeIsa().load(std::memory_order_relaxed); }
+
+void setVuActiveDspIsa(VuDspIsa isa) {
+    activeIsa().store(isaSupported(isa) ? isa : VuDspIsa::Scalar, std::memory_order_relaxed);
+}
+
+VuEmphasisSumKernel vuActiveEmphasisSumKernel() { return vuEmphasisSumKernel(vuActiveDspIsa()); }
+
+const char* vuDspIsaName(VuDspIsa isa) {
+    switch (isa) {
+    case VuDspIsa::Sse2:
+        return "sse2";
+    case VuDspIsa::Avx2:
+        return "avx2";
+    case VuDspIsa::Neon:
+        return "neon";
+    case VuDspIsa::Scalar:
+    default:
+        return "scalar";
+    }
+}
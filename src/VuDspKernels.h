@@ -0,0 +1,51 @@
+#pragma once
+
+// Inner metering kernel: pre-emphasis + sum of squares for every channel of
+// an interleaved buffer in a single pass.
+//
+// For each frame n and channel c < channels (frames are `stride` floats apart):
+//   e[n] = x[n] + 0.15 * (x[n] - x[n-1])
+//   sums[c] += double(e[n]) * double(e[n])
+// prev[c] supplies x[-1] on entry and receives the last raw sample on return.
+// prev and sums hold `channels` entries. The SIMD variants vectorize any
+// channel count when stride == channels; a stride wider than the metered
+// channels uses the scalar path.
+//
+// Accuracy of the SIMD variants against the scalar reference:
+// the pre-emphasis is evaluated with the same float operations and the double
+// products of two floats are exact, so the only difference is the order of the
+// double additions (wide accumulators). The sums agree to a relative error
+// below frames * 2^-53; after the float conversion in the caller the mean
+// square agrees to within 1 ulp and is bit-identical in practice. NEON builds
+// whose scalar path is contracted to FMA by the compiler can differ by 1 float
+// ulp in individual emphasis values.
+using VuEmphasisSumKernel = void (*)(const float* data,
+                                     unsigned int frames,
+                                     unsigned int stride,
+                                     unsigned int channels,
+                                     float* prev,
+                                     double* sums);
+
+enum class VuDspIsa {
+    Scalar,
+    Sse2,
+    Avx2,
+    Neon,
+};
+
+// Kernel for an instruction set, or nullptr if not built in or not supported by this CPU.
+VuEmphasisSumKernel vuEmphasisSumKernel(VuDspIsa isa);
+
+// Best instruction set supported at runtime. AVX2 is only a win on the
+// per-callback path (block-accurate integration measures no faster than
+// SSE2), so it is selected explicitly rather than by default.
+VuDspIsa vuBestDspIsa();
+
+// Instruction set used by the metering pipeline. Defaults to vuBestDspIsa().
+// Forcing an unsupported ISA falls back to Scalar. Intended for benchmarks and
+// reference comparisons; not meant to be switched while audio is running.
+VuDspIsa vuActiveDspIsa();
+void setVuActiveDspIsa(VuDspIsa isa);
+VuEmphasisSumKernel vuActiveEmphasisSumKernel();
+
+const char* vuDspIsaName(VuDspIsa isa);
@@ -0,0 +1,165 @@
+#include "VuDspWorker.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "VuMetrics.h"
+
+// Ring capacity in milliseconds of audio. Large enough to ride out scheduling
+// hiccups of the DSP thread at 192 kHz without holding excessive memory.
+static constexpr float kRingBufferMs = 250.0f;
+
+// Upper bound for one process() call. Matches the 50 ms dt clamp in the DSP so a
+// backlog is worked off in chunks the ballistics were designed for.
+static constexpr float kMaxChunkMs = 50.0f;
+
+VuDspWorker::~VuDspWorker() { stop(); }
+
+void VuDspWorker::setInputCount(unsigned int inputs) {
+    if (running_.load(std::memory_order_acquire)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(formatMutex_);
+    inputs_.resize(std::max(1u, inputs));
+    for (std::unique_ptr<Input>& in : inputs_) {
+        if (!in) {
+            in = std::make_unique<Input>();
+        }
+    }
+}
+
+void VuDspWorker::start(unsigned int input, unsigned int channels, float sampleRate, ProcessFn process) {
+    if (input >= inputs_.size()) {
+        return;
+    }
+    stopThread();
+
+    Input& in = *inputs_[input];
+    if (channels == 0 || sampleRate <= 0.0f || !process) {
+        std::lock_guard<std::mutex> lock(formatMutex_);
+        in.channels.store(0, std::memory_order_relaxed);
+    } else {
+        const auto framesFor = [sampleRate](float ms) {
+            return static_cast<std::size_t>(std::ceil(sampleRate * ms / 1000.0f));
+        };
+
+        in.process = std::move(process);
+        {
+            std::lock_guard<std::mutex> lock(formatMutex_);
+            in.channels.store(channels, std::memory_order_relaxed);
+            in.sampleRate.store(sampleRate, std::memory_order_relaxed);
+            in.ring.reset(framesFor(kRingBufferMs) * channels);
+        }
+        in.scratchSamples = std::max<std::size_t>(1, framesFor(kMaxChunkMs)) * channels;
+        in.scratch.reset(new float[in.scratchSamples]);
+    }
+
+    // The other inputs are served again as well
+    const bool any = std::any_of(inputs_.begin(), inputs_.end(), [](const std::unique_ptr<Input>& i) {
+        return i->channels.load(std::memory_order_relaxed) > 0;
+    });
+    if (any) {
+        running_.store(true, std::memory_order_release);
+        thread_ = std::thread([this]() { run(); });
+    }
+}
+
+void VuDspWorker::stop() {
+    stopThread();
+
+    std::lock_guard<std::mutex> lock(formatMutex_);
+    for (const std::unique_ptr<Input>& in : inputs_) {
+        in->channels.store(0, std::memory_order_relaxed);
+        in->sampleRate.store(0.0f, std::memory_order_relaxed);
+    }
+}
+
+void VuDspWorker::stopThread() {
+    if (!running_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    wakeSeq_.fetch_add(1, std::memory_order_release);
+    wakeSeq_.notify_one();
+
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+bool VuDspWorker::push(unsigned int input, const float* data, unsigned int frames) {
+    if (!running_.load(std::memory_order_acquire) || input >= inputs_.size()) {
+        return false;
+    }
+
+    Input& in = *inputs_[input];
+    const unsigned int channels = in.channels.load(std::memory_order_relaxed);
+    if (channels == 0) {
+        return false;
+    }
+    const bool ok = in.ring.write(data, static_cast<std::size_t>(frames) * channels);
+    if (!ok) {
+        vuMetrics().add(VuCounter::RingOverruns);
+        vuMetrics().add(VuCounter::RingDroppedFrames, frames);
+    }
+
+    wakeSeq_.fetch_add(1, std::memory_order_release);
+    wakeSeq_.notify_one();
+    return ok;
+}
+
+VuDspWorker::Stats VuDspWorker::stats(unsigned int input) const {
+    std::lock_guard<std::mutex> lock(formatMutex_);
+
+    Stats s;
+    if (input >= inputs_.size()) {
+        return s;
+    }
+    const Input& in = *inputs_[input];
+    s.channels = in.channels.load(std::memory_order_relaxed);
+    s.sampleRate = in.sampleRate.load(std::memory_order_relaxed);
+    if (s.channels == 0) {
+        return s;
+    }
+    s.capacityFrames = in.ring.capacity() / s.channels;
+    s.fillFrames = in.ring.fillLevel() / s.channels;
+    s.highWaterFrames = in.ring.highWaterMark() / s.channels;
+    s.overruns = in.ring.overrunCount();
+    s.droppedFrames = in.ring.droppedSamples() / s.channels;
+    return s;
+}
+
+void VuDspWorker::run() {
+    while (running_.load(std::memory_order_acquire)) {
+        // Read the sequence before draining: a push that lands after the rings
+        // looked empty bumps it, so wait() below returns immediately.
+        const std::uint32_t seq = wakeSeq_.load(std::memory_order_acquire);
+
+        // Formats only change while this thread is stopped
+        bool drained = true;
+        for (const std::unique_ptr<Input>& in : inputs_) {
+            const unsigned int channels = in->channels.load(std::memory_order_relaxed);
+            if (channels == 0) {
+                continue;
+            }
+
+            // Writes are whole frames and scratchSamples is a multiple of the
+            // channel count, so every read returns whole frames as well.
+            const std::size_t samples = in->ring.read(in->scratch.get(), in->scratchSamples);
+            if (samples == 0) {
+                continue;
+            }
+            drained = false;
+
+            VuScopedTimer timer(VuStage::Dsp);
+            in->process(in->scratch.get(),
+                        static_cast<unsigned int>(samples / channels),
+                        channels,
+                        in->sampleRate.load(std::memory_order_relaxed));
+            vuMetrics().add(VuCounter::DspBlocks);
+        }
+        if (drained) {
+            wakeSeq_.wait(seq, std::memory_order_acquire);
+        }
+    }
+}
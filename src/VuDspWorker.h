@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "VuSampleRing.h"
+
+// Dedicated DSP thread fed by the capture callbacks through VuSampleRings.
+//
+// The capture callback only copies raw interleaved frames into the ring (push),
+// so it returns to PulseAudio / CoreAudio quickly. The worker drains the ring and
+// runs the metering pipeline through the supplied process function.
+//
+// Each input (one per metered source) has its own ring, format and process
+// function, all served by the one thread: it takes at most one chunk from
+// each input in turn, so a busy source cannot starve the others. Input 0 is
+// the one the single-input overloads address.
+class VuDspWorker final {
+  public:
+    using ProcessFn =
+        std::function<void(const float* data, unsigned int frames, unsigned int channels, float sampleRate)>;
+
+    struct Stats {
+        unsigned int channels = 0;
+        float sampleRate = 0.0f;
+        std::size_t capacityFrames = 0;
+        std::size_t fillFrames = 0;
+        std::size_t highWaterFrames = 0;
+        std::uint64_t overruns = 0;      // number of rejected pushes
+        std::uint64_t droppedFrames = 0; // frames lost to overruns
+    };
+
+    VuDspWorker() { setInputCount(1); }
+    ~VuDspWorker();
+
+    VuDspWorker(const VuDspWorker&) = delete;
+    VuDspWorker& operator=(const VuDspWorker&) = delete;
+
+    // Number of inputs; only while stopped, before the first start()
+    void setInputCount(unsigned int inputs);
+    unsigned int inputCount() const { return static_cast<unsigned int>(inputs_.size()); }
+
+    // Sizes the input's ring for the given format and (re)starts the worker
+    // thread; the other inputs keep their rings and format. Must not run
+    // concurrently with push() to the same input, and a push() to another
+    // input while the thread restarts is rejected. May run on the capture
+    // thread (a device hot swap) while another thread polls stats().
+    void start(unsigned int channels, float sampleRate, ProcessFn process) {
+        start(0, channels, sampleRate, std::move(process));
+    }
+    void start(unsigned int input, unsigned int channels, float sampleRate, ProcessFn process);
+
+    // Stops the thread and unconfigures every input
+    void stop();
+    bool isRunning() const { return running_.load(std::memory_order_acquire); }
+
+    // Producer side (capture callback). Never blocks; returns false on overrun
+    // or for an input that is not started.
+    bool push(const float* data, unsigned int frames) { return push(0, data, frames); }
+    bool push(unsigned int input, const float* data, unsigned int frames);
+
+    // Any thread; a snapshot consistent with one start()
+    Stats stats() const { return stats(0); }
+    Stats stats(unsigned int input) const;
+
+  private:
+    struct Input {
+        VuSampleRing ring;
+        std::unique_ptr<float[]> scratch;
+        std::size_t scratchSamples = 0;
+
+        // Written by start() and read by stats() from other threads; 0
+        // channels = not started
+        std::atomic<unsigned int> channels{0};
+        std::atomic<float> sampleRate{0.0f};
+        ProcessFn process;
+    };
+
+    void run();
+    void stopThread();
+
+    std::vector<std::unique_ptr<Input>> inputs_;
+
+    // Held by start() while it changes a format and reallocates a ring, and
+    // by stats() while it reads them; push() and the worker never take it
+    mutable std::mutex formatMutex_;
+
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<std::uint32_t> wakeSeq_{0};
+};
@@ -0,0 +1,146 @@
+#include "VuFft.h"
+
+#include <cmath>
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define ANALOGVU_FFT_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define ANALOGVU_FFT_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+// c' = a - w c, a' = a + w c for n contiguous butterflies
+void butterfliesScalar(float* ar, float* ai, float* cr, float* ci, const float* wr, const float* wi, unsigned int n) {
+    for (unsigned int j = 0; j < n; ++j) {
+        const float tr = wr[j] * cr[j] - wi[j] * ci[j];
+        const float ti = wr[j] * ci[j] + wi[j] * cr[j];
+        cr[j] = ar[j] - tr;
+        ci[j] = ai[j] - ti;
+        ar[j] += tr;
+        ai[j] += ti;
+    }
+}
+
+void butterflies(float* ar, float* ai, float* cr, float* ci, const float* wr, const float* wi, unsigned int n) {
+#if defined(ANALOGVU_FFT_X86) && defined(__SSE2__)
+    if (n >= 4) {
+        for (unsigned int j = 0; j < n; j += 4) {
+            const __m128 wR = _mm_loadu_ps(wr + j);
+            const __m128 wI = _mm_loadu_ps(wi + j);
+            const __m128 cR = _mm_loadu_ps(cr + j);
+            const __m128 cI = _mm_loadu_ps(ci + j);
+            const __m128 aR = _mm_loadu_ps(ar + j);
+            const __m128 aI = _mm_loadu_ps(ai + j);
+            const __m128 tR = _mm_sub_ps(_mm_mul_ps(wR, cR), _mm_mul_ps(wI, cI));
+            const __m128 tI = _mm_add_ps(_mm_mul_ps(wR, cI), _mm_mul_ps(wI, cR));
+            _mm_storeu_ps(cr + j, _mm_sub_ps(aR, tR));
+            _mm_storeu_ps(ci + j, _mm_sub_ps(aI, tI));
+            _mm_storeu_ps(ar + j, _mm_add_ps(aR, tR));
+            _mm_storeu_ps(ai + j, _mm_add_ps(aI, tI));
+        }
+        return;
+    }
+#elif defined(ANALOGVU_FFT_NEON)
+    if (n >= 4) {
+        for (unsigned int j = 0; j < n; j += 4) {
+            const float32x4_t wR = vld1q_f32(wr + j);
+            const float32x4_t wI = vld1q_f32(wi + j);
+            const float32x4_t cR = vld1q_f32(cr + j);
+            const float32x4_t cI = vld1q_f32(ci + j);
+            const float32x4_t aR = vld1q_f32(ar + j);
+            const float32x4_t aI = vld1q_f32(ai + j);
+            const float32x4_t tR = vsubq_f32(vmulq_f32(wR, cR), vmulq_f32(wI, cI));
+            const float32x4_t tI = vaddq_f32(vmulq_f32(wR, cI), vmulq_f32(wI, cR));
+            vst1q_f32(cr + j, vsubq_f32(aR, tR));
+            vst1q_f32(ci + j, vsubq_f32(aI, tI));
+            vst1q_f32(ar + j, vaddq_f32(aR, tR));
+            vst1q_f32(ai + j, vaddq_f32(aI, tI));
+        }
+        return;
+    }
+#endif
+    butterfliesScalar(ar, ai, cr, ci, wr, wi, n);
+}
+
+} // namespace
+
+VuRealFft::VuRealFft(unsigned int size) : size_(size), half_(size / 2) {
+    unsigned int bits = 0;
+    while ((1u << bits) < half_) {
+        ++bits;
+    }
+
+    bitReverse_.resize(half_);
+    for (unsigned int n = 0; n < half_; ++n) {
+        unsigned int r = 0;
+        for (unsigned int b = 0; b < bits; ++b) {
+            r |= ((n >> b) & 1u) << (bits - 1 - b);
+        }
+        bitReverse_[n] = r;
+    }
+
+    twiddleRe_.resize(half_);
+    twiddleIm_.resize(half_);
+    for (unsigned int h = 1; h < half_; h *= 2) {
+        for (unsigned int j = 0; j < h; ++j) {
+            const double angle = -kPi * static_cast<double>(j) / static_cast<double>(h);
+            twiddleRe_[h - 1 + j] = static_cast<float>(std::cos(angle));
+            twiddleIm_[h - 1 + j] = static_cast<float>(std::sin(angle));
+        }
+    }
+
+    splitRe_.resize(half_);
+    splitIm_.resize(half_);
+    for (unsigned int k = 0; k < half_; ++k) {
+        const double angle = -2.0 * kPi * static_cast<double>(k) / static_cast<double>(size_);
+        splitRe_[k] = static_cast<float>(std::cos(angle));
+        splitIm_[k] = static_cast<float>(std::sin(angle));
+    }
+
+    re_.resize(half_);
+    im_.resize(half_);
+}
+
+void VuRealFft::transform(const float* in, float* outRe, float* outIm) {
+    // Even samples as the real part, odd as the imaginary part, in
+    // bit-reversed order
+    for (unsigned int n = 0; n < half_; ++n) {
+        re_[bitReverse_[n]] = in[2 * n];
+        im_[bitReverse_[n]] = in[2 * n + 1];
+    }
+
+    for (unsigned int h = 1; h < half_; h *= 2) {
+        const float* wr = twiddleRe_.data() + (h - 1);
+        const float* wi = twiddleIm_.data() + (h - 1);
+        for (unsigned int b = 0; b < half_; b += 2 * h) {
+            butterflies(re_.data() + b, im_.data() + b, re_.data() + b + h, im_.data() + b + h, wr, wi, h);
+        }
+    }
+
+    // Split the packed spectrum Z into the real input's X:
+    //   X[k] = (Z[k] + Z*[M-k]) / 2 - i W^k (Z[k] - Z*[M-k]) / 2, W = e^(-2 pi i / N)
+    for (unsigned int k = 0; k <= half_; ++k) {
+        const unsigned int a = k % half_;
+        const unsigned int b = (half_ - k) % half_;
+        const float zr = re_[a];
+        const float zi = im_[a];
+        const float mr = re_[b];
+        const float mi = -im_[b];
+
+        const float evenR = 0.5f * (zr + mr);
+        const float evenI = 0.5f * (zi + mi);
+        const float oddR = 0.5f * (zi - mi);
+        const float oddI = -0.5f * (zr - mr);
+
+        const float wr = k < half_ ? splitRe_[k] : -1.0f;
+        const float wi = k < half_ ? splitIm_[k] : 0.0f;
+        outRe[k] = evenR + wr * oddR - wi * oddI;
+        outIm[k] = evenI + wr * oddI + wi * oddR;
+    }
+}
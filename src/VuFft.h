@@ -0,0 +1,41 @@
+#pragma once
+
+#include <vector>
+
+// Preplanned FFT of a real signal, size a power of two.
+//
+// The plan (bit-reversal order, per-stage twiddles and the real-input split
+// factors) is built in the constructor, so transform() never allocates. The
+// real input is packed into a complex FFT of half the size on split
+// real/imaginary arrays; each radix-2 stage walks contiguous butterflies,
+// four at a time with SSE2 or NEON where the build has them.
+class VuRealFft final {
+  public:
+    // size: power of two, at least 16
+    explicit VuRealFft(unsigned int size);
+
+    unsigned int size() const { return size_; }
+    unsigned int bins() const { return size_ / 2 + 1; }
+
+    // in: size() samples. outRe/outIm: bins() values, DC to Nyquist,
+    // unnormalized (a full-scale sine on a bin gives size() / 2).
+    void transform(const float* in, float* outRe, float* outIm);
+
+  private:
+    unsigned int size_ = 0;
+    unsigned int half_ = 0; // complex FFT size
+
+    std::vector<unsigned int> bitReverse_;
+
+    // Twiddles of the stage with h butterflies per group at [h - 1, 2h - 1)
+    std::vector<float> twiddleRe_;
+    std::vector<float> twiddleIm_;
+
+    // e^(-2 pi i k / size) for the real-input split, k < half_
+    std::vector<float> splitRe_;
+    std::vector<float> splitIm_;
+
+    // Work arrays
+    std::vector<float> re_;
+    std::vector<float> im_;
+};
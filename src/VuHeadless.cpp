@@ -0,0 +1,128 @@
+#include "VuHeadless.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QTextStream>
+#include <QTimer>
+
+#include <chrono>
+#include <csignal>
+
+#include "VuMetrics.h"
+
+namespace {
+
+volatile std::sig_atomic_t quitRequested = 0;
+
+void requestQuit(int) {
+    quitRequested = 1;
+}
+
+constexpr int kQuitPollMs = 100;
+
+// Logging interval when there is neither an exporter nor --log-levels
+constexpr double kDefaultLogIntervalMs = 1000.0;
+
+// "<seconds> <source> vu <dB per channel> peak <dB per channel> M <LUFS> S <LUFS> I <LUFS>"
+void logLevels(QTextStream& out, double seconds, int source, const VuLevelFrame& frame) {
+    out << QString::number(seconds, 'f', 3) << ' ' << source << " vu";
+    for (unsigned int c = 0; c < frame.channels; ++c) {
+        out << ' ' << QString::number(frame.vuDb[c], 'f', 1);
+    }
+    out << " peak";
+    for (unsigned int c = 0; c < frame.channels; ++c) {
+        out << ' ' << QString::number(frame.peakHoldDb[c], 'f', 1);
+    }
+    out << " M " << QString::number(frame.momentaryLufs, 'f', 1) << " S "
+        << QString::number(frame.shortTermLufs, 'f', 1) << " I " << QString::number(frame.integratedLufs, 'f', 1)
+        << Qt::endl;
+}
+
+} // namespace
+
+std::unique_ptr<VuLevelExporter> vuStartLevelExporter(const AudioCapture& audio,
+                                                      const VuLevelExporter::Options& options,
+                                                      QString* errorOut) {
+    auto exporter = std::make_unique<VuLevelExporter>(options);
+    for (int i = 0; i < audio.sourceCount(); ++i) {
+        exporter->addSource([&audio, i]() { return audio.sourceLevels(i); });
+    }
+    if (!exporter->start(errorOut)) {
+        return nullptr;
+    }
+    return exporter;
+}
+
+bool vuWriteMetricsJson(const QString& path, QString* errorOut) {
+    const QByteArray json = QByteArray::fromStdString(vuMetricsJson(vuMetrics().snapshot()));
+    QFile file(path);
+    const bool opened =
+        (path == QLatin1String("-")) ? file.open(stdout, QIODevice::WriteOnly) : file.open(QIODevice::WriteOnly);
+    if (!opened || file.write(json) != json.size()) {
+        if (errorOut) *errorOut = QStringLiteral("Failed to write metrics to %1").arg(path);
+        return false;
+    }
+    return true;
+}
+
+int vuRunHeadless(QCoreApplication& app, AudioCapture::Options options, const VuOutputOptions& output) {
+    QTextStream err(stderr);
+    options.persistReferenceLevels = false;
+
+    AudioCapture audio(options);
+    QObject::connect(&audio, &AudioCapture::errorOccurred, &app, [](const QString& message) {
+        QTextStream(stderr) << message << Qt::endl;
+    });
+
+    QString error;
+    if (!audio.start(&error)) {
+        err << "Audio initialization failed: " << error << Qt::endl;
+        return 1;
+    }
+
+    std::unique_ptr<VuLevelExporter> exporter;
+    if (output.exporting()) {
+        exporter = vuStartLevelExporter(audio, output.exporter, &error);
+        if (!exporter) {
+            err << "Level export failed: " << error << Qt::endl;
+            audio.stop();
+            return 1;
+        }
+    }
+
+    QTextStream out(stdout);
+    const auto start = std::chrono::steady_clock::now();
+    QTimer logTimer;
+    const double logIntervalMs =
+        (output.logIntervalMs > 0.0 || output.exporting()) ? output.logIntervalMs : kDefaultLogIntervalMs;
+    if (logIntervalMs > 0.0) {
+        QObject::connect(&logTimer, &QTimer::timeout, &app, [&]() {
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            for (int i = 0; i < audio.sourceCount(); ++i) {
+                logLevels(out, seconds, i, audio.sourceLevels(i));
+            }
+        });
+        logTimer.start(static_cast<int>(logIntervalMs));
+    }
+
+    // The handler only sets a flag; the event loop polls it
+    std::signal(SIGINT, requestQuit);
+    std::signal(SIGTERM, requestQuit);
+    QTimer quitPoll;
+    QObject::connect(&quitPoll, &QTimer::timeout, &app, [&app]() {
+        if (quitRequested) {
+            app.quit();
+        }
+    });
+    quitPoll.start(kQuitPollMs);
+
+    const int status = app.exec();
+
+    exporter.reset();
+    audio.stop();
+    if (!output.metricsJsonPath.isEmpty() && !vuWriteMetricsJson(output.metricsJsonPath, &error)) {
+        err << error << Qt::endl;
+        return status == 0 ? 1 : status;
+    }
+    return status;
+}
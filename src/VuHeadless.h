@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QString>
+
+#include <memory>
+
+#include "AudioCapture.h"
+#include "VuLevelExporter.h"
+
+class QCoreApplication;
+
+// Where levels go besides the meter window
+struct VuOutputOptions {
+    // Started when it has targets or a listen port
+    VuLevelExporter::Options exporter;
+
+    // Headless only: one stdout line per source every interval; 0 = off
+    double logIntervalMs = 0.0;
+
+    // vuMetrics() as JSON, written on exit ("-" = stdout); empty = off
+    QString metricsJsonPath;
+
+    bool exporting() const { return !exporter.targets.isEmpty() || exporter.listenPort != 0; }
+};
+
+// Exports every source of audio, as source 0, 1, ... in AudioCapture's order.
+// audio must outlive the exporter. Returns nullptr and sets errorOut on failure.
+std::unique_ptr<VuLevelExporter> vuStartLevelExporter(const AudioCapture& audio,
+                                                      const VuLevelExporter::Options& options,
+                                                      QString* errorOut = nullptr);
+
+bool vuWriteMetricsJson(const QString& path, QString* errorOut = nullptr);
+
+// Capture without any UI: levels are only exported and/or logged (every
+// second when nothing else is asked for), until SIGINT or SIGTERM. Needs
+// nothing beyond a QCoreApplication (no display connection, no fonts or
+// widgets) and leaves the GUI's QSettings alone, so references come from the
+// options. Returns the process exit status.
+int vuRunHeadless(QCoreApplication& app, AudioCapture::Options options, const VuOutputOptions& output);
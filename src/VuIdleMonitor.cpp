@@ -0,0 +1,135 @@
+#include "VuIdleMonitor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+float vuInterleavedPeak(const float* data, unsigned int frames, unsigned int channels) {
+    const std::size_t samples = static_cast<std::size_t>(frames) * channels;
+
+    // Four independent maxima so the loop vectorizes without -ffast-math
+    float m0 = 0.0f;
+    float m1 = 0.0f;
+    float m2 = 0.0f;
+    float m3 = 0.0f;
+    std::size_t i = 0;
+    for (; i + 4 <= samples; i += 4) {
+        m0 = std::max(m0, std::abs(data[i]));
+        m1 = std::max(m1, std::abs(data[i + 1]));
+        m2 = std::max(m2, std::abs(data[i + 2]));
+        m3 = std::max(m3, std::abs(data[i + 3]));
+    }
+    for (; i < samples; ++i) {
+        m0 = std::max(m0, std::abs(data[i]));
+    }
+    return std::max(std::max(m0, m1), std::max(m2, m3));
+}
+
+const char* vuIdleStateName(VuIdleState state) {
+    switch (state) {
+    case VuIdleState::Settling:
+        return "settling";
+    case VuIdleState::Idle:
+        return "idle";
+    case VuIdleState::Active:
+        break;
+    }
+    return "active";
+}
+
+bool VuIdleMonitor::admit(const float* data,
+                          unsigned int frames,
+                          unsigned int channels,
+                          float sampleRate,
+                          Transition* transition) {
+    if (transition) *transition = Transition::None;
+
+    if (state_.load(std::memory_order_acquire) != VuIdleState::Idle) {
+        return true;
+    }
+
+    if (vuInterleavedPeak(data, frames, channels) <= options_.wakePeak) {
+        if (sampleRate > 0.0f) {
+            addSeconds(seconds_[static_cast<int>(VuIdleState::Idle)], static_cast<double>(frames) / sampleRate);
+        }
+        droppedFrames_.fetch_add(frames, std::memory_order_relaxed);
+        return false;
+    }
+
+    // The metering side may be waking us at the same time; count it once
+    VuIdleState expected = VuIdleState::Idle;
+    if (state_.compare_exchange_strong(expected, VuIdleState::Active, std::memory_order_acq_rel)) {
+        wakeups_.fetch_add(1, std::memory_order_relaxed);
+        if (transition) *transition = Transition::Woke;
+    }
+    return true;
+}
+
+VuIdleMonitor::Transition VuIdleMonitor::noteMetered(const float* data,
+                                                     unsigned int frames,
+                                                     unsigned int channels,
+                                                     float sampleRate,
+                                                     const float* vuDb,
+                                                     const float* peakHoldDb,
+                                                     unsigned int meteredChannels) {
+    if (sampleRate <= 0.0f || frames == 0) {
+        return Transition::None;
+    }
+    const double seconds = static_cast<double>(frames) / sampleRate;
+    const bool quiet = vuInterleavedPeak(data, frames, channels) <= options_.wakePeak;
+
+    VuIdleState state = state_.load(std::memory_order_acquire);
+
+    if (!quiet) {
+        quietSeconds_ = 0.0;
+        if (state == VuIdleState::Idle) {
+            // Pushed before the capture side saw the idle state
+            if (state_.compare_exchange_strong(state, VuIdleState::Active, std::memory_order_acq_rel)) {
+                wakeups_.fetch_add(1, std::memory_order_relaxed);
+                addSeconds(seconds_[static_cast<int>(VuIdleState::Active)], seconds);
+                return Transition::Woke;
+            }
+        } else {
+            state_.store(VuIdleState::Active, std::memory_order_release);
+        }
+        addSeconds(seconds_[static_cast<int>(VuIdleState::Active)], seconds);
+        return Transition::None;
+    }
+
+    if (state == VuIdleState::Idle) {
+        // A block that was already queued when the monitor went idle
+        return Transition::None;
+    }
+
+    quietSeconds_ += seconds;
+    addSeconds(seconds_[static_cast<int>(VuIdleState::Settling)], seconds);
+
+    bool atRest = true;
+    for (unsigned int c = 0; c < meteredChannels; ++c) {
+        atRest = atRest && vuDb[c] <= options_.restVu && peakHoldDb[c] <= options_.restVu;
+    }
+
+    if (options_.idleAfterSeconds > 0.0f && atRest && quietSeconds_ >= options_.idleAfterSeconds) {
+        quietSeconds_ = 0.0;
+        state_.store(VuIdleState::Idle, std::memory_order_release);
+        return Transition::WentIdle;
+    }
+
+    state_.store(VuIdleState::Settling, std::memory_order_release);
+    return Transition::None;
+}
+
+VuIdleMonitor::Residency VuIdleMonitor::residency() const {
+    Residency r;
+    for (std::size_t i = 0; i < seconds_.size(); ++i) {
+        r.seconds[i] = seconds_[i].load(std::memory_order_relaxed);
+    }
+    r.wakeups = wakeups_.load(std::memory_order_relaxed);
+    return r;
+}
+
+void VuIdleMonitor::wake() {
+    quietSeconds_ = 0.0;
+    droppedFrames_.store(0, std::memory_order_relaxed);
+    state_.store(VuIdleState::Active, std::memory_order_release);
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Silence-aware idle state machine for one metered source.
+//
+//   Active   -> Settling  the input's sample peak drops below the wake level
+//   Settling -> Active    the input comes back
+//   Settling -> Idle      quiet for idleAfterSeconds and every needle and peak
+//                         hold is at rest
+//   Idle     -> Active    the first block above the wake level
+//
+// While idle the capture callback only takes the block's sample peak
+// (admit()); quiet blocks are dropped there, so neither the DSP worker nor the
+// UI wakes up. The first loud block is metered in full straight away.
+//
+// admit() runs on the capture thread and noteMetered() on the thread that
+// meters the block (the DSP worker, or the capture thread itself). Idle is
+// entered only by noteMetered() and left by whichever side sees the signal
+// first; each residency counter has one writer.
+struct VuIdleOptions {
+    // 0 disables idling
+    float idleAfterSeconds = 10.0f;
+
+    // Sample peak that counts as signal; about -54 dBFS, the VU path's wake threshold
+    float wakePeak = 0.002f;
+
+    // Needle position at or below which the meter reads as at rest (bottom of a VU scale)
+    float restVu = -20.0f;
+};
+
+enum class VuIdleState { Active, Settling, Idle };
+
+class VuIdleMonitor final {
+  public:
+    enum class Transition { None, WentIdle, Woke };
+
+    // Audio time spent in each state
+    struct Residency {
+        std::array<double, 3> seconds{}; // indexed by VuIdleState
+        std::uint64_t wakeups = 0;
+
+        double totalSeconds() const { return seconds[0] + seconds[1] + seconds[2]; }
+    };
+
+    explicit VuIdleMonitor(const VuIdleOptions& options = VuIdleOptions()) : options_(options) {}
+
+    VuIdleMonitor(const VuIdleMonitor&) = delete;
+    VuIdleMonitor& operator=(const VuIdleMonitor&) = delete;
+
+    // Capture side. Returns false for a block that arrived while idle and is
+    // still quiet (drop it); true otherwise. transition is Woke when this
+    // block ended the idle state.
+    bool admit(const float* data,
+               unsigned int frames,
+               unsigned int channels,
+               float sampleRate,
+               Transition* transition = nullptr);
+
+    // Metering side, after each admitted block. vuDb/peakHoldDb are the
+    // published needle and peak hold levels.
+    Transition noteMetered(const float* data,
+                           unsigned int frames,
+                           unsigned int channels,
+                           float sampleRate,
+                           const float* vuDb,
+                           const float* peakHoldDb,
+                           unsigned int meteredChannels);
+
+    VuIdleState state() const { return state_.load(std::memory_order_acquire); }
+    bool idle() const { return state() == VuIdleState::Idle; }
+
+    // Safe from any thread
+    Residency residency() const;
+
+    // Frames admit() dropped since the last wake(); the metering side adds
+    // them to its stream position
+    std::uint64_t droppedFrames() const { return droppedFrames_.load(std::memory_order_relaxed); }
+
+    // Back to Active (capture restart); residency is kept, droppedFrames() restarts
+    void wake();
+
+  private:
+    static void addSeconds(std::atomic<double>& counter, double seconds) {
+        counter.store(counter.load(std::memory_order_relaxed) + seconds, std::memory_order_relaxed);
+    }
+
+    VuIdleOptions options_;
+    std::atomic<VuIdleState> state_{VuIdleState::Active};
+
+    // Metering side only
+    double quietSeconds_ = 0.0;
+
+    // Active/Settling are written by the metering side, Idle by the capture side
+    std::array<std::atomic<double>, 3> seconds_{};
+    std::atomic<std::uint64_t> wakeups_{0};
+    std::atomic<std::uint64_t> droppedFrames_{0};
+};
+
+// Highest absolute sample of an interleaved buffer, over all channels
+float vuInterleavedPeak(const float* data, unsigned int frames, unsigned int channels);
+
+// "active", "settling", "idle"
+const char* vuIdleStateName(VuIdleState state);
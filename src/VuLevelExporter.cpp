@@ -0,0 +1,570 @@
+#include "VuLevelExporter.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "VuMetrics.h"
+
+static_assert(sizeof(sockaddr_in) <= 16, "Destination::address holds a sockaddr_in");
+
+namespace {
+
+constexpr char kBinaryMagic[4] = {'V', 'U', 'M', '1'};
+constexpr std::uint16_t kBinaryVersion = 1;
+constexpr std::size_t kBinaryHeaderBytes = 8;
+constexpr std::size_t kBinaryFrameBytes = 44; // without channels
+constexpr std::size_t kBinaryChannelBytes = 16;
+
+constexpr char kOscBundleTag[8] = {'#', 'b', 'u', 'n', 'd', 'l', 'e', '\0'};
+constexpr std::size_t kOscBundleHeaderBytes = 16; // tag + time tag
+
+constexpr std::size_t kRequestBytes = 128;
+constexpr std::size_t kCookieDigits = 8; // shorter than any valid request
+
+// splitmix64 finalizer
+std::uint64_t mix64(std::uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+std::int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// -------- Byte order --------
+
+std::uint8_t* putLe(std::uint8_t* p, std::uint64_t v, unsigned int bytes) {
+    for (unsigned int i = 0; i < bytes; ++i) {
+        *p++ = static_cast<std::uint8_t>(v >> (8 * i));
+    }
+    return p;
+}
+
+std::uint8_t* putBe(std::uint8_t* p, std::uint64_t v, unsigned int bytes) {
+    for (unsigned int i = bytes; i-- > 0;) {
+        *p++ = static_cast<std::uint8_t>(v >> (8 * i));
+    }
+    return p;
+}
+
+std::uint32_t floatBits(float f) {
+    std::uint32_t bits = 0;
+    std::memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+std::uint8_t* putLeF32(std::uint8_t* p, float f) {
+    return putLe(p, floatBits(f), 4);
+}
+
+std::uint8_t* putBeF32(std::uint8_t* p, float f) {
+    return putBe(p, floatBits(f), 4);
+}
+
+// OSC strings are NUL-terminated and padded to a multiple of four bytes
+std::size_t oscPaddedSize(std::size_t length) {
+    return (length + 4) & ~std::size_t{3};
+}
+
+std::uint8_t* putOscString(std::uint8_t* p, const char* s, std::size_t length) {
+    const std::size_t padded = oscPaddedSize(length);
+    std::memcpy(p, s, length);
+    std::memset(p + length, 0, padded - length);
+    return p + padded;
+}
+
+} // namespace
+
+// -------- Encoding --------
+
+std::size_t VuLevelExporter::beginPacket(Format format, unsigned int batch, std::uint8_t* out) {
+    if (format == Format::Binary) {
+        std::memcpy(out, kBinaryMagic, sizeof(kBinaryMagic));
+        std::uint8_t* p = putLe(out + 4, kBinaryVersion, 2);
+        putLe(p, 0, 2);
+        return kBinaryHeaderBytes;
+    }
+    if (batch <= 1) {
+        return 0;
+    }
+    std::memcpy(out, kOscBundleTag, sizeof(kOscBundleTag));
+    putBe(out + 8, 1, 8); // time tag 1: immediately
+    return kOscBundleHeaderBytes;
+}
+
+void VuLevelExporter::finishPacket(Format format, std::uint8_t* out, unsigned int frameCount) {
+    if (format == Format::Binary) {
+        putLe(out + 6, frameCount, 2);
+    }
+}
+
+std::size_t VuLevelExporter::appendFrame(Format format,
+                                         unsigned int batch,
+                                         const VuLevelFrame& frame,
+                                         unsigned int sourceIndex,
+                                         std::uint8_t* out,
+                                         std::size_t used,
+                                         std::size_t capacity) {
+    const unsigned int channels = std::min<unsigned int>(frame.channels, kVuMaxChannels);
+    std::uint8_t* p = out + used;
+
+    if (format == Format::Binary) {
+        const std::size_t size = kBinaryFrameBytes + channels * kBinaryChannelBytes;
+        if (used + size > capacity) {
+            return 0;
+        }
+        p = putLe(p, sourceIndex, 2);
+        p = putLe(p, channels, 2);
+        p = putLe(p, frame.sequence, 8);
+        p = putLe(p, frame.frameCounter, 8);
+        p = putLe(p, static_cast<std::uint64_t>(frame.timestampNs), 8);
+        p = putLeF32(p, frame.momentaryLufs);
+        p = putLeF32(p, frame.shortTermLufs);
+        p = putLeF32(p, frame.integratedLufs);
+        p = putLeF32(p, frame.maxTruePeakDbtp);
+        for (unsigned int c = 0; c < channels; ++c) {
+            p = putLeF32(p, frame.vuDb[c]);
+            p = putLeF32(p, frame.peakHoldDb[c]);
+            p = putLeF32(p, frame.truePeakDbtp[c]);
+            p = putLeF32(p, frame.ppmDbfs[c]);
+        }
+        return size;
+    }
+
+    // OSC message /vu/<source> ,ihfff followed by two floats per channel
+    char address[16];
+    const int addressLength = std::snprintf(address, sizeof(address), "/vu/%u", sourceIndex);
+    char tags[8 + 2 * kVuMaxChannels] = ",ihfff";
+    std::size_t tagLength = 6;
+    for (unsigned int c = 0; c < 2 * channels; ++c) {
+        tags[tagLength++] = 'f';
+    }
+
+    const std::size_t prefix = batch > 1 ? 4 : 0; // bundle element size
+    const std::size_t message = oscPaddedSize(static_cast<std::size_t>(addressLength)) + oscPaddedSize(tagLength) + 4 +
+                                8 + 3 * 4 + 2 * channels * 4;
+    if (used + prefix + message > capacity) {
+        return 0;
+    }
+
+    if (prefix > 0) {
+        p = putBe(p, message, 4);
+    }
+    p = putOscString(p, address, static_cast<std::size_t>(addressLength));
+    p = putOscString(p, tags, tagLength);
+    p = putBe(p, channels, 4);
+    p = putBe(p, frame.sequence, 8);
+    p = putBeF32(p, frame.momentaryLufs);
+    p = putBeF32(p, frame.shortTermLufs);
+    p = putBeF32(p, frame.integratedLufs);
+    for (unsigned int c = 0; c < channels; ++c) {
+        p = putBeF32(p, frame.vuDb[c]);
+    }
+    for (unsigned int c = 0; c < channels; ++c) {
+        p = putBeF32(p, frame.peakHoldDb[c]);
+    }
+    return prefix + message;
+}
+
+bool VuLevelExporter::formatFromName(const QString& name, Format* out) {
+    if (name == QLatin1String("binary")) {
+        *out = Format::Binary;
+    } else if (name == QLatin1String("osc")) {
+        *out = Format::Osc;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool VuLevelExporter::parseTarget(const QString& text, Target* out) {
+    const int colon = text.lastIndexOf(QLatin1Char(':'));
+    if (colon <= 0) {
+        return false;
+    }
+    bool ok = false;
+    const uint port = text.mid(colon + 1).toUInt(&ok);
+    if (!ok || port == 0 || port > 65535) {
+        return false;
+    }
+    out->host = text.left(colon);
+    out->port = static_cast<std::uint16_t>(port);
+    return true;
+}
+
+bool VuLevelExporter::parseListen(const QString& text, QString* host, std::uint16_t* port) {
+    const int colon = text.lastIndexOf(QLatin1Char(':'));
+    if (colon == 0) {
+        return false;
+    }
+    bool ok = false;
+    const uint value = text.mid(colon + 1).toUInt(&ok);
+    if (!ok || value == 0 || value > 65535) {
+        return false;
+    }
+    if (colon > 0) {
+        *host = text.left(colon);
+    }
+    *port = static_cast<std::uint16_t>(value);
+    return true;
+}
+
+// -------- Exporter --------
+
+VuLevelExporter::VuLevelExporter(const Options& options) : options_(options) {}
+
+VuLevelExporter::~VuLevelExporter() {
+    stop();
+}
+
+void VuLevelExporter::addSource(SourceFn source) {
+    if (!running_.load(std::memory_order_relaxed)) {
+        sources_.push_back(std::move(source));
+    }
+}
+
+bool VuLevelExporter::start(QString* errorOut) {
+    if (running_.load(std::memory_order_relaxed)) {
+        return true;
+    }
+    if (options_.targets.isEmpty() && options_.listenPort == 0) {
+        if (errorOut) *errorOut = QStringLiteral("No export targets and no listen port");
+        return false;
+    }
+
+    // Resolve fixed targets up front so the thread never blocks in DNS
+    targets_.clear();
+    targets_.reserve(static_cast<std::size_t>(options_.targets.size()));
+    for (const Target& t : options_.targets) {
+        addrinfo hints{};
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_DGRAM;
+        addrinfo* result = nullptr;
+        const QByteArray host = t.host.toUtf8();
+        const QByteArray port = QByteArray::number(t.port);
+        if (getaddrinfo(host.constData(), port.constData(), &hints, &result) != 0 || !result) {
+            if (errorOut) *errorOut = QStringLiteral("Cannot resolve export target %1").arg(t.host);
+            targets_.clear();
+            return false;
+        }
+        Destination& d = targets_.emplace_back();
+        std::memcpy(d.address.data(), result->ai_addr, std::min<std::size_t>(result->ai_addrlen, d.address.size()));
+        freeaddrinfo(result);
+        d.format = t.format;
+        d.batch = std::clamp(t.batch, 1u, kMaxBatch);
+        d.active = true;
+        resetPacket(d);
+    }
+
+    socket_ = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (socket_ < 0) {
+        if (errorOut)
+            *errorOut = QStringLiteral("Cannot create UDP socket: %1").arg(QString::fromLocal8Bit(strerror(errno)));
+        targets_.clear();
+        return false;
+    }
+    fcntl(socket_, F_SETFL, fcntl(socket_, F_GETFL, 0) | O_NONBLOCK);
+
+    if (options_.listenPort != 0) {
+        sockaddr_in local{};
+        local.sin_family = AF_INET;
+        local.sin_port = htons(options_.listenPort);
+        const QByteArray host = options_.listenHost.toUtf8();
+        addrinfo hints{};
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_DGRAM;
+        addrinfo* result = nullptr;
+        if (getaddrinfo(host.constData(), nullptr, &hints, &result) != 0 || !result) {
+            if (errorOut) *errorOut = QStringLiteral("Cannot resolve listen address %1").arg(options_.listenHost);
+            ::close(socket_);
+            socket_ = -1;
+            targets_.clear();
+            return false;
+        }
+        local.sin_addr = reinterpret_cast<const sockaddr_in*>(result->ai_addr)->sin_addr;
+        freeaddrinfo(result);
+        if (::bind(socket_, reinterpret_cast<const sockaddr*>(&local), sizeof(local)) < 0) {
+            if (errorOut)
+                *errorOut = QStringLiteral("Cannot listen on UDP %1:%2: %3")
+                                .arg(options_.listenHost)
+                                .arg(options_.listenPort)
+                                .arg(QString::fromLocal8Bit(strerror(errno)));
+            ::close(socket_);
+            socket_ = -1;
+            targets_.clear();
+            return false;
+        }
+    }
+
+    for (Destination& d : subscribers_) {
+        d.active = false;
+    }
+    std::random_device entropy;
+    cookieSecret_ = (std::uint64_t{entropy()} << 32) ^ entropy();
+    subscriberCount_.store(0, std::memory_order_relaxed);
+    lastSequence_.assign(sources_.size(), 0);
+    lastSentNs_.assign(sources_.size(), 0);
+
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread(&VuLevelExporter::run, this);
+    return true;
+}
+
+void VuLevelExporter::stop() {
+    if (!running_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    if (socket_ >= 0) {
+        ::close(socket_);
+        socket_ = -1;
+    }
+}
+
+VuLevelExporter::Stats VuLevelExporter::stats() const {
+    Stats s;
+    s.framesSent = framesSent_.load(std::memory_order_relaxed);
+    s.packetsSent = packetsSent_.load(std::memory_order_relaxed);
+    s.packetsDropped = packetsDropped_.load(std::memory_order_relaxed);
+    s.subscribers = subscriberCount_.load(std::memory_order_relaxed);
+    return s;
+}
+
+void VuLevelExporter::run() {
+    const double rate = std::clamp(options_.rateHz, 1.0, 1000.0);
+    const auto periodNs = static_cast<std::int64_t>(1e9 / rate);
+    const auto keepaliveNs = static_cast<std::int64_t>(kKeepaliveSeconds * 1e9);
+    // A packet still short of its batch goes out after this many ticks
+    const auto maxAgeNs = [periodNs](const Destination& d) { return periodNs * d.batch; };
+    std::int64_t nextNs = steadyNowNs();
+
+    while (running_.load(std::memory_order_acquire)) {
+        // Sleep until the next tick, serving subscription requests meanwhile
+        std::int64_t nowNs = steadyNowNs();
+        while (nowNs < nextNs && running_.load(std::memory_order_relaxed)) {
+            pollfd pfd{socket_, POLLIN, 0};
+            const int timeoutMs = static_cast<int>((nextNs - nowNs + 999'999) / 1'000'000);
+            if (::poll(&pfd, 1, timeoutMs) > 0 && (pfd.revents & POLLIN)) {
+                handleRequests(steadyNowNs());
+            }
+            nowNs = steadyNowNs();
+        }
+        // A stall (e.g. a suspended machine) skips the missed ticks
+        nextNs = std::max(nextNs + periodNs, nowNs);
+
+        for (Destination& d : subscribers_) {
+            if (d.active && nowNs >= d.expiresNs) {
+                flush(d);
+                d.active = false;
+                subscriberCount_.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+
+        for (std::size_t i = 0; i < sources_.size(); ++i) {
+            const VuLevelFrame frame = sources_[i]();
+            if (frame.sequence == lastSequence_[i] && nowNs - lastSentNs_[i] < keepaliveNs) {
+                continue;
+            }
+            lastSequence_[i] = frame.sequence;
+            lastSentNs_[i] = nowNs;
+
+            const auto source = static_cast<unsigned int>(i);
+            for (Destination& d : targets_) {
+                publish(d, frame, source, nowNs);
+            }
+            for (Destination& d : subscribers_) {
+                if (d.active) {
+                    publish(d, frame, source, nowNs);
+                }
+            }
+        }
+
+        for (Destination& d : targets_) {
+            if (d.frames > 0 && nowNs - d.firstFrameNs >= maxAgeNs(d)) {
+                flush(d);
+            }
+        }
+        for (Destination& d : subscribers_) {
+            if (d.active && d.frames > 0 && nowNs - d.firstFrameNs >= maxAgeNs(d)) {
+                flush(d);
+            }
+        }
+    }
+
+    // Send what is still batched up
+    for (Destination& d : targets_) {
+        flush(d);
+    }
+    for (Destination& d : subscribers_) {
+        if (d.active) {
+            flush(d);
+        }
+    }
+}
+
+void VuLevelExporter::handleRequests(std::int64_t nowNs) {
+    char request[kRequestBytes];
+    sockaddr_in from{};
+    socklen_t fromLength = sizeof(from);
+
+    for (;;) {
+        const ssize_t n = ::recvfrom(
+            socket_, request, sizeof(request) - 1, 0, reinterpret_cast<sockaddr*>(&from), &fromLength);
+        if (n < 0) {
+            return; // EAGAIN: drained
+        }
+        request[n] = '\0';
+        fromLength = sizeof(from);
+
+        char verb[16] = {};
+        char format[16] = {};
+        unsigned int batch = 1;
+        char cookie[16] = {};
+        if (std::sscanf(request, "%15s %15s %u %15s", verb, format, &batch, cookie) < 1) {
+            continue;
+        }
+
+        // Existing entry for this address, else a free one
+        Destination* entry = nullptr;
+        Destination* free = nullptr;
+        for (Destination& d : subscribers_) {
+            sockaddr_in to;
+            std::memcpy(&to, d.address.data(), sizeof(to));
+            if (d.active && to.sin_addr.s_addr == from.sin_addr.s_addr && to.sin_port == from.sin_port) {
+                entry = &d;
+                break;
+            }
+            if (!d.active && !free) {
+                free = &d;
+            }
+        }
+
+        if (std::strcmp(verb, "unsubscribe") == 0) {
+            if (entry) {
+                entry->active = false;
+                subscriberCount_.fetch_sub(1, std::memory_order_relaxed);
+            }
+            continue;
+        }
+        if (std::strcmp(verb, "subscribe") != 0) {
+            continue;
+        }
+
+        Format f = Format::Binary;
+        if (format[0] != '\0' && !formatFromName(QString::fromLatin1(format), &f)) {
+            continue;
+        }
+        batch = std::clamp(batch, 1u, kMaxBatch);
+
+        const bool added = !entry;
+        if (added) {
+            // Only stream to an address that has shown it receives our replies
+            const std::int64_t epoch = nowNs / static_cast<std::int64_t>(kSubscriptionSeconds * 1e9);
+            const std::uint32_t expected = cookieFor(from.sin_addr.s_addr, from.sin_port, epoch);
+            const std::uint32_t previous = cookieFor(from.sin_addr.s_addr, from.sin_port, epoch - 1);
+            char* end = nullptr;
+            const unsigned long given = std::strtoul(cookie, &end, 16);
+            const bool valid = std::strlen(cookie) == kCookieDigits && *end == '\0' &&
+                               (given == expected || given == previous);
+            if (!valid) {
+                char reply[kCookieDigits + 1];
+                std::snprintf(reply, sizeof(reply), "%08x", static_cast<unsigned int>(expected));
+                ::sendto(socket_, reply, kCookieDigits, 0, reinterpret_cast<const sockaddr*>(&from), sizeof(from));
+                continue;
+            }
+            if (!free) {
+                continue; // table full; the client's renewal will retry
+            }
+            entry = free;
+            entry->address = {};
+            std::memcpy(entry->address.data(), &from, sizeof(from));
+            entry->active = true;
+            subscriberCount_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // A change of format or batch starts a new packet
+        if (added || entry->format != f || entry->batch != batch) {
+            entry->format = f;
+            entry->batch = batch;
+            resetPacket(*entry);
+        }
+        entry->expiresNs = nowNs + static_cast<std::int64_t>(kSubscriptionSeconds * 1e9);
+    }
+}
+
+std::uint32_t VuLevelExporter::cookieFor(std::uint32_t address, std::uint16_t port, std::int64_t epoch) const {
+    const std::uint64_t h = mix64(cookieSecret_ ^ ((std::uint64_t{address} << 16) | port));
+    return static_cast<std::uint32_t>(mix64(h ^ static_cast<std::uint64_t>(epoch)) >> 32);
+}
+
+void VuLevelExporter::publish(Destination& d,
+                              const VuLevelFrame& frame,
+                              unsigned int sourceIndex,
+                              std::int64_t nowNs) {
+    std::size_t size = appendFrame(d.format, d.batch, frame, sourceIndex, d.packet.data(), d.used, d.packet.size());
+    if (size == 0 && d.frames > 0) {
+        // Full before the batch was: send what fits and start over
+        flush(d);
+        size = appendFrame(d.format, d.batch, frame, sourceIndex, d.packet.data(), d.used, d.packet.size());
+    }
+    if (size == 0) {
+        return;
+    }
+    if (d.frames == 0) {
+        d.firstFrameNs = nowNs;
+    }
+    d.used += size;
+    ++d.frames;
+
+    // Without a bundle an OSC packet holds exactly one message
+    const bool bare = d.format == Format::Osc && d.batch <= 1;
+    if (bare || d.frames >= d.batch) {
+        flush(d);
+    }
+}
+
+void VuLevelExporter::flush(Destination& d) {
+    if (d.frames == 0) {
+        return;
+    }
+    finishPacket(d.format, d.packet.data(), d.frames);
+
+    const ssize_t sent = ::sendto(socket_,
+                                  d.packet.data(),
+                                  d.used,
+                                  0,
+                                  reinterpret_cast<const sockaddr*>(d.address.data()),
+                                  sizeof(sockaddr_in));
+    if (sent == static_cast<ssize_t>(d.used)) {
+        packetsSent_.fetch_add(1, std::memory_order_relaxed);
+        framesSent_.fetch_add(d.frames, std::memory_order_relaxed);
+        vuMetrics().add(VuCounter::ExportPackets);
+    } else {
+        packetsDropped_.fetch_add(1, std::memory_order_relaxed);
+        vuMetrics().add(VuCounter::ExportDrops);
+    }
+    resetPacket(d);
+}
+
+void VuLevelExporter::resetPacket(Destination& d) {
+    d.used = beginPacket(d.format, d.batch, d.packet.data());
+    d.frames = 0;
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <QList>
+#include <QString>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "VuLevelSnapshot.h"
+
+// Publishes meter levels over UDP to remote dashboards, lighting desks and the
+// like, independent of the GUI.
+//
+// The exporter runs on its own thread. At the configured rate it reads each
+// source's latest VuLevelFrame (a lock-free seqlock read, so the DSP worker is
+// never held up) and appends the frames that changed to every destination's
+// packet buffer; a packet is sent once it holds the destination's batch of
+// frames, or once its oldest frame is a batch of ticks old, so a slow or idle
+// source never holds frames back for long. Sockets are non-blocking: a
+// destination that cannot keep up loses packets (counted in stats()) instead
+// of stalling anything. Packet buffers and the subscriber table are
+// fixed-size, so steady-state serialization never allocates.
+//
+// Destinations are either fixed (Options::targets) or subscribe themselves by
+// sending a datagram to Options::listenPort on Options::listenHost (loopback
+// unless configured otherwise):
+//
+//   subscribe [binary|osc] [batch] [cookie]   start or renew (default: binary, 1)
+//   unsubscribe
+//
+// Frames go to the address the request came from, so before streaming to a
+// new address the exporter checks that it can receive: a subscribe without a
+// valid cookie is answered with just a cookie (8 hex digits, never larger than
+// the request), which the client repeats as the fourth field. Cookies are
+// keyed to the address and stay valid for one to two kSubscriptionSeconds; a
+// renewal from an active subscriber needs none. A subscription lapses
+// kSubscriptionSeconds after the last request, so clients renew it every few
+// seconds.
+//
+// Binary packets (little endian):
+//   header   char[4] "VUM1", u16 version (1), u16 frame count
+//   frame    u16 source, u16 channels, u64 sequence, u64 frameCounter,
+//            i64 timestampNs, f32 momentaryLufs, f32 shortTermLufs,
+//            f32 integratedLufs, f32 maxTruePeakDbtp,
+//            then per channel f32 vuDb, f32 peakHoldDb, f32 truePeakDbtp, f32 ppmDbfs
+//
+// OSC packets: one message per frame, in an immediate bundle when batched:
+//   /vu/<source> ,ihfff{f...}  channels, sequence (int64), momentary,
+//                              short-term and integrated LUFS, then vuDb and
+//                              peakHoldDb per channel
+class VuLevelExporter final {
+  public:
+    enum class Format { Binary, Osc };
+
+    struct Target {
+        QString host;
+        std::uint16_t port = 0;
+        Format format = Format::Binary;
+        unsigned int batch = 1; // frames per packet
+    };
+
+    struct Options {
+        double rateHz = 30.0;
+        QList<Target> targets;
+        QString listenHost = QStringLiteral("127.0.0.1"); // address subscriptions are accepted on
+        std::uint16_t listenPort = 0;                     // 0: no subscriptions
+    };
+
+    struct Stats {
+        std::uint64_t framesSent = 0;
+        std::uint64_t packetsSent = 0;
+        std::uint64_t packetsDropped = 0; // socket buffer full or send error
+        unsigned int subscribers = 0;
+    };
+
+    // Fits a standard Ethernet MTU without IP fragmentation
+    static constexpr std::size_t kMaxPacketBytes = 1472;
+    static constexpr unsigned int kMaxBatch = 64;
+    static constexpr unsigned int kMaxSubscribers = 16;
+    static constexpr double kSubscriptionSeconds = 10.0;
+    // An unchanged (e.g. idle) source is re-sent this often so clients see it is alive
+    static constexpr double kKeepaliveSeconds = 1.0;
+
+    using SourceFn = std::function<VuLevelFrame()>;
+
+    explicit VuLevelExporter(const Options& options);
+    ~VuLevelExporter();
+
+    VuLevelExporter(const VuLevelExporter&) = delete;
+    VuLevelExporter& operator=(const VuLevelExporter&) = delete;
+
+    // Sources are exported in the order added, as source 0, 1, ...; only
+    // before start(). source must be safe to call from the exporter thread.
+    void addSource(SourceFn source);
+
+    // Resolves the targets, opens the socket and starts the thread
+    bool start(QString* errorOut = nullptr);
+    void stop();
+    bool isRunning() const { return running_.load(std::memory_order_relaxed); }
+
+    Stats stats() const;
+
+    // Packet encoding, as used by the exporter thread; none of it allocates.
+    // beginPacket() writes the header (binary: frame count patched by
+    // finishPacket(); OSC: a bundle header when batch > 1) and returns its size.
+    // appendFrame() writes one frame at out + used and returns its size, or 0
+    // when it would not fit in capacity.
+    static std::size_t beginPacket(Format format, unsigned int batch, std::uint8_t* out);
+    static std::size_t appendFrame(Format format,
+                                   unsigned int batch,
+                                   const VuLevelFrame& frame,
+                                   unsigned int sourceIndex,
+                                   std::uint8_t* out,
+                                   std::size_t used,
+                                   std::size_t capacity);
+    static void finishPacket(Format format, std::uint8_t* out, unsigned int frameCount);
+
+    static bool formatFromName(const QString& name, Format* out);
+    // host:port
+    static bool parseTarget(const QString& text, Target* out);
+    // [host:]port; host is left unchanged when omitted
+    static bool parseListen(const QString& text, QString* host, std::uint16_t* port);
+
+  private:
+    // A resolved destination and its packet under construction
+    struct Destination {
+        std::array<std::uint8_t, 16> address{}; // sockaddr_in
+        Format format = Format::Binary;
+        unsigned int batch = 1;
+        std::int64_t expiresNs = 0; // subscribers only; 0 = fixed target
+        bool active = false;
+
+        std::array<std::uint8_t, kMaxPacketBytes> packet{};
+        std::size_t used = 0;
+        unsigned int frames = 0;
+        std::int64_t firstFrameNs = 0; // when the packet's first frame was added
+    };
+
+    void run();
+    void handleRequests(std::int64_t nowNs);
+    // address and port in network byte order, as in sockaddr_in
+    std::uint32_t cookieFor(std::uint32_t address, std::uint16_t port, std::int64_t epoch) const;
+    void publish(Destination& d, const VuLevelFrame& frame, unsigned int sourceIndex, std::int64_t nowNs);
+    void flush(Destination& d);
+    void resetPacket(Destination& d);
+
+    Options options_;
+    std::vector<SourceFn> sources_;
+
+    // Exporter thread only once running; sized in start()
+    std::vector<Destination> targets_;
+    std::array<Destination, kMaxSubscribers> subscribers_{};
+    std::vector<std::uint64_t> lastSequence_;
+    std::vector<std::int64_t> lastSentNs_;
+
+    int socket_ = -1;
+    std::uint64_t cookieSecret_ = 0; // drawn in start()
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+
+    std::atomic<std::uint64_t> framesSent_{0};
+    std::atomic<std::uint64_t> packetsSent_{0};
+    std::atomic<std::uint64_t> packetsDropped_{0};
+    std::atomic<unsigned int> subscriberCount_{0};
+};
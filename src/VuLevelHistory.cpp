@@ -0,0 +1,165 @@
+#include "VuLevelHistory.h"
+
+#include <algorithm>
+#include <cmath>
+
+VuLevelHistory::VuLevelHistory(float floorDb) : floorDb_(floorDb) {
+    for (Level& level : levels_) {
+        level.values = std::make_unique<std::atomic<float>[]>(kCapacity * kMaxChannels * kValuesPerBucket);
+    }
+}
+
+double VuLevelHistory::bucketSeconds(unsigned int level) {
+    double seconds = kBaseBucketSeconds;
+    for (unsigned int i = 0; i < level; ++i) {
+        seconds *= kDecimation;
+    }
+    return seconds;
+}
+
+unsigned int VuLevelHistory::levelFor(double seconds, unsigned int maxBuckets) {
+    const double buckets = static_cast<double>(std::min(maxBuckets, kCapacity));
+    for (unsigned int level = 0; level < kLevels; ++level) {
+        if (bucketSeconds(level) * buckets >= seconds) {
+            return level;
+        }
+    }
+    return kLevels - 1;
+}
+
+// -------- Writer --------
+
+void VuLevelHistory::push(const VuLevelFrame& frame, unsigned int frames, float sampleRate) {
+    if (frames == 0 || sampleRate <= 0.0f) {
+        return;
+    }
+
+    const unsigned int channels = std::min(frame.channels, kMaxChannels);
+    if (channels != writerChannels_) {
+        writerChannels_ = channels;
+        channels_.store(channels, std::memory_order_relaxed);
+    }
+
+    if (sampleRate != sampleRate_) {
+        sampleRate_ = sampleRate;
+        bucketFrames_ = std::max<std::uint64_t>(1, std::llround(sampleRate * kBaseBucketSeconds));
+        bucketFill_ = std::min(bucketFill_, bucketFrames_ - 1);
+    }
+
+    // Stream time skipped since the last frame (idle blocks are dropped
+    // before metering); anything beyond the coarsest level's span would only
+    // overwrite floor buckets with floor buckets
+    const std::uint64_t start = frame.frameCounter >= frames ? frame.frameCounter - frames : 0;
+    if (lastFrameCounter_ != 0 && start > lastFrameCounter_) {
+        const std::uint64_t maxGap = static_cast<std::uint64_t>(bucketSeconds(kLevels - 1) / kBaseBucketSeconds) *
+                                     kCapacity * bucketFrames_;
+        std::array<float, kMaxChannels> floor;
+        floor.fill(floorDb_);
+        addSpan(floor.data(), floor.data(), std::min(start - lastFrameCounter_, maxGap));
+    }
+    lastFrameCounter_ = frame.frameCounter;
+
+    addSpan(frame.vuDb.data(), frame.peakHoldDb.data(), frames);
+}
+
+void VuLevelHistory::addSpan(const float* vuDb, const float* peakDb, std::uint64_t frames) {
+    std::array<Bucket, kMaxChannels> in;
+    for (unsigned int c = 0; c < writerChannels_; ++c) {
+        in[c] = {vuDb[c], vuDb[c], peakDb[c]};
+    }
+
+    while (frames > 0) {
+        const std::uint64_t n = std::min(frames, bucketFrames_ - bucketFill_);
+        mergePending(levels_[0], in.data());
+        bucketFill_ += n;
+        frames -= n;
+
+        if (bucketFill_ == bucketFrames_) {
+            bucketFill_ = 0;
+            closeBucket(0);
+        }
+    }
+}
+
+void VuLevelHistory::mergePending(Level& level, const Bucket* buckets) {
+    for (unsigned int c = 0; c < writerChannels_; ++c) {
+        Bucket& p = level.pending[c];
+        const Bucket& b = buckets[c];
+        if (level.merged == 0) {
+            p = b;
+        } else {
+            p.vuMin = std::min(p.vuMin, b.vuMin);
+            p.vuMax = std::max(p.vuMax, b.vuMax);
+            p.peakMax = std::max(p.peakMax, b.peakMax);
+        }
+    }
+    ++level.merged;
+}
+
+void VuLevelHistory::closeBucket(unsigned int index) {
+    Level& level = levels_[index];
+
+    // Announce the bucket before overwriting its slot, so a reader that may
+    // have seen any of the new values also sees the announcement
+    const std::uint64_t bucket = level.started.load(std::memory_order_relaxed);
+    level.started.store(bucket + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    std::atomic<float>* slot = &level.values[(bucket % kCapacity) * kMaxChannels * kValuesPerBucket];
+    for (unsigned int c = 0; c < writerChannels_; ++c) {
+        const Bucket& p = level.pending[c];
+        slot[c * kValuesPerBucket + 0].store(p.vuMin, std::memory_order_relaxed);
+        slot[c * kValuesPerBucket + 1].store(p.vuMax, std::memory_order_relaxed);
+        slot[c * kValuesPerBucket + 2].store(p.peakMax, std::memory_order_relaxed);
+    }
+    level.published.store(bucket + 1, std::memory_order_release);
+
+    if (index + 1 < kLevels) {
+        Level& coarser = levels_[index + 1];
+        mergePending(coarser, level.pending.data());
+        if (coarser.merged == kDecimation) {
+            closeBucket(index + 1);
+        }
+    }
+    level.merged = 0;
+}
+
+// -------- Reader --------
+
+std::uint64_t VuLevelHistory::bucketCount(unsigned int level) const {
+    if (level >= kLevels) {
+        return 0;
+    }
+    return levels_[level].published.load(std::memory_order_acquire);
+}
+
+unsigned int
+VuLevelHistory::read(unsigned int level, unsigned int channel, Bucket* out, unsigned int maxBuckets) const {
+    if (level >= kLevels || channel >= kMaxChannels) {
+        return 0;
+    }
+    const Level& l = levels_[level];
+
+    const std::uint64_t published = l.published.load(std::memory_order_acquire);
+    unsigned int n = static_cast<unsigned int>(std::min<std::uint64_t>({maxBuckets, published, kCapacity}));
+    const std::uint64_t first = published - n;
+
+    for (unsigned int i = 0; i < n; ++i) {
+        const std::atomic<float>* slot =
+            &l.values[((first + i) % kCapacity) * kMaxChannels * kValuesPerBucket + channel * kValuesPerBucket];
+        out[i] = {slot[0].load(std::memory_order_relaxed),
+                  slot[1].load(std::memory_order_relaxed),
+                  slot[2].load(std::memory_order_relaxed)};
+    }
+
+    // Buckets older than started - kCapacity may have been overwritten
+    // while they were copied
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const std::uint64_t started = l.started.load(std::memory_order_relaxed);
+    if (started > kCapacity && first < started - kCapacity) {
+        const unsigned int stale = static_cast<unsigned int>(std::min<std::uint64_t>(n, started - kCapacity - first));
+        std::copy(out + stale, out + n, out);
+        n -= stale;
+    }
+    return n;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "VuLevelSnapshot.h"
+
+// Scrolling level history behind the meter's history strip: VU and peak-hold
+// levels per channel over the last minutes, at several resolutions.
+//
+// The DSP thread appends every published VuLevelFrame (push()); the GUI reads
+// the newest buckets of whichever resolution suits the span and width it
+// draws (read()). Each level is a fixed ring of min/max buckets. The finest is
+// kBaseBucketSeconds wide and each coarser one kDecimation times wider, merged
+// as the finer level fills: with the defaults 5 s at 10 ms, 20 s at 40 ms,
+// 82 s at 160 ms and 5.5 min at 640 ms.
+//
+// Buckets follow stream time (VuLevelFrame::frameCounter), so an idle spell,
+// whose blocks are dropped before metering, shows up as floor buckets. Nothing
+// allocates after construction and neither side locks: the writer announces a
+// bucket, stores it as relaxed atomics and then publishes it, and a reader
+// drops whatever the writer may have overwritten while it was copying.
+class VuLevelHistory final {
+  public:
+    static constexpr unsigned int kLevels = 4;
+    static constexpr unsigned int kDecimation = 4;
+    static constexpr unsigned int kCapacity = 512; // buckets per level
+    static constexpr double kBaseBucketSeconds = 0.010;
+
+    // Channels kept; the rest of a wider stream is not recorded
+    static constexpr unsigned int kMaxChannels = 8;
+
+    struct Bucket {
+        float vuMin = 0.0f;
+        float vuMax = 0.0f;
+        float peakMax = 0.0f; // highest peak hold
+    };
+
+    explicit VuLevelHistory(float floorDb = -20.0f);
+
+    VuLevelHistory(const VuLevelHistory&) = delete;
+    VuLevelHistory& operator=(const VuLevelHistory&) = delete;
+
+    // Writer side (one thread): frame covers the `frames` stream frames up to
+    // frame.frameCounter. A frame counter that goes backwards (a device
+    // switch) continues the history without a gap.
+    void push(const VuLevelFrame& frame, unsigned int frames, float sampleRate);
+
+    static double bucketSeconds(unsigned int level);
+
+    // Finest level that spans `seconds` in at most maxBuckets buckets, or
+    // the coarsest level if none does
+    static unsigned int levelFor(double seconds, unsigned int maxBuckets);
+
+    // Reader side, from any thread
+    unsigned int channels() const { return channels_.load(std::memory_order_relaxed); }
+
+    // Buckets completed on a level so far; changes when there is more to draw
+    std::uint64_t bucketCount(unsigned int level) const;
+
+    // Copies up to maxBuckets of the newest buckets of one channel, oldest
+    // first, and returns how many were copied
+    unsigned int read(unsigned int level, unsigned int channel, Bucket* out, unsigned int maxBuckets) const;
+
+  private:
+    static constexpr unsigned int kValuesPerBucket = 3;
+
+    struct Level {
+        // kCapacity buckets of kMaxChannels channels of kValuesPerBucket floats
+        std::unique_ptr<std::atomic<float>[]> values;
+
+        // Buckets announced (the writer may be storing the last one) and
+        // completed
+        alignas(64) std::atomic<std::uint64_t> started{0};
+        std::atomic<std::uint64_t> published{0};
+
+        // Writer only: the bucket being merged from the finer level (or from
+        // frames on level 0)
+        std::array<Bucket, kMaxChannels> pending{};
+        unsigned int merged = 0;
+    };
+
+    void addSpan(const float* vuDb, const float* peakDb, std::uint64_t frames);
+    void mergePending(Level& level, const Bucket* buckets);
+    void closeBucket(unsigned int level);
+
+    float floorDb_;
+    std::array<Level, kLevels> levels_;
+    std::atomic<unsigned int> channels_{0};
+
+    // Writer only
+    unsigned int writerChannels_ = 0;
+    float sampleRate_ = 0.0f;
+    std::uint64_t bucketFrames_ = 0;
+    std::uint64_t bucketFill_ = 0;
+    std::uint64_t lastFrameCounter_ = 0;
+};
@@ -0,0 +1,80 @@
+#include "VuLevelSnapshot.h"
+
+#include <algorithm>
+#include <cstring>
+
+// -------- VuLevelSnapshot --------
+
+VuLevelSnapshot::VuLevelSnapshot() {
+    for (auto& w : words_) {
+        w.store(0, std::memory_order_relaxed);
+    }
+}
+
+void VuLevelSnapshot::publish(const VuLevelFrame& frame) {
+    std::array<std::uint64_t, kWords> buf{};
+    VuLevelFrame stamped = frame;
+    stamped.sequence = ++published_;
+    std::memcpy(buf.data(), &stamped, sizeof(VuLevelFrame));
+
+    const std::uint64_t seq = seq_.load(std::memory_order_relaxed);
+    seq_.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (std::size_t i = 0; i < kWords; ++i) {
+        words_[i].store(buf[i], std::memory_order_relaxed);
+    }
+
+    seq_.store(seq + 2, std::memory_order_release);
+}
+
+VuLevelFrame VuLevelSnapshot::read() const {
+    std::array<std::uint64_t, kWords> buf{};
+
+    for (;;) {
+        const std::uint64_t before = seq_.load(std::memory_order_acquire);
+        if (before & 1u) {
+            continue;
+        }
+
+        for (std::size_t i = 0; i < kWords; ++i) {
+            buf[i] = words_[i].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq_.load(std::memory_order_relaxed) == before) {
+            break;
+        }
+    }
+
+    VuLevelFrame frame;
+    std::memcpy(static_cast<void*>(&frame), buf.data(), sizeof(VuLevelFrame));
+    return frame;
+}
+
+// -------- VuPeakHold --------
+
+void VuPeakHold::reset(float valueDb) {
+    peak_.fill(valueDb);
+    holdLeft_.fill(0.0f);
+}
+
+void VuPeakHold::update(const float* vuDb, unsigned int channels, unsigned int frames, float sampleRate, float* outDb) {
+    channels = std::min(channels, kVuMaxChannels);
+    const float dt = (sampleRate > 0.0f) ? static_cast<float>(frames) / sampleRate : 0.0f;
+
+    for (unsigned int c = 0; c < channels; ++c) {
+        const float x = vuDb[c];
+
+        if (x >= peak_[c]) {
+            peak_[c] = x;
+            holdLeft_[c] = kHoldSeconds;
+        } else if (holdLeft_[c] > 0.0f) {
+            holdLeft_[c] -= dt;
+        } else {
+            peak_[c] = std::max(x, peak_[c] - kReleaseDbPerSecond * dt);
+        }
+
+        outDb[c] = peak_[c];
+    }
+}
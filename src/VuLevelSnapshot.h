@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+#include "VUBallistics.h"
+#include "VuDetectors.h"
+
+// One consistent set of meter levels, as published by the DSP worker.
+struct VuLevelFrame final {
+    std::array<float, kVuMaxChannels> vuDb{};       // ballistics output per channel
+    std::array<float, kVuMaxChannels> peakHoldDb{}; // highest vuDb over the hold window
+    unsigned int channels = 0;
+
+    // Broadcast detector readings (VuDetectors.h); only meaningful for the
+    // detectors the source runs
+    std::array<float, kVuMaxChannels> truePeakDbtp{};
+    std::array<float, kVuMaxChannels> ppmDbfs{};
+    float maxTruePeakDbtp = kVuDetectorFloorDb;
+    float momentaryLufs = kVuDetectorFloorDb;
+    float shortTermLufs = kVuDetectorFloorDb;
+    float integratedLufs = kVuDetectorFloorDb;
+
+    // Stream position after the block these levels were computed from, in
+    // capture frames (idle-skipped ones included) since the source was
+    // created; not reset on a device switch or restart
+    std::uint64_t frameCounter = 0;
+
+    // steady_clock time (ns) of the update; 0 for a reset that is not a DSP update
+    std::int64_t timestampNs = 0;
+
+    // Incremented on every publish; lets consumers skip frames they already saw
+    std::uint64_t sequence = 0;
+
+    // Channel 0/1 with the mono fallback used by the stereo meter
+    float leftVuDb() const { return vuDb[0]; }
+    float rightVuDb() const { return vuDb[channels == 1 ? 0 : 1]; }
+};
+
+// Single-writer, multi-reader seqlock holding the latest VuLevelFrame.
+//
+// The DSP worker publishes without blocking; the UI frame scheduler and any
+// other consumer read a whole frame without locks and never see channels from
+// different blocks. The payload is stored as relaxed atomic words so torn
+// reads are detected by the sequence check rather than being a data race.
+class VuLevelSnapshot final {
+  public:
+    VuLevelSnapshot();
+
+    // Writer side (one thread at a time)
+    void publish(const VuLevelFrame& frame);
+
+    // Reader side; retries while a publish is in progress
+    VuLevelFrame read() const;
+
+  private:
+    static_assert(std::is_trivially_copyable_v<VuLevelFrame>);
+    static constexpr std::size_t kWords = (sizeof(VuLevelFrame) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    std::atomic<std::uint64_t> seq_{0}; // odd while a publish is in progress
+    std::array<std::atomic<std::uint64_t>, kWords> words_;
+    std::uint64_t published_ = 0; // writer-only frame sequence
+};
+
+// Per-channel peak hold applied to the ballistics output before publishing:
+// a new maximum is held for kHoldSeconds, then the hold falls back to the
+// current level at kReleaseDbPerSecond.
+class VuPeakHold final {
+  public:
+    static constexpr float kHoldSeconds = 1.5f;
+    static constexpr float kReleaseDbPerSecond = 20.0f;
+
+    void reset(float valueDb);
+    void update(const float* vuDb, unsigned int channels, unsigned int frames, float sampleRate, float* outDb);
+
+  private:
+    std::array<float, kVuMaxChannels> peak_{};
+    std::array<float, kVuMaxChannels> holdLeft_{}; // seconds of hold remaining
+};
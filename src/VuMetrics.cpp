@@ -0,0 +1,196 @@
+#include "VuMetrics.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+
+// -------- VuLatencyHistogram --------
+
+unsigned int VuLatencyHistogram::bucketFor(std::uint64_t ns) {
+    ns = std::min<std::uint64_t>(ns, (std::uint64_t{1} << kMaxBits) - 1);
+    if (ns < kSubBuckets) {
+        return static_cast<unsigned int>(ns);
+    }
+    // Octave [2^e, 2^(e+1)) is split into kSubBuckets equal steps
+    const unsigned int e = 63u - static_cast<unsigned int>(std::countl_zero(ns));
+    const unsigned int shift = e - kSubBucketBits;
+    return (shift + 1) * kSubBuckets + static_cast<unsigned int>((ns >> shift) - kSubBuckets);
+}
+
+std::uint64_t VuLatencyHistogram::bucketLowerNs(unsigned int bucket) {
+    if (bucket < kSubBuckets) {
+        return bucket;
+    }
+    const unsigned int shift = bucket / kSubBuckets - 1;
+    return static_cast<std::uint64_t>(kSubBuckets + bucket % kSubBuckets) << shift;
+}
+
+void VuLatencyHistogram::record(std::uint64_t ns) {
+    buckets_[bucketFor(ns)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sumNs_.fetch_add(ns, std::memory_order_relaxed);
+
+    std::uint64_t max = maxNs_.load(std::memory_order_relaxed);
+    while (ns > max && !maxNs_.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+    }
+}
+
+void VuLatencyHistogram::reset() {
+    for (auto& b : buckets_) {
+        b.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    sumNs_.store(0, std::memory_order_relaxed);
+    maxNs_.store(0, std::memory_order_relaxed);
+}
+
+std::uint64_t VuLatencyHistogram::quantileNs(double q) const {
+    // Sum the buckets rather than trusting count_, which may be a step ahead
+    std::array<std::uint64_t, kBuckets> counts;
+    std::uint64_t total = 0;
+    for (unsigned int i = 0; i < kBuckets; ++i) {
+        counts[i] = buckets_[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    const double wanted = std::clamp(q, 0.0, 1.0) * static_cast<double>(total);
+    const std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(wanted + 0.5));
+    std::uint64_t seen = 0;
+    for (unsigned int i = 0; i < kBuckets; ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            const std::uint64_t upper = (i + 1 < kBuckets) ? bucketLowerNs(i + 1) - 1 : bucketLowerNs(i);
+            return std::min(upper, maxNs());
+        }
+    }
+    return maxNs();
+}
+
+// -------- VuMetrics --------
+
+VuMetrics::VuMetrics() {
+    startNs_.store(nowNs(), std::memory_order_relaxed);
+}
+
+VuMetricsSnapshot VuMetrics::snapshot() const {
+    VuMetricsSnapshot s;
+    s.uptimeSeconds = static_cast<double>(nowNs() - startNs_.load(std::memory_order_relaxed)) * 1e-9;
+
+    for (std::size_t i = 0; i < kVuStageCount; ++i) {
+        const VuLatencyHistogram& h = stages_[i].histogram;
+        VuStageStats& out = s.stages[i];
+        out.count = h.count();
+        out.meanNs = out.count > 0 ? static_cast<double>(h.sumNs()) / static_cast<double>(out.count) : 0.0;
+        out.p50Ns = h.quantileNs(0.50);
+        out.p90Ns = h.quantileNs(0.90);
+        out.p99Ns = h.quantileNs(0.99);
+        out.p999Ns = h.quantileNs(0.999);
+        out.maxNs = h.maxNs();
+    }
+    for (std::size_t i = 0; i < kVuCounterCount; ++i) {
+        s.counters[i] = counters_[i].value.load(std::memory_order_relaxed);
+    }
+    return s;
+}
+
+void VuMetrics::reset() {
+    for (Stage& stage : stages_) {
+        stage.histogram.reset();
+    }
+    for (Counter& c : counters_) {
+        c.value.store(0, std::memory_order_relaxed);
+    }
+    startNs_.store(nowNs(), std::memory_order_relaxed);
+}
+
+VuMetrics& vuMetrics() {
+    static VuMetrics metrics;
+    return metrics;
+}
+
+// -------- Names / JSON --------
+
+const char* vuStageName(VuStage stage) {
+    switch (stage) {
+    case VuStage::Capture:
+        return "capture";
+    case VuStage::Dsp:
+        return "dsp";
+    case VuStage::Paint:
+        return "paint";
+    case VuStage::FrameInterval:
+        return "frame_interval";
+    case VuStage::Spectrum:
+        return "spectrum";
+    case VuStage::Overlay:
+        return "overlay";
+    }
+    return "unknown";
+}
+
+const char* vuCounterName(VuCounter counter) {
+    switch (counter) {
+    case VuCounter::CaptureBuffers:
+        return "capture_buffers";
+    case VuCounter::CaptureOverflows:
+        return "capture_overflows";
+    case VuCounter::RingOverruns:
+        return "ring_overruns";
+    case VuCounter::RingDroppedFrames:
+        return "ring_dropped_frames";
+    case VuCounter::DspBlocks:
+        return "dsp_blocks";
+    case VuCounter::Paints:
+        return "paints";
+    case VuCounter::MissedFrames:
+        return "missed_frames";
+    case VuCounter::ExportPackets:
+        return "export_packets";
+    case VuCounter::ExportDrops:
+        return "export_drops";
+    }
+    return "unknown";
+}
+
+std::string vuMetricsJson(const VuMetricsSnapshot& snapshot) {
+    std::string out;
+    char num[64];
+
+    const auto us = [&num](double ns) {
+        std::snprintf(num, sizeof(num), "%.3f", ns * 1e-3);
+        return std::string(num);
+    };
+
+    std::snprintf(num, sizeof(num), "%.3f", snapshot.uptimeSeconds);
+    out += "{\n  \"uptime_s\": ";
+    out += num;
+    out += ",\n  \"stages\": {";
+
+    for (std::size_t i = 0; i < kVuStageCount; ++i) {
+        const VuStageStats& s = snapshot.stages[i];
+        out += (i == 0) ? "\n" : ",\n";
+        out += "    \"";
+        out += vuStageName(static_cast<VuStage>(i));
+        out += "\": {\"count\": " + std::to_string(s.count);
+        out += ", \"mean_us\": " + us(s.meanNs);
+        out += ", \"p50_us\": " + us(static_cast<double>(s.p50Ns));
+        out += ", \"p90_us\": " + us(static_cast<double>(s.p90Ns));
+        out += ", \"p99_us\": " + us(static_cast<double>(s.p99Ns));
+        out += ", \"p999_us\": " + us(static_cast<double>(s.p999Ns));
+        out += ", \"max_us\": " + us(static_cast<double>(s.maxNs));
+        out += "}";
+    }
+
+    out += "\n  },\n  \"counters\": {";
+    for (std::size_t i = 0; i < kVuCounterCount; ++i) {
+        out += (i == 0) ? "\n" : ",\n";
+        out += "    \"";
+        out += vuCounterName(static_cast<VuCounter>(i));
+        out += "\": " + std::to_string(snapshot.counters[i]);
+    }
+    out += "\n  }\n}\n";
+    return out;
+}
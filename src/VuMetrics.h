@@ -0,0 +1,152 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Process-wide runtime metrics: event counters and latency histograms for the
+// capture, DSP and paint stages.
+//
+// Everything is preallocated and updated with relaxed atomics, so recording
+// never locks or allocates and is safe on the audio threads. Each stage is in
+// practice written by one thread (capture callback, DSP worker, GUI thread);
+// every histogram and counter sits on its own cache line so those writers do
+// not contend.
+// Readers take a snapshot() at any time; a snapshot taken during an update
+// may be off by that one event.
+
+enum class VuStage {
+    Capture,      // capture callback, from entry to return
+    Dsp,          // one metering pass on the DSP worker
+    Paint,        // meter paintEvent() / paintGL()
+    FrameInterval, // time between ticks of an active VUFrameScheduler
+    Spectrum,      // one spectrum update on the VuSpectrumAnalyzer thread
+    Overlay        // rendering the meter's history/spectrum strip
+};
+inline constexpr std::size_t kVuStageCount = 6;
+
+enum class VuCounter {
+    CaptureBuffers,    // buffers delivered by the audio API
+    CaptureOverflows,  // the audio server dropped captured data (PulseAudio overflow)
+    RingOverruns,      // pushes rejected by the capture -> DSP ring
+    RingDroppedFrames, // frames lost to those overruns
+    DspBlocks,         // metering passes
+    Paints,            // meter repaints
+    MissedFrames,      // display frames an active scheduler did not tick for
+    ExportPackets,     // UDP packets sent by VuLevelExporter
+    ExportDrops        // packets it dropped because a socket buffer was full
+};
+inline constexpr std::size_t kVuCounterCount = 9;
+
+// HDR-style histogram of durations in nanoseconds: 16 linear sub-buckets per
+// power of two (about 6% resolution) from 1 ns up to 2^40 ns (18 minutes),
+// larger values land in the top bucket.
+class VuLatencyHistogram final {
+  public:
+    static constexpr unsigned int kSubBucketBits = 4;
+    static constexpr unsigned int kSubBuckets = 1u << kSubBucketBits;
+    static constexpr unsigned int kMaxBits = 40;
+    static constexpr unsigned int kBuckets = (kMaxBits - kSubBucketBits + 1) * kSubBuckets;
+
+    void record(std::uint64_t ns);
+    void reset();
+
+    std::uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    std::uint64_t sumNs() const { return sumNs_.load(std::memory_order_relaxed); }
+    std::uint64_t maxNs() const { return maxNs_.load(std::memory_order_relaxed); }
+
+    // Upper edge of the bucket holding the q-quantile (0..1); 0 when empty
+    std::uint64_t quantileNs(double q) const;
+
+    static unsigned int bucketFor(std::uint64_t ns);
+    static std::uint64_t bucketLowerNs(unsigned int bucket);
+
+  private:
+    std::atomic<std::uint64_t> count_{0};
+    std::atomic<std::uint64_t> sumNs_{0};
+    std::atomic<std::uint64_t> maxNs_{0};
+    std::array<std::atomic<std::uint64_t>, kBuckets> buckets_{};
+};
+
+struct VuStageStats {
+    std::uint64_t count = 0;
+    double meanNs = 0.0;
+    std::uint64_t p50Ns = 0;
+    std::uint64_t p90Ns = 0;
+    std::uint64_t p99Ns = 0;
+    std::uint64_t p999Ns = 0;
+    std::uint64_t maxNs = 0;
+};
+
+struct VuMetricsSnapshot {
+    double uptimeSeconds = 0.0; // since start or the last reset()
+    std::array<VuStageStats, kVuStageCount> stages{};
+    std::array<std::uint64_t, kVuCounterCount> counters{};
+
+    const VuStageStats& stage(VuStage s) const { return stages[static_cast<std::size_t>(s)]; }
+    std::uint64_t counter(VuCounter c) const { return counters[static_cast<std::size_t>(c)]; }
+};
+
+class VuMetrics final {
+  public:
+    VuMetrics();
+
+    VuMetrics(const VuMetrics&) = delete;
+    VuMetrics& operator=(const VuMetrics&) = delete;
+
+    void record(VuStage stage, std::uint64_t ns) { stages_[static_cast<std::size_t>(stage)].histogram.record(ns); }
+    void add(VuCounter counter, std::uint64_t n = 1) {
+        counters_[static_cast<std::size_t>(counter)].value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    VuMetricsSnapshot snapshot() const;
+
+    // Clears every histogram and counter; events racing with it may survive
+    void reset();
+
+    static std::int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+  private:
+    struct alignas(64) Stage {
+        VuLatencyHistogram histogram;
+    };
+    struct alignas(64) Counter {
+        std::atomic<std::uint64_t> value{0};
+    };
+
+    std::array<Stage, kVuStageCount> stages_;
+    std::array<Counter, kVuCounterCount> counters_;
+    std::atomic<std::int64_t> startNs_{0};
+};
+
+// The process-wide registry
+VuMetrics& vuMetrics();
+
+// Records the lifetime of the scope as one event of a stage
+class VuScopedTimer final {
+  public:
+    explicit VuScopedTimer(VuStage stage) : stage_(stage), startNs_(VuMetrics::nowNs()) {}
+    ~VuScopedTimer() { vuMetrics().record(stage_, static_cast<std::uint64_t>(VuMetrics::nowNs() - startNs_)); }
+
+    VuScopedTimer(const VuScopedTimer&) = delete;
+    VuScopedTimer& operator=(const VuScopedTimer&) = delete;
+
+  private:
+    VuStage stage_;
+    std::int64_t startNs_;
+};
+
+// "capture", "dsp", "paint", "frame_interval"
+const char* vuStageName(VuStage stage);
+// "capture_buffers", "capture_overflows", ...
+const char* vuCounterName(VuCounter counter);
+
+// {"uptime_s": ..., "stages": {"capture": {"count": ..., "mean_us": ..., "p50_us": ...}, ...},
+//  "counters": {"capture_buffers": ..., ...}}
+std::string vuMetricsJson(const VuMetricsSnapshot& snapshot);
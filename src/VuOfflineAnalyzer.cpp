@@ -0,0 +1,246 @@
+#include "VuOfflineAnalyzer.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QThread>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "VUBallistics.h"
+#include "VuAudioFileReader.h"
+
+namespace {
+
+// Same clamp range as the live Linux capture path
+constexpr float kFloorVu = -96.0f;
+constexpr float kCeilingVu = 6.0f;
+constexpr float kPeakFloorDbfs = -120.0f;
+
+// Frames decoded per read; a multiple of the interval is used so only the
+// final interval of a file can be short
+constexpr unsigned int kChunkFrames = 65536;
+
+// Binary layout (little-endian):
+//   char[4]  "AVUT"
+//   uint32   version (1)
+//   uint32   channels in each record
+//   float32  sample rate
+//   uint32   frames per record (the last record may cover fewer)
+// followed by one record per interval of `channels` pairs {float32 vu, float32 peak_dbfs}.
+constexpr char kBinaryMagic[4] = {'A', 'V', 'U', 'T'};
+constexpr std::uint32_t kBinaryVersion = 1;
+
+void appendU32(QByteArray& out, std::uint32_t v) {
+    const char bytes[4] = {static_cast<char>(v & 0xFF),
+                           static_cast<char>((v >> 8) & 0xFF),
+                           static_cast<char>((v >> 16) & 0xFF),
+                           static_cast<char>((v >> 24) & 0xFF)};
+    out.append(bytes, 4);
+}
+
+void appendF32(QByteArray& out, float f) {
+    std::uint32_t bits = 0;
+    std::memcpy(&bits, &f, sizeof(bits));
+    appendU32(out, bits);
+}
+
+QByteArray binaryHeader(unsigned int channels, float sampleRate, unsigned int intervalFrames) {
+    QByteArray out;
+    out.append(kBinaryMagic, 4);
+    appendU32(out, kBinaryVersion);
+    appendU32(out, channels);
+    appendF32(out, sampleRate);
+    appendU32(out, intervalFrames);
+    return out;
+}
+
+QByteArray csvHeader(unsigned int channels) {
+    QByteArray out("time_s");
+    for (unsigned int c = 0; c < channels; ++c) {
+        out += ",ch" + QByteArray::number(c) + "_vu,ch" + QByteArray::number(c) + "_peak_dbfs";
+    }
+    out += '\n';
+    return out;
+}
+
+} // namespace
+
+VuOfflineAnalyzer::VuOfflineAnalyzer(const Options& options) : options_(options) {}
+
+QString VuOfflineAnalyzer::defaultOutputPath(const QString& inputPath, Format format) {
+    return inputPath + (format == Format::Binary ? QStringLiteral(".vu.bin") : QStringLiteral(".vu.csv"));
+}
+
+VuOfflineAnalyzer::Result VuOfflineAnalyzer::analyze(const Job& job) const {
+    Result result;
+    result.inputPath = job.inputPath;
+    result.outputPath = job.outputPath.isEmpty() ? defaultOutputPath(job.inputPath, options_.format) : job.outputPath;
+
+    QElapsedTimer wall;
+    wall.start();
+
+    QString err;
+    std::unique_ptr<VuAudioFileReader> reader = VuAudioFileReader::open(job.inputPath, &err);
+    if (!reader) {
+        result.error = err;
+        return result;
+    }
+
+    const unsigned int inChannels = reader->channels();
+    const unsigned int channels = std::min(inChannels, kVuMaxChannels);
+    const float sampleRate = reader->sampleRate();
+    const unsigned int intervalFrames =
+        std::max(1u, static_cast<unsigned int>(std::lround(sampleRate * options_.intervalMs / 1000.0)));
+    const unsigned int chunkFrames = intervalFrames * std::max(1u, kChunkFrames / intervalFrames);
+
+    result.channels = channels;
+    result.sampleRate = sampleRate;
+
+    QFile out(result.outputPath);
+    if (!out.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        result.error = QStringLiteral("Cannot write %1: %2").arg(result.outputPath, out.errorString());
+        return result;
+    }
+
+    const bool binary = options_.format == Format::Binary;
+    out.write(binary ? binaryHeader(channels, sampleRate, intervalFrames) : csvHeader(channels));
+
+    VUBallisticsBank ballistics(kFloorVu);
+    ballistics.setJitterEnabled(options_.needleJitter);
+    ballistics.setFastMath(options_.mathMode == VuMathMode::Fast);
+    VuAudioDspState state;
+    state.integrationMode = options_.integrationMode;
+    state.mathMode = options_.mathMode;
+
+    VuDetectorOptions detectors;
+    detectors.truePeak = options_.loudness;
+    detectors.loudness = options_.loudness;
+    std::unique_ptr<VuDetectorState> detectorState;
+    if (detectors.any()) {
+        detectorState = std::make_unique<VuDetectorState>();
+    }
+
+    const VuCalibration calibration = vuCalibration(options_.reference);
+
+    std::vector<float> chunk(static_cast<std::size_t>(chunkFrames) * inChannels);
+    std::array<float, kVuMaxChannels> vu{};
+    std::array<float, kVuMaxChannels> peak{};
+
+    // One record is formatted into here, then appended to the (buffered) file
+    QByteArray record;
+    record.reserve(static_cast<qsizetype>(channels) * 32 + 32);
+    char num[32];
+
+    for (;;) {
+        // Fill the chunk; decoders may return short reads before the end
+        unsigned int got = 0;
+        while (got < chunkFrames) {
+            const unsigned int n = reader->read(chunk.data() + static_cast<std::size_t>(got) * inChannels, chunkFrames - got);
+            if (n == 0) {
+                break;
+            }
+            got += n;
+        }
+        if (got == 0) {
+            break;
+        }
+
+        if (detectorState) {
+            processInterleavedFloatAudioDetectors(chunk.data(), got, inChannels, sampleRate, detectors, *detectorState);
+        }
+
+        for (unsigned int pos = 0; pos < got; pos += intervalFrames) {
+            const unsigned int frames = std::min(intervalFrames, got - pos);
+            const float* slice = chunk.data() + static_cast<std::size_t>(pos) * inChannels;
+
+            peak.fill(0.0f);
+            for (unsigned int i = 0; i < frames; ++i) {
+                const float* frame = slice + static_cast<std::size_t>(i) * inChannels;
+                for (unsigned int c = 0; c < channels; ++c) {
+                    peak[c] = std::max(peak[c], std::abs(frame[c]));
+                }
+            }
+
+            processInterleavedFloatAudioToVuDb(slice,
+                                               frames,
+                                               inChannels,
+                                               sampleRate,
+                                               calibration,
+                                               ballistics,
+                                               state,
+                                               kFloorVu,
+                                               kCeilingVu,
+                                               vu.data());
+
+            record.clear();
+            if (!binary) {
+                std::snprintf(num, sizeof(num), "%.4f", static_cast<double>(result.frames) / sampleRate);
+                record.append(num);
+            }
+            for (unsigned int c = 0; c < channels; ++c) {
+                const float peakDbfs = std::max(kPeakFloorDbfs, 20.0f * std::log10(std::max(peak[c], 1e-12f)));
+                if (binary) {
+                    appendF32(record, vu[c]);
+                    appendF32(record, peakDbfs);
+                } else {
+                    std::snprintf(num, sizeof(num), ",%.3f,%.2f", vu[c], peakDbfs);
+                    record.append(num);
+                }
+            }
+            if (!binary) {
+                record.append('\n');
+            }
+
+            if (out.write(record) != record.size()) {
+                result.error = QStringLiteral("Write error on %1: %2").arg(result.outputPath, out.errorString());
+                return result;
+            }
+
+            result.frames += frames;
+            ++result.records;
+        }
+    }
+
+    if (!reader->error().isEmpty()) {
+        result.error = QStringLiteral("Decode error in %1: %2").arg(job.inputPath, reader->error());
+        return result;
+    }
+
+    if (!out.flush()) {
+        result.error = QStringLiteral("Write error on %1: %2").arg(result.outputPath, out.errorString());
+        return result;
+    }
+
+    if (detectorState) {
+        result.loudnessMeasured = true;
+        result.integratedLufs = detectorState->readings.integratedLufs;
+        result.maxTruePeakDbtp = detectorState->readings.maxTruePeakDbtp;
+    }
+
+    result.audioSeconds = static_cast<double>(result.frames) / sampleRate;
+    result.wallSeconds = static_cast<double>(wall.nsecsElapsed()) * 1e-9;
+    result.ok = true;
+    return result;
+}
+
+QList<VuOfflineAnalyzer::Result> VuOfflineAnalyzer::analyzeAll(const QList<Job>& jobs, int maxThreads) const {
+    // Plain vector so workers write distinct elements without any container detach
+    std::vector<Result> results(static_cast<std::size_t>(jobs.size()));
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(maxThreads > 0 ? maxThreads : QThread::idealThreadCount());
+
+    for (qsizetype i = 0; i < jobs.size(); ++i) {
+        pool.start([this, &jobs, &results, i]() { results[static_cast<std::size_t>(i)] = analyze(jobs[i]); });
+    }
+    pool.waitForDone();
+
+    return QList<Result>(results.begin(), results.end());
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <QList>
+#include <QString>
+
+#include <cstdint>
+
+#include "VuAudioDsp.h"
+#include "VuDetectors.h"
+
+// Batch metering of recorded audio files through the live meter's DSP path
+// (processInterleavedFloatAudioToVuDb + VUBallisticsBank), without capture or
+// widgets. Files are streamed in fixed-size chunks, so memory use is constant
+// regardless of length, and several files run in parallel on a thread pool.
+//
+// For every output interval the result holds one record per channel with the
+// ballistics output (VU) and the sample peak (dBFS) within the interval.
+// Optionally the whole file's integrated loudness and true peak are measured
+// on the way (VuDetectors.h).
+class VuOfflineAnalyzer {
+  public:
+    enum class Format {
+        Csv,   // time_s,ch0_vu,ch0_peak_dbfs,ch1_vu,...
+        Binary // "AVUT" header + float32 records; see writeBinaryHeader()
+    };
+
+    struct Options {
+        Format format = Format::Csv;
+        double intervalMs = 10.0;
+
+        VuReferenceOptions reference;
+        VuIntegrationMode integrationMode = VuIntegrationMode::BlockAccurate;
+        VuMathMode mathMode = VuMathMode::Exact;
+
+        // Off by default so repeated runs of the same file are bit-identical
+        bool needleJitter = false;
+
+        // Integrated loudness and maximum true peak for the Result
+        bool loudness = false;
+    };
+
+    struct Job {
+        QString inputPath;
+        QString outputPath; // empty: defaultOutputPath()
+    };
+
+    struct Result {
+        bool ok = false;
+        QString error;
+
+        QString inputPath;
+        QString outputPath;
+
+        unsigned int channels = 0;
+        float sampleRate = 0.0f;
+        std::uint64_t frames = 0;
+        std::uint64_t records = 0;
+        double audioSeconds = 0.0;
+        double wallSeconds = 0.0;
+
+        // Options::loudness
+        bool loudnessMeasured = false;
+        float integratedLufs = kVuDetectorFloorDb;
+        float maxTruePeakDbtp = kVuDetectorFloorDb;
+    };
+
+    explicit VuOfflineAnalyzer(const Options& options);
+
+    Result analyze(const Job& job) const;
+
+    // Runs the jobs on up to maxThreads workers (0 = one per core). Results are
+    // returned in job order.
+    QList<Result> analyzeAll(const QList<Job>& jobs, int maxThreads = 0) const;
+
+    // <input>.vu.csv or <input>.vu.bin next to the input
+    static QString defaultOutputPath(const QString& inputPath, Format format);
+
+  private:
+    Options options_;
+};
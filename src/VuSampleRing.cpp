@@ -0,0 +1,85 @@
+#include "VuSampleRing.h"
+
+#include <algorithm>
+#include <cstring>
+
+static std::size_t roundUpToPowerOfTwo(std::size_t n) {
+    std::size_t p = 1;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+VuSampleRing::VuSampleRing(std::size_t capacitySamples) { reset(capacitySamples); }
+
+void VuSampleRing::reset(std::size_t capacitySamples) {
+    capacity_ = capacitySamples > 0 ? roundUpToPowerOfTwo(capacitySamples) : 0;
+    mask_ = capacity_ > 0 ? capacity_ - 1 : 0;
+    buffer_.reset(capacity_ > 0 ? new float[capacity_] : nullptr);
+
+    head_.store(0, std::memory_order_relaxed);
+    tail_.store(0, std::memory_order_relaxed);
+    highWater_.store(0, std::memory_order_relaxed);
+    overruns_.store(0, std::memory_order_relaxed);
+    dropped_.store(0, std::memory_order_relaxed);
+}
+
+bool VuSampleRing::write(const float* data, std::size_t count) {
+    if (count == 0) {
+        return true;
+    }
+
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    const std::size_t tail = tail_.load(std::memory_order_acquire);
+    const std::size_t used = head - tail;
+
+    if (!data || count > capacity_ - used) {
+        overruns_.fetch_add(1, std::memory_order_relaxed);
+        dropped_.fetch_add(count, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Copy in at most two pieces (before and after the wrap point).
+    const std::size_t start = head & mask_;
+    const std::size_t first = std::min(count, capacity_ - start);
+    std::memcpy(buffer_.get() + start, data, first * sizeof(float));
+    if (first < count) {
+        std::memcpy(buffer_.get(), data + first, (count - first) * sizeof(float));
+    }
+
+    head_.store(head + count, std::memory_order_release);
+
+    // Only the producer updates the high-water mark, so a plain store is enough.
+    const std::size_t fill = used + count;
+    if (fill > highWater_.load(std::memory_order_relaxed)) {
+        highWater_.store(fill, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+std::size_t VuSampleRing::read(float* out, std::size_t maxCount) {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    const std::size_t head = head_.load(std::memory_order_acquire);
+    const std::size_t count = std::min(head - tail, maxCount);
+    if (count == 0 || !out) {
+        return 0;
+    }
+
+    const std::size_t start = tail & mask_;
+    const std::size_t first = std::min(count, capacity_ - start);
+    std::memcpy(out, buffer_.get() + start, first * sizeof(float));
+    if (first < count) {
+        std::memcpy(out + first, buffer_.get(), (count - first) * sizeof(float));
+    }
+
+    tail_.store(tail + count, std::memory_order_release);
+    return count;
+}
+
+std::size_t VuSampleRing::fillLevel() const {
+    const std::size_t tail = tail_.load(std::memory_order_acquire);
+    const std::size_t head = head_.load(std::memory_order_acquire);
+    // Both positions may move between the two loads; clamp instead of locking.
+    return std::min(head - tail, capacity_);
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Wait-free single-producer / single-consumer ring of interleaved float samples.
+//
+// The capture callback is the only producer and the DSP worker the only consumer.
+// Writes are all-or-nothing so interleaved frames are never split: when there is
+// not enough free space the whole write is dropped and counted as an overrun.
+class VuSampleRing final {
+  public:
+    explicit VuSampleRing(std::size_t capacitySamples = 0);
+
+    // Reallocates the ring (capacity is rounded up to a power of two).
+    // Not thread-safe: only call while neither side is active.
+    void reset(std::size_t capacitySamples);
+
+    // Producer side.
+    bool write(const float* data, std::size_t count);
+
+    // Consumer side. Returns the number of samples copied into out.
+    std::size_t read(float* out, std::size_t maxCount);
+
+    std::size_t capacity() const { return capacity_; }
+    std::size_t fillLevel() const;
+    std::size_t highWaterMark() const { return highWater_.load(std::memory_order_relaxed); }
+    std::uint64_t overrunCount() const { return overruns_.load(std::memory_order_relaxed); }
+    std::uint64_t droppedSamples() const { return dropped_.load(std::memory_order_relaxed); }
+
+  private:
+    std::unique_ptr<float[]> buffer_;
+    std::size_t capacity_ = 0;
+    std::size_t mask_ = 0;
+
+    // Monotonic positions; the index into buffer_ is (pos & mask_).
+    alignas(64) std::atomic<std::size_t> head_{0}; // written by producer only
+    alignas(64) std::atomic<std::size_t> tail_{0}; // written by consumer only
+
+    alignas(64) std::atomic<std::size_t> highWater_{0};
+    std::atomic<std::uint64_t> overruns_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+};
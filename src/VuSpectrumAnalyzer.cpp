@@ -0,0 +1,217 @@
+#include "VuSpectrumAnalyzer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#include "VuMetrics.h"
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+// About 0.34 s at 48 kHz; the analyzer drains it every 33 ms
+constexpr std::size_t kRingSamples = 4 * VuSpectrumAnalyzer::kFftSize;
+
+// Samples downmixed per ring write in push()
+constexpr unsigned int kPushChunk = 256;
+
+} // namespace
+
+VuSpectrumAnalyzer::VuSpectrumAnalyzer() : ring_(kRingSamples) {
+    for (auto& w : words_) {
+        w.store(0, std::memory_order_relaxed);
+    }
+}
+
+VuSpectrumAnalyzer::~VuSpectrumAnalyzer() { stop(); }
+
+float VuSpectrumAnalyzer::bandEdgeHz(unsigned int band) {
+    const float t = static_cast<float>(band) / static_cast<float>(VuSpectrumFrame::kBands);
+    return kLowHz * std::pow(kHighHz / kLowHz, t);
+}
+
+void VuSpectrumAnalyzer::start() {
+    if (isRunning()) {
+        return;
+    }
+
+    if (!fft_) {
+        fft_ = std::make_unique<VuRealFft>(kFftSize);
+        chunk_.resize(kRingSamples);
+        history_.resize(kFftSize);
+        input_.resize(kFftSize);
+        re_.resize(fft_->bins());
+        im_.resize(fft_->bins());
+
+        window_.resize(kFftSize);
+        for (unsigned int i = 0; i < kFftSize; ++i) {
+            window_[i] = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * kPi * i / kFftSize));
+        }
+    }
+
+    std::fill(history_.begin(), history_.end(), 0.0f);
+    historyPos_ = 0;
+    bands_ = VuSpectrumFrame();
+    bands_.bandDb.fill(kFloorDb);
+
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread([this]() { run(); });
+}
+
+void VuSpectrumAnalyzer::stop() {
+    running_.store(false, std::memory_order_release);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void VuSpectrumAnalyzer::push(const float* data, unsigned int frames, unsigned int channels, float sampleRate) {
+    if (!isRunning() || channels == 0) {
+        return;
+    }
+    sampleRate_.store(sampleRate, std::memory_order_relaxed);
+
+    const float scale = 1.0f / static_cast<float>(channels);
+    float mono[kPushChunk];
+    while (frames > 0) {
+        const unsigned int n = std::min(frames, kPushChunk);
+        for (unsigned int i = 0; i < n; ++i) {
+            float sum = 0.0f;
+            for (unsigned int c = 0; c < channels; ++c) {
+                sum += data[c];
+            }
+            mono[i] = sum * scale;
+            data += channels;
+        }
+        // A full ring means the analyzer is behind; it only needs the newest samples
+        ring_.write(mono, n);
+        frames -= n;
+    }
+}
+
+void VuSpectrumAnalyzer::run() {
+    using Clock = std::chrono::steady_clock;
+    const auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / kUpdateHz));
+
+    // Samples queued before this start are from an older run
+    while (ring_.read(chunk_.data(), chunk_.size()) > 0) {
+    }
+
+    auto next = Clock::now();
+    while (running_.load(std::memory_order_acquire)) {
+        next += interval;
+        std::this_thread::sleep_until(next);
+
+        bool fresh = false;
+        for (;;) {
+            const std::size_t n = ring_.read(chunk_.data(), chunk_.size());
+            if (n == 0) {
+                break;
+            }
+            fresh = true;
+
+            // Only the newest kFftSize samples matter
+            const float* src = chunk_.data();
+            std::size_t count = n;
+            if (count > kFftSize) {
+                src += count - kFftSize;
+                count = kFftSize;
+            }
+            for (std::size_t i = 0; i < count; ++i) {
+                history_[historyPos_] = src[i];
+                historyPos_ = (historyPos_ + 1) % kFftSize;
+            }
+        }
+
+        // Nothing new (e.g. an idle source): keep the last spectrum
+        const float sampleRate = sampleRate_.load(std::memory_order_relaxed);
+        if (fresh && sampleRate > 0.0f) {
+            analyze(sampleRate);
+        }
+    }
+}
+
+void VuSpectrumAnalyzer::analyze(float sampleRate) {
+    VuScopedTimer timer(VuStage::Spectrum);
+
+    if (sampleRate != bandSampleRate_) {
+        bandSampleRate_ = sampleRate;
+        const float binHz = sampleRate / static_cast<float>(kFftSize);
+        const unsigned int lastBin = kFftSize / 2;
+        for (unsigned int b = 0; b <= VuSpectrumFrame::kBands; ++b) {
+            const float bin = std::round(bandEdgeHz(b) / binHz);
+            bandBins_[b] = static_cast<unsigned int>(std::clamp(bin, 1.0f, static_cast<float>(lastBin)));
+        }
+    }
+
+    // historyPos_ is the oldest sample
+    for (unsigned int i = 0; i < kFftSize; ++i) {
+        input_[i] = history_[(historyPos_ + i) % kFftSize] * window_[i];
+    }
+    fft_->transform(input_.data(), re_.data(), im_.data());
+
+    // A sine of amplitude a gives |X| = a * N / 4 through the Hann window
+    const float powerScale = 16.0f / (static_cast<float>(kFftSize) * static_cast<float>(kFftSize));
+    const float fall = kFallDbPerSecond / static_cast<float>(kUpdateHz);
+    const unsigned int bins = fft_->bins();
+
+    for (unsigned int b = 0; b < VuSpectrumFrame::kBands; ++b) {
+        // Low bands narrower than a bin share their nearest bin
+        const unsigned int lo = std::min(bandBins_[b], bins - 1);
+        const unsigned int hi = std::clamp(bandBins_[b + 1], lo + 1, bins);
+
+        float power = 0.0f;
+        for (unsigned int k = lo; k < hi; ++k) {
+            power = std::max(power, re_[k] * re_[k] + im_[k] * im_[k]);
+        }
+        const float db = std::max(kFloorDb, 10.0f * std::log10(power * powerScale + 1e-30f));
+        bands_.bandDb[b] = std::max(db, bands_.bandDb[b] - fall);
+    }
+
+    bands_.sampleRate = sampleRate;
+    ++bands_.sequence;
+    publish(bands_);
+}
+
+// -------- Seqlock --------
+
+void VuSpectrumAnalyzer::publish(const VuSpectrumFrame& frame) {
+    std::array<std::uint64_t, kWords> buf{};
+    std::memcpy(buf.data(), &frame, sizeof(VuSpectrumFrame));
+
+    const std::uint64_t seq = seq_.load(std::memory_order_relaxed);
+    seq_.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (std::size_t i = 0; i < kWords; ++i) {
+        words_[i].store(buf[i], std::memory_order_relaxed);
+    }
+
+    seq_.store(seq + 2, std::memory_order_release);
+}
+
+VuSpectrumFrame VuSpectrumAnalyzer::read() const {
+    std::array<std::uint64_t, kWords> buf{};
+
+    for (;;) {
+        const std::uint64_t before = seq_.load(std::memory_order_acquire);
+        if (before & 1u) {
+            continue;
+        }
+
+        for (std::size_t i = 0; i < kWords; ++i) {
+            buf[i] = words_[i].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq_.load(std::memory_order_relaxed) == before) {
+            break;
+        }
+    }
+
+    VuSpectrumFrame frame;
+    std::memcpy(static_cast<void*>(&frame), buf.data(), sizeof(VuSpectrumFrame));
+    return frame;
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "VuFft.h"
+#include "VuSampleRing.h"
+
+// One set of spectrum bands, as published by VuSpectrumAnalyzer.
+struct VuSpectrumFrame final {
+    static constexpr unsigned int kBands = 48;
+
+    // Level per band in dBFS (a full-scale sine reads 0): log-spaced from
+    // kLowHz to kHighHz, each band the strongest bin in it, falling back
+    // at VuSpectrumAnalyzer::kFallDbPerSecond
+    std::array<float, kBands> bandDb{};
+    float sampleRate = 0.0f;
+
+    // Incremented on every publish; 0 until the first spectrum
+    std::uint64_t sequence = 0;
+};
+
+// Real-time spectrum of one source for the meter's spectrum strip.
+//
+// The DSP worker hands each metered block to push(), which only downmixes it
+// into a wait-free ring (and returns at once while the analyzer is stopped).
+// The analyzer's own thread wakes kUpdateHz times a second, takes the newest
+// kFftSize samples, applies a Hann window and a preplanned VuRealFft, and
+// publishes the bands through a seqlock like VuLevelSnapshot. Buffers and the
+// FFT plan are allocated by start(), so the running analyzer never allocates
+// and the audio path never waits on it.
+class VuSpectrumAnalyzer final {
+  public:
+    static constexpr unsigned int kFftSize = 4096; // 85 ms, 11.7 Hz bins at 48 kHz
+    static constexpr double kUpdateHz = 30.0;
+    static constexpr float kLowHz = 20.0f;
+    static constexpr float kHighHz = 20000.0f;
+    static constexpr float kFloorDb = -120.0f;
+    static constexpr float kFallDbPerSecond = 40.0f;
+
+    VuSpectrumAnalyzer();
+    ~VuSpectrumAnalyzer();
+
+    VuSpectrumAnalyzer(const VuSpectrumAnalyzer&) = delete;
+    VuSpectrumAnalyzer& operator=(const VuSpectrumAnalyzer&) = delete;
+
+    // GUI thread
+    void start();
+    void stop();
+    bool isRunning() const { return running_.load(std::memory_order_acquire); }
+
+    // Producer (one thread, the DSP worker): channels are averaged to mono
+    void push(const float* data, unsigned int frames, unsigned int channels, float sampleRate);
+
+    // Latest bands; lock-free, from any thread
+    VuSpectrumFrame read() const;
+
+    // Lower edge of band b in Hz (b == kBands gives the upper edge of the last)
+    static float bandEdgeHz(unsigned int band);
+
+  private:
+    void run();
+    void analyze(float sampleRate);
+    void publish(const VuSpectrumFrame& frame);
+
+    // Sized once in the constructor: push() may still be running while the
+    // analyzer stops or starts
+    VuSampleRing ring_;
+    std::atomic<float> sampleRate_{0.0f};
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+
+    // Analyzer thread only
+    std::unique_ptr<VuRealFft> fft_;
+    std::vector<float> chunk_;
+    std::vector<float> history_; // newest kFftSize samples, circular
+    std::size_t historyPos_ = 0;
+    std::vector<float> window_;
+    std::vector<float> input_;
+    std::vector<float> re_;
+    std::vector<float> im_;
+    float bandSampleRate_ = 0.0f;
+    std::array<unsigned int, VuSpectrumFrame::kBands + 1> bandBins_{};
+    VuSpectrumFrame bands_;
+
+    // Seqlock holding the latest VuSpectrumFrame
+    static_assert(std::is_trivially_copyable_v<VuSpectrumFrame>);
+    static constexpr std::size_t kWords =
+        (sizeof(VuSpectrumFrame) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+    std::atomic<std::uint64_t> seq_{0};
+    std::array<std::atomic<std::uint64_t>, kWords> words_;
+};
@@ -0,0 +1,48 @@
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QTextStream>
+
+#include "AudioCapture.h"
+#include "VuCommandLine.h"
+#include "VuHeadless.h"
+#include "version.h"
+
+// analog_vu_headless: the metering daemon. Links only analog_vu_core (Qt Core,
+// the audio API and the DSP), so it starts without Qt Gui/Widgets, a display
+// connection, fonts or skins.
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("AnalogVUMeter");
+    QCoreApplication::setApplicationVersion(APP_VERSION);
+    QCoreApplication::setOrganizationName("AnalogVUMeter");
+    QCoreApplication::setOrganizationDomain("analogvumeter.org");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Analog VU meter levels without a window: exports (--export, --export-listen) "
+                                     "or logs (--log-levels) levels until interrupted");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    const VuCommandLine common;
+    common.addOptions(parser);
+    parser.process(app);
+
+    if (common.listDevices(parser)) {
+        QTextStream(stdout) << AudioCapture::listDevicesString();
+        return 0;
+    }
+
+    AudioCapture::Options options;
+    VuOutputOptions output;
+    QString error;
+    if (!common.apply(parser, &options, &output, &error)) {
+        QTextStream(stderr) << error << Qt::endl;
+        return 2;
+    }
+
+    // Exported and logged with every frame
+    options.detectors.loudness = true;
+    options.detectors.truePeak = true;
+
+    return vuRunHeadless(app, options, output);
+}
@@ -1,14 +1,83 @@
 #include <QApplication>
 #include <QCommandLineParser>
 #include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
 #include <QTextStream>
 
+#include <cstring>
+#include <memory>
+
 #include "AudioCapture.h"
 #include "MainWindow.h"
+#include "VuCommandLine.h"
+#include "VuHeadless.h"
+#include "VuOfflineAnalyzer.h"
 #include "version.h"
 
+// Offline analysis and --headless run without a display, so they must not
+// create a QApplication
+static bool isHeadlessInvocation(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--analyze") == 0 || std::strncmp(argv[i], "--analyze=", 10) == 0 ||
+            std::strcmp(argv[i], "--headless") == 0 || std::strcmp(argv[i], "--no-gui") == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static int runOfflineAnalysis(const QStringList& inputs,
+                              const QString& output,
+                              const VuOfflineAnalyzer::Options& options,
+                              int jobs) {
+    QTextStream err(stderr);
+    QTextStream out(stdout);
+
+    // --analyze-output is a file for a single input and a directory otherwise
+    QList<VuOfflineAnalyzer::Job> work;
+    for (const QString& input : inputs) {
+        VuOfflineAnalyzer::Job job;
+        job.inputPath = input;
+        if (!output.isEmpty()) {
+            if (inputs.size() == 1 && !QFileInfo(output).isDir()) {
+                job.outputPath = output;
+            } else {
+                const QString name = QFileInfo(VuOfflineAnalyzer::defaultOutputPath(input, options.format)).fileName();
+                job.outputPath = QDir(output).filePath(name);
+            }
+        }
+        work.append(job);
+    }
+
+    const VuOfflineAnalyzer analyzer(options);
+    const QList<VuOfflineAnalyzer::Result> results = analyzer.analyzeAll(work, jobs);
+
+    int failures = 0;
+    for (const VuOfflineAnalyzer::Result& r : results) {
+        if (!r.ok) {
+            err << r.inputPath << ": " << r.error << Qt::endl;
+            ++failures;
+            continue;
+        }
+        const double speed = (r.wallSeconds > 0.0) ? r.audioSeconds / r.wallSeconds : 0.0;
+        out << r.inputPath << ": " << r.channels << " ch, " << QString::number(r.audioSeconds, 'f', 1) << " s in "
+            << QString::number(r.wallSeconds, 'f', 2) << " s (" << QString::number(speed, 'f', 0) << "x) -> "
+            << r.outputPath << Qt::endl;
+        if (r.loudnessMeasured) {
+            out << "  integrated " << QString::number(r.integratedLufs, 'f', 1) << " LUFS, true peak "
+                << QString::number(r.maxTruePeakDbtp, 'f', 1) << " dBTP" << Qt::endl;
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}
+
 int main(int argc, char** argv) {
-    QApplication app(argc, argv);
+    const bool headless = isHeadlessInvocation(argc, argv);
+    std::unique_ptr<QCoreApplication> appHolder(headless ? new QCoreApplication(argc, argv)
+                                                         : new QApplication(argc, argv));
+    QCoreApplication& app = *appHolder;
     QCoreApplication::setApplicationName("AnalogVUMeter");
     QCoreApplication::setApplicationVersion(APP_VERSION);
     QCoreApplication::setOrganizationName("AnalogVUMeter");
@@ -23,65 +92,114 @@ int main(int argc, char** argv) {
     parser.addHelpOption();
     parser.addVersionOption();
 
-    QCommandLineOption listDevicesOpt(QStringList() << "list-devices", "List audio devices and exit.");
-    QCommandLineOption deviceOpt(QStringList() << "device", "Audio device index (legacy, unused).", "index");
-#if defined(__APPLE__)
-    QCommandLineOption deviceNameOpt(QStringList() << "device-name", "Audio device UID.", "uid");
-#else
-    QCommandLineOption deviceNameOpt(QStringList() << "device-name", "PulseAudio device name (sink/source).", "name");
-#endif
-    QCommandLineOption deviceTypeOpt(
-        QStringList() << "device-type", "Device type: 0=system output, 1=microphone.", "type", "0");
-    QCommandLineOption refOpt(QStringList() << "ref-dbfs", "Reference dBFS for 0 VU.", "db", "-18");
+    const VuCommandLine common;
+    QCommandLineOption needleAtlasOpt(QStringList() << "needle-atlas",
+                                      "Skin mode: draw the needle from sprites pre-rotated at load time.");
+    QCommandLineOption headlessOpt(QStringList() << "headless" << "no-gui",
+                                   "Capture without a window and only export (--export) or log (--log-levels) "
+                                   "levels; runs until interrupted.");
+    QCommandLineOption analyzeOpt(QStringList() << "analyze",
+                                  "Meter an audio file (WAV/FLAC) offline and exit. May be repeated.",
+                                  "file");
+    QCommandLineOption analyzeOutputOpt(QStringList() << "analyze-output",
+                                        "Output file (single input) or directory for --analyze.",
+                                        "path");
+    QCommandLineOption analyzeFormatOpt(
+        QStringList() << "analyze-format", "Output format for --analyze: csv or binary.", "format", "csv");
+    QCommandLineOption analyzeIntervalOpt(
+        QStringList() << "analyze-interval", "Milliseconds per output record for --analyze.", "ms", "10");
+    QCommandLineOption analyzeLoudnessOpt(
+        QStringList() << "analyze-loudness",
+        "Also measure integrated loudness (EBU R128) and maximum true peak of each --analyze input.");
+    QCommandLineOption jobsOpt(
+        QStringList() << "jobs", "Files analyzed in parallel (default: one per core).", "n", "0");
 
-    parser.addOption(listDevicesOpt);
-    parser.addOption(deviceOpt);
-    parser.addOption(deviceNameOpt);
-    parser.addOption(deviceTypeOpt);
-    parser.addOption(refOpt);
+    common.addOptions(parser);
+    parser.addOption(needleAtlasOpt);
+    parser.addOption(headlessOpt);
+    parser.addOption(analyzeOpt);
+    parser.addOption(analyzeOutputOpt);
+    parser.addOption(analyzeFormatOpt);
+    parser.addOption(analyzeIntervalOpt);
+    parser.addOption(analyzeLoudnessOpt);
+    parser.addOption(jobsOpt);
 
     parser.process(app);
 
-    if (parser.isSet(listDevicesOpt)) {
+    if (common.listDevices(parser)) {
         QTextStream(stdout) << AudioCapture::listDevicesString();
         return 0;
     }
 
     AudioCapture::Options options;
+    VuOutputOptions output;
+    QString error;
+    if (!common.apply(parser, &options, &output, &error)) {
+        QTextStream(stderr) << error << Qt::endl;
+        return 2;
+    }
 
-    // Legacy device index (unused but kept for compatibility)
-    if (parser.isSet(deviceOpt)) {
-        bool ok = false;
-        const int idx = parser.value(deviceOpt).toInt(&ok);
-        if (ok) {
-            options.deviceIndex = idx;
+    if (parser.isSet(analyzeOpt)) {
+        VuOfflineAnalyzer::Options offline;
+        offline.reference.referenceDbfs = options.referenceDbfs;
+        offline.reference.referenceDbfsOverride = options.referenceDbfsOverride;
+        offline.reference.deviceType = options.deviceType;
+        if (options.fastMath) {
+            offline.mathMode = VuMathMode::Fast;
         }
-    }
 
-    // Device name/UID
-    if (parser.isSet(deviceNameOpt)) {
-        options.deviceName = parser.value(deviceNameOpt);
-    }
+        const QString format = parser.value(analyzeFormatOpt);
+        if (format == QLatin1String("binary")) {
+            offline.format = VuOfflineAnalyzer::Format::Binary;
+        } else if (format != QLatin1String("csv")) {
+            QTextStream(stderr) << "Unknown --analyze-format: " << format << Qt::endl;
+            return 2;
+        }
 
-    if (parser.isSet(deviceTypeOpt)) {
         bool ok = false;
-        const int type = parser.value(deviceTypeOpt).toInt(&ok);
-        if (ok) {
-            options.deviceType = type;
+        const double interval = parser.value(analyzeIntervalOpt).toDouble(&ok);
+        if (ok && interval > 0.0) {
+            offline.intervalMs = interval;
         }
+
+        offline.loudness = parser.isSet(analyzeLoudnessOpt);
+
+        return runOfflineAnalysis(parser.values(analyzeOpt),
+                                  parser.value(analyzeOutputOpt),
+                                  offline,
+                                  parser.value(jobsOpt).toInt());
     }
 
-    if (parser.isSet(refOpt)) {
-        bool ok = false;
-        const double ref = parser.value(refOpt).toDouble(&ok);
-        if (ok) {
-            options.referenceDbfs = ref;
-            options.referenceDbfsOverride = true;
-        }
+    // Programme loudness and true peak feed the Needle menu readout and the
+    // exported frames whatever the needles show; together they cost well
+    // under 1% of a core
+    options.detectors.loudness = true;
+    options.detectors.truePeak = true;
+
+    if (headless) {
+        return vuRunHeadless(app, options, output);
     }
 
-    MainWindow w(options);
+    MainWindow::DisplayOptions display;
+    display.needleAtlas = parser.isSet(needleAtlasOpt);
+
+    MainWindow w(options, display);
     w.show();
 
-    return app.exec();
+    // Started after the window so a failure is reported but the meter still runs
+    std::unique_ptr<VuLevelExporter> exporter;
+    if (output.exporting()) {
+        exporter = vuStartLevelExporter(w.audio(), output.exporter, &error);
+        if (!exporter) {
+            QTextStream(stderr) << "Level export failed: " << error << Qt::endl;
+        }
+    }
+
+    const int status = app.exec();
+    exporter.reset();
+    if (!output.metricsJsonPath.isEmpty() && !vuWriteMetricsJson(output.metricsJsonPath, &error)) {
+        QTextStream(stderr) << error << Qt::endl;
+        return status == 0 ? 1 : status;
+    }
+    return status;
 }